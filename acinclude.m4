@@ -7,6 +7,21 @@ AC_DEFUN([AX_LIBFSHFS_CHECK_LOCAL],
   [dnl Check for internationalization functions in libfshfs/libfshfs_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for direct I/O headers and functions in libfshfs/libfshfs_direct_io.c
+  AC_CHECK_HEADERS([errno.h fcntl.h unistd.h])
+
+  AC_CHECK_FUNCS([close open pread])
+
+  dnl Check for kernel copy headers and functions in libfshfs/libfshfs_kernel_copy.c
+  AC_CHECK_HEADERS([sys/sendfile.h])
+
+  AC_CHECK_FUNCS([copy_file_range pwrite sendfile write])
+
+  dnl Check for vectored read headers and functions in libfshfs/libfshfs_io_handle.c
+  AC_CHECK_HEADERS([sys/uio.h])
+
+  AC_CHECK_FUNCS([preadv])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -0,0 +1,416 @@
+/*
+ * Creates a sparse image of the allocated blocks of a Hierarchical File System (HFS) volume
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "fshfstools_getopt.h"
+#include "fshfstools_libcerror.h"
+#include "fshfstools_libclocale.h"
+#include "fshfstools_libcnotify.h"
+#include "fshfstools_libfshfs.h"
+#include "fshfstools_output.h"
+#include "fshfstools_signal.h"
+#include "fshfstools_unused.h"
+#include "image_handle.h"
+
+image_handle_t *fshfsimage_image_handle = NULL;
+int fshfsimage_abort                     = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use fshfsimage to create a sparse image of a Hierarchical\n"
+	                 " File System (HFS) volume that only contains the allocated\n"
+	                 " blocks.\n\n" );
+
+	fprintf( stream, "Usage: fshfsimage [ -o offset ] [ -hmvV ] source target\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n" );
+	fprintf( stream, "\ttarget: the target image file, which is overwritten\n\n" );
+
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     only image the metadata, which consists of the volume\n"
+	                 "\t        headers, the allocation, extents overflow, catalog,\n"
+	                 "\t        attributes and startup files and the journal\n" );
+	fprintf( stream, "\t-o:     specify the volume offset\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for fshfsimage
+ */
+void fshfsimage_signal_handler(
+      fshfstools_signal_t signal FSHFSTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "fshfsimage_signal_handler";
+
+	FSHFSTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	fshfsimage_abort = 1;
+
+	if( fshfsimage_image_handle != NULL )
+	{
+		if( image_handle_signal_abort(
+		     fshfsimage_image_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal image handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libfshfs_error_t *error                  = NULL;
+	system_character_t *option_volume_offset = NULL;
+	system_character_t *source               = NULL;
+	system_character_t *target               = NULL;
+	char *program                            = "fshfsimage";
+	system_integer_t option                  = 0;
+	int metadata_only                        = 0;
+	int result                               = 0;
+	int verbose                              = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "fshfstools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( fshfstools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	fshfstools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = fshfstools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hmo:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				metadata_only = 1;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				fshfstools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libfshfs_notify_set_stream(
+	 stderr,
+	 NULL );
+	libfshfs_notify_set_verbose(
+	 verbose );
+
+	if( image_handle_initialize(
+	     &fshfsimage_image_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize image handle.\n" );
+
+		goto on_error;
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( image_handle_set_volume_offset(
+		     fshfsimage_image_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 fshfsimage_image_handle->volume_offset );
+		}
+	}
+	if( image_handle_open_input(
+	     fshfsimage_image_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	if( image_handle_open_output(
+	     fshfsimage_image_handle,
+	     target,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	if( fshfstools_signal_attach(
+	     fshfsimage_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_only != 0 )
+	{
+		result = image_handle_write_metadata(
+		          fshfsimage_image_handle,
+		          &error );
+	}
+	else
+	{
+		result = image_handle_write_allocated_blocks(
+		          fshfsimage_image_handle,
+		          &error );
+	}
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write image.\n" );
+
+		goto on_error;
+	}
+	if( fshfstools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Imaging: ABORTED\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "Imaging: SUCCESS\n\n" );
+
+		fprintf(
+		 stdout,
+		 "Written: %" PRIu64 " of %" PRIu64 " bytes.\n",
+		 fshfsimage_image_handle->number_of_bytes_written,
+		 fshfsimage_image_handle->volume_size );
+	}
+	if( image_handle_close(
+	     fshfsimage_image_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close image handle.\n" );
+
+		goto on_error;
+	}
+	if( image_handle_free(
+	     &fshfsimage_image_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free image handle.\n" );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( fshfsimage_image_handle != NULL )
+	{
+		image_handle_close(
+		 fshfsimage_image_handle,
+		 NULL );
+		image_handle_free(
+		 &fshfsimage_image_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
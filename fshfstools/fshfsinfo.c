@@ -70,12 +70,14 @@ void usage_fprint(
 	fprintf( stream, "Use fshfsinfo to determine information about a Hierarchical\n"
 	                 " File System (HFS) volume.\n\n" );
 
-	fprintf( stream, "Usage: fshfsinfo [ -o offset ] [ -hHvV ] source\n\n" );
+	fprintf( stream, "Usage: fshfsinfo [ -o offset ] [ -hHjvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-H:     shows the file system hierarchy\n" );
+	fprintf( stream, "\t-j:     replay the journal, without modifying the source,\n"
+	                 "\t        to read the most recent version of the metadata\n" );
 	fprintf( stream, "\t-o:     specify the volume offset\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
@@ -139,6 +141,7 @@ int main( int argc, char * const argv[] )
 	char *program                            = "fshfsinfo";
 	system_integer_t option                  = 0;
 	int option_mode                          = FSHFSINFO_MODE_VOLUME;
+	int replay_journal                       = 0;
 	int verbose                              = 0;
 
 	libcnotify_stream_set(
@@ -174,7 +177,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = fshfstools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hHo:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hHjo:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -201,6 +204,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'j':
+				replay_journal = 1;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -249,6 +257,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	fshfsinfo_info_handle->replay_journal = (uint8_t) replay_journal;
+
 	if( option_volume_offset != NULL )
 	{
 		if( info_handle_set_volume_offset(
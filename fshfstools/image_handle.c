@@ -0,0 +1,967 @@
+/*
+ * Image handle
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "fshfstools_libbfio.h"
+#include "fshfstools_libcerror.h"
+#include "fshfstools_libfshfs.h"
+#include "fshfstools_system_string.h"
+#include "image_handle.h"
+
+#if !defined( LIBFSHFS_HAVE_BFIO )
+
+extern \
+int libfshfs_volume_open_file_io_handle(
+     libfshfs_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libfshfs_error_t **error );
+
+#endif /* !defined( LIBFSHFS_HAVE_BFIO ) */
+
+#define IMAGE_HANDLE_NOTIFY_STREAM	stdout
+
+/* The size of the buffer used to copy data, large enough to read allocated runs
+ * sequentially in a small number of read operations
+ */
+#define IMAGE_HANDLE_BUFFER_SIZE	( 8 * 1024 * 1024 )
+
+/* The size of the reserved boot blocks and the volume header at the start of the volume
+ */
+#define IMAGE_HANDLE_VOLUME_HEADER_END_OFFSET	1536
+
+/* The size of the area at the end of the volume that contains the alternate volume header
+ */
+#define IMAGE_HANDLE_ALTERNATE_VOLUME_HEADER_SIZE	1024
+
+/* Creates an image handle
+ * Make sure the value image_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_initialize(
+     image_handle_t **image_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_initialize";
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *image_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid image handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*image_handle = memory_allocate_structure(
+	                 image_handle_t );
+
+	if( *image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create image handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *image_handle,
+	     0,
+	     sizeof( image_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear image handle.",
+		 function );
+
+		memory_free(
+		 *image_handle );
+
+		*image_handle = NULL;
+
+		return( -1 );
+	}
+	( *image_handle )->buffer = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * IMAGE_HANDLE_BUFFER_SIZE );
+
+	if( ( *image_handle )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *image_handle )->buffer_size = IMAGE_HANDLE_BUFFER_SIZE;
+
+	if( libbfio_file_range_initialize(
+	     &( ( *image_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &( ( *image_handle )->output_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize output file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *image_handle )->notify_stream = IMAGE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *image_handle != NULL )
+	{
+		if( ( *image_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *image_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		if( ( *image_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *image_handle )->buffer );
+		}
+		memory_free(
+		 *image_handle );
+
+		*image_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an image handle
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_free(
+     image_handle_t **image_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_free";
+	int result            = 1;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *image_handle != NULL )
+	{
+		if( ( *image_handle )->input_volume != NULL )
+		{
+			if( libfshfs_volume_free(
+			     &( ( *image_handle )->input_volume ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input volume.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libbfio_handle_free(
+		     &( ( *image_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *image_handle )->output_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *image_handle )->buffer );
+
+		memory_free(
+		 *image_handle );
+
+		*image_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the image handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_signal_abort(
+     image_handle_t *image_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_signal_abort";
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	image_handle->abort = 1;
+
+	if( image_handle->input_volume != NULL )
+	{
+		if( libfshfs_volume_signal_abort(
+		     image_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_set_volume_offset(
+     image_handle_t *image_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( fshfstools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	image_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_open_input(
+     image_handle_t *image_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function          = "image_handle_open_input";
+	size_t filename_length         = 0;
+	uint32_t allocation_block_size = 0;
+	uint32_t number_of_blocks      = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     image_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     image_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file name.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_range_set(
+	     image_handle->input_file_io_handle,
+	     image_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set range.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_initialize(
+	     &( image_handle->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	/* The journal is not replayed since the image should contain the data as stored
+	 */
+	if( libfshfs_volume_open_file_io_handle(
+	     image_handle->input_volume,
+	     image_handle->input_file_io_handle,
+	     LIBFSHFS_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_get_allocation_block_size(
+	     image_handle->input_volume,
+	     &allocation_block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation block size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_get_number_of_blocks(
+	     image_handle->input_volume,
+	     &number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks.",
+		 function );
+
+		goto on_error;
+	}
+	image_handle->volume_size = (size64_t) number_of_blocks * allocation_block_size;
+
+	if( image_handle->volume_size < IMAGE_HANDLE_VOLUME_HEADER_END_OFFSET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( image_handle->input_volume != NULL )
+	{
+		libfshfs_volume_free(
+		 &( image_handle->input_volume ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the output
+ * Returns 1 if successful or -1 on error
+ */
+int image_handle_open_output(
+     image_handle_t *image_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "image_handle_open_output";
+	size_t filename_length = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     image_handle->output_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     image_handle->output_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     image_handle->output_file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output file.",
+		 function );
+
+		return( -1 );
+	}
+	image_handle->number_of_bytes_written = 0;
+
+	return( 1 );
+}
+
+/* Closes the input and output
+ * Returns the 0 if succesful or -1 on error
+ */
+int image_handle_close(
+     image_handle_t *image_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_close";
+	int result            = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_handle->input_volume != NULL )
+	{
+		if( libfshfs_volume_close(
+		     image_handle->input_volume,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input volume.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libbfio_handle_is_open(
+	     image_handle->output_file_io_handle,
+	     NULL ) == 1 )
+	{
+		if( libbfio_handle_close(
+		     image_handle->output_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Copies a range of the volume data from the input to the same offset in the output
+ * Ranges that are not copied remain holes in a sparse output file
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int image_handle_copy_range(
+     image_handle_t *image_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "image_handle_copy_range";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > image_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > ( image_handle->volume_size - (size64_t) offset ) )
+	{
+		size = image_handle->volume_size - (size64_t) offset;
+	}
+	if( libbfio_handle_seek_offset(
+	     image_handle->output_file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in output file.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	while( size > 0 )
+	{
+		if( image_handle->abort != 0 )
+		{
+			return( 0 );
+		}
+		read_size = image_handle->buffer_size;
+
+		if( (size64_t) read_size > size )
+		{
+			read_size = (size_t) size;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              image_handle->input_file_io_handle,
+		              image_handle->buffer,
+		              read_size,
+		              offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ") from input volume.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		write_count = libbfio_handle_write_buffer(
+		               image_handle->output_file_io_handle,
+		               image_handle->buffer,
+		               read_size,
+		               error );
+
+		if( write_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ") to output file.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		offset += read_size;
+		size   -= read_size;
+
+		image_handle->number_of_bytes_written += read_size;
+	}
+	return( 1 );
+}
+
+/* Writes the allocated blocks of the input volume to the output
+ * The volume headers are always written and unallocated blocks are left as holes
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int image_handle_write_allocated_blocks(
+     image_handle_t *image_handle,
+     libcerror_error_t **error )
+{
+	static char *function          = "image_handle_write_allocated_blocks";
+	uint32_t allocation_block_size = 0;
+	uint32_t block_number          = 0;
+	uint32_t number_of_run_blocks  = 0;
+	uint8_t is_allocated           = 0;
+	int result                     = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_volume_get_allocation_block_size(
+	     image_handle->input_volume,
+	     &allocation_block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation block size.",
+		 function );
+
+		return( -1 );
+	}
+	result = image_handle_copy_range(
+	          image_handle,
+	          0,
+	          IMAGE_HANDLE_VOLUME_HEADER_END_OFFSET,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write volume header.",
+			 function );
+		}
+		return( result );
+	}
+	do
+	{
+		result = libfshfs_volume_get_allocation_block_run(
+		          image_handle->input_volume,
+		          block_number,
+		          &number_of_run_blocks,
+		          &is_allocated,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation block run: %" PRIu32 ".",
+			 function,
+			 block_number );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( is_allocated != 0 )
+		{
+			result = image_handle_copy_range(
+			          image_handle,
+			          (off64_t) block_number * allocation_block_size,
+			          (size64_t) number_of_run_blocks * allocation_block_size,
+			          error );
+
+			if( result != 1 )
+			{
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write allocation blocks: %" PRIu32 " - %" PRIu32 ".",
+					 function,
+					 block_number,
+					 block_number + number_of_run_blocks - 1 );
+				}
+				return( result );
+			}
+		}
+		block_number += number_of_run_blocks;
+	}
+	while( number_of_run_blocks > 0 );
+
+	/* The alternate volume header is written last which also sets the size of the output
+	 */
+	result = image_handle_copy_range(
+	          image_handle,
+	          (off64_t) ( image_handle->volume_size - IMAGE_HANDLE_ALTERNATE_VOLUME_HEADER_SIZE ),
+	          IMAGE_HANDLE_ALTERNATE_VOLUME_HEADER_SIZE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write alternate volume header.",
+		 function );
+	}
+	return( result );
+}
+
+/* Writes the metadata of the input volume to the output image
+ * The metadata extents are sorted by offset and written in a single sequential pass
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int image_handle_write_metadata(
+     image_handle_t *image_handle,
+     libcerror_error_t **error )
+{
+	static char *function  = "image_handle_write_metadata";
+	size64_t extent_size   = 0;
+	off64_t extent_offset  = 0;
+	int extent_index       = 0;
+	int number_of_extents  = 0;
+	int result             = 0;
+
+	if( image_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_volume_get_number_of_metadata_extents(
+	     image_handle->input_volume,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of metadata extents.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last metadata extent contains the alternate volume header which also sets the size of the output
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfshfs_volume_get_metadata_extent_by_index(
+		     image_handle->input_volume,
+		     extent_index,
+		     &extent_offset,
+		     &extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		result = image_handle_copy_range(
+		          image_handle,
+		          extent_offset,
+		          extent_size,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write metadata extent: %d.",
+				 function,
+				 extent_index );
+			}
+			return( result );
+		}
+	}
+	return( 1 );
+}
+
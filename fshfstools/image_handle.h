@@ -0,0 +1,132 @@
+/*
+ * Image handle
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _IMAGE_HANDLE_H )
+#define _IMAGE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "fshfstools_libbfio.h"
+#include "fshfstools_libcerror.h"
+#include "fshfstools_libfshfs.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct image_handle image_handle_t;
+
+struct image_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libfshfs input volume
+	 */
+	libfshfs_volume_t *input_volume;
+
+	/* The libbfio output file IO handle
+	 */
+	libbfio_handle_t *output_file_io_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The number of bytes written
+	 */
+	size64_t number_of_bytes_written;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int image_handle_initialize(
+     image_handle_t **image_handle,
+     libcerror_error_t **error );
+
+int image_handle_free(
+     image_handle_t **image_handle,
+     libcerror_error_t **error );
+
+int image_handle_signal_abort(
+     image_handle_t *image_handle,
+     libcerror_error_t **error );
+
+int image_handle_set_volume_offset(
+     image_handle_t *image_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int image_handle_open_input(
+     image_handle_t *image_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int image_handle_open_output(
+     image_handle_t *image_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int image_handle_close(
+     image_handle_t *image_handle,
+     libcerror_error_t **error );
+
+int image_handle_copy_range(
+     image_handle_t *image_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int image_handle_write_allocated_blocks(
+     image_handle_t *image_handle,
+     libcerror_error_t **error );
+
+int image_handle_write_metadata(
+     image_handle_t *image_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _IMAGE_HANDLE_H ) */
+
@@ -42,6 +42,10 @@ struct info_handle
 	 */
 	off64_t volume_offset;
 
+	/* Value to indicate if the journal should be replayed
+	 */
+	uint8_t replay_journal;
+
 	/* The libbfio input file IO handle
 	 */
 	libbfio_handle_t *input_file_io_handle;
@@ -59,12 +63,6 @@ struct info_handle
 	int abort;
 };
 
-int fshfstools_system_string_copy_from_64_bit_in_decimal(
-     const system_character_t *string,
-     size_t string_size,
-     uint64_t *value_64bit,
-     libcerror_error_t **error );
-
 int info_handle_initialize(
      info_handle_t **info_handle,
      libcerror_error_t **error );
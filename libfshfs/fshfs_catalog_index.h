@@ -0,0 +1,179 @@
+/*
+ * The catalog index file definition
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FSHFS_CATALOG_INDEX_H )
+#define _FSHFS_CATALOG_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The catalog index file is a sidecar file that is not stored in the volume
+ * All values are stored in little-endian and all tables have fixed size entries
+ * so that the file can be used in-place after it has been read
+ *
+ * The file consists of:
+ * the file header
+ * the entries table, sorted by identifier
+ * the parent entries table, sorted by parent identifier
+ * the names data
+ */
+
+typedef struct fshfs_catalog_index_file_header fshfs_catalog_index_file_header_t;
+
+struct fshfs_catalog_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "fshfscix"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The volume modification time
+	 * Consists of 4 bytes
+	 */
+	uint8_t volume_modification_time[ 4 ];
+
+	/* The volume write count
+	 * Consists of 4 bytes
+	 */
+	uint8_t volume_write_count[ 4 ];
+
+	/* The number of entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_entries[ 4 ];
+
+	/* The catalog file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t catalog_file_size[ 8 ];
+
+	/* The number of parent entries
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_parent_entries[ 4 ];
+
+	/* The names data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t names_data_size[ 4 ];
+
+	/* Unknown (reserved)
+	 * Consists of 8 bytes
+	 */
+	uint8_t unknown1[ 8 ];
+};
+
+typedef struct fshfs_catalog_index_entry fshfs_catalog_index_entry_t;
+
+struct fshfs_catalog_index_entry
+{
+	/* The identifier (CNID)
+	 * Consists of 4 bytes
+	 */
+	uint8_t identifier[ 4 ];
+
+	/* The parent identifier (CNID)
+	 * Consists of 4 bytes
+	 */
+	uint8_t parent_identifier[ 4 ];
+
+	/* The catalog B-tree leaf node number
+	 * Consists of 4 bytes
+	 */
+	uint8_t node_number[ 4 ];
+
+	/* The record index in the catalog B-tree leaf node
+	 * Consists of 2 bytes
+	 */
+	uint8_t record_index[ 2 ];
+
+	/* The record type
+	 * Consists of 2 bytes
+	 */
+	uint8_t record_type[ 2 ];
+
+	/* The name offset, relative to the start of the names data
+	 * Consists of 4 bytes
+	 */
+	uint8_t name_offset[ 4 ];
+
+	/* The name size
+	 * Consists of 2 bytes
+	 */
+	uint8_t name_size[ 2 ];
+
+	/* Unknown (reserved)
+	 * Consists of 2 bytes
+	 */
+	uint8_t unknown1[ 2 ];
+};
+
+typedef struct fshfs_catalog_index_parent_entry fshfs_catalog_index_parent_entry_t;
+
+struct fshfs_catalog_index_parent_entry
+{
+	/* The parent identifier (CNID)
+	 * Consists of 4 bytes
+	 */
+	uint8_t parent_identifier[ 4 ];
+
+	/* The catalog B-tree leaf node number of the first record with the parent identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t node_number[ 4 ];
+
+	/* The number of records with the parent identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_records[ 4 ];
+
+	/* The number of children, which are the directory and file records with the parent identifier
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_children[ 4 ];
+
+	/* The record index of the first record with the parent identifier
+	 * Consists of 2 bytes
+	 */
+	uint8_t record_index[ 2 ];
+
+	/* Unknown (reserved)
+	 * Consists of 2 bytes
+	 */
+	uint8_t unknown1[ 2 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FSHFS_CATALOG_INDEX_H ) */
+
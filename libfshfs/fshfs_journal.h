@@ -0,0 +1,163 @@
+/*
+ * The HFS journal definitions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FSHFS_JOURNAL_H )
+#define _FSHFS_JOURNAL_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct fshfs_journal_information_block fshfs_journal_information_block_t;
+
+struct fshfs_journal_information_block
+{
+	/* The flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t flags[ 4 ];
+
+	/* The device signature
+	 * Consists of 32 bytes
+	 */
+	uint8_t device_signature[ 32 ];
+
+	/* The journal offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t journal_offset[ 8 ];
+
+	/* The journal size
+	 * Consists of 8 bytes
+	 */
+	uint8_t journal_size[ 8 ];
+
+	/* Reserved
+	 * Consists of 128 bytes
+	 */
+	uint8_t reserved[ 128 ];
+};
+
+typedef struct fshfs_journal_header fshfs_journal_header_t;
+
+struct fshfs_journal_header
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * "JNLx"
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The endian signature
+	 * Consists of 4 bytes
+	 */
+	uint8_t endian_signature[ 4 ];
+
+	/* The start offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t start_offset[ 8 ];
+
+	/* The end offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t end_offset[ 8 ];
+
+	/* The journal size
+	 * Consists of 8 bytes
+	 */
+	uint8_t journal_size[ 8 ];
+
+	/* The block list header size
+	 * Consists of 4 bytes
+	 */
+	uint8_t block_list_header_size[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+
+	/* The journal header size
+	 * Consists of 4 bytes
+	 */
+	uint8_t journal_header_size[ 4 ];
+};
+
+typedef struct fshfs_journal_block_list_header fshfs_journal_block_list_header_t;
+
+struct fshfs_journal_block_list_header
+{
+	/* The maximum number of blocks
+	 * Consists of 2 bytes
+	 */
+	uint8_t maximum_number_of_blocks[ 2 ];
+
+	/* The number of blocks
+	 * Consists of 2 bytes
+	 */
+	uint8_t number_of_blocks[ 2 ];
+
+	/* The number of bytes used
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_bytes_used[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+};
+
+typedef struct fshfs_journal_block_information fshfs_journal_block_information_t;
+
+struct fshfs_journal_block_information
+{
+	/* The block number
+	 * Consists of 8 bytes
+	 */
+	uint8_t block_number[ 8 ];
+
+	/* The block size
+	 * Consists of 4 bytes
+	 */
+	uint8_t block_size[ 4 ];
+
+	/* The next block list header offset
+	 * Consists of 4 bytes
+	 */
+	uint8_t next[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FSHFS_JOURNAL_H ) */
+
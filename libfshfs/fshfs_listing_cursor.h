@@ -0,0 +1,85 @@
+/*
+ * The listing cursor data definition
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FSHFS_LISTING_CURSOR_H )
+#define _FSHFS_LISTING_CURSOR_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The listing cursor data is not stored in the volume, it is the serialized
+ * form of a listing cursor so that a paged listing can be resumed later
+ * All values are stored in little-endian
+ */
+
+typedef struct fshfs_listing_cursor fshfs_listing_cursor_t;
+
+struct fshfs_listing_cursor
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "fshfslcr"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The parent identifier (CNID) of the listed directory
+	 * Consists of 4 bytes
+	 */
+	uint8_t parent_identifier[ 4 ];
+
+	/* The catalog B-tree leaf node number of the last listed record
+	 * Consists of 4 bytes
+	 * Contains 0 if no records have been listed
+	 */
+	uint8_t node_number[ 4 ];
+
+	/* The record index of the last listed record in the catalog B-tree leaf node
+	 * Consists of 2 bytes
+	 */
+	uint8_t record_index[ 2 ];
+
+	/* The name size of the key of the last listed record
+	 * Consists of 2 bytes
+	 */
+	uint8_t name_size[ 2 ];
+
+	/* The name of the key of the last listed record
+	 * Consists of 512 bytes
+	 * Contains an UTF-16 big-endian string without end of string character
+	 */
+	uint8_t name[ 512 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FSHFS_LISTING_CURSOR_H ) */
+
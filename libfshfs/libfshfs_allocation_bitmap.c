@@ -0,0 +1,817 @@
+/*
+ * Allocation bitmap functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_allocation_bitmap.h"
+#include "libfshfs_allocation_block_stream.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+#include "libfshfs_libfdata.h"
+
+/* The size of the chunks in which the bitmap is read
+ * This value must be a multitude of 8
+ */
+#define LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE	( 1024 * 1024 )
+
+/* Creates an allocation bitmap
+ * Make sure the value allocation_bitmap is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_bitmap_initialize(
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libfshfs_io_handle_t *io_handle,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_allocation_bitmap_initialize";
+	size64_t bitmap_size  = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap_size = ( (size64_t) number_of_blocks + 7 ) / 8;
+
+	if( bitmap_size > fork_descriptor->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value exceeds allocation file size.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_bitmap = memory_allocate_structure(
+	                      libfshfs_allocation_bitmap_t );
+
+	if( *allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_bitmap,
+	     0,
+	     sizeof( libfshfs_allocation_bitmap_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation bitmap.",
+		 function );
+
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+
+		return( -1 );
+	}
+	( *allocation_bitmap )->chunk_data = (uint8_t *) memory_allocate(
+	                                                  sizeof( uint8_t ) * LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE );
+
+	if( ( *allocation_bitmap )->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_allocation_block_stream_initialize(
+	     &( ( *allocation_bitmap )->data_stream ),
+	     io_handle,
+	     fork_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation file data stream.",
+		 function );
+
+		goto on_error;
+	}
+	( *allocation_bitmap )->number_of_blocks  = number_of_blocks;
+	( *allocation_bitmap )->chunk_data_offset = -1;
+
+	return( 1 );
+
+on_error:
+	if( *allocation_bitmap != NULL )
+	{
+		if( ( *allocation_bitmap )->chunk_data != NULL )
+		{
+			memory_free(
+			 ( *allocation_bitmap )->chunk_data );
+		}
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_bitmap_free(
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_allocation_bitmap_free";
+	int result            = 1;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		if( libfdata_stream_free(
+		     &( ( *allocation_bitmap )->data_stream ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation file data stream.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *allocation_bitmap )->chunk_data );
+
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of bits set in a 64-bit value
+ * Returns the number of bits set
+ */
+uint32_t libfshfs_allocation_bitmap_get_population_count(
+          uint64_t value_64bit )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	return( (uint32_t) __builtin_popcountll(
+	                    value_64bit ) );
+#else
+	value_64bit = value_64bit - ( ( value_64bit >> 1 ) & 0x5555555555555555ULL );
+	value_64bit = ( value_64bit & 0x3333333333333333ULL ) + ( ( value_64bit >> 2 ) & 0x3333333333333333ULL );
+	value_64bit = ( value_64bit + ( value_64bit >> 4 ) ) & 0x0f0f0f0f0f0f0f0fULL;
+
+	return( (uint32_t) ( ( value_64bit * 0x0101010101010101ULL ) >> 56 ) );
+#endif
+}
+
+/* Retrieves the number of leading (most significant) zero bits in a 64-bit value
+ * Returns the number of leading zero bits, which is 64 if the value is 0
+ */
+uint8_t libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+         uint64_t value_64bit )
+{
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+	uint8_t number_of_bits = 0;
+#endif
+
+	if( value_64bit == 0 )
+	{
+		return( 64 );
+	}
+#if defined( __GNUC__ ) || defined( __clang__ )
+	return( (uint8_t) __builtin_clzll(
+	                   value_64bit ) );
+#else
+	while( ( value_64bit & 0x8000000000000000ULL ) == 0 )
+	{
+		value_64bit <<= 1;
+
+		number_of_bits++;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Retrieves the number of bits set in bitmap data
+ * The data is processed a 64-bit word at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_bitmap_get_number_of_set_bits(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *number_of_set_bits,
+     libcerror_error_t **error )
+{
+	static char *function     = "libfshfs_allocation_bitmap_get_number_of_set_bits";
+	size_t data_offset        = 0;
+	uint64_t number_of_bits   = 0;
+	uint64_t value_64bit      = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_set_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of set bits.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( data_offset + 8 ) <= data_size )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+
+		number_of_bits += libfshfs_allocation_bitmap_get_population_count(
+		                   value_64bit );
+
+		data_offset += 8;
+	}
+	while( data_offset < data_size )
+	{
+		number_of_bits += libfshfs_allocation_bitmap_get_population_count(
+		                   (uint64_t) data[ data_offset ] );
+
+		data_offset += 1;
+	}
+	if( number_of_bits > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of set bits value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_set_bits = (uint32_t) number_of_bits;
+
+	return( 1 );
+}
+
+/* Retrieves the run of equal bits in bitmap data that starts at a specific bit index
+ * The bits are stored most significant bit first and the data size must be a multitude of 8
+ * 64-bit words that consist entirely of the bit value of the run are skipped in one step
+ * Returns 1 if successful, 0 if the bit index is out of bounds or -1 on error
+ */
+int libfshfs_allocation_bitmap_get_run_in_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t bit_index,
+     uint32_t *number_of_bits,
+     uint8_t *bit_value,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfshfs_allocation_bitmap_get_run_in_data";
+	size_t data_offset      = 0;
+	uint64_t current_index  = 0;
+	uint64_t maximum_index  = 0;
+	uint64_t run_pattern    = 0;
+	uint64_t value_64bit    = 0;
+	uint8_t number_of_zeros = 0;
+	uint8_t word_bit_index  = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) ( (uint64_t) UINT32_MAX / 8 ) )
+	 || ( ( data_size % 8 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit value.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_index = (uint64_t) data_size * 8;
+
+	if( (uint64_t) bit_index >= maximum_index )
+	{
+		return( 0 );
+	}
+	*bit_value = ( data[ bit_index / 8 ] >> ( 7 - ( bit_index % 8 ) ) ) & 0x01;
+
+	if( *bit_value != 0 )
+	{
+		run_pattern = 0xffffffffffffffffULL;
+	}
+	current_index  = bit_index;
+	data_offset    = (size_t) ( current_index / 64 ) * 8;
+	word_bit_index = (uint8_t) ( current_index % 64 );
+
+	while( data_offset < data_size )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 &( data[ data_offset ] ),
+		 value_64bit );
+
+		/* Bits that differ from the run pattern are set, bits before
+		 * the start of the run are ignored
+		 */
+		value_64bit ^= run_pattern;
+		value_64bit <<= word_bit_index;
+
+		if( value_64bit != 0 )
+		{
+			number_of_zeros = libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+			                   value_64bit );
+
+			current_index += number_of_zeros;
+
+			break;
+		}
+		current_index += 64 - word_bit_index;
+		data_offset   += 8;
+		word_bit_index = 0;
+	}
+	*number_of_bits = (uint32_t) ( current_index - bit_index );
+
+	return( 1 );
+}
+
+/* Reads the chunk of the bitmap at a specific offset
+ * Bits of blocks beyond the number of blocks are cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_bitmap_read_chunk(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     off64_t chunk_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_allocation_bitmap_read_chunk";
+	size64_t bitmap_size  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	uint8_t last_bits     = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap_size = ( (size64_t) allocation_bitmap->number_of_blocks + 7 ) / 8;
+
+	if( ( chunk_data_offset < 0 )
+	 || ( (size64_t) chunk_data_offset >= bitmap_size )
+	 || ( ( chunk_data_offset % LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->chunk_data_offset == chunk_data_offset )
+	{
+		return( 1 );
+	}
+	read_size = LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE;
+
+	if( read_size > ( bitmap_size - chunk_data_offset ) )
+	{
+		read_size = (size_t) ( bitmap_size - chunk_data_offset );
+	}
+	allocation_bitmap->chunk_data_offset = -1;
+
+	if( libfdata_stream_seek_offset(
+	     allocation_bitmap->data_stream,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in allocation file data stream.",
+		 function,
+		 chunk_data_offset,
+		 chunk_data_offset );
+
+		return( -1 );
+	}
+	read_count = libfdata_stream_read_buffer(
+	              allocation_bitmap->data_stream,
+	              (intptr_t *) file_io_handle,
+	              allocation_bitmap->chunk_data,
+	              read_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") from allocation file data stream.",
+		 function,
+		 chunk_data_offset,
+		 chunk_data_offset );
+
+		return( -1 );
+	}
+	if( ( (size64_t) chunk_data_offset + read_size ) == bitmap_size )
+	{
+		last_bits = (uint8_t) ( allocation_bitmap->number_of_blocks % 8 );
+
+		if( last_bits != 0 )
+		{
+			allocation_bitmap->chunk_data[ read_size - 1 ] &= (uint8_t) ( 0xff << ( 8 - last_bits ) );
+		}
+	}
+	allocation_bitmap->chunk_data_size = read_size;
+
+	while( ( allocation_bitmap->chunk_data_size % 8 ) != 0 )
+	{
+		allocation_bitmap->chunk_data[ allocation_bitmap->chunk_data_size ] = 0;
+
+		allocation_bitmap->chunk_data_size += 1;
+	}
+	allocation_bitmap->chunk_data_offset = chunk_data_offset;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated blocks
+ * The bitmap is read in chunks on first access, after which the value is cached
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     uint32_t *number_of_allocated_blocks,
+     libcerror_error_t **error )
+{
+	static char *function           = "libfshfs_allocation_bitmap_get_number_of_allocated_blocks";
+	size64_t bitmap_size            = 0;
+	off64_t chunk_data_offset       = 0;
+	uint32_t number_of_set_bits     = 0;
+	uint64_t total_number_of_blocks = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_allocated_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocated blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->number_of_allocated_blocks_set == 0 )
+	{
+		bitmap_size = ( (size64_t) allocation_bitmap->number_of_blocks + 7 ) / 8;
+
+		while( (size64_t) chunk_data_offset < bitmap_size )
+		{
+			if( libfshfs_allocation_bitmap_read_chunk(
+			     allocation_bitmap,
+			     file_io_handle,
+			     chunk_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 chunk_data_offset,
+				 chunk_data_offset );
+
+				return( -1 );
+			}
+			if( libfshfs_allocation_bitmap_get_number_of_set_bits(
+			     allocation_bitmap->chunk_data,
+			     allocation_bitmap->chunk_data_size,
+			     &number_of_set_bits,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of set bits in chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 chunk_data_offset,
+				 chunk_data_offset );
+
+				return( -1 );
+			}
+			total_number_of_blocks += number_of_set_bits;
+			chunk_data_offset      += LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE;
+		}
+		allocation_bitmap->number_of_allocated_blocks     = (uint32_t) total_number_of_blocks;
+		allocation_bitmap->number_of_allocated_blocks_set = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: number of allocated blocks\t: %" PRIu32 " of %" PRIu32 "\n",
+			 function,
+			 allocation_bitmap->number_of_allocated_blocks,
+			 allocation_bitmap->number_of_blocks );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+	}
+	*number_of_allocated_blocks = allocation_bitmap->number_of_allocated_blocks;
+
+	return( 1 );
+}
+
+/* Retrieves the run of blocks with the same allocation status that starts at a specific block
+ * Returns 1 if successful, 0 if the block number is out of bounds or -1 on error
+ */
+int libfshfs_allocation_bitmap_get_block_run(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     uint32_t block_number,
+     uint32_t *number_of_blocks,
+     uint8_t *is_allocated,
+     libcerror_error_t **error )
+{
+	static char *function        = "libfshfs_allocation_bitmap_get_block_run";
+	off64_t chunk_data_offset    = 0;
+	uint64_t chunk_bit_offset    = 0;
+	uint64_t current_block       = 0;
+	uint32_t number_of_run_bits  = 0;
+	uint8_t bit_value            = 0;
+	uint8_t run_bit_value        = 0;
+	int result                   = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_allocated == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is allocated.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number >= allocation_bitmap->number_of_blocks )
+	{
+		return( 0 );
+	}
+	current_block = block_number;
+
+	while( current_block < allocation_bitmap->number_of_blocks )
+	{
+		chunk_data_offset = (off64_t) ( current_block / 8 );
+		chunk_data_offset = chunk_data_offset - ( chunk_data_offset % LIBFSHFS_ALLOCATION_BITMAP_CHUNK_SIZE );
+		chunk_bit_offset  = (uint64_t) chunk_data_offset * 8;
+
+		if( libfshfs_allocation_bitmap_read_chunk(
+		     allocation_bitmap,
+		     file_io_handle,
+		     chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 chunk_data_offset,
+			 chunk_data_offset );
+
+			return( -1 );
+		}
+		result = libfshfs_allocation_bitmap_get_run_in_data(
+		          allocation_bitmap->chunk_data,
+		          allocation_bitmap->chunk_data_size,
+		          (uint32_t) ( current_block - chunk_bit_offset ),
+		          &number_of_run_bits,
+		          &bit_value,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve run of block: %" PRIu64 " in chunk.",
+			 function,
+			 current_block );
+
+			return( -1 );
+		}
+		if( current_block == block_number )
+		{
+			run_bit_value = bit_value;
+		}
+		else if( bit_value != run_bit_value )
+		{
+			break;
+		}
+		current_block += number_of_run_bits;
+
+		/* The run ends inside the chunk
+		 */
+		if( current_block < ( chunk_bit_offset + ( (uint64_t) allocation_bitmap->chunk_data_size * 8 ) ) )
+		{
+			break;
+		}
+	}
+	if( current_block > allocation_bitmap->number_of_blocks )
+	{
+		current_block = allocation_bitmap->number_of_blocks;
+	}
+	*number_of_blocks = (uint32_t) ( current_block - block_number );
+	*is_allocated     = run_bit_value;
+
+	return( 1 );
+}
+
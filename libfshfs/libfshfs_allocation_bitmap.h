@@ -0,0 +1,128 @@
+/*
+ * Allocation bitmap functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_ALLOCATION_BITMAP_H )
+#define _LIBFSHFS_ALLOCATION_BITMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libfdata.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_allocation_bitmap libfshfs_allocation_bitmap_t;
+
+struct libfshfs_allocation_bitmap
+{
+	/* The allocation file data stream
+	 */
+	libfdata_stream_t *data_stream;
+
+	/* The number of (allocation) blocks
+	 */
+	uint32_t number_of_blocks;
+
+	/* The chunk data
+	 */
+	uint8_t *chunk_data;
+
+	/* The chunk data size, which is a multitude of 8
+	 */
+	size_t chunk_data_size;
+
+	/* The offset of the chunk data relative to the start of the bitmap
+	 * A value of -1 indicates the chunk data is not set
+	 */
+	off64_t chunk_data_offset;
+
+	/* Value to indicate the number of allocated blocks was determined
+	 */
+	uint8_t number_of_allocated_blocks_set;
+
+	/* The number of allocated blocks
+	 */
+	uint32_t number_of_allocated_blocks;
+};
+
+int libfshfs_allocation_bitmap_initialize(
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libfshfs_io_handle_t *io_handle,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_allocation_bitmap_free(
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+uint32_t libfshfs_allocation_bitmap_get_population_count(
+          uint64_t value_64bit );
+
+uint8_t libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+         uint64_t value_64bit );
+
+int libfshfs_allocation_bitmap_get_number_of_set_bits(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *number_of_set_bits,
+     libcerror_error_t **error );
+
+int libfshfs_allocation_bitmap_get_run_in_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t bit_index,
+     uint32_t *number_of_bits,
+     uint8_t *bit_value,
+     libcerror_error_t **error );
+
+int libfshfs_allocation_bitmap_read_chunk(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     off64_t chunk_data_offset,
+     libcerror_error_t **error );
+
+int libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     uint32_t *number_of_allocated_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_allocation_bitmap_get_block_run(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle,
+     uint32_t block_number,
+     uint32_t *number_of_blocks,
+     uint8_t *is_allocated,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_ALLOCATION_BITMAP_H ) */
+
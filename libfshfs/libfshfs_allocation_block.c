@@ -24,6 +24,7 @@
 #include <types.h>
 
 #include "libfshfs_allocation_block.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_libbfio.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcnotify.h"
@@ -33,10 +34,12 @@
 
 /* Creates an allocation block
  * Make sure the value allocation_block is referencing, is set to NULL
+ * The data is retrieved from the buffer pool, which can be NULL, and is released to it when the allocation block is freed
  * Returns 1 if successful or -1 on error
  */
 int libfshfs_allocation_block_initialize(
      libfshfs_allocation_block_t **allocation_block,
+     libfshfs_buffer_pool_t *buffer_pool,
      size_t data_size,
      libcerror_error_t **error )
 {
@@ -110,21 +113,23 @@ int libfshfs_allocation_block_initialize(
 	}
 	if( data_size > 0 )
 	{
-		( *allocation_block )->data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * data_size );
-
-		if( ( *allocation_block )->data == NULL )
+		if( libfshfs_buffer_pool_get_buffer(
+		     buffer_pool,
+		     data_size,
+		     &( ( *allocation_block )->data ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 			 "%s: unable to create data.",
 			 function );
 
 			goto on_error;
 		}
-		( *allocation_block )->data_size = data_size;
+		( *allocation_block )->data_size   = data_size;
+		( *allocation_block )->buffer_pool = buffer_pool;
 	}
 	return( 1 );
 
@@ -147,6 +152,7 @@ int libfshfs_allocation_block_free(
      libcerror_error_t **error )
 {
 	static char *function = "libfshfs_allocation_block_free";
+	int result            = 1;
 
 	if( allocation_block == NULL )
 	{
@@ -161,17 +167,26 @@ int libfshfs_allocation_block_free(
 	}
 	if( *allocation_block != NULL )
 	{
-		if( ( *allocation_block )->data != NULL )
+		if( libfshfs_buffer_pool_release_buffer(
+		     ( *allocation_block )->buffer_pool,
+		     &( ( *allocation_block )->data ),
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *allocation_block )->data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release data.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *allocation_block );
 
 		*allocation_block = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Reads an allocation block
@@ -224,6 +239,7 @@ int libfshfs_allocation_block_read_element_data(
 	}
 	if( libfshfs_allocation_block_initialize(
 	     &allocation_block,
+	     io_handle->buffer_pool,
 	     (size_t) allocation_block_size,
 	     error ) != 1 )
 	{
@@ -287,24 +303,10 @@ int libfshfs_allocation_block_read_element_data(
 			 allocation_block_size );
 		}
 #endif
-		if( libbfio_handle_seek_offset(
-		     file_io_handle,
-		     allocation_block_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset: 0x%08" PRIx64 ".",
-			 function,
-			 allocation_block_offset );
-
-			goto on_error;
-		}
-		read_count = libbfio_handle_read_buffer(
+		read_count = libfshfs_io_handle_read_buffer_at_offset(
+		              io_handle,
 		              file_io_handle,
+		              allocation_block_offset,
 		              allocation_block->data,
 		              allocation_block->data_size,
 		              error );
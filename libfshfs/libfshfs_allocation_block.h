@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_io_handle.h"
 #include "libfshfs_libbfio.h"
 #include "libfshfs_libcerror.h"
@@ -45,10 +46,15 @@ struct libfshfs_allocation_block
 	/* The data size
 	 */
 	size_t data_size;
+
+	/* The buffer pool the data was retrieved from
+	 */
+	libfshfs_buffer_pool_t *buffer_pool;
 };
 
 int libfshfs_allocation_block_initialize(
      libfshfs_allocation_block_t **allocation_block,
+     libfshfs_buffer_pool_t *buffer_pool,
      size_t data_size,
      libcerror_error_t **error );
 
@@ -1,5 +1,5 @@
 /*
- * Cluster block stream functions
+ * Allocation block stream functions
  *
  * Copyright (C) 2010-2020, Joachim Metz <joachim.metz@gmail.com>
  *
@@ -25,6 +25,7 @@
 
 #include "libfshfs_allocation_block.h"
 #include "libfshfs_allocation_block_stream.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_definitions.h"
 #include "libfshfs_fork_descriptor.h"
 #include "libfshfs_io_handle.h"
@@ -32,7 +33,6 @@
 #include "libfshfs_libcdata.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcnotify.h"
-#include "libfshfs_libfcache.h"
 #include "libfshfs_libfdata.h"
 #include "libfshfs_unused.h"
 
@@ -114,8 +114,9 @@ int libfshfs_allocation_block_stream_data_handle_initialize(
 
 		return( -1 );
 	}
-	( *data_handle )->io_handle = io_handle;
-	( *data_handle )->data_size = data_size;
+	( *data_handle )->io_handle                = io_handle;
+	( *data_handle )->data_size                = data_size;
+	( *data_handle )->previous_read_end_offset = -1;
 
 	return( 1 );
 
@@ -138,6 +139,7 @@ int libfshfs_allocation_block_stream_data_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libfshfs_allocation_block_stream_data_handle_free";
+	int result            = 1;
 
 	if( data_handle == NULL )
 	{
@@ -154,12 +156,34 @@ int libfshfs_allocation_block_stream_data_handle_free(
 	{
 		/* IO handle is freed elsewhere
 		 */
+		if( ( *data_handle )->readahead_buffer != NULL )
+		{
+			if( libfshfs_buffer_pool_release_buffer(
+			     ( *data_handle )->io_handle->buffer_pool,
+			     &( ( *data_handle )->readahead_buffer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release readahead buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *data_handle )->segment_end_offsets != NULL )
+		{
+			memory_free(
+			 ( *data_handle )->segment_end_offsets );
+		}
 		memory_free(
 		 *data_handle );
 
 		*data_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones (duplicates) the data handle
@@ -226,21 +250,42 @@ int libfshfs_allocation_block_stream_data_handle_clone(
 
 		return( -1 );
 	}
-/* TODO clone vectors and array */
-	if( libfcache_cache_clone(
-	     &( ( *destination_data_handle )->cache ),
-	     source_data_handle->cache,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination cache.",
-		 function );
-
-		goto on_error;
-	}
+	if( source_data_handle->segment_end_offsets != NULL )
+	{
+		( *destination_data_handle )->segment_end_offsets = (off64_t *) memory_allocate(
+		                                                     sizeof( off64_t ) * source_data_handle->number_of_segments );
+
+		if( ( *destination_data_handle )->segment_end_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment end offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_data_handle )->segment_end_offsets,
+		     source_data_handle->segment_end_offsets,
+		     sizeof( off64_t ) * source_data_handle->number_of_segments ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment end offsets.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_data_handle )->number_of_segments = source_data_handle->number_of_segments;
+	}
+
+	/* The cached data is shared through the block cache of the IO handle
+	 * so only the cursor is cloned, the readahead state starts empty
+	 */
 	return( 1 );
 
 on_error:
@@ -253,7 +298,93 @@ on_error:
 	return( -1 );
 }
 
+/* Resizes the readahead buffer to contain at least size bytes
+ * The readahead buffer is retrieved from the buffer pool, so that it is aligned for direct I/O,
+ * and its data is not retained when resized
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_allocation_block_stream_data_handle_resize_readahead_buffer(
+     libfshfs_allocation_block_stream_data_handle_t *data_handle,
+     size_t size,
+     libcerror_error_t **error )
+{
+	uint8_t *readahead_buffer = NULL;
+	static char *function     = "libfshfs_allocation_block_stream_data_handle_resize_readahead_buffer";
+
+	if( data_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > data_handle->readahead_buffer_size )
+	{
+		if( libfshfs_buffer_pool_get_buffer(
+		     data_handle->io_handle->buffer_pool,
+		     size,
+		     &readahead_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve readahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( data_handle->readahead_buffer != NULL )
+		{
+			if( libfshfs_buffer_pool_release_buffer(
+			     data_handle->io_handle->buffer_pool,
+			     &( data_handle->readahead_buffer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release readahead buffer.",
+				 function );
+
+				libfshfs_buffer_pool_release_buffer(
+				 data_handle->io_handle->buffer_pool,
+				 &readahead_buffer,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		data_handle->readahead_buffer      = readahead_buffer;
+		data_handle->readahead_buffer_size = size;
+		data_handle->readahead_data_size   = 0;
+	}
+	return( 1 );
+}
+
 /* Reads data from the current offset into a buffer
+ * Sequential reads are served from a readahead buffer, of which the window grows while the reads
+ * remain sequential and is clamped to the end of the segment. Other reads that are smaller than
+ * an allocation block are served from the file data partition of the block cache, the remaining
+ * reads are read directly
  * Callback for the allocation block stream
  * Returns the number of bytes read or -1 on error
  */
@@ -268,11 +399,16 @@ ssize_t libfshfs_allocation_block_stream_data_handle_read_segment_data(
          uint8_t read_flags,
          libcerror_error_t **error )
 {
-	libfshfs_allocation_block_t *allocation_block = NULL;
-	static char *function                         = "libfshfs_allocation_block_stream_data_handle_read_segment_data";
-	off64_t segment_offset                        = 0;
-	size64_t segment_size                         = 0;
-	ssize_t read_count                            = 0;
+	static char *function           = "libfshfs_allocation_block_stream_data_handle_read_segment_data";
+	size_t allocation_block_size    = 0;
+	size_t readahead_data_offset    = 0;
+	size_t read_size                = 0;
+	size_t remaining_data_size      = 0;
+	size_t segment_data_offset      = 0;
+	ssize_t read_count              = 0;
+	off64_t allocation_block_offset = 0;
+	off64_t segment_end_offset      = 0;
+	uint8_t is_sequential           = 0;
 
 	if( data_handle == NULL )
 	{
@@ -296,6 +432,18 @@ ssize_t libfshfs_allocation_block_stream_data_handle_read_segment_data(
 
 		return( -1 );
 	}
+	if( ( segment_index < 0 )
+	 || ( segment_index >= data_handle->number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( segment_data == NULL )
 	{
 		libcerror_error_set(
@@ -322,42 +470,195 @@ ssize_t libfshfs_allocation_block_stream_data_handle_read_segment_data(
 	{
 		return( 0 );
 	}
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     data_handle->current_segment_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek segment offset: 0x%08" PRIx64 ".",
-		 function,
-		 data_handle->current_segment_offset );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              segment_data,
-	              segment_data_size,
-	              error );
-
-	if( read_count != (ssize_t) segment_data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment data.",
-		 function );
-
-		return( -1 );
-	}
-	data_handle->current_segment_offset += read_count;
-
-	return( read_count );
+	segment_end_offset    = data_handle->segment_end_offsets[ segment_index ];
+	allocation_block_size = (size_t) data_handle->io_handle->allocation_block_size;
+
+	if( data_handle->current_segment_offset == data_handle->previous_read_end_offset )
+	{
+		is_sequential = 1;
+	}
+	while( segment_data_offset < segment_data_size )
+	{
+		remaining_data_size = segment_data_size - segment_data_offset;
+
+		if( ( data_handle->readahead_data_size > 0 )
+		 && ( data_handle->current_segment_offset >= data_handle->readahead_offset )
+		 && ( data_handle->current_segment_offset < ( data_handle->readahead_offset + (off64_t) data_handle->readahead_data_size ) ) )
+		{
+			readahead_data_offset = (size_t) ( data_handle->current_segment_offset - data_handle->readahead_offset );
+
+			read_size = data_handle->readahead_data_size - readahead_data_offset;
+
+			if( read_size > remaining_data_size )
+			{
+				read_size = remaining_data_size;
+			}
+			if( memory_copy(
+			     &( segment_data[ segment_data_offset ] ),
+			     &( data_handle->readahead_buffer[ readahead_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy readahead data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			/* The readahead window grows while the reads are sequential and collapses otherwise
+			 */
+			if( is_sequential == 0 )
+			{
+				data_handle->readahead_window_size = 0;
+			}
+			else if( data_handle->readahead_window_size == 0 )
+			{
+				data_handle->readahead_window_size = LIBFSHFS_READAHEAD_INITIAL_WINDOW_SIZE;
+			}
+			else if( data_handle->readahead_window_size < LIBFSHFS_READAHEAD_MAXIMUM_WINDOW_SIZE )
+			{
+				data_handle->readahead_window_size *= 2;
+			}
+			if( ( data_handle->readahead_window_size == 0 )
+			 && ( data_handle->io_handle->block_cache != NULL )
+			 && ( allocation_block_size > 0 )
+			 && ( remaining_data_size < allocation_block_size ) )
+			{
+				allocation_block_offset = data_handle->current_segment_offset
+				                        - ( data_handle->current_segment_offset % allocation_block_size );
+
+				if( ( allocation_block_offset + (off64_t) allocation_block_size ) <= segment_end_offset )
+				{
+					if( libfshfs_allocation_block_stream_data_handle_resize_readahead_buffer(
+					     data_handle,
+					     allocation_block_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+						 "%s: unable to resize readahead buffer.",
+						 function );
+
+						return( -1 );
+					}
+					data_handle->readahead_data_size = 0;
+
+					read_count = libfshfs_io_handle_read_block_at_offset(
+					              data_handle->io_handle,
+					              file_io_handle,
+					              LIBFSHFS_BLOCK_CACHE_PARTITION_FILE_DATA,
+					              allocation_block_offset,
+					              data_handle->readahead_buffer,
+					              allocation_block_size,
+					              error );
+
+					if( read_count != (ssize_t) allocation_block_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read allocation block.",
+						 function );
+
+						return( -1 );
+					}
+					data_handle->readahead_offset    = allocation_block_offset;
+					data_handle->readahead_data_size = allocation_block_size;
+
+					/* The data is copied from the readahead buffer in the next iteration
+					 */
+					continue;
+				}
+			}
+			read_size = data_handle->readahead_window_size;
+
+			if( (off64_t) read_size > ( segment_end_offset - data_handle->current_segment_offset ) )
+			{
+				read_size = (size_t) ( segment_end_offset - data_handle->current_segment_offset );
+			}
+			if( read_size <= remaining_data_size )
+			{
+				read_size = remaining_data_size;
+
+				read_count = libfshfs_io_handle_read_data_at_offset(
+				              data_handle->io_handle,
+				              file_io_handle,
+				              data_handle->current_segment_offset,
+				              &( segment_data[ segment_data_offset ] ),
+				              read_size,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read segment data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			else
+			{
+				if( libfshfs_allocation_block_stream_data_handle_resize_readahead_buffer(
+				     data_handle,
+				     data_handle->readahead_window_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+					 "%s: unable to resize readahead buffer.",
+					 function );
+
+					return( -1 );
+				}
+				data_handle->readahead_data_size = 0;
+
+				read_count = libfshfs_io_handle_read_data_at_offset(
+				              data_handle->io_handle,
+				              file_io_handle,
+				              data_handle->current_segment_offset,
+				              data_handle->readahead_buffer,
+				              read_size,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read readahead data.",
+					 function );
+
+					return( -1 );
+				}
+				data_handle->readahead_offset    = data_handle->current_segment_offset;
+				data_handle->readahead_data_size = read_size;
+
+				/* The data is copied from the readahead buffer in the next iteration
+				 */
+				continue;
+			}
+		}
+		segment_data_offset                 += read_size;
+		data_handle->current_segment_offset += read_size;
+	}
+	data_handle->previous_read_end_offset = data_handle->current_segment_offset;
+
+	return( (ssize_t) segment_data_size );
 }
 
 /* Seeks a certain offset of the data
@@ -417,6 +718,14 @@ int libfshfs_allocation_block_stream_initialize(
 {
 	libfshfs_allocation_block_stream_data_handle_t *data_handle = NULL;
 	static char *function                                       = "libfshfs_allocation_block_stream_initialize";
+	size64_t extent_size                                        = 0;
+	size64_t segments_size                                      = 0;
+	off64_t extent_offset                                       = 0;
+	uint32_t number_of_blocks                                   = 0;
+	uint32_t start_block_number                                 = 0;
+	int extent_index                                            = 0;
+	int number_of_extents                                       = 0;
+	int segment_index                                           = 0;
 
 	if( allocation_block_stream == NULL )
 	{
@@ -440,10 +749,32 @@ int libfshfs_allocation_block_stream_initialize(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->allocation_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - allocation block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfshfs_allocation_block_stream_data_handle_initialize(
 	     &data_handle,
 	     io_handle,
-	     0,
+	     fork_descriptor->size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -466,6 +797,75 @@ int libfshfs_allocation_block_stream_initialize(
 
 		goto on_error;
 	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents > 0 )
+	{
+		if( (size_t) number_of_extents > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of extents value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		data_handle->segment_end_offsets = (off64_t *) memory_allocate(
+		                                    sizeof( off64_t ) * number_of_extents );
+
+		if( data_handle->segment_end_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment end offsets.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		extent_offset = (off64_t) start_block_number * io_handle->allocation_block_size;
+		extent_size   = (size64_t) number_of_blocks * io_handle->allocation_block_size;
+		data_handle->segment_end_offsets[ extent_index ] = extent_offset + (off64_t) extent_size;
+	}
+	data_handle->number_of_segments = number_of_extents;
+
 	if( libfdata_stream_initialize(
 	     allocation_block_stream,
 	     (intptr_t *) data_handle,
@@ -487,7 +887,103 @@ int libfshfs_allocation_block_stream_initialize(
 
 		goto on_error;
 	}
-/* TODO implement */
+	/* The data handle is now managed by the stream
+	 */
+	data_handle = NULL;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		extent_offset = (off64_t) start_block_number * io_handle->allocation_block_size;
+		extent_size   = (size64_t) number_of_blocks * io_handle->allocation_block_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: extent: %d offset\t\t\t: 0x%08" PRIx64 "\n",
+			 function,
+			 extent_index,
+			 extent_offset );
+
+			libcnotify_printf(
+			 "%s: extent: %d size\t\t\t: %" PRIu64 "\n",
+			 function,
+			 extent_index,
+			 extent_size );
+		}
+#endif
+		if( libfdata_stream_append_segment(
+		     *allocation_block_stream,
+		     &segment_index,
+		     0,
+		     extent_offset,
+		     extent_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d as stream segment.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		segments_size += extent_size;
+	}
+	if( fork_descriptor->size > segments_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fork descriptor - size: %" PRIu64 " exceeds size of extents: %" PRIu64 ".",
+		 function,
+		 fork_descriptor->size,
+		 segments_size );
+
+		goto on_error;
+	}
+	/* The last allocation block can contain data beyond the end of the fork
+	 */
+	if( fork_descriptor->size < segments_size )
+	{
+		if( libfdata_stream_set_mapped_size(
+		     *allocation_block_stream,
+		     fork_descriptor->size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set mapped size of stream.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
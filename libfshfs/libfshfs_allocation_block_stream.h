@@ -29,7 +29,6 @@
 #include "libfshfs_io_handle.h"
 #include "libfshfs_libbfio.h"
 #include "libfshfs_libcerror.h"
-#include "libfshfs_libfcache.h"
 #include "libfshfs_libfdata.h"
 
 #if defined( __cplusplus )
@@ -52,9 +51,37 @@ struct libfshfs_allocation_block_stream_data_handle
 	 */
 	size64_t data_size;
 
-	/* The cache
+	/* The segment end offsets, which are used to clamp the readahead to the extent boundaries
 	 */
-	libfcache_cache_t *cache;
+	off64_t *segment_end_offsets;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The end offset of the previous read, which is used to detect sequential reads
+	 */
+	off64_t previous_read_end_offset;
+
+	/* The readahead window size, where 0 represents no readahead
+	 */
+	size_t readahead_window_size;
+
+	/* The readahead buffer
+	 */
+	uint8_t *readahead_buffer;
+
+	/* The readahead buffer size
+	 */
+	size_t readahead_buffer_size;
+
+	/* The offset of the data in the readahead buffer
+	 */
+	off64_t readahead_offset;
+
+	/* The size of the data in the readahead buffer
+	 */
+	size_t readahead_data_size;
 };
 
 int libfshfs_allocation_block_stream_data_handle_initialize(
@@ -72,6 +99,11 @@ int libfshfs_allocation_block_stream_data_handle_clone(
      libfshfs_allocation_block_stream_data_handle_t *source_data_handle,
      libcerror_error_t **error );
 
+int libfshfs_allocation_block_stream_data_handle_resize_readahead_buffer(
+     libfshfs_allocation_block_stream_data_handle_t *data_handle,
+     size_t size,
+     libcerror_error_t **error );
+
 ssize_t libfshfs_allocation_block_stream_data_handle_read_segment_data(
          libfshfs_allocation_block_stream_data_handle_t *data_handle,
          libbfio_handle_t *file_io_handle,
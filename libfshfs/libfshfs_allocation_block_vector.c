@@ -42,11 +42,14 @@ int libfshfs_allocation_block_vector_initialize(
      libfshfs_fork_descriptor_t *fork_descriptor,
      libcerror_error_t **error )
 {
-	static char *function  = "libfshfs_allocation_block_vector_initialize";
-	off64_t segment_offset = 0;
-	size64_t segment_size  = 0;
-	int extent_index       = 0;
-	int segment_index      = 0;
+	static char *function       = "libfshfs_allocation_block_vector_initialize";
+	off64_t segment_offset      = 0;
+	size64_t segment_size       = 0;
+	uint32_t number_of_blocks   = 0;
+	uint32_t start_block_number = 0;
+	int extent_index            = 0;
+	int number_of_extents       = 0;
+	int segment_index           = 0;
 
 	if( allocation_block_vector == NULL )
 	{
@@ -101,12 +104,43 @@ int libfshfs_allocation_block_vector_initialize(
 
 		goto on_error;
 	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
 	for( extent_index = 0;
-	     extent_index < 8;
+	     extent_index < number_of_extents;
 	     extent_index++ )
 	{
-		segment_offset = fork_descriptor->extents[ extent_index ][ 0 ] * io_handle->allocation_block_size;
-		segment_size   = fork_descriptor->extents[ extent_index ][ 1 ] * io_handle->allocation_block_size;
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		segment_offset = (off64_t) start_block_number * io_handle->allocation_block_size;
+		segment_size   = (size64_t) number_of_blocks * io_handle->allocation_block_size;
 
 		if( libfdata_vector_append_segment(
 		     *allocation_block_vector,
@@ -128,7 +162,6 @@ int libfshfs_allocation_block_vector_initialize(
 			goto on_error;
 		}
 	}
-/* TODO add extended extents support */
 	return( 1 );
 
 on_error:
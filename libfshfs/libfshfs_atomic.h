@@ -0,0 +1,101 @@
+/*
+ * Atomic operations
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_ATOMIC_H )
+#define _LIBFSHFS_ATOMIC_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The atomic operations are used for values that are shared between threads
+ * without holding a lock, such as reference counts and values that are
+ * published once after they have been read
+ * Without multi-thread support they are plain operations
+ */
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT ) && defined( WINAPI )
+
+#define libfshfs_atomic_increment_uint32( value ) \
+	(uint32_t) InterlockedIncrement( (LONG volatile *) ( value ) )
+
+#define libfshfs_atomic_decrement_uint32( value ) \
+	(uint32_t) InterlockedDecrement( (LONG volatile *) ( value ) )
+
+#define libfshfs_atomic_get_pointer( pointer ) \
+	InterlockedCompareExchangePointer( (PVOID volatile *) ( pointer ), NULL, NULL )
+
+#define libfshfs_atomic_set_pointer( pointer, value ) \
+	InterlockedExchangePointer( (PVOID volatile *) ( pointer ), (PVOID) ( value ) )
+
+#define libfshfs_atomic_compare_and_swap_pointer( pointer, expected_value, new_value ) \
+	( InterlockedCompareExchangePointer( (PVOID volatile *) ( pointer ), (PVOID) ( new_value ), (PVOID) ( expected_value ) ) == (PVOID) ( expected_value ) )
+
+#elif defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ )
+
+#define libfshfs_atomic_increment_uint32( value ) \
+	__atomic_add_fetch( ( value ), 1, __ATOMIC_ACQ_REL )
+
+#define libfshfs_atomic_decrement_uint32( value ) \
+	__atomic_sub_fetch( ( value ), 1, __ATOMIC_ACQ_REL )
+
+#define libfshfs_atomic_get_pointer( pointer ) \
+	__atomic_load_n( ( pointer ), __ATOMIC_ACQUIRE )
+
+#define libfshfs_atomic_set_pointer( pointer, value ) \
+	__atomic_store_n( ( pointer ), ( value ), __ATOMIC_RELEASE )
+
+#define libfshfs_atomic_compare_and_swap_pointer( pointer, expected_value, new_value ) \
+	__sync_bool_compare_and_swap( ( pointer ), ( expected_value ), ( new_value ) )
+
+#elif defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+
+#error Missing atomic operations for multi-thread support
+
+#else
+
+#define libfshfs_atomic_increment_uint32( value ) \
+	( ++( *( value ) ) )
+
+#define libfshfs_atomic_decrement_uint32( value ) \
+	( --( *( value ) ) )
+
+#define libfshfs_atomic_get_pointer( pointer ) \
+	( *( pointer ) )
+
+#define libfshfs_atomic_set_pointer( pointer, value ) \
+	( *( pointer ) = ( value ) )
+
+#define libfshfs_atomic_compare_and_swap_pointer( pointer, expected_value, new_value ) \
+	( ( *( pointer ) == ( expected_value ) ) ? ( ( *( pointer ) = ( new_value ) ), 1 ) : 0 )
+
+#endif
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_ATOMIC_H ) */
+
@@ -0,0 +1,642 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_block_cache.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+/* The hash of a block offset, based on Fibonacci hashing
+ * The upper bits of the product are used since block offsets are typically aligned
+ */
+#define libfshfs_block_cache_get_hash( offset ) \
+	( (uint32_t) ( ( ( (uint64_t) ( offset ) >> 9 ) * 0x9e3779b97f4a7c15ULL ) >> 32 ) )
+
+/* Creates a block cache
+ * Make sure the value block_cache is referencing, is set to NULL
+ * The maximum number of blocks should contain a value for every partition,
+ * where 0 disables caching for the partition, and is rounded up to a multiple of the number of ways
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_cache_initialize(
+     libfshfs_block_cache_t **block_cache,
+     const int *maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_block_cache_initialize";
+	size_t entries_size   = 0;
+	int entry_index       = 0;
+	int number_of_entries = 0;
+	int number_of_sets    = 0;
+	int partition         = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	for( partition = 0;
+	     partition < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS;
+	     partition++ )
+	{
+		if( ( maximum_number_of_blocks[ partition ] < 0 )
+		 || ( maximum_number_of_blocks[ partition ] > LIBFSHFS_BLOCK_CACHE_MAXIMUM_NUMBER_OF_BLOCKS ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid maximum number of blocks of partition: %d value out of bounds.",
+			 function,
+			 partition );
+
+			return( -1 );
+		}
+	}
+	*block_cache = memory_allocate_structure(
+	                libfshfs_block_cache_t );
+
+	if( *block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_cache,
+	     0,
+	     sizeof( libfshfs_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block cache.",
+		 function );
+
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+
+		return( -1 );
+	}
+	for( partition = 0;
+	     partition < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS;
+	     partition++ )
+	{
+		if( maximum_number_of_blocks[ partition ] == 0 )
+		{
+			continue;
+		}
+		number_of_sets    = ( maximum_number_of_blocks[ partition ] + LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS - 1 ) / LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+		number_of_entries = number_of_sets * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+		entries_size      = sizeof( libfshfs_block_cache_entry_t ) * number_of_entries;
+
+		( *block_cache )->entries[ partition ] = (libfshfs_block_cache_entry_t *) memory_allocate(
+		                                                                           entries_size );
+
+		if( ( *block_cache )->entries[ partition ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries of partition: %d.",
+			 function,
+			 partition );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *block_cache )->entries[ partition ],
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries of partition: %d.",
+			 function,
+			 partition );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			( *block_cache )->entries[ partition ][ entry_index ].offset = -1;
+		}
+		( *block_cache )->replacement_indexes[ partition ] = (uint8_t *) memory_allocate(
+		                                                                  sizeof( uint8_t ) * number_of_sets );
+
+		if( ( *block_cache )->replacement_indexes[ partition ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create replacement indexes of partition: %d.",
+			 function,
+			 partition );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *block_cache )->replacement_indexes[ partition ],
+		     0,
+		     sizeof( uint8_t ) * number_of_sets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear replacement indexes of partition: %d.",
+			 function,
+			 partition );
+
+			goto on_error;
+		}
+		( *block_cache )->number_of_sets[ partition ] = number_of_sets;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *block_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *block_cache != NULL )
+	{
+		libfshfs_block_cache_free(
+		 block_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_cache_free(
+     libfshfs_block_cache_t **block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_block_cache_free";
+	int entry_index       = 0;
+	int number_of_entries = 0;
+	int partition         = 0;
+	int result            = 1;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_cache != NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( ( *block_cache )->read_write_lock != NULL )
+		{
+			if( libcthreads_read_write_lock_free(
+			     &( ( *block_cache )->read_write_lock ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read/write lock.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		for( partition = 0;
+		     partition < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS;
+		     partition++ )
+		{
+			if( ( *block_cache )->replacement_indexes[ partition ] != NULL )
+			{
+				memory_free(
+				 ( *block_cache )->replacement_indexes[ partition ] );
+			}
+			if( ( *block_cache )->entries[ partition ] == NULL )
+			{
+				continue;
+			}
+			number_of_entries = ( *block_cache )->number_of_sets[ partition ] * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+
+			for( entry_index = 0;
+			     entry_index < number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *block_cache )->entries[ partition ][ entry_index ].data != NULL )
+				{
+					memory_free(
+					 ( *block_cache )->entries[ partition ][ entry_index ].data );
+				}
+			}
+			memory_free(
+			 ( *block_cache )->entries[ partition ] );
+		}
+		memory_free(
+		 *block_cache );
+
+		*block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the data of a specific block
+ * The block is only available if it was cached with the same offset and size
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_block_cache_get_block(
+     libfshfs_block_cache_t *block_cache,
+     int partition,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfshfs_block_cache_entry_t *entry = NULL;
+	static char *function               = "libfshfs_block_cache_get_block";
+	int entry_index                     = 0;
+	int result                          = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( partition < 0 )
+	 || ( partition >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) LIBFSHFS_BLOCK_CACHE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		return( 0 );
+	}
+	if( block_cache->number_of_sets[ partition ] == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = &( block_cache->entries[ partition ][ ( libfshfs_block_cache_get_hash( offset ) % block_cache->number_of_sets[ partition ] ) * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( ( entry[ entry_index ].offset == offset )
+		 && ( entry[ entry_index ].data_size == size ) )
+		{
+			if( memory_copy(
+			     buffer,
+			     entry[ entry_index ].data,
+			     size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block data.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				result = 1;
+			}
+			break;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the data of a specific block
+ * The block replaces a block with the same offset, an unused entry or the oldest block of its set
+ * Returns 1 if successful, 0 if the block is not cached or -1 on error
+ */
+int libfshfs_block_cache_set_block(
+     libfshfs_block_cache_t *block_cache,
+     int partition,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libfshfs_block_cache_entry_t *entry = NULL;
+	uint8_t *entry_data                 = NULL;
+	static char *function               = "libfshfs_block_cache_set_block";
+	int entry_index                     = 0;
+	int set_index                       = 0;
+
+	if( block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( partition < 0 )
+	 || ( partition >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) LIBFSHFS_BLOCK_CACHE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		return( 0 );
+	}
+	if( block_cache->number_of_sets[ partition ] == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	set_index = (int) ( libfshfs_block_cache_get_hash( offset ) % block_cache->number_of_sets[ partition ] );
+	entry     = &( block_cache->entries[ partition ][ set_index * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS ] );
+
+	for( entry_index = 0;
+	     entry_index < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+	     entry_index++ )
+	{
+		if( entry[ entry_index ].offset == offset )
+		{
+			break;
+		}
+	}
+	if( entry_index >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS )
+	{
+		for( entry_index = 0;
+		     entry_index < LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS;
+		     entry_index++ )
+		{
+			if( entry[ entry_index ].offset == -1 )
+			{
+				break;
+			}
+		}
+	}
+	if( entry_index >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS )
+	{
+		entry_index = (int) block_cache->replacement_indexes[ partition ][ set_index ];
+
+		block_cache->replacement_indexes[ partition ][ set_index ] = (uint8_t) ( ( entry_index + 1 ) % LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS );
+	}
+	entry = &( entry[ entry_index ] );
+
+	if( entry->data_size != data_size )
+	{
+		entry_data = (uint8_t *) memory_reallocate(
+		                          entry->data,
+		                          data_size );
+
+		if( entry_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entry data.",
+			 function );
+
+			goto on_error;
+		}
+		entry->data      = entry_data;
+		entry->data_size = data_size;
+	}
+	if( memory_copy(
+	     entry->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block data.",
+		 function );
+
+		goto on_error;
+	}
+	entry->offset = offset;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     block_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	entry->offset = -1;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 block_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
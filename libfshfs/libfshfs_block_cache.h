@@ -0,0 +1,106 @@
+/*
+ * Block cache functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_BLOCK_CACHE_H )
+#define _LIBFSHFS_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_block_cache_entry libfshfs_block_cache_entry_t;
+
+struct libfshfs_block_cache_entry
+{
+	/* The offset, where -1 represents an unused entry
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libfshfs_block_cache libfshfs_block_cache_t;
+
+struct libfshfs_block_cache
+{
+	/* The entries of the partitions, which are stored in sets of LIBFSHFS_BLOCK_CACHE_NUMBER_OF_WAYS entries
+	 */
+	libfshfs_block_cache_entry_t *entries[ LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ];
+
+	/* The index of the entry that is replaced next of every set of the partitions
+	 */
+	uint8_t *replacement_indexes[ LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ];
+
+	/* The number of sets of the partitions
+	 */
+	int number_of_sets[ LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ];
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfshfs_block_cache_initialize(
+     libfshfs_block_cache_t **block_cache,
+     const int *maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_block_cache_free(
+     libfshfs_block_cache_t **block_cache,
+     libcerror_error_t **error );
+
+int libfshfs_block_cache_get_block(
+     libfshfs_block_cache_t *block_cache,
+     int partition,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libfshfs_block_cache_set_block(
+     libfshfs_block_cache_t *block_cache,
+     int partition,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_BLOCK_CACHE_H ) */
+
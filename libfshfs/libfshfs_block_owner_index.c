@@ -0,0 +1,1205 @@
+/*
+ * Block owner index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfshfs_block_owner_index.h"
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_extents_btree_file.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#include "fshfs_catalog_file.h"
+#include "fshfs_fork.h"
+
+/* The maximum number of B-tree nodes that are read at once
+ */
+#define LIBFSHFS_BLOCK_OWNER_INDEX_MAXIMUM_NUMBER_OF_NODES_PER_READ	256
+
+/* Creates a block owner index
+ * Make sure the value block_owner_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_initialize(
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_block_owner_index_initialize";
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_owner_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block owner index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*block_owner_index = memory_allocate_structure(
+	                      libfshfs_block_owner_index_t );
+
+	if( *block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block owner index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *block_owner_index,
+	     0,
+	     sizeof( libfshfs_block_owner_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block owner index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *block_owner_index != NULL )
+	{
+		memory_free(
+		 *block_owner_index );
+
+		*block_owner_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a block owner index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_free(
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_block_owner_index_free";
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block_owner_index != NULL )
+	{
+		if( ( *block_owner_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *block_owner_index )->entries );
+		}
+		memory_free(
+		 *block_owner_index );
+
+		*block_owner_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares the start block numbers of 2 block owner index entries
+ * This function is used to sort the entries with qsort
+ * Returns -1 if the first start block number is less, 0 if equal or 1 if greater
+ */
+int libfshfs_block_owner_index_compare_entries(
+     const void *first_entry,
+     const void *second_entry )
+{
+	uint32_t first_start_block_number  = ( (libfshfs_block_owner_index_entry_t *) first_entry )->start_block_number;
+	uint32_t second_start_block_number = ( (libfshfs_block_owner_index_entry_t *) second_entry )->start_block_number;
+
+	if( first_start_block_number < second_start_block_number )
+	{
+		return( -1 );
+	}
+	else if( first_start_block_number > second_start_block_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends an extent to the block owner index
+ * Extents without blocks are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_append_extent(
+     libfshfs_block_owner_index_t *block_owner_index,
+     uint32_t start_block_number,
+     uint32_t number_of_blocks,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t fork_block_number,
+     libcerror_error_t **error )
+{
+	libfshfs_block_owner_index_entry_t *entries = NULL;
+	libfshfs_block_owner_index_entry_t *entry   = NULL;
+	static char *function                       = "libfshfs_block_owner_index_append_extent";
+	size_t entries_size                         = 0;
+	uint32_t maximum_number_of_entries          = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == 0 )
+	{
+		return( 1 );
+	}
+	if( ( number_of_blocks > ( (uint32_t) UINT32_MAX - start_block_number ) )
+	 || ( number_of_blocks > ( (uint32_t) UINT32_MAX - fork_block_number ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_owner_index->number_of_entries >= block_owner_index->maximum_number_of_entries )
+	{
+		if( block_owner_index->maximum_number_of_entries == 0 )
+		{
+			maximum_number_of_entries = 256;
+		}
+		else if( block_owner_index->maximum_number_of_entries < 0x80000000UL )
+		{
+			maximum_number_of_entries = block_owner_index->maximum_number_of_entries * 2;
+		}
+		else
+		{
+			maximum_number_of_entries = 0;
+		}
+		if( ( maximum_number_of_entries == 0 )
+		 || ( (size_t) maximum_number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libfshfs_block_owner_index_entry_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		entries_size = sizeof( libfshfs_block_owner_index_entry_t ) * maximum_number_of_entries;
+
+		entries = (libfshfs_block_owner_index_entry_t *) memory_reallocate(
+		                                                  block_owner_index->entries,
+		                                                  entries_size );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		block_owner_index->entries                   = entries;
+		block_owner_index->maximum_number_of_entries = maximum_number_of_entries;
+	}
+	entry = &( block_owner_index->entries[ block_owner_index->number_of_entries ] );
+
+	entry->start_block_number = start_block_number;
+	entry->number_of_blocks   = number_of_blocks;
+	entry->identifier         = identifier;
+	entry->fork_block_number  = fork_block_number;
+	entry->fork_type          = fork_type;
+
+	block_owner_index->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Appends the extents in an HFS+ extents record to the block owner index
+ * The extents record contains 8 extents, an extent without blocks marks the end of the record
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_append_extents_data(
+     libfshfs_block_owner_index_t *block_owner_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t fork_block_number,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfshfs_block_owner_index_append_extents_data";
+	size_t data_offset          = 0;
+	uint32_t number_of_blocks   = 0;
+	uint32_t start_block_number = 0;
+	int extent_index            = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 64 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 start_block_number );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset + 4 ] ),
+		 number_of_blocks );
+
+		data_offset += 8;
+
+		if( number_of_blocks == 0 )
+		{
+			break;
+		}
+		if( libfshfs_block_owner_index_append_extent(
+		     block_owner_index,
+		     start_block_number,
+		     number_of_blocks,
+		     identifier,
+		     fork_type,
+		     fork_block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d to block owner index.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		fork_block_number += number_of_blocks;
+	}
+	return( 1 );
+}
+
+/* Appends the extents in a fork descriptor to the block owner index
+ * Only the extents stored in the fork descriptor itself are appended, the overflow
+ * extents are read from the extents B-tree file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_append_fork_descriptor(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t identifier,
+     uint8_t fork_type,
+     libcerror_error_t **error )
+{
+	static char *function      = "libfshfs_block_owner_index_append_fork_descriptor";
+	uint32_t fork_block_number = 0;
+	int extent_index           = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		if( fork_descriptor->extents[ extent_index ][ 1 ] == 0 )
+		{
+			break;
+		}
+		if( libfshfs_block_owner_index_append_extent(
+		     block_owner_index,
+		     fork_descriptor->extents[ extent_index ][ 0 ],
+		     fork_descriptor->extents[ extent_index ][ 1 ],
+		     identifier,
+		     fork_type,
+		     fork_block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d to block owner index.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		fork_block_number += fork_descriptor->extents[ extent_index ][ 1 ];
+	}
+	return( 1 );
+}
+
+/* Reads the extents in the records of a catalog or extents B-tree leaf node
+ * Only HFS+ records are supported
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_read_leaf_node(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_btree_node_t *node,
+     int btree_file_type,
+     libcerror_error_t **error )
+{
+	fshfs_catalog_file_record_hfsplus_t *file_record = NULL;
+	const uint8_t *record_data                       = NULL;
+	static char *function                            = "libfshfs_block_owner_index_read_leaf_node";
+	size_t record_data_offset                        = 0;
+	size_t record_data_size                          = 0;
+	uint32_t fork_block_number                       = 0;
+	uint32_t identifier                              = 0;
+	uint16_t key_data_size                           = 0;
+	uint16_t number_of_records                       = 0;
+	uint16_t record_index                            = 0;
+	uint16_t record_type                             = 0;
+	uint8_t fork_type                                = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( node->descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid node - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( btree_file_type != LIBFSHFS_BTREE_FILE_TYPE_CATALOG )
+	 && ( btree_file_type != LIBFSHFS_BTREE_FILE_TYPE_EXTENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported B-tree file type.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_records = node->descriptor->number_of_records;
+
+	for( record_index = 0;
+	     record_index < number_of_records;
+	     record_index++ )
+	{
+		if( libfshfs_btree_node_get_record_data_by_index(
+		     node,
+		     record_index,
+		     &record_data,
+		     &record_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record: %" PRIu16 " data.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		if( ( record_data == NULL )
+		 || ( record_data_size < 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint16_big_endian(
+		 record_data,
+		 key_data_size );
+
+		record_data_offset = (size_t) key_data_size + 2;
+
+		if( btree_file_type == LIBFSHFS_BTREE_FILE_TYPE_CATALOG )
+		{
+			if( record_data_offset > ( record_data_size - 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 record_type );
+
+			/* Only file records own allocation blocks
+			 */
+			if( record_type != 0x0002 )
+			{
+				continue;
+			}
+			if( ( record_data_size - record_data_offset ) < sizeof( fshfs_catalog_file_record_hfsplus_t ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record: %" PRIu16 " data size value out of bounds.",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+			file_record = (fshfs_catalog_file_record_hfsplus_t *) &( record_data[ record_data_offset ] );
+
+			byte_stream_copy_to_uint32_big_endian(
+			 file_record->identifier,
+			 identifier );
+
+			if( libfshfs_block_owner_index_append_extents_data(
+			     block_owner_index,
+			     ( (fshfs_fork_descriptor_t *) file_record->data_fork_descriptor )->extents,
+			     64,
+			     identifier,
+			     LIBFSHFS_FORK_TYPE_DATA,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append data fork extents of record: %" PRIu16 ".",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+			if( libfshfs_block_owner_index_append_extents_data(
+			     block_owner_index,
+			     ( (fshfs_fork_descriptor_t *) file_record->resource_fork_descriptor )->extents,
+			     64,
+			     identifier,
+			     LIBFSHFS_FORK_TYPE_RESOURCE,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append resource fork extents of record: %" PRIu16 ".",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( libfshfs_extents_btree_file_get_key_from_record_data(
+			     record_data,
+			     record_data_size,
+			     &identifier,
+			     &fork_type,
+			     &fork_block_number,
+			     &record_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve key of record: %" PRIu16 ".",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+			if( ( record_data_size - record_data_offset ) < 64 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record: %" PRIu16 " data size value out of bounds.",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+			if( libfshfs_block_owner_index_append_extents_data(
+			     block_owner_index,
+			     &( record_data[ record_data_offset ] ),
+			     record_data_size - record_data_offset,
+			     identifier,
+			     fork_type,
+			     fork_block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extents of record: %" PRIu16 ".",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the extents in the leaf nodes of a catalog or extents B-tree file
+ * The B-tree is walked level by level, where the nodes of a level are read in batches
+ * so that their reads can be coalesced and, if available, run in parallel
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_read_btree_file(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int btree_file_type,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *nodes[ LIBFSHFS_BLOCK_OWNER_INDEX_MAXIMUM_NUMBER_OF_NODES_PER_READ ];
+
+	libfshfs_btree_node_t *node          = NULL;
+	const uint8_t *record_data           = NULL;
+	uint32_t *level_node_numbers         = NULL;
+	uint32_t *sub_node_numbers           = NULL;
+	uint32_t *resized_node_numbers       = NULL;
+	static char *function                = "libfshfs_block_owner_index_read_btree_file";
+	size_t record_data_offset            = 0;
+	size_t record_data_size              = 0;
+	uint64_t maximum_number_of_nodes     = 0;
+	uint64_t number_of_nodes             = 0;
+	uint32_t level_node_index            = 0;
+	uint32_t maximum_number_of_sub_nodes = 0;
+	uint32_t number_of_level_nodes       = 0;
+	uint32_t number_of_sub_nodes         = 0;
+	uint32_t sub_node_number             = 0;
+	uint16_t key_data_size               = 0;
+	uint16_t number_of_records           = 0;
+	uint16_t record_index                = 0;
+	int depth                            = 0;
+	int node_index                       = 0;
+	int number_of_read_nodes             = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header->node_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree file - node size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     nodes,
+	     0,
+	     sizeof( libfshfs_btree_node_t * ) * LIBFSHFS_BLOCK_OWNER_INDEX_MAXIMUM_NUMBER_OF_NODES_PER_READ ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear nodes.",
+		 function );
+
+		return( -1 );
+	}
+	/* A root node number of 0 indicates an empty B-tree
+	 */
+	if( btree_file->header->root_node_number == 0 )
+	{
+		return( 1 );
+	}
+	maximum_number_of_nodes = fork_descriptor->size / btree_file->header->node_size;
+
+	level_node_numbers = (uint32_t *) memory_allocate(
+	                                   sizeof( uint32_t ) );
+
+	if( level_node_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create level node numbers.",
+		 function );
+
+		goto on_error;
+	}
+	level_node_numbers[ 0 ] = btree_file->header->root_node_number;
+	number_of_level_nodes   = 1;
+
+	while( number_of_level_nodes > 0 )
+	{
+		number_of_nodes += number_of_level_nodes;
+
+		if( ( depth >= LIBFSHFS_MAXIMUM_BTREE_DEPTH )
+		 || ( number_of_nodes > maximum_number_of_nodes ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree level: %d value out of bounds.",
+			 function,
+			 depth );
+
+			goto on_error;
+		}
+		number_of_sub_nodes = 0;
+
+		for( level_node_index = 0;
+		     level_node_index < number_of_level_nodes;
+		     level_node_index += (uint32_t) number_of_read_nodes )
+		{
+			number_of_read_nodes = LIBFSHFS_BLOCK_OWNER_INDEX_MAXIMUM_NUMBER_OF_NODES_PER_READ;
+
+			if( (uint32_t) number_of_read_nodes > ( number_of_level_nodes - level_node_index ) )
+			{
+				number_of_read_nodes = (int) ( number_of_level_nodes - level_node_index );
+			}
+			for( node_index = 0;
+			     node_index < number_of_read_nodes;
+			     node_index++ )
+			{
+				if( ( level_node_numbers[ level_node_index + node_index ] == 0 )
+				 || ( (uint64_t) level_node_numbers[ level_node_index + node_index ] >= maximum_number_of_nodes ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid B-tree node number: %" PRIu32 " value out of bounds.",
+					 function,
+					 level_node_numbers[ level_node_index + node_index ] );
+
+					goto on_error;
+				}
+			}
+			if( libfshfs_btree_file_read_nodes_by_number(
+			     btree_file,
+			     file_io_handle,
+			     &( level_node_numbers[ level_node_index ] ),
+			     number_of_read_nodes,
+			     nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read B-tree level: %d nodes.",
+				 function,
+				 depth );
+
+				goto on_error;
+			}
+			for( node_index = 0;
+			     node_index < number_of_read_nodes;
+			     node_index++ )
+			{
+				node = nodes[ node_index ];
+
+				if( ( node == NULL )
+				 || ( node->descriptor == NULL ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+					 function,
+					 level_node_numbers[ level_node_index + node_index ] );
+
+					goto on_error;
+				}
+				if( node->descriptor->type == LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+				{
+					if( libfshfs_block_owner_index_read_leaf_node(
+					     block_owner_index,
+					     node,
+					     btree_file_type,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read B-tree leaf node: %" PRIu32 ".",
+						 function,
+						 level_node_numbers[ level_node_index + node_index ] );
+
+						goto on_error;
+					}
+				}
+				else if( node->descriptor->type == LIBFSHFS_BTREE_NODE_TYPE_INDEX_NODE )
+				{
+					number_of_records = node->descriptor->number_of_records;
+
+					for( record_index = 0;
+					     record_index < number_of_records;
+					     record_index++ )
+					{
+						if( libfshfs_btree_node_get_record_data_by_index(
+						     node,
+						     record_index,
+						     &record_data,
+						     &record_data_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+							 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+							 function,
+							 level_node_numbers[ level_node_index + node_index ],
+							 record_index );
+
+							goto on_error;
+						}
+						if( ( record_data == NULL )
+						 || ( record_data_size < 2 ) )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+							 "%s: invalid record data size value out of bounds.",
+							 function );
+
+							goto on_error;
+						}
+						byte_stream_copy_to_uint16_big_endian(
+						 record_data,
+						 key_data_size );
+
+						record_data_offset = (size_t) key_data_size + 2;
+
+						if( record_data_offset > ( record_data_size - 4 ) )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+							 "%s: invalid record data offset value out of bounds.",
+							 function );
+
+							goto on_error;
+						}
+						byte_stream_copy_to_uint32_big_endian(
+						 &( record_data[ record_data_offset ] ),
+						 sub_node_number );
+
+						if( number_of_sub_nodes >= maximum_number_of_sub_nodes )
+						{
+							if( maximum_number_of_sub_nodes == 0 )
+							{
+								maximum_number_of_sub_nodes = 64;
+							}
+							else if( maximum_number_of_sub_nodes < 0x80000000UL )
+							{
+								maximum_number_of_sub_nodes *= 2;
+							}
+							else
+							{
+								maximum_number_of_sub_nodes = 0;
+							}
+							if( ( maximum_number_of_sub_nodes == 0 )
+							 || ( (size_t) maximum_number_of_sub_nodes > ( (size_t) SSIZE_MAX / sizeof( uint32_t ) ) ) )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+								 "%s: invalid number of sub nodes value exceeds maximum.",
+								 function );
+
+								goto on_error;
+							}
+							resized_node_numbers = (uint32_t *) memory_reallocate(
+							                                     sub_node_numbers,
+							                                     sizeof( uint32_t ) * maximum_number_of_sub_nodes );
+
+							if( resized_node_numbers == NULL )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_MEMORY,
+								 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+								 "%s: unable to resize sub node numbers.",
+								 function );
+
+								goto on_error;
+							}
+							sub_node_numbers = resized_node_numbers;
+						}
+						sub_node_numbers[ number_of_sub_nodes++ ] = sub_node_number;
+					}
+				}
+				else
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+					 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+					 function,
+					 level_node_numbers[ level_node_index + node_index ],
+					 node->descriptor->type );
+
+					goto on_error;
+				}
+				if( libfshfs_btree_node_free(
+				     &( nodes[ node_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free B-tree node: %d.",
+					 function,
+					 node_index );
+
+					goto on_error;
+				}
+			}
+		}
+		memory_free(
+		 level_node_numbers );
+
+		level_node_numbers    = sub_node_numbers;
+		number_of_level_nodes = number_of_sub_nodes;
+
+		sub_node_numbers            = NULL;
+		number_of_sub_nodes         = 0;
+		maximum_number_of_sub_nodes = 0;
+
+		depth++;
+	}
+	if( level_node_numbers != NULL )
+	{
+		memory_free(
+		 level_node_numbers );
+	}
+	return( 1 );
+
+on_error:
+	for( node_index = 0;
+	     node_index < LIBFSHFS_BLOCK_OWNER_INDEX_MAXIMUM_NUMBER_OF_NODES_PER_READ;
+	     node_index++ )
+	{
+		if( nodes[ node_index ] != NULL )
+		{
+			libfshfs_btree_node_free(
+			 &( nodes[ node_index ] ),
+			 NULL );
+		}
+	}
+	if( sub_node_numbers != NULL )
+	{
+		memory_free(
+		 sub_node_numbers );
+	}
+	if( level_node_numbers != NULL )
+	{
+		memory_free(
+		 level_node_numbers );
+	}
+	return( -1 );
+}
+
+/* Sorts the entries of the block owner index by start block number
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_block_owner_index_sort(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_block_owner_index_sort";
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_owner_index->number_of_entries > 1 )
+	{
+		qsort(
+		 block_owner_index->entries,
+		 (size_t) block_owner_index->number_of_entries,
+		 sizeof( libfshfs_block_owner_index_entry_t ),
+		 &libfshfs_block_owner_index_compare_entries );
+	}
+	return( 1 );
+}
+
+/* Retrieves the entry that contains a specific allocation block number
+ * The entries must have been sorted
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_block_owner_index_get_entry_by_block_number(
+     libfshfs_block_owner_index_t *block_owner_index,
+     uint32_t block_number,
+     libfshfs_block_owner_index_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libfshfs_block_owner_index_entry_t *safe_entry = NULL;
+	static char *function                          = "libfshfs_block_owner_index_get_entry_by_block_number";
+	uint32_t entry_index                           = 0;
+	uint32_t maximum                               = 0;
+	uint32_t minimum                               = 0;
+
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the number of entries that start at or before the block number
+	 */
+	maximum = block_owner_index->number_of_entries;
+
+	while( minimum < maximum )
+	{
+		entry_index = minimum + ( ( maximum - minimum ) / 2 );
+
+		if( block_owner_index->entries[ entry_index ].start_block_number <= block_number )
+		{
+			minimum = entry_index + 1;
+		}
+		else
+		{
+			maximum = entry_index;
+		}
+	}
+	if( minimum == 0 )
+	{
+		return( 0 );
+	}
+	safe_entry = &( block_owner_index->entries[ minimum - 1 ] );
+
+	if( ( block_number - safe_entry->start_block_number ) >= safe_entry->number_of_blocks )
+	{
+		return( 0 );
+	}
+	*entry = safe_entry;
+
+	return( 1 );
+}
+
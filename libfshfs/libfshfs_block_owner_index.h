@@ -0,0 +1,146 @@
+/*
+ * Block owner index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_BLOCK_OWNER_INDEX_H )
+#define _LIBFSHFS_BLOCK_OWNER_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_block_owner_index_entry libfshfs_block_owner_index_entry_t;
+
+struct libfshfs_block_owner_index_entry
+{
+	/* The number of the first allocation block of the extent
+	 */
+	uint32_t start_block_number;
+
+	/* The number of allocation blocks of the extent
+	 */
+	uint32_t number_of_blocks;
+
+	/* The identifier (CNID) of the owner
+	 */
+	uint32_t identifier;
+
+	/* The number of the first allocation block of the extent relative to the start of the fork
+	 */
+	uint32_t fork_block_number;
+
+	/* The fork type
+	 */
+	uint8_t fork_type;
+};
+
+typedef struct libfshfs_block_owner_index libfshfs_block_owner_index_t;
+
+struct libfshfs_block_owner_index
+{
+	/* The entries, which are sorted by start block number after the index was sorted
+	 */
+	libfshfs_block_owner_index_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	uint32_t maximum_number_of_entries;
+};
+
+int libfshfs_block_owner_index_initialize(
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_free(
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_compare_entries(
+     const void *first_entry,
+     const void *second_entry );
+
+int libfshfs_block_owner_index_append_extent(
+     libfshfs_block_owner_index_t *block_owner_index,
+     uint32_t start_block_number,
+     uint32_t number_of_blocks,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t fork_block_number,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_append_extents_data(
+     libfshfs_block_owner_index_t *block_owner_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t fork_block_number,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_append_fork_descriptor(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t identifier,
+     uint8_t fork_type,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_read_leaf_node(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_btree_node_t *node,
+     int btree_file_type,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_read_btree_file(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int btree_file_type,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_sort(
+     libfshfs_block_owner_index_t *block_owner_index,
+     libcerror_error_t **error );
+
+int libfshfs_block_owner_index_get_entry_by_block_number(
+     libfshfs_block_owner_index_t *block_owner_index,
+     uint32_t block_number,
+     libfshfs_block_owner_index_entry_t **entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_BLOCK_OWNER_INDEX_H ) */
+
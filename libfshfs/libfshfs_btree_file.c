@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfshfs_block_cache.h"
 #include "libfshfs_btree_file.h"
 #include "libfshfs_btree_header.h"
 #include "libfshfs_btree_node_descriptor.h"
@@ -31,6 +32,8 @@
 #include "libfshfs_debug.h"
 #include "libfshfs_definitions.h"
 #include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_io_scheduler.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcnotify.h"
 #include "libfshfs_libfcache.h"
@@ -191,6 +194,22 @@ int libfshfs_btree_file_free(
 
 			result = -1;
 		}
+		if( ( *btree_file )->fork_descriptor != NULL )
+		{
+			if( libfshfs_fork_descriptor_free(
+			     &( ( *btree_file )->fork_descriptor ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free fork descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *btree_file );
 
@@ -333,6 +352,7 @@ int libfshfs_btree_file_get_root_node(
 }
 
 /* Reads the B-tree file
+ * The nodes are cached in the block cache partition
  * Returns 1 if successful or -1 on error
  */
 int libfshfs_btree_file_read(
@@ -340,6 +360,7 @@ int libfshfs_btree_file_read(
      libfshfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfshfs_fork_descriptor_t *fork_descriptor,
+     int block_cache_partition,
      libcerror_error_t **error )
 {
 	uint8_t header_node_data[ 512 ];
@@ -393,6 +414,18 @@ int libfshfs_btree_file_read(
 
 		return( -1 );
 	}
+	if( ( block_cache_partition < 0 )
+	 || ( block_cache_partition >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block cache partition value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	/* Read the header record first to determine the B-tree node size.
 	 */
 	file_offset = fork_descriptor->extents[ 0 ][ 0 ] * io_handle->allocation_block_size;
@@ -406,24 +439,10 @@ int libfshfs_btree_file_read(
 		 file_offset );
 	}
 #endif
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek B-tree header node offset: %" PRIi64 ".",
-		 function,
-		 file_offset );
-
-		goto on_error;
-	}
-	read_count = libbfio_handle_read_buffer(
+	read_count = libfshfs_io_handle_read_buffer_at_offset(
+	              io_handle,
 	              file_io_handle,
+	              file_offset,
 	              header_node_data,
 	              512,
 	              error );
@@ -513,6 +532,7 @@ int libfshfs_btree_file_read(
 	     io_handle,
 	     btree_file->header->node_size,
 	     fork_descriptor,
+	     block_cache_partition,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -538,9 +558,32 @@ int libfshfs_btree_file_read(
 
 		goto on_error;
 	}
+	if( libfshfs_fork_descriptor_clone(
+	     &( btree_file->fork_descriptor ),
+	     fork_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create fork descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	btree_file->io_handle             = io_handle;
+	btree_file->block_cache_partition = block_cache_partition;
+
 	return( 1 );
 
 on_error:
+	if( btree_file->fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &( btree_file->fork_descriptor ),
+		 NULL );
+	}
 	if( btree_file->nodes_cache != NULL )
 	{
 		libfcache_cache_free(
@@ -562,3 +605,637 @@ on_error:
 	return( -1 );
 }
 
+/* Determines the offset of a specific B-tree node
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_btree_file_get_node_offset(
+     libfshfs_btree_file_t *btree_file,
+     uint32_t node_number,
+     off64_t *node_offset,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfshfs_btree_file_get_node_offset";
+	uint64_t extent_offset      = 0;
+	uint64_t extent_size        = 0;
+	uint64_t relative_offset    = 0;
+	uint32_t number_of_blocks   = 0;
+	uint32_t start_block_number = 0;
+	int extent_index            = 0;
+	int number_of_extents       = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     btree_file->fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	relative_offset = (uint64_t) node_number * btree_file->header->node_size;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     btree_file->fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		extent_offset = (uint64_t) start_block_number * btree_file->io_handle->allocation_block_size;
+		extent_size   = (uint64_t) number_of_blocks * btree_file->io_handle->allocation_block_size;
+
+		if( relative_offset < extent_size )
+		{
+			/* A node that is not stored contiguously is not supported
+			 */
+			if( ( extent_size - relative_offset ) < (uint64_t) btree_file->header->node_size )
+			{
+				break;
+			}
+			*node_offset = (off64_t) ( extent_offset + relative_offset );
+
+			return( 1 );
+		}
+		relative_offset -= extent_size;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid node number: %" PRIu32 " value out of bounds.",
+	 function,
+	 node_number );
+
+	return( -1 );
+}
+
+/* Retrieves a B-tree node that is stored in the nodes cache
+ * The nodes cache is only searched, a node that is not cached is not read
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_btree_file_get_cached_node_by_offset(
+     libfshfs_btree_file_t *btree_file,
+     off64_t node_offset,
+     libfshfs_btree_node_t **node,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libfshfs_btree_file_get_cached_node_by_offset";
+	off64_t cache_value_offset           = 0;
+	int64_t cache_value_timestamp        = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = 0;
+	int number_of_cache_entries          = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	*node = NULL;
+
+	if( libfcache_cache_get_number_of_entries(
+	     btree_file->nodes_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of nodes cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* The nodes vector stores the block cache partition as the file index
+	 * of the cached nodes and does not change after the B-tree file was read,
+	 * hence the timestamp is not compared
+	 */
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libfcache_cache_get_value_by_index(
+		     btree_file->nodes_cache,
+		     cache_entry_index,
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve nodes cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( cache_value == NULL )
+		{
+			continue;
+		}
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier of nodes cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( ( cache_value_file_index != btree_file->block_cache_partition )
+		 || ( cache_value_offset != node_offset ) )
+		{
+			continue;
+		}
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value of nodes cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( *node != NULL )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reads multiple B-tree nodes
+ * The nodes are retrieved from the nodes cache or block cache if available, the other nodes
+ * are read using the I/O scheduler, which coalesces the reads, and are stored in the block cache
+ * afterwards. The nodes are not stored in the nodes cache
+ * The nodes array should be able to contain number_of_nodes values,
+ * the nodes are owned by the caller and should be freed with libfshfs_btree_node_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_btree_file_read_nodes_by_number(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     const uint32_t *node_numbers,
+     int number_of_nodes,
+     libfshfs_btree_node_t **nodes,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *cached_node    = NULL;
+	libfshfs_io_scheduler_t *io_scheduler = NULL;
+	off64_t *read_offsets                 = NULL;
+	static char *function                 = "libfshfs_btree_file_read_nodes_by_number";
+	off64_t node_offset                   = 0;
+	int node_index                        = 0;
+	int result                            = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node numbers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_nodes < 0 )
+	 || ( (size_t) number_of_nodes > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid nodes.",
+		 function );
+
+		return( -1 );
+	}
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		nodes[ node_index ] = NULL;
+	}
+	if( number_of_nodes == 0 )
+	{
+		return( 1 );
+	}
+	/* The offsets of the nodes that are read, or -1 if the node was retrieved from a cache
+	 */
+	read_offsets = (off64_t *) memory_allocate(
+	                            sizeof( off64_t ) * number_of_nodes );
+
+	if( read_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read offsets.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_io_scheduler_initialize(
+	     &io_scheduler,
+	     btree_file->io_handle->maximum_read_gap_size,
+	     LIBFSHFS_IO_SCHEDULER_MAXIMUM_READ_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create I/O scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		read_offsets[ node_index ] = -1;
+
+		if( libfshfs_btree_file_get_node_offset(
+		     btree_file,
+		     node_numbers[ node_index ],
+		     &node_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine offset of B-tree node: %" PRIu32 ".",
+			 function,
+			 node_numbers[ node_index ] );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_node_initialize(
+		     &( nodes[ node_index ] ),
+		     btree_file->io_handle->buffer_pool,
+		     (size_t) btree_file->header->node_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create B-tree node: %" PRIu32 ".",
+			 function,
+			 node_numbers[ node_index ] );
+
+			goto on_error;
+		}
+		result = libfshfs_btree_file_get_cached_node_by_offset(
+		          btree_file,
+		          node_offset,
+		          &cached_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %" PRIu32 " from nodes cache.",
+			 function,
+			 node_numbers[ node_index ] );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( cached_node->data_size != nodes[ node_index ]->data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid cached B-tree node: %" PRIu32 " - data size value out of bounds.",
+				 function,
+				 node_numbers[ node_index ] );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     nodes[ node_index ]->data,
+			     cached_node->data,
+			     cached_node->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy cached B-tree node: %" PRIu32 ".",
+				 function,
+				 node_numbers[ node_index ] );
+
+				goto on_error;
+			}
+		}
+		else if( btree_file->io_handle->block_cache != NULL )
+		{
+			result = libfshfs_block_cache_get_block(
+			          btree_file->io_handle->block_cache,
+			          btree_file->block_cache_partition,
+			          node_offset,
+			          nodes[ node_index ]->data,
+			          nodes[ node_index ]->data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve B-tree node: %" PRIu32 " from block cache.",
+				 function,
+				 node_numbers[ node_index ] );
+
+				goto on_error;
+			}
+		}
+		if( result == 0 )
+		{
+			if( libfshfs_io_scheduler_queue_read(
+			     io_scheduler,
+			     node_offset,
+			     nodes[ node_index ]->data,
+			     nodes[ node_index ]->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue read of B-tree node: %" PRIu32 ".",
+				 function,
+				 node_numbers[ node_index ] );
+
+				goto on_error;
+			}
+			read_offsets[ node_index ] = node_offset;
+		}
+	}
+	if( libfshfs_io_scheduler_flush(
+	     io_scheduler,
+	     btree_file->io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read B-tree nodes.",
+		 function );
+
+		goto on_error;
+	}
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		/* Only the nodes that were read are stored in the block cache
+		 */
+		if( ( btree_file->io_handle->block_cache != NULL )
+		 && ( read_offsets[ node_index ] >= 0 ) )
+		{
+			if( libfshfs_block_cache_set_block(
+			     btree_file->io_handle->block_cache,
+			     btree_file->block_cache_partition,
+			     read_offsets[ node_index ],
+			     nodes[ node_index ]->data,
+			     nodes[ node_index ]->data_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set B-tree node: %" PRIu32 " in block cache.",
+				 function,
+				 node_numbers[ node_index ] );
+
+				goto on_error;
+			}
+		}
+		if( libfshfs_btree_node_read(
+		     nodes[ node_index ],
+		     nodes[ node_index ]->data,
+		     nodes[ node_index ]->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read B-tree node: %" PRIu32 ".",
+			 function,
+			 node_numbers[ node_index ] );
+
+			goto on_error;
+		}
+	}
+	if( libfshfs_io_scheduler_free(
+	     &io_scheduler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free I/O scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 read_offsets );
+
+	return( 1 );
+
+on_error:
+	if( io_scheduler != NULL )
+	{
+		libfshfs_io_scheduler_free(
+		 &io_scheduler,
+		 NULL );
+	}
+	if( read_offsets != NULL )
+	{
+		memory_free(
+		 read_offsets );
+	}
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		if( nodes[ node_index ] != NULL )
+		{
+			libfshfs_btree_node_free(
+			 &( nodes[ node_index ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
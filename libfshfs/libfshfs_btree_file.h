@@ -53,6 +53,18 @@ struct libfshfs_btree_file
 	/* The nodes cache
 	 */
 	libfcache_cache_t *nodes_cache;
+
+	/* The IO handle
+	 */
+	libfshfs_io_handle_t *io_handle;
+
+	/* The block cache partition of the nodes
+	 */
+	int block_cache_partition;
+
+	/* The fork descriptor, which is used to determine the offsets of the nodes
+	 */
+	libfshfs_fork_descriptor_t *fork_descriptor;
 };
 
 int libfshfs_btree_file_initialize(
@@ -81,6 +93,27 @@ int libfshfs_btree_file_read(
      libfshfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfshfs_fork_descriptor_t *fork_descriptor,
+     int block_cache_partition,
+     libcerror_error_t **error );
+
+int libfshfs_btree_file_get_node_offset(
+     libfshfs_btree_file_t *btree_file,
+     uint32_t node_number,
+     off64_t *node_offset,
+     libcerror_error_t **error );
+
+int libfshfs_btree_file_get_cached_node_by_offset(
+     libfshfs_btree_file_t *btree_file,
+     off64_t node_offset,
+     libfshfs_btree_node_t **node,
+     libcerror_error_t **error );
+
+int libfshfs_btree_file_read_nodes_by_number(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     const uint32_t *node_numbers,
+     int number_of_nodes,
+     libfshfs_btree_node_t **nodes,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
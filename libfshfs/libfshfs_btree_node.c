@@ -26,6 +26,7 @@
 
 #include "libfshfs_btree_node_descriptor.h"
 #include "libfshfs_btree_node.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_debug.h"
 #include "libfshfs_definitions.h"
 #include "libfshfs_libcdata.h"
@@ -145,10 +146,12 @@ int libfshfs_btree_node_record_free(
 
 /* Creates a B-tree node
  * Make sure the value node is referencing, is set to NULL
+ * The data is retrieved from the buffer pool, which can be NULL, and is released to it when the node is freed
  * Returns 1 if successful or -1 on error
  */
 int libfshfs_btree_node_initialize(
      libfshfs_btree_node_t **node,
+     libfshfs_buffer_pool_t *buffer_pool,
      size_t data_size,
      libcerror_error_t **error )
 {
@@ -235,21 +238,23 @@ int libfshfs_btree_node_initialize(
 	}
 	if( data_size > 0 )
 	{
-		( *node )->data = (uint8_t *) memory_allocate(
-		                               sizeof( uint8_t ) * data_size );
-
-		if( ( *node )->data == NULL )
+		if( libfshfs_buffer_pool_get_buffer(
+		     buffer_pool,
+		     data_size,
+		     &( ( *node )->data ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 			 "%s: unable to create data.",
 			 function );
 
 			goto on_error;
 		}
-		( *node )->data_size = data_size;
+		( *node )->data_size   = data_size;
+		( *node )->buffer_pool = buffer_pool;
 	}
 	if( libcdata_array_initialize(
 	     &( ( *node )->records_array ),
@@ -272,8 +277,10 @@ on_error:
 	{
 		if( ( *node )->data != NULL )
 		{
-			memory_free(
-			 ( *node )->data );
+			libfshfs_buffer_pool_release_buffer(
+			 buffer_pool,
+			 &( ( *node )->data ),
+			 NULL );
 		}
 		if( ( *node )->descriptor != NULL )
 		{
@@ -339,10 +346,19 @@ int libfshfs_btree_node_free(
 
 			result = -1;
 		}
-		if( ( *node )->data != NULL )
+		if( libfshfs_buffer_pool_release_buffer(
+		     ( *node )->buffer_pool,
+		     &( ( *node )->data ),
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *node )->data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release data.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *node );
@@ -645,6 +661,7 @@ on_error:
 }
 
 /* Reads a B-tree node
+ * The element data file index contains the block cache partition of the node
  * Callback function for the B-tree node vector
  * Returns 1 if successful or -1 on error
  */
@@ -654,7 +671,7 @@ int libfshfs_btree_node_read_element_data(
      libfdata_vector_t *vector,
      libfcache_cache_t *cache,
      int element_index LIBFSHFS_ATTRIBUTE_UNUSED,
-     int element_data_file_index LIBFSHFS_ATTRIBUTE_UNUSED,
+     int element_data_file_index,
      off64_t btree_node_offset,
      size64_t btree_node_size,
      uint32_t range_flags,
@@ -666,7 +683,6 @@ int libfshfs_btree_node_read_element_data(
 	ssize_t read_count          = 0;
 
 	LIBFSHFS_UNREFERENCED_PARAMETER( element_index )
-	LIBFSHFS_UNREFERENCED_PARAMETER( element_data_file_index )
 	LIBFSHFS_UNREFERENCED_PARAMETER( read_flags )
 
 	if( io_handle == NULL )
@@ -694,6 +710,7 @@ int libfshfs_btree_node_read_element_data(
 	}
 	if( libfshfs_btree_node_initialize(
 	     &node,
+	     io_handle->buffer_pool,
 	     (size_t) btree_node_size,
 	     error ) != 1 )
 	{
@@ -757,24 +774,11 @@ int libfshfs_btree_node_read_element_data(
 			 btree_node_size );
 		}
 #endif
-		if( libbfio_handle_seek_offset(
-		     file_io_handle,
-		     btree_node_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset: 0x%08" PRIx64 ".",
-			 function,
-			 btree_node_offset );
-
-			goto on_error;
-		}
-		read_count = libbfio_handle_read_buffer(
+		read_count = libfshfs_io_handle_read_block_at_offset(
+		              io_handle,
 		              file_io_handle,
+		              element_data_file_index,
+		              btree_node_offset,
 		              node->data,
 		              node->data_size,
 		              error );
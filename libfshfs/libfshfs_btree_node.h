@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libfshfs_btree_node_descriptor.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_io_handle.h"
 #include "libfshfs_libbfio.h"
 #include "libfshfs_libcdata.h"
@@ -66,6 +67,10 @@ struct libfshfs_btree_node
 	 */
 	size_t data_size;
 
+	/* The buffer pool the data was retrieved from
+	 */
+	libfshfs_buffer_pool_t *buffer_pool;
+
 	/* The records array
 	 */
 	libcdata_array_t *records_array;
@@ -81,6 +86,7 @@ int libfshfs_btree_node_record_free(
 
 int libfshfs_btree_node_initialize(
      libfshfs_btree_node_t **node,
+     libfshfs_buffer_pool_t *buffer_pool,
      size_t data_size,
      libcerror_error_t **error );
 
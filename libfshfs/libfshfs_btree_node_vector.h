@@ -39,6 +39,7 @@ int libfshfs_btree_node_vector_initialize(
      libfshfs_io_handle_t *io_handle,
      uint16_t node_size,
      libfshfs_fork_descriptor_t *fork_descriptor,
+     int block_cache_partition,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
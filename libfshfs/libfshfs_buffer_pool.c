@@ -0,0 +1,598 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+/* Creates a buffer pool
+ * Make sure the value buffer_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_initialize(
+     libfshfs_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_buffer_pool_initialize";
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_pool = memory_allocate_structure(
+	                libfshfs_buffer_pool_t );
+
+	if( *buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffer_pool,
+	     0,
+	     sizeof( libfshfs_buffer_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer pool.",
+		 function );
+
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *buffer_pool )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *buffer_pool != NULL )
+	{
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a buffer pool
+ * The buffers that were retained by the pool are freed as well
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_free(
+     libfshfs_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_buffer_pool_free";
+	int buffer_index      = 0;
+	int result            = 1;
+	int size_class        = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *buffer_pool )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( size_class = 0;
+		     size_class < LIBFSHFS_BUFFER_POOL_NUMBER_OF_SIZE_CLASSES;
+		     size_class++ )
+		{
+			for( buffer_index = 0;
+			     buffer_index < ( *buffer_pool )->number_of_free_buffers[ size_class ];
+			     buffer_index++ )
+			{
+				if( libfshfs_buffer_pool_free_buffer(
+				     &( ( *buffer_pool )->free_buffers[ size_class ][ buffer_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free buffer: %d of size class: %d.",
+					 function,
+					 buffer_index,
+					 size_class );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the size class of a specific buffer size
+ * Returns 1 if successful, 0 if the size exceeds the maximum buffer size or -1 on error
+ */
+int libfshfs_buffer_pool_get_size_class(
+     size_t size,
+     int *size_class,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_buffer_pool_get_size_class";
+	size_t class_size     = LIBFSHFS_BUFFER_POOL_MINIMUM_BUFFER_SIZE;
+	int safe_size_class   = 0;
+
+	if( size_class == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size class.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) LIBFSHFS_BUFFER_POOL_MAXIMUM_BUFFER_SIZE )
+	{
+		return( 0 );
+	}
+	while( class_size < size )
+	{
+		class_size     <<= 1;
+		safe_size_class += 1;
+	}
+	*size_class = safe_size_class;
+
+	return( 1 );
+}
+
+/* Allocates a buffer that is aligned to LIBFSHFS_BUFFER_POOL_ALIGNMENT
+ * The buffer is preceded by a header that is used to free the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_allocate_buffer(
+     size_t size,
+     int size_class,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	libfshfs_buffer_pool_buffer_header_t *buffer_header = NULL;
+	uint8_t *allocated_data                             = NULL;
+	static char *function                               = "libfshfs_buffer_pool_allocate_buffer";
+	size_t allocated_size                               = 0;
+	intptr_t aligned_address                            = 0;
+
+	if( ( size == 0 )
+	 || ( size > ( (size_t) SSIZE_MAX - LIBFSHFS_BUFFER_POOL_ALIGNMENT - sizeof( libfshfs_buffer_pool_buffer_header_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_class < -1 )
+	 || ( size_class >= LIBFSHFS_BUFFER_POOL_NUMBER_OF_SIZE_CLASSES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size class value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	allocated_size = size + LIBFSHFS_BUFFER_POOL_ALIGNMENT - 1 + sizeof( libfshfs_buffer_pool_buffer_header_t );
+
+	allocated_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * allocated_size );
+
+	if( allocated_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	aligned_address  = (intptr_t) allocated_data + sizeof( libfshfs_buffer_pool_buffer_header_t ) + LIBFSHFS_BUFFER_POOL_ALIGNMENT - 1;
+	aligned_address &= ~( (intptr_t) LIBFSHFS_BUFFER_POOL_ALIGNMENT - 1 );
+
+	buffer_header = (libfshfs_buffer_pool_buffer_header_t *) ( aligned_address - sizeof( libfshfs_buffer_pool_buffer_header_t ) );
+
+	buffer_header->allocated_data = allocated_data;
+	buffer_header->size_class     = size_class;
+
+	*buffer = (uint8_t *) aligned_address;
+
+	return( 1 );
+}
+
+/* Frees a buffer that was allocated with libfshfs_buffer_pool_allocate_buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_free_buffer(
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	libfshfs_buffer_pool_buffer_header_t *buffer_header = NULL;
+	static char *function                               = "libfshfs_buffer_pool_free_buffer";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer != NULL )
+	{
+		buffer_header = (libfshfs_buffer_pool_buffer_header_t *) ( *buffer - sizeof( libfshfs_buffer_pool_buffer_header_t ) );
+
+		memory_free(
+		 buffer_header->allocated_data );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves a buffer of at least a specific size
+ * The buffer is aligned to LIBFSHFS_BUFFER_POOL_ALIGNMENT and its data is not initialized
+ * A retained buffer of the size class is reused if available
+ * If buffer_pool is NULL a buffer is allocated that is not retained
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_get_buffer(
+     libfshfs_buffer_pool_t *buffer_pool,
+     size_t size,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_buffer  = NULL;
+	static char *function = "libfshfs_buffer_pool_get_buffer";
+	int result            = 0;
+	int size_class        = -1;
+
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool != NULL )
+	{
+		result = libfshfs_buffer_pool_get_size_class(
+		          size,
+		          &size_class,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size class.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			size_class = -1;
+		}
+	}
+	if( size_class != -1 )
+	{
+		size = (size_t) LIBFSHFS_BUFFER_POOL_MINIMUM_BUFFER_SIZE << size_class;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     buffer_pool->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( buffer_pool->number_of_free_buffers[ size_class ] > 0 )
+		{
+			buffer_pool->number_of_free_buffers[ size_class ] -= 1;
+
+			safe_buffer = buffer_pool->free_buffers[ size_class ][ buffer_pool->number_of_free_buffers[ size_class ] ];
+
+			buffer_pool->free_buffers[ size_class ][ buffer_pool->number_of_free_buffers[ size_class ] ] = NULL;
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     buffer_pool->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+	}
+	if( safe_buffer == NULL )
+	{
+		if( libfshfs_buffer_pool_allocate_buffer(
+		     size,
+		     size_class,
+		     &safe_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*buffer = safe_buffer;
+
+	return( 1 );
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+on_error:
+	if( safe_buffer != NULL )
+	{
+		libfshfs_buffer_pool_free_buffer(
+		 &safe_buffer,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Releases a buffer that was retrieved with libfshfs_buffer_pool_get_buffer
+ * The buffer is retained for reuse if its size class has room, otherwise it is freed
+ * If buffer_pool is NULL the buffer is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_buffer_pool_release_buffer(
+     libfshfs_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	libfshfs_buffer_pool_buffer_header_t *buffer_header = NULL;
+	static char *function                               = "libfshfs_buffer_pool_release_buffer";
+	size_t free_size                                    = 0;
+	int maximum_number_of_free_buffers                  = 0;
+	int size_class                                      = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	buffer_header = (libfshfs_buffer_pool_buffer_header_t *) ( *buffer - sizeof( libfshfs_buffer_pool_buffer_header_t ) );
+
+	size_class = buffer_header->size_class;
+
+	if( ( buffer_pool != NULL )
+	 && ( size_class != -1 ) )
+	{
+		/* The retained size of every size class is bounded, where at least 1 buffer is retained
+		 */
+		free_size = (size_t) LIBFSHFS_BUFFER_POOL_MINIMUM_BUFFER_SIZE << size_class;
+
+		maximum_number_of_free_buffers = (int) ( LIBFSHFS_BUFFER_POOL_MAXIMUM_FREE_SIZE / free_size );
+
+		if( maximum_number_of_free_buffers < 1 )
+		{
+			maximum_number_of_free_buffers = 1;
+		}
+		else if( maximum_number_of_free_buffers > LIBFSHFS_BUFFER_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS )
+		{
+			maximum_number_of_free_buffers = LIBFSHFS_BUFFER_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS;
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     buffer_pool->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( buffer_pool->number_of_free_buffers[ size_class ] < maximum_number_of_free_buffers )
+		{
+			buffer_pool->free_buffers[ size_class ][ buffer_pool->number_of_free_buffers[ size_class ] ] = *buffer;
+
+			buffer_pool->number_of_free_buffers[ size_class ] += 1;
+
+			*buffer = NULL;
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     buffer_pool->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( *buffer == NULL )
+		{
+			return( 1 );
+		}
+	}
+	if( libfshfs_buffer_pool_free_buffer(
+	     buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
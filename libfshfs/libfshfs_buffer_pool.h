@@ -0,0 +1,107 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_BUFFER_POOL_H )
+#define _LIBFSHFS_BUFFER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_buffer_pool_buffer_header libfshfs_buffer_pool_buffer_header_t;
+
+struct libfshfs_buffer_pool_buffer_header
+{
+	/* The allocated data, which contains the header and the aligned buffer
+	 */
+	uint8_t *allocated_data;
+
+	/* The size class, where -1 represents a buffer that is not retained
+	 */
+	int size_class;
+};
+
+typedef struct libfshfs_buffer_pool libfshfs_buffer_pool_t;
+
+struct libfshfs_buffer_pool
+{
+	/* The free buffers of the size classes
+	 */
+	uint8_t *free_buffers[ LIBFSHFS_BUFFER_POOL_NUMBER_OF_SIZE_CLASSES ][ LIBFSHFS_BUFFER_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS ];
+
+	/* The number of free buffers of the size classes
+	 */
+	int number_of_free_buffers[ LIBFSHFS_BUFFER_POOL_NUMBER_OF_SIZE_CLASSES ];
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfshfs_buffer_pool_initialize(
+     libfshfs_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_free(
+     libfshfs_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_get_size_class(
+     size_t size,
+     int *size_class,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_allocate_buffer(
+     size_t size,
+     int size_class,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_free_buffer(
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_get_buffer(
+     libfshfs_buffer_pool_t *buffer_pool,
+     size_t size,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libfshfs_buffer_pool_release_buffer(
+     libfshfs_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_BUFFER_POOL_H ) */
+
@@ -29,6 +29,7 @@
 
 #include "libfshfs_catalog_btree_file.h"
 #include "libfshfs_catalog_btree_key.h"
+#include "libfshfs_definitions.h"
 #include "libfshfs_directory_entry.h"
 #include "libfshfs_directory_record.h"
 #include "libfshfs_file_record.h"
@@ -37,6 +38,7 @@
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcnotify.h"
 #include "libfshfs_libuna.h"
+#include "libfshfs_memory_arena.h"
 #include "libfshfs_thread_record.h"
 
 #include "fshfs_catalog_file.h"
@@ -873,6 +875,7 @@ int libfshfs_catalog_btree_file_get_directory_entries(
      libfshfs_btree_file_t *btree_file,
      libbfio_handle_t *file_io_handle,
      uint32_t parent_identifier,
+     libfshfs_memory_arena_t *memory_arena,
      libcdata_array_t *directory_entries,
      libcerror_error_t **error )
 {
@@ -899,6 +902,7 @@ int libfshfs_catalog_btree_file_get_directory_entries(
 	     file_io_handle,
 	     root_node,
 	     parent_identifier,
+	     memory_arena,
 	     directory_entries,
 	     error ) != 1 )
 	{
@@ -922,6 +926,234 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the numbers of the sub nodes that can contain records of a specific parent identifier from a catalog B-tree index node
+ * Only the last sub node with keys less than the parent identifier and the sub nodes with keys
+ * of the parent identifier can contain records of the parent identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_btree_file_get_sub_node_numbers_from_node(
+     libfshfs_btree_node_t *node,
+     uint32_t parent_identifier,
+     uint32_t *sub_node_numbers,
+     uint16_t maximum_number_of_sub_nodes,
+     uint16_t *number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	libfshfs_catalog_btree_key_t *node_key = NULL;
+	uint8_t *record_data                   = NULL;
+	static char *function                  = "libfshfs_catalog_btree_file_get_sub_node_numbers_from_node";
+	size_t record_data_offset              = 0;
+	size_t record_data_size                = 0;
+	uint32_t sub_node_number               = 0;
+	uint16_t number_of_records             = 0;
+	uint16_t record_index                  = 0;
+	uint16_t safe_number_of_sub_nodes      = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( node->descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree node - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( node->descriptor->type != 0x00 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported B-tree node type: 0x%02" PRIx8 ".",
+		 function,
+		 node->descriptor->type );
+
+		return( -1 );
+	}
+	if( sub_node_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node numbers.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_records = node->descriptor->number_of_records;
+
+	for( record_index = 0;
+	     record_index < number_of_records;
+	     record_index++ )
+	{
+		if( libfshfs_btree_node_get_record_data_by_index(
+		     node,
+		     record_index,
+		     &record_data,
+		     &record_data_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node record: %" PRIu16 " data.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		if( libfshfs_catalog_btree_key_initialize(
+		     &node_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_catalog_btree_key_read_data(
+		     node_key,
+		     record_data,
+		     record_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+		if( node_key->parent_identifier > parent_identifier )
+		{
+			break;
+		}
+		/* Only the last sub node with keys less than the parent identifier
+		 * can contain records of the parent identifier
+		 */
+		if( node_key->parent_identifier < parent_identifier )
+		{
+			safe_number_of_sub_nodes = 0;
+		}
+		if( safe_number_of_sub_nodes >= maximum_number_of_sub_nodes )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of sub nodes value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		record_data_offset = node_key->data_size;
+
+		if( ( record_data_size < 4 )
+		 || ( record_data_offset > ( record_data_size - 4 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( record_data[ record_data_offset ] ),
+		 sub_node_number );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: B-tree sub node number\t: %" PRIu32 "\n",
+			 function,
+			 sub_node_number );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		sub_node_numbers[ safe_number_of_sub_nodes++ ] = sub_node_number;
+
+		if( libfshfs_catalog_btree_key_free(
+		     &node_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( node_key != NULL )
+	{
+		if( libfshfs_catalog_btree_key_free(
+		     &node_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*number_of_sub_nodes = safe_number_of_sub_nodes;
+
+	return( 1 );
+
+on_error:
+	if( node_key != NULL )
+	{
+		libfshfs_catalog_btree_key_free(
+		 &node_key,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves directory entries for a specific parent identifier from the catalog B-tree node
  * Returns 1 if successful or -1 on error
  */
@@ -930,13 +1162,14 @@ int libfshfs_catalog_btree_file_get_directory_entries_from_node(
      libbfio_handle_t *file_io_handle,
      libfshfs_btree_node_t *node,
      uint32_t parent_identifier,
+     libfshfs_memory_arena_t *memory_arena,
      libcdata_array_t *directory_entries,
      libcerror_error_t **error )
 {
 /* TODO improve handling of sub_node_numbers */
+	libfshfs_btree_node_t *sub_nodes[ 64 ];
 	uint32_t sub_node_numbers[ 64 ];
 
-	libfshfs_btree_node_t *sub_node               = NULL;
 	libfshfs_catalog_btree_key_t *node_key        = NULL;
 	libfshfs_directory_entry_t *directory_entry   = NULL;
 	libfshfs_directory_record_t *directory_record = NULL;
@@ -946,7 +1179,7 @@ int libfshfs_catalog_btree_file_get_directory_entries_from_node(
 	static char *function                         = "libfshfs_catalog_btree_file_get_directory_entries_from_node";
 	size_t record_data_offset                     = 0;
 	size_t record_data_size                       = 0;
-	uint32_t sub_node_number                      = 0;
+	uint16_t number_of_read_sub_nodes             = 0;
 	uint16_t number_of_records                    = 0;
 	uint16_t number_of_sub_nodes                  = 0;
 	uint16_t record_index                         = 0;
@@ -990,6 +1223,97 @@ int libfshfs_catalog_btree_file_get_directory_entries_from_node(
 	number_of_records = node->descriptor->number_of_records;
 	node_type         = node->descriptor->type;
 
+	if( node_type == 0x00 )
+	{
+		if( libfshfs_catalog_btree_file_get_sub_node_numbers_from_node(
+		     node,
+		     parent_identifier,
+		     sub_node_numbers,
+		     64,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree sub node numbers.",
+			 function );
+
+			goto on_error;
+		}
+		/* Read the sub nodes after retrieving the sub node numbers
+		 * to prevent the node being cached out
+		 */
+		if( number_of_sub_nodes > 0 )
+		{
+			/* The reads of the sub nodes are coalesced since sub nodes are commonly stored adjacent
+			 */
+			if( libfshfs_btree_file_read_nodes_by_number(
+			     btree_file,
+			     file_io_handle,
+			     sub_node_numbers,
+			     (int) number_of_sub_nodes,
+			     sub_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read B-tree sub nodes.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_read_sub_nodes = number_of_sub_nodes;
+
+			for( record_index = 0;
+			     record_index < number_of_sub_nodes;
+			     record_index++ )
+			{
+				if( libfshfs_catalog_btree_file_get_directory_entries_from_node(
+				     btree_file,
+				     file_io_handle,
+				     sub_nodes[ record_index ],
+				     parent_identifier,
+				     memory_arena,
+				     directory_entries,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve directory entries from catalog B-tree node: %" PRIu32 ".",
+					 function,
+					 sub_node_numbers[ record_index ] );
+
+					goto on_error;
+				}
+			}
+			for( record_index = 0;
+			     record_index < number_of_sub_nodes;
+			     record_index++ )
+			{
+				if( libfshfs_btree_node_free(
+				     &( sub_nodes[ record_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free B-tree sub node: %" PRIu32 ".",
+					 function,
+					 sub_node_numbers[ record_index ] );
+
+					goto on_error;
+				}
+			}
+		}
+		return( 1 );
+	}
 	for( record_index = 0;
 	     record_index < number_of_records;
 	     record_index++ )
@@ -1052,150 +1376,147 @@ int libfshfs_catalog_btree_file_get_directory_entries_from_node(
 
 			goto on_error;
 		}
-		if( node_type == 0x00 )
+		if( node_type == 0xff )
 		{
-			if( node_key->parent_identifier <= parent_identifier )
+			if( node_key->parent_identifier == parent_identifier )
 			{
-				if( ( record_data_size < 4 )
-				 || ( record_data_offset >= ( record_data_size - 4 ) ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: invalid record data size value out of bounds.",
-					 function );
-
-					goto on_error;
-				}
-				byte_stream_copy_to_uint32_big_endian(
-				 &( record_data[ record_data_offset ] ),
-				 sub_node_number );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: B-tree sub node number\t: %" PRIu32 "\n",
-					 function,
-					 sub_node_number );
-
-					libcnotify_printf(
-					 "\n" );
-				}
-#endif
-				record_data_offset += 4;
-
-				sub_node_numbers[ number_of_sub_nodes++ ] = sub_node_number;
-			}
-		}
-		else if( node_type == 0xff )
-		{
-			if( node_key->parent_identifier == parent_identifier )
-			{
-				byte_stream_copy_to_uint16_big_endian(
+				byte_stream_copy_to_uint16_big_endian(
 				 &( record_data[ record_data_offset ] ),
 				 record_type );
 
-				switch( record_type )
+				if( memory_arena != NULL )
 				{
-					case 0x0001:
-					case 0x0100:
-						if( libfshfs_directory_record_initialize(
-						     &directory_record,
+					if( ( record_type == 0x0001 )
+					 || ( record_type == 0x0002 )
+					 || ( record_type == 0x0100 )
+					 || ( record_type == 0x0200 ) )
+					{
+						if( libfshfs_directory_entry_initialize_in_memory_arena(
+						     &directory_entry,
+						     memory_arena,
+						     node_key->parent_identifier,
+						     node_key->name,
+						     node_key->name_size,
+						     record_type,
+						     &( record_data[ record_data_offset ] ),
+						     record_data_size - record_data_offset,
 						     error ) != 1 )
 						{
 							libcerror_error_set(
 							 error,
 							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-							 "%s: unable to create directory record.",
+							 "%s: unable to create directory entry.",
 							 function );
 
 							goto on_error;
 						}
-						if( libfshfs_directory_record_read_data(
-						     directory_record,
-						     &( record_data[ record_data_offset ] ),
-						     record_data_size,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_IO,
-							 LIBCERROR_IO_ERROR_READ_FAILED,
-							 "%s: unable to read directory record.",
-							 function );
-
-							goto on_error;
-						}
-						catalog_record = (intptr_t *) directory_record;
-
-						break;
-
-					case 0x0002:
-					case 0x0200:
-						if( libfshfs_file_record_initialize(
-						     &file_record,
+					}
+				}
+				else
+				{
+					switch( record_type )
+					{
+						case 0x0001:
+						case 0x0100:
+							if( libfshfs_directory_record_initialize(
+							     &directory_record,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+								 "%s: unable to create directory record.",
+								 function );
+
+								goto on_error;
+							}
+							if( libfshfs_directory_record_read_data(
+							     directory_record,
+							     &( record_data[ record_data_offset ] ),
+							     record_data_size,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_IO,
+								 LIBCERROR_IO_ERROR_READ_FAILED,
+								 "%s: unable to read directory record.",
+								 function );
+
+								goto on_error;
+							}
+							catalog_record = (intptr_t *) directory_record;
+
+							break;
+
+						case 0x0002:
+						case 0x0200:
+							if( libfshfs_file_record_initialize(
+							     &file_record,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+								 "%s: unable to create file record.",
+								 function );
+
+								goto on_error;
+							}
+							if( libfshfs_file_record_read_data(
+							     file_record,
+							     &( record_data[ record_data_offset ] ),
+							     record_data_size,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_IO,
+								 LIBCERROR_IO_ERROR_READ_FAILED,
+								 "%s: unable to read file record.",
+								 function );
+
+								goto on_error;
+							}
+							catalog_record = (intptr_t *) file_record;
+
+							break;
+
+						default:
+							break;
+					}
+					if( catalog_record != NULL )
+					{
+						if( libfshfs_directory_entry_initialize(
+						     &directory_entry,
 						     error ) != 1 )
 						{
 							libcerror_error_set(
 							 error,
 							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 							 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-							 "%s: unable to create file record.",
-							 function );
-
-							goto on_error;
-						}
-						if( libfshfs_file_record_read_data(
-						     file_record,
-						     &( record_data[ record_data_offset ] ),
-						     record_data_size,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_IO,
-							 LIBCERROR_IO_ERROR_READ_FAILED,
-							 "%s: unable to read file record.",
+							 "%s: unable to create directory entry.",
 							 function );
 
 							goto on_error;
 						}
-						catalog_record = (intptr_t *) file_record;
-
-						break;
-
-					default:
-						break;
+						directory_entry->record_type       = record_type;
+						directory_entry->name              = node_key->name;
+						directory_entry->name_size         = node_key->name_size;
+						directory_entry->parent_identifier = node_key->parent_identifier;
+						directory_entry->catalog_record    = catalog_record;
+
+						node_key->name      = NULL;
+						node_key->name_size = 0;
+						directory_record    = NULL;
+						file_record         = NULL;
+					}
 				}
-				if( catalog_record != NULL )
+				if( directory_entry != NULL )
 				{
-					if( libfshfs_directory_entry_initialize(
-					     &directory_entry,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-						 "%s: unable to create directory entry.",
-						 function );
-
-						goto on_error;
-					}
-					directory_entry->record_type       = record_type;
-					directory_entry->name              = node_key->name;
-					directory_entry->name_size         = node_key->name_size;
-					directory_entry->parent_identifier = node_key->parent_identifier;
-					directory_entry->catalog_record    = catalog_record;
-
-					node_key->name      = NULL;
-					node_key->name_size = 0;
-					directory_record    = NULL;
-					file_record         = NULL;
-
 					if( libcdata_array_append_entry(
 					     directory_entries,
 					     &entry_index,
@@ -1229,57 +1550,20 @@ int libfshfs_catalog_btree_file_get_directory_entries_from_node(
 			goto on_error;
 		}
 	}
-	/* Read the sub nodes after reading the data of the record
-	 * to prevent the node being cached out
-	 */
-	if( node_type == 0x00 )
+	return( 1 );
+
+on_error:
+	for( record_index = 0;
+	     record_index < number_of_read_sub_nodes;
+	     record_index++ )
 	{
-		for( record_index = 0;
-		     record_index < number_of_sub_nodes;
-		     record_index++ )
+		if( sub_nodes[ record_index ] != NULL )
 		{
-			sub_node_number = sub_node_numbers[ record_index ];
-
-			if( libfshfs_btree_file_get_node_by_number(
-			     btree_file,
-			     file_io_handle,
-			     sub_node_number,
-			     &sub_node,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve B-tree sub node: %" PRIu32 ".",
-				 function,
-				 sub_node_number );
-
-				goto on_error;
-			}
-			if( libfshfs_catalog_btree_file_get_directory_entries_from_node(
-			     btree_file,
-			     file_io_handle,
-			     sub_node,
-			     parent_identifier,
-			     directory_entries,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve directory entries from catalog B-tree node: %" PRIu32 ".",
-				 function,
-				 sub_node_number );
-
-				goto on_error;
-			}
+			libfshfs_btree_node_free(
+			 &( sub_nodes[ record_index ] ),
+			 NULL );
 		}
 	}
-	return( 1 );
-
-on_error:
 	if( directory_entry != NULL )
 	{
 		libfshfs_directory_entry_free(
@@ -1307,3 +1591,1225 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the directory entry of a specific record in a catalog B-tree leaf node
+ * Returns 1 if successful, 0 if the record is not a directory or file record or -1 on error
+ */
+int libfshfs_catalog_btree_file_get_directory_entry_by_record(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t node_number,
+     uint16_t record_index,
+     libfshfs_memory_arena_t *memory_arena,
+     libfshfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node                   = NULL;
+	libfshfs_catalog_btree_key_t *node_key        = NULL;
+	libfshfs_directory_record_t *directory_record = NULL;
+	libfshfs_file_record_t *file_record           = NULL;
+	const uint8_t *record_data                    = NULL;
+	intptr_t *catalog_record                      = NULL;
+	static char *function                         = "libfshfs_catalog_btree_file_get_directory_entry_by_record";
+	size_t record_data_offset                     = 0;
+	size_t record_data_size                       = 0;
+	uint16_t record_type                          = 0;
+	int result                                    = 0;
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_number > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid node number value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_btree_file_get_node_by_number(
+	     btree_file,
+	     file_io_handle,
+	     (int) node_number,
+	     &node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree node: %" PRIu32 ".",
+		 function,
+		 node_number );
+
+		goto on_error;
+	}
+	if( ( node == NULL )
+	 || ( node->descriptor == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+		 function,
+		 node_number );
+
+		goto on_error;
+	}
+	if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+		 function,
+		 node_number,
+		 node->descriptor->type );
+
+		goto on_error;
+	}
+	if( libfshfs_btree_node_get_record_data_by_index(
+	     node,
+	     record_index,
+	     &record_data,
+	     &record_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+		 function,
+		 node_number,
+		 record_index );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_btree_key_initialize(
+	     &node_key,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create catalog B-tree key.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_btree_key_read_data(
+	     node_key,
+	     record_data,
+	     record_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog B-tree key.",
+		 function );
+
+		goto on_error;
+	}
+	record_data_offset = node_key->data_size;
+
+	if( ( record_data_size < 2 )
+	 || ( record_data_offset > ( record_data_size - 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record data offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( record_data[ record_data_offset ] ),
+	 record_type );
+
+	if( memory_arena != NULL )
+	{
+		if( ( record_type == 0x0001 )
+		 || ( record_type == 0x0002 )
+		 || ( record_type == 0x0100 )
+		 || ( record_type == 0x0200 ) )
+		{
+			if( libfshfs_directory_entry_initialize_in_memory_arena(
+			     directory_entry,
+			     memory_arena,
+			     node_key->parent_identifier,
+			     node_key->name,
+			     node_key->name_size,
+			     record_type,
+			     &( record_data[ record_data_offset ] ),
+			     record_data_size - record_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create directory entry.",
+				 function );
+
+				goto on_error;
+			}
+			result = 1;
+		}
+	}
+	else
+	{
+		switch( record_type )
+		{
+			case 0x0001:
+			case 0x0100:
+				if( libfshfs_directory_record_initialize(
+				     &directory_record,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create directory record.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfshfs_directory_record_read_data(
+				     directory_record,
+				     &( record_data[ record_data_offset ] ),
+				     record_data_size - record_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read directory record.",
+					 function );
+
+					goto on_error;
+				}
+				catalog_record = (intptr_t *) directory_record;
+
+				break;
+
+			case 0x0002:
+			case 0x0200:
+				if( libfshfs_file_record_initialize(
+				     &file_record,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create file record.",
+					 function );
+
+					goto on_error;
+				}
+				if( libfshfs_file_record_read_data(
+				     file_record,
+				     &( record_data[ record_data_offset ] ),
+				     record_data_size - record_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read file record.",
+					 function );
+
+					goto on_error;
+				}
+				catalog_record = (intptr_t *) file_record;
+
+				break;
+
+			default:
+				break;
+		}
+		if( catalog_record != NULL )
+		{
+			if( libfshfs_directory_entry_initialize(
+			     directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create directory entry.",
+				 function );
+
+				goto on_error;
+			}
+			( *directory_entry )->record_type       = record_type;
+			( *directory_entry )->name              = node_key->name;
+			( *directory_entry )->name_size         = node_key->name_size;
+			( *directory_entry )->parent_identifier = node_key->parent_identifier;
+			( *directory_entry )->catalog_record    = catalog_record;
+
+			node_key->name      = NULL;
+			node_key->name_size = 0;
+			directory_record    = NULL;
+			file_record         = NULL;
+
+			result = 1;
+		}
+	}
+	if( libfshfs_catalog_btree_key_free(
+	     &node_key,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free catalog B-tree key.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( *directory_entry != NULL )
+	{
+		libfshfs_directory_entry_free(
+		 directory_entry,
+		 NULL );
+	}
+	if( file_record != NULL )
+	{
+		libfshfs_file_record_free(
+		 &file_record,
+		 NULL );
+	}
+	if( directory_record != NULL )
+	{
+		libfshfs_directory_record_free(
+		 &directory_record,
+		 NULL );
+	}
+	if( node_key != NULL )
+	{
+		libfshfs_catalog_btree_key_free(
+		 &node_key,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves directory entries for a specific parent identifier from a range of catalog B-tree leaf records
+ * The range starts at a specific record in a leaf node and can continue in the next leaf nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_btree_file_get_directory_entries_from_record(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint32_t number_of_records,
+     libfshfs_memory_arena_t *memory_arena,
+     libcdata_array_t *directory_entries,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node                 = NULL;
+	libfshfs_directory_entry_t *directory_entry = NULL;
+	static char *function                       = "libfshfs_catalog_btree_file_get_directory_entries_from_record";
+	uint32_t next_node_number                   = 0;
+	uint16_t number_of_node_records             = 0;
+	int entry_index                             = 0;
+	int result                                  = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	while( number_of_records > 0 )
+	{
+		if( ( node_number == 0 )
+		 || ( node_number > (uint32_t) INT_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node number value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %" PRIu32 ".",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		/* Retrieve the values of the descriptor before reading the records
+		 * to prevent the node being cached out
+		 */
+		number_of_node_records = node->descriptor->number_of_records;
+		next_node_number       = node->descriptor->next_node_number;
+
+		if( record_index >= number_of_node_records )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( record_index < number_of_node_records )
+		    && ( number_of_records > 0 ) )
+		{
+			result = libfshfs_catalog_btree_file_get_directory_entry_by_record(
+			          btree_file,
+			          file_io_handle,
+			          node_number,
+			          record_index,
+			          memory_arena,
+			          &directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from catalog B-tree node: %" PRIu32 " record: %" PRIu16 ".",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( directory_entry->parent_identifier != parent_identifier )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid directory entry - parent identifier value out of bounds.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcdata_array_append_entry(
+				     directory_entries,
+				     &entry_index,
+				     (intptr_t *) directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append directory entry to array.",
+					 function );
+
+					goto on_error;
+				}
+				directory_entry = NULL;
+			}
+			record_index++;
+			number_of_records--;
+		}
+		node_number  = next_node_number;
+		record_index = 0;
+	}
+	return( 1 );
+
+on_error:
+	if( directory_entry != NULL )
+	{
+		libfshfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 directory_entries,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
+	 NULL );
+
+	return( -1 );
+}
+
+
+/* Retrieves the position of the first catalog B-tree leaf record of a specific parent identifier
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int libfshfs_catalog_btree_file_get_first_record_by_parent_identifier(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node            = NULL;
+	libfshfs_catalog_btree_key_t *node_key = NULL;
+	const uint8_t *record_data             = NULL;
+	static char *function                  = "libfshfs_catalog_btree_file_get_first_record_by_parent_identifier";
+	size_t record_data_offset              = 0;
+	size_t record_data_size                = 0;
+	uint32_t key_parent_identifier         = 0;
+	uint32_t next_node_number              = 0;
+	uint32_t safe_node_number              = 0;
+	uint32_t sub_node_number               = 0;
+	uint16_t number_of_node_records        = 0;
+	uint16_t safe_record_index             = 0;
+	uint8_t node_type                      = 0;
+	int depth                              = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node number.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record index.",
+		 function );
+
+		return( -1 );
+	}
+	safe_node_number = btree_file->header->root_node_number;
+
+	/* Descend the index nodes to the leaf node that contains the first record
+	 * with a key equal to or greater than the key ( parent identifier, "" )
+	 */
+	while( safe_node_number != 0 )
+	{
+		if( ( safe_node_number > (uint32_t) INT_MAX )
+		 || ( depth >= LIBFSHFS_MAXIMUM_BTREE_DEPTH ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node number value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) safe_node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %" PRIu32 ".",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		node_type = node->descriptor->type;
+
+		if( node_type == LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			break;
+		}
+		if( node_type != LIBFSHFS_BTREE_NODE_TYPE_INDEX_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 safe_node_number,
+			 node_type );
+
+			goto on_error;
+		}
+		number_of_node_records = node->descriptor->number_of_records;
+		sub_node_number        = 0;
+
+		for( safe_record_index = 0;
+		     safe_record_index < number_of_node_records;
+		     safe_record_index++ )
+		{
+			if( libfshfs_btree_node_get_record_data_by_index(
+			     node,
+			     safe_record_index,
+			     &record_data,
+			     &record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+				 function,
+				 safe_node_number,
+				 safe_record_index );
+
+				goto on_error;
+			}
+			if( libfshfs_catalog_btree_key_initialize(
+			     &node_key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfshfs_catalog_btree_key_read_data(
+			     node_key,
+			     record_data,
+			     record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+			/* The first index record is used when all keys are greater than the key searched for
+			 */
+			if( ( safe_record_index > 0 )
+			 && ( ( node_key->parent_identifier > parent_identifier )
+			  || ( ( node_key->parent_identifier == parent_identifier )
+			   &&  ( node_key->name_size > 0 ) ) ) )
+			{
+				break;
+			}
+			record_data_offset = node_key->data_size;
+
+			if( ( record_data_size < 4 )
+			 || ( record_data_offset > ( record_data_size - 4 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 sub_node_number );
+
+			if( libfshfs_catalog_btree_key_free(
+			     &node_key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( node_key != NULL )
+		{
+			if( libfshfs_catalog_btree_key_free(
+			     &node_key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		safe_node_number = sub_node_number;
+
+		depth++;
+	}
+	/* Scan the leaf nodes for the first record of the parent identifier
+	 */
+	while( safe_node_number != 0 )
+	{
+		if( safe_node_number > (uint32_t) INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node number value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) safe_node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %" PRIu32 ".",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 safe_node_number,
+			 node->descriptor->type );
+
+			goto on_error;
+		}
+		number_of_node_records = node->descriptor->number_of_records;
+		next_node_number       = node->descriptor->next_node_number;
+
+		for( safe_record_index = 0;
+		     safe_record_index < number_of_node_records;
+		     safe_record_index++ )
+		{
+			if( libfshfs_btree_node_get_record_data_by_index(
+			     node,
+			     safe_record_index,
+			     &record_data,
+			     &record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+				 function,
+				 safe_node_number,
+				 safe_record_index );
+
+				goto on_error;
+			}
+			/* Only the parent identifier of the key is needed, hence the key is not read
+			 */
+			if( record_data_size < sizeof( fshfs_catalog_index_key_hfsplus_t ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 ( (fshfs_catalog_index_key_hfsplus_t *) record_data )->parent_identifier,
+			 key_parent_identifier );
+
+			if( key_parent_identifier == parent_identifier )
+			{
+				*node_number  = safe_node_number;
+				*record_index = safe_record_index;
+
+				return( 1 );
+			}
+			else if( key_parent_identifier > parent_identifier )
+			{
+				return( 0 );
+			}
+		}
+		safe_node_number = next_node_number;
+	}
+	return( 0 );
+
+on_error:
+	if( node_key != NULL )
+	{
+		libfshfs_catalog_btree_key_free(
+		 &node_key,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a page of directory entries for a specific parent identifier from the catalog B-tree leaf records
+ * The page starts at a specific record in a leaf node and can continue in the next leaf nodes
+ * If a last name is provided the record at the start position must contain the last directory entry
+ * of the previous page, this record is not retrieved again
+ * On return the node number and record index contain the position of the last directory entry retrieved
+ * Returns 1 if successful, 0 if the record at the start position does not match the last name or -1 on error
+ */
+int libfshfs_catalog_btree_file_get_directory_entries_page(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     const uint8_t *last_name,
+     uint16_t last_name_size,
+     int maximum_number_of_directory_entries,
+     libcdata_array_t *directory_entries,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node                 = NULL;
+	libfshfs_catalog_btree_key_t *node_key      = NULL;
+	libfshfs_directory_entry_t *directory_entry = NULL;
+	const uint8_t *record_data                  = NULL;
+	static char *function                       = "libfshfs_catalog_btree_file_get_directory_entries_page";
+	size_t record_data_size                     = 0;
+	uint32_t last_node_number                   = 0;
+	uint32_t safe_node_number                   = 0;
+	uint16_t last_record_index                  = 0;
+	uint16_t safe_record_index                  = 0;
+	uint8_t match_last_name                     = 0;
+	int entry_index                             = 0;
+	int number_of_directory_entries             = 0;
+	int result                                  = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node number.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record index.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_directory_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of directory entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	safe_node_number  = *node_number;
+	safe_record_index = *record_index;
+	last_node_number  = *node_number;
+	last_record_index = *record_index;
+
+	if( last_name != NULL )
+	{
+		match_last_name = 1;
+	}
+	while( ( safe_node_number != 0 )
+	    && ( number_of_directory_entries < maximum_number_of_directory_entries ) )
+	{
+		if( safe_node_number > (uint32_t) INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid node number value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		/* The node is retrieved for every record since retrieving the directory entry
+		 * can cause the node to be cached out
+		 */
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) safe_node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree node: %" PRIu32 ".",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 safe_node_number );
+
+			goto on_error;
+		}
+		if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 safe_node_number,
+			 node->descriptor->type );
+
+			goto on_error;
+		}
+		if( safe_record_index >= node->descriptor->number_of_records )
+		{
+			safe_node_number  = node->descriptor->next_node_number;
+			safe_record_index = 0;
+
+			continue;
+		}
+		if( libfshfs_btree_node_get_record_data_by_index(
+		     node,
+		     safe_record_index,
+		     &record_data,
+		     &record_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+			 function,
+			 safe_node_number,
+			 safe_record_index );
+
+			goto on_error;
+		}
+		if( libfshfs_catalog_btree_key_initialize(
+		     &node_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_catalog_btree_key_read_data(
+		     node_key,
+		     record_data,
+		     record_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+		if( node_key->parent_identifier != parent_identifier )
+		{
+			result = 1;
+		}
+		else if( match_last_name != 0 )
+		{
+			/* The names are compared as stored since the last name was copied from the same key
+			 */
+			if( ( node_key->name_size != last_name_size )
+			 || ( ( last_name_size > 0 )
+			  &&  ( memory_compare(
+			         node_key->name,
+			         last_name,
+			         (size_t) last_name_size ) != 0 ) ) )
+			{
+				result = 1;
+			}
+			else
+			{
+				result = 0;
+			}
+		}
+		else
+		{
+			result = 0;
+		}
+		if( libfshfs_catalog_btree_key_free(
+		     &node_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog B-tree key.",
+			 function );
+
+			goto on_error;
+		}
+		if( result != 0 )
+		{
+			/* The start record does not contain the last name or the records of the parent have ended
+			 */
+			if( match_last_name != 0 )
+			{
+				return( 0 );
+			}
+			break;
+		}
+		if( match_last_name != 0 )
+		{
+			match_last_name = 0;
+		}
+		else
+		{
+			result = libfshfs_catalog_btree_file_get_directory_entry_by_record(
+			          btree_file,
+			          file_io_handle,
+			          safe_node_number,
+			          safe_record_index,
+			          NULL,
+			          &directory_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry from catalog B-tree node: %" PRIu32 " record: %" PRIu16 ".",
+				 function,
+				 safe_node_number,
+				 safe_record_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libcdata_array_append_entry(
+				     directory_entries,
+				     &entry_index,
+				     (intptr_t *) directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append directory entry to array.",
+					 function );
+
+					goto on_error;
+				}
+				directory_entry = NULL;
+
+				last_node_number  = safe_node_number;
+				last_record_index = safe_record_index;
+
+				number_of_directory_entries++;
+			}
+		}
+		safe_record_index++;
+	}
+	*node_number  = last_node_number;
+	*record_index = last_record_index;
+
+	return( 1 );
+
+on_error:
+	if( directory_entry != NULL )
+	{
+		libfshfs_directory_entry_free(
+		 &directory_entry,
+		 NULL );
+	}
+	if( node_key != NULL )
+	{
+		libfshfs_catalog_btree_key_free(
+		 &node_key,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 directory_entries,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
+	 NULL );
+
+	return( -1 );
+}
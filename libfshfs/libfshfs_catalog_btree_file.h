@@ -30,6 +30,7 @@
 #include "libfshfs_libbfio.h"
 #include "libfshfs_libcdata.h"
 #include "libfshfs_libcerror.h"
+#include "libfshfs_memory_arena.h"
 #include "libfshfs_thread_record.h"
 
 #if defined( __cplusplus )
@@ -70,14 +71,64 @@ int libfshfs_catalog_btree_file_get_directory_entries(
      libfshfs_btree_file_t *btree_file,
      libbfio_handle_t *file_io_handle,
      uint32_t parent_identifier,
+     libfshfs_memory_arena_t *memory_arena,
      libcdata_array_t *directory_entries,
      libcerror_error_t **error );
 
+int libfshfs_catalog_btree_file_get_sub_node_numbers_from_node(
+     libfshfs_btree_node_t *node,
+     uint32_t parent_identifier,
+     uint32_t *sub_node_numbers,
+     uint16_t maximum_number_of_sub_nodes,
+     uint16_t *number_of_sub_nodes,
+     libcerror_error_t **error );
+
 int libfshfs_catalog_btree_file_get_directory_entries_from_node(
      libfshfs_btree_file_t *btree_file,
      libbfio_handle_t *file_io_handle,
      libfshfs_btree_node_t *node,
      uint32_t parent_identifier,
+     libfshfs_memory_arena_t *memory_arena,
+     libcdata_array_t *directory_entries,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_btree_file_get_directory_entry_by_record(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t node_number,
+     uint16_t record_index,
+     libfshfs_memory_arena_t *memory_arena,
+     libfshfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_btree_file_get_directory_entries_from_record(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint32_t number_of_records,
+     libfshfs_memory_arena_t *memory_arena,
+     libcdata_array_t *directory_entries,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_btree_file_get_first_record_by_parent_identifier(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_btree_file_get_directory_entries_page(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     const uint8_t *last_name,
+     uint16_t last_name_size,
+     int maximum_number_of_directory_entries,
      libcdata_array_t *directory_entries,
      libcerror_error_t **error );
 
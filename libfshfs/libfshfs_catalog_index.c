@@ -0,0 +1,2085 @@
+/*
+ * Catalog index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_catalog_btree_key.h"
+#include "libfshfs_catalog_index.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
+#include "libfshfs_volume_header.h"
+
+#include "fshfs_catalog_file.h"
+#include "fshfs_catalog_index.h"
+
+#define LIBFSHFS_CATALOG_INDEX_FORMAT_VERSION	3
+
+const uint8_t fshfs_catalog_index_signature[ 8 ] = { 'f', 's', 'h', 'f', 's', 'c', 'i', 'x' };
+
+/* Creates a catalog index
+ * Make sure the value catalog_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_initialize(
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_initialize";
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *catalog_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid catalog index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*catalog_index = memory_allocate_structure(
+	                  libfshfs_catalog_index_t );
+
+	if( *catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create catalog index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *catalog_index,
+	     0,
+	     sizeof( libfshfs_catalog_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear catalog index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *catalog_index != NULL )
+	{
+		memory_free(
+		 *catalog_index );
+
+		*catalog_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a catalog index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_free(
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_free";
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *catalog_index != NULL )
+	{
+		if( ( *catalog_index )->data != NULL )
+		{
+			memory_free(
+			 ( *catalog_index )->data );
+		}
+		memory_free(
+		 *catalog_index );
+
+		*catalog_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares the identifiers of 2 catalog index entries
+ * This function is used to sort the entries table with qsort
+ * Returns -1 if the first identifier is less, 0 if equal or 1 if greater
+ */
+int libfshfs_catalog_index_compare_entry_data(
+     const void *first_entry_data,
+     const void *second_entry_data )
+{
+	uint32_t first_identifier  = 0;
+	uint32_t second_identifier = 0;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_entry_t *) first_entry_data )->identifier,
+	 first_identifier );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_entry_t *) second_entry_data )->identifier,
+	 second_identifier );
+
+	if( first_identifier < second_identifier )
+	{
+		return( -1 );
+	}
+	else if( first_identifier > second_identifier )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the catalog index file header
+ * This function also determines the size of the catalog index data
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_read_file_header_data(
+     libfshfs_catalog_index_t *catalog_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "libfshfs_catalog_index_read_file_header_data";
+	uint64_t index_size     = 0;
+	uint32_t format_version = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( fshfs_catalog_index_file_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: catalog index file header data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( fshfs_catalog_index_file_header_t ),
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     ( (fshfs_catalog_index_file_header_t *) data )->signature,
+	     fshfs_catalog_index_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->format_version,
+	 format_version );
+
+	if( format_version != LIBFSHFS_CATALOG_INDEX_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->volume_modification_time,
+	 catalog_index->volume_modification_time );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->volume_write_count,
+	 catalog_index->volume_write_count );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->number_of_entries,
+	 catalog_index->number_of_entries );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->catalog_file_size,
+	 catalog_index->catalog_file_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->number_of_parent_entries,
+	 catalog_index->number_of_parent_entries );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->names_data_size,
+	 catalog_index->names_data_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: signature\t\t\t: %c%c%c%c%c%c%c%c\n",
+		 function,
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 0 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 1 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 2 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 3 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 4 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 5 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 6 ],
+		 ( (fshfs_catalog_index_file_header_t *) data )->signature[ 7 ] );
+
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: volume modification time\t\t: %" PRIu32 "\n",
+		 function,
+		 catalog_index->volume_modification_time );
+
+		libcnotify_printf(
+		 "%s: volume write count\t\t: %" PRIu32 "\n",
+		 function,
+		 catalog_index->volume_write_count );
+
+		libcnotify_printf(
+		 "%s: number of entries\t\t\t: %" PRIu32 "\n",
+		 function,
+		 catalog_index->number_of_entries );
+
+		libcnotify_printf(
+		 "%s: catalog file size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 catalog_index->catalog_file_size );
+
+		libcnotify_printf(
+		 "%s: number of parent entries\t\t: %" PRIu32 "\n",
+		 function,
+		 catalog_index->number_of_parent_entries );
+
+		libcnotify_printf(
+		 "%s: names data size\t\t\t: %" PRIu32 "\n",
+		 function,
+		 catalog_index->names_data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	index_size = sizeof( fshfs_catalog_index_file_header_t )
+	           + ( (uint64_t) catalog_index->number_of_entries * sizeof( fshfs_catalog_index_entry_t ) )
+	           + ( (uint64_t) catalog_index->number_of_parent_entries * sizeof( fshfs_catalog_index_parent_entry_t ) )
+	           + catalog_index->names_data_size;
+
+	if( index_size > (uint64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid catalog index size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	catalog_index->data_size = (size_t) index_size;
+
+	return( 1 );
+}
+
+/* Writes the catalog index file header
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_write_file_header_data(
+     libfshfs_catalog_index_t *catalog_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_write_file_header_data";
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( fshfs_catalog_index_file_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( fshfs_catalog_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (fshfs_catalog_index_file_header_t *) data )->signature,
+	     fshfs_catalog_index_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->format_version,
+	 LIBFSHFS_CATALOG_INDEX_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->volume_modification_time,
+	 catalog_index->volume_modification_time );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->volume_write_count,
+	 catalog_index->volume_write_count );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->number_of_entries,
+	 catalog_index->number_of_entries );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->catalog_file_size,
+	 catalog_index->catalog_file_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->number_of_parent_entries,
+	 catalog_index->number_of_parent_entries );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) data )->names_data_size,
+	 catalog_index->names_data_size );
+
+	return( 1 );
+}
+
+/* Sets the catalog index data
+ * The catalog index takes over management of the data if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_set_data(
+     libfshfs_catalog_index_t *catalog_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_set_data";
+	size_t data_offset    = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid catalog index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_catalog_index_read_file_header_data(
+	     catalog_index,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != catalog_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( fshfs_catalog_index_file_header_t );
+
+	catalog_index->entries_data = &( data[ data_offset ] );
+	data_offset                += (size_t) catalog_index->number_of_entries * sizeof( fshfs_catalog_index_entry_t );
+
+	catalog_index->parent_entries_data = &( data[ data_offset ] );
+	data_offset                       += (size_t) catalog_index->number_of_parent_entries * sizeof( fshfs_catalog_index_parent_entry_t );
+
+	catalog_index->names_data = &( data[ data_offset ] );
+	catalog_index->data       = data;
+
+	return( 1 );
+}
+
+/* Reads the catalog index from the catalog B-tree file
+ * The entries are read in a single pass over the B-tree leaf nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_read_btree_file(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node            = NULL;
+	libfshfs_catalog_btree_key_t *node_key = NULL;
+	libfshfs_parent_index_entry_t *entry   = NULL;
+	libfshfs_parent_index_t *parent_index  = NULL;
+	const uint8_t *record_data             = NULL;
+	uint8_t *data                          = NULL;
+	uint8_t *entries_data                  = NULL;
+	uint8_t *entry_data                    = NULL;
+	uint8_t *names_data                    = NULL;
+	uint8_t *parent_entry_data             = NULL;
+	uint8_t *reallocation                  = NULL;
+	static char *function                  = "libfshfs_catalog_index_read_btree_file";
+	size_t data_offset                     = 0;
+	size_t data_size                       = 0;
+	size_t entries_data_size               = 0;
+	size_t maximum_names_data_size         = 0;
+	size_t parent_entries_data_size        = 0;
+	size_t record_data_offset              = 0;
+	size_t record_data_size                = 0;
+	uint64_t maximum_number_of_nodes       = 0;
+	uint64_t number_of_nodes               = 0;
+	uint32_t identifier                    = 0;
+	uint32_t maximum_number_of_entries     = 0;
+	uint32_t names_data_size               = 0;
+	uint32_t node_number                   = 0;
+	uint32_t number_of_entries             = 0;
+	uint32_t parent_entry_index            = 0;
+	uint16_t number_of_records             = 0;
+	uint16_t record_index                  = 0;
+	uint16_t record_type                   = 0;
+	uint8_t is_child                       = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid catalog index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header->catalog_file_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume header - missing catalog file fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header->node_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree file - node size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The parent index is built in the same pass over the B-tree leaf nodes as the entries
+	 */
+	if( libfshfs_parent_index_initialize(
+	     &parent_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create parent index.",
+		 function );
+
+		goto on_error;
+	}
+	catalog_index->volume_modification_time = volume_header->modification_time;
+	catalog_index->volume_write_count       = volume_header->volume_write_count;
+	catalog_index->catalog_file_size        = volume_header->catalog_file_fork_descriptor->size;
+
+	maximum_number_of_nodes = catalog_index->catalog_file_size / btree_file->header->node_size;
+
+	node_number = btree_file->header->first_leaf_node_number;
+
+	while( node_number != 0 )
+	{
+		if( ( (uint64_t) node_number >= maximum_number_of_nodes )
+		 || ( number_of_nodes >= maximum_number_of_nodes ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree leaf node number: %" PRIu32 " value out of bounds.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree leaf node: %" PRIu32 ".",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree leaf node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 node_number,
+			 node->descriptor->type );
+
+			goto on_error;
+		}
+		number_of_records = node->descriptor->number_of_records;
+
+		for( record_index = 0;
+		     record_index < number_of_records;
+		     record_index++ )
+		{
+			if( libfshfs_btree_node_get_record_data_by_index(
+			     node,
+			     record_index,
+			     &record_data,
+			     &record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+			if( libfshfs_catalog_btree_key_initialize(
+			     &node_key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfshfs_catalog_btree_key_read_data(
+			     node_key,
+			     record_data,
+			     record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+			record_data_offset = node_key->data_size;
+
+			if( ( record_data_size < 2 )
+			 || ( record_data_offset > ( record_data_size - 2 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 record_type );
+
+			record_data_size -= record_data_offset;
+			record_data      += record_data_offset;
+
+			switch( record_type )
+			{
+				case 0x0001:
+					is_child = 1;
+
+					if( record_data_size < sizeof( fshfs_catalog_directory_record_hfsplus_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_directory_record_hfsplus_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0002:
+					is_child = 1;
+
+					if( record_data_size < sizeof( fshfs_catalog_file_record_hfsplus_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_file_record_hfsplus_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0100:
+					is_child = 1;
+
+					if( record_data_size < sizeof( fshfs_catalog_directory_record_hfs_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_directory_record_hfs_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0200:
+					is_child = 1;
+
+					if( record_data_size < sizeof( fshfs_catalog_file_record_hfs_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_file_record_hfs_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				default:
+					is_child    = 0;
+					record_type = 0;
+
+					break;
+			}
+			if( libfshfs_parent_index_append_record(
+			     parent_index,
+			     node_key->parent_identifier,
+			     node_number,
+			     record_index,
+			     is_child,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append node: %" PRIu32 " record: %" PRIu16 " to parent index.",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+			/* Only directory and file records are indexed
+			 */
+			if( record_type != 0 )
+			{
+				if( number_of_entries >= maximum_number_of_entries )
+				{
+					if( maximum_number_of_entries >= (uint32_t) ( ( SSIZE_MAX / 2 ) / sizeof( fshfs_catalog_index_entry_t ) ) )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+						 "%s: invalid number of entries value exceeds maximum.",
+						 function );
+
+						goto on_error;
+					}
+					maximum_number_of_entries = ( maximum_number_of_entries == 0 ) ? 1024 : maximum_number_of_entries * 2;
+
+					reallocation = (uint8_t *) memory_reallocate(
+					                            entries_data,
+					                            sizeof( fshfs_catalog_index_entry_t ) * maximum_number_of_entries );
+
+					if( reallocation == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize entries data.",
+						 function );
+
+						goto on_error;
+					}
+					entries_data = reallocation;
+				}
+				if( node_key->name_size > ( UINT32_MAX - names_data_size ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid names data size value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				if( ( (size_t) names_data_size + node_key->name_size ) > maximum_names_data_size )
+				{
+					maximum_names_data_size = ( maximum_names_data_size == 0 ) ? 16384 : maximum_names_data_size * 2;
+
+					if( maximum_names_data_size < ( (size_t) names_data_size + node_key->name_size ) )
+					{
+						maximum_names_data_size = (size_t) names_data_size + node_key->name_size;
+					}
+					reallocation = (uint8_t *) memory_reallocate(
+					                            names_data,
+					                            sizeof( uint8_t ) * maximum_names_data_size );
+
+					if( reallocation == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize names data.",
+						 function );
+
+						goto on_error;
+					}
+					names_data = reallocation;
+				}
+				entry_data = &( entries_data[ number_of_entries * sizeof( fshfs_catalog_index_entry_t ) ] );
+
+				if( memory_set(
+				     entry_data,
+				     0,
+				     sizeof( fshfs_catalog_index_entry_t ) ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear entry data.",
+					 function );
+
+					goto on_error;
+				}
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->identifier,
+				 identifier );
+
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->parent_identifier,
+				 node_key->parent_identifier );
+
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->node_number,
+				 node_number );
+
+				byte_stream_copy_from_uint16_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->record_index,
+				 record_index );
+
+				byte_stream_copy_from_uint16_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->record_type,
+				 record_type );
+
+				byte_stream_copy_from_uint32_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->name_offset,
+				 names_data_size );
+
+				byte_stream_copy_from_uint16_little_endian(
+				 ( (fshfs_catalog_index_entry_t *) entry_data )->name_size,
+				 node_key->name_size );
+
+				if( node_key->name_size > 0 )
+				{
+					if( memory_copy(
+					     &( names_data[ names_data_size ] ),
+					     node_key->name,
+					     (size_t) node_key->name_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy name.",
+						 function );
+
+						goto on_error;
+					}
+					names_data_size += node_key->name_size;
+				}
+				number_of_entries++;
+			}
+			if( libfshfs_catalog_btree_key_free(
+			     &node_key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free catalog B-tree key.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		node_number = node->descriptor->next_node_number;
+
+		number_of_nodes++;
+	}
+	/* The entries are stored in leaf order, which is sorted by parent identifier and name,
+	 * the entries table is sorted by identifier
+	 */
+	entries_data_size = (size_t) number_of_entries * sizeof( fshfs_catalog_index_entry_t );
+
+	if( number_of_entries > 1 )
+	{
+		qsort(
+		 entries_data,
+		 (size_t) number_of_entries,
+		 sizeof( fshfs_catalog_index_entry_t ),
+		 &libfshfs_catalog_index_compare_entry_data );
+	}
+	parent_entries_data_size = (size_t) parent_index->number_of_entries * sizeof( fshfs_catalog_index_parent_entry_t );
+
+	data_size = sizeof( fshfs_catalog_index_file_header_t )
+	          + entries_data_size
+	          + parent_entries_data_size
+	          + names_data_size;
+
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	catalog_index->number_of_entries        = number_of_entries;
+	catalog_index->number_of_parent_entries = parent_index->number_of_entries;
+	catalog_index->names_data_size          = names_data_size;
+
+	if( libfshfs_catalog_index_write_file_header_data(
+	     catalog_index,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write catalog index file header.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( fshfs_catalog_index_file_header_t );
+
+	if( entries_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     entries_data,
+		     entries_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entries data.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += entries_data_size;
+	}
+	for( parent_entry_index = 0;
+	     parent_entry_index < parent_index->number_of_entries;
+	     parent_entry_index++ )
+	{
+		entry             = &( parent_index->entries[ parent_entry_index ] );
+		parent_entry_data = &( data[ data_offset ] );
+
+		if( memory_set(
+		     parent_entry_data,
+		     0,
+		     sizeof( fshfs_catalog_index_parent_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear parent entry data.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->parent_identifier,
+		 entry->parent_identifier );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->node_number,
+		 entry->node_number );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->number_of_records,
+		 entry->number_of_records );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->number_of_children,
+		 entry->number_of_children );
+
+		byte_stream_copy_from_uint16_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->record_index,
+		 entry->record_index );
+
+		data_offset += sizeof( fshfs_catalog_index_parent_entry_t );
+	}
+	if( names_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     names_data,
+		     (size_t) names_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy names data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfshfs_catalog_index_set_data(
+	     catalog_index,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set catalog index data.",
+		 function );
+
+		goto on_error;
+	}
+	data = NULL;
+
+	if( names_data != NULL )
+	{
+		memory_free(
+		 names_data );
+	}
+	if( entries_data != NULL )
+	{
+		memory_free(
+		 entries_data );
+	}
+	if( libfshfs_parent_index_free(
+	     &parent_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free parent index.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( node_key != NULL )
+	{
+		libfshfs_catalog_btree_key_free(
+		 &node_key,
+		 NULL );
+	}
+	if( names_data != NULL )
+	{
+		memory_free(
+		 names_data );
+	}
+	if( entries_data != NULL )
+	{
+		memory_free(
+		 entries_data );
+	}
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	catalog_index->number_of_entries        = 0;
+	catalog_index->number_of_parent_entries = 0;
+	catalog_index->names_data_size          = 0;
+
+	return( -1 );
+}
+
+/* Reads the catalog index from a catalog index file
+ * The catalog index file is read into memory in a single read and used in-place
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_read_file_io_handle(
+     libfshfs_catalog_index_t *catalog_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( fshfs_catalog_index_file_header_t ) ];
+
+	uint8_t *data         = NULL;
+	static char *function = "libfshfs_catalog_index_read_file_io_handle";
+	size64_t file_size    = 0;
+	ssize_t read_count    = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid catalog index - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve catalog index file size.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              file_header_data,
+	              sizeof( fshfs_catalog_index_file_header_t ),
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) sizeof( fshfs_catalog_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index file header data at offset: 0 (0x00000000).",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_index_read_file_header_data(
+	     catalog_index,
+	     file_header_data,
+	     sizeof( fshfs_catalog_index_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size != (size64_t) catalog_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid catalog index file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * catalog_index->data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data,
+	              catalog_index->data_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) catalog_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_index_set_data(
+	     catalog_index,
+	     data,
+	     catalog_index->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set catalog index data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	catalog_index->data_size = 0;
+
+	return( -1 );
+}
+
+/* Writes the catalog index to a catalog index file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_write_file_io_handle(
+     libfshfs_catalog_index_t *catalog_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_write_file_io_handle";
+	ssize_t write_count   = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid catalog index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0 (0x00000000).",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               catalog_index->data,
+	               catalog_index->data_size,
+	               error );
+
+	if( write_count != (ssize_t) catalog_index->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write catalog index data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the catalog index matches the volume header
+ * Returns 1 if the catalog index matches, 0 if not or -1 on error
+ */
+int libfshfs_catalog_index_matches_volume_header(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_volume_header_t *volume_header,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_catalog_index_matches_volume_header";
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header->catalog_file_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume header - missing catalog file fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( catalog_index->volume_modification_time != volume_header->modification_time )
+	 || ( catalog_index->volume_write_count != volume_header->volume_write_count )
+	 || ( catalog_index->catalog_file_size != volume_header->catalog_file_fork_descriptor->size ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the parent index from the parent entries of the catalog index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_read_parent_index(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_parent_index_t *parent_index,
+     libcerror_error_t **error )
+{
+	libfshfs_parent_index_entry_t *entry = NULL;
+	const uint8_t *parent_entry_data     = NULL;
+	static char *function                = "libfshfs_catalog_index_read_parent_index";
+	uint32_t parent_entry_index          = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->parent_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid catalog index - missing parent entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_index->entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parent index - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->number_of_parent_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) catalog_index->number_of_parent_entries > ( (size_t) SSIZE_MAX / sizeof( libfshfs_parent_index_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of parent entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	parent_index->entries = (libfshfs_parent_index_entry_t *) memory_allocate(
+	                                                           sizeof( libfshfs_parent_index_entry_t ) * catalog_index->number_of_parent_entries );
+
+	if( parent_index->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent index entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( parent_entry_index = 0;
+	     parent_entry_index < catalog_index->number_of_parent_entries;
+	     parent_entry_index++ )
+	{
+		entry             = &( parent_index->entries[ parent_entry_index ] );
+		parent_entry_data = &( catalog_index->parent_entries_data[ (size_t) parent_entry_index * sizeof( fshfs_catalog_index_parent_entry_t ) ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->parent_identifier,
+		 entry->parent_identifier );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->node_number,
+		 entry->node_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->number_of_records,
+		 entry->number_of_records );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->number_of_children,
+		 entry->number_of_children );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (fshfs_catalog_index_parent_entry_t *) parent_entry_data )->record_index,
+		 entry->record_index );
+
+		/* The parent index is searched with a binary search hence the entries must be sorted
+		 */
+		if( ( parent_entry_index > 0 )
+		 && ( entry->parent_identifier <= parent_index->entries[ parent_entry_index - 1 ].parent_identifier ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported parent entry: %" PRIu32 " not stored in key order.",
+			 function,
+			 parent_entry_index );
+
+			goto on_error;
+		}
+	}
+	parent_index->number_of_entries         = catalog_index->number_of_parent_entries;
+	parent_index->maximum_number_of_entries = catalog_index->number_of_parent_entries;
+
+	return( 1 );
+
+on_error:
+	if( parent_index->entries != NULL )
+	{
+		memory_free(
+		 parent_index->entries );
+
+		parent_index->entries = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads the names of the directories in the catalog index into the path cache
+ * Only directories are added since only directories can be ancestors in a path
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_catalog_index_read_path_cache(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_path_cache_t *path_cache,
+     libcerror_error_t **error )
+{
+	const uint8_t *entry_data  = NULL;
+	static char *function      = "libfshfs_catalog_index_read_path_cache";
+	uint32_t entry_index       = 0;
+	uint32_t identifier        = 0;
+	uint32_t name_offset       = 0;
+	uint32_t parent_identifier = 0;
+	uint16_t name_size         = 0;
+	uint16_t record_type       = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( catalog_index->entries_data == NULL )
+	 || ( catalog_index->names_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid catalog index - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < catalog_index->number_of_entries;
+	     entry_index++ )
+	{
+		entry_data = &( catalog_index->entries_data[ (size_t) entry_index * sizeof( fshfs_catalog_index_entry_t ) ] );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->record_type,
+		 record_type );
+
+		if( ( record_type != 0x0001 )
+		 && ( record_type != 0x0100 ) )
+		{
+			continue;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->identifier,
+		 identifier );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->parent_identifier,
+		 parent_identifier );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->name_offset,
+		 name_offset );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->name_size,
+		 name_size );
+
+		if( ( name_offset > catalog_index->names_data_size )
+		 || ( (uint32_t) name_size > ( catalog_index->names_data_size - name_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry: %" PRIu32 " name offset value out of bounds.",
+			 function,
+			 identifier );
+
+			return( -1 );
+		}
+		if( libfshfs_path_cache_insert_entry(
+		     path_cache,
+		     identifier,
+		     parent_identifier,
+		     &( catalog_index->names_data[ name_offset ] ),
+		     name_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert path cache entry: %" PRIu32 ".",
+			 function,
+			 identifier );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the entry data for a specific identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_catalog_index_get_entry_data_by_identifier(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     const uint8_t **entry_data,
+     libcerror_error_t **error )
+{
+	const uint8_t *safe_entry_data = NULL;
+	static char *function          = "libfshfs_catalog_index_get_entry_data_by_identifier";
+	uint32_t entry_identifier      = 0;
+	uint32_t entry_index           = 0;
+	uint32_t lower_entry_index     = 0;
+	uint32_t upper_entry_index     = 0;
+
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index->entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid catalog index - missing entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	upper_entry_index = catalog_index->number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		safe_entry_data = &( catalog_index->entries_data[ (size_t) entry_index * sizeof( fshfs_catalog_index_entry_t ) ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) safe_entry_data )->identifier,
+		 entry_identifier );
+
+		if( identifier == entry_identifier )
+		{
+			*entry_data = safe_entry_data;
+
+			return( 1 );
+		}
+		else if( identifier > entry_identifier )
+		{
+			lower_entry_index = entry_index + 1;
+		}
+		else
+		{
+			upper_entry_index = entry_index;
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the location of the catalog record of a specific identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_catalog_index_get_entry_by_identifier(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error )
+{
+	const uint8_t *entry_data = NULL;
+	static char *function     = "libfshfs_catalog_index_get_entry_by_identifier";
+	int result                = 0;
+
+	if( parent_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node number.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record index.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfshfs_catalog_index_get_entry_data_by_identifier(
+	          catalog_index,
+	          identifier,
+	          &entry_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %" PRIu32 " data.",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->parent_identifier,
+		 *parent_identifier );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->node_number,
+		 *node_number );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (fshfs_catalog_index_entry_t *) entry_data )->record_index,
+		 *record_index );
+	}
+	return( result );
+}
+
+/* Removes the entry of a specific identifier from the catalog index
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_catalog_index_remove_entry(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     libcerror_error_t **error )
+{
+	const uint8_t *entry_data = NULL;
+	static char *function     = "libfshfs_catalog_index_remove_entry";
+	size_t copy_size          = 0;
+	size_t data_offset        = 0;
+	size_t entries_data_end   = 0;
+	int result                = 0;
+
+	result = libfshfs_catalog_index_get_entry_data_by_identifier(
+	          catalog_index,
+	          identifier,
+	          &entry_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry: %" PRIu32 " data.",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	data_offset      = (size_t) ( entry_data - catalog_index->data );
+	entries_data_end = sizeof( fshfs_catalog_index_file_header_t )
+	                 + ( (size_t) catalog_index->number_of_entries * sizeof( fshfs_catalog_index_entry_t ) );
+
+	if( ( data_offset < sizeof( fshfs_catalog_index_file_header_t ) )
+	 || ( data_offset > ( entries_data_end - sizeof( fshfs_catalog_index_entry_t ) ) )
+	 || ( entries_data_end > catalog_index->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data that follows the entry, which includes the parent entries and names data,
+	 * is moved at most the size of an entry at a time since the source and destination overlap
+	 */
+	while( data_offset < ( catalog_index->data_size - sizeof( fshfs_catalog_index_entry_t ) ) )
+	{
+		copy_size = catalog_index->data_size - sizeof( fshfs_catalog_index_entry_t ) - data_offset;
+
+		if( copy_size > sizeof( fshfs_catalog_index_entry_t ) )
+		{
+			copy_size = sizeof( fshfs_catalog_index_entry_t );
+		}
+		if( memory_copy(
+		     &( catalog_index->data[ data_offset ] ),
+		     &( catalog_index->data[ data_offset + sizeof( fshfs_catalog_index_entry_t ) ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to move entry data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += copy_size;
+	}
+	catalog_index->number_of_entries   -= 1;
+	catalog_index->data_size           -= sizeof( fshfs_catalog_index_entry_t );
+	catalog_index->parent_entries_data -= sizeof( fshfs_catalog_index_entry_t );
+	catalog_index->names_data          -= sizeof( fshfs_catalog_index_entry_t );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_catalog_index_file_header_t *) catalog_index->data )->number_of_entries,
+	 catalog_index->number_of_entries );
+
+	return( 1 );
+}
+
@@ -0,0 +1,174 @@
+/*
+ * Catalog index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_CATALOG_INDEX_H )
+#define _LIBFSHFS_CATALOG_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
+#include "libfshfs_volume_header.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_catalog_index libfshfs_catalog_index_t;
+
+struct libfshfs_catalog_index
+{
+	/* The volume modification time
+	 */
+	uint32_t volume_modification_time;
+
+	/* The volume write count
+	 */
+	uint32_t volume_write_count;
+
+	/* The catalog file size
+	 */
+	uint64_t catalog_file_size;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The number of parent entries
+	 */
+	uint32_t number_of_parent_entries;
+
+	/* The names data size
+	 */
+	uint32_t names_data_size;
+
+	/* The data, which contains the catalog index file header, entries, parent entries and names data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The entries data
+	 */
+	const uint8_t *entries_data;
+
+	/* The parent entries data
+	 */
+	const uint8_t *parent_entries_data;
+
+	/* The names data
+	 */
+	const uint8_t *names_data;
+};
+
+int libfshfs_catalog_index_initialize(
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_free(
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_compare_entry_data(
+     const void *first_entry_data,
+     const void *second_entry_data );
+
+int libfshfs_catalog_index_read_file_header_data(
+     libfshfs_catalog_index_t *catalog_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_write_file_header_data(
+     libfshfs_catalog_index_t *catalog_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_set_data(
+     libfshfs_catalog_index_t *catalog_index,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_read_btree_file(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_read_file_io_handle(
+     libfshfs_catalog_index_t *catalog_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_write_file_io_handle(
+     libfshfs_catalog_index_t *catalog_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_matches_volume_header(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_volume_header_t *volume_header,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_read_parent_index(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_parent_index_t *parent_index,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_read_path_cache(
+     libfshfs_catalog_index_t *catalog_index,
+     libfshfs_path_cache_t *path_cache,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_get_entry_data_by_identifier(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     const uint8_t **entry_data,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_get_entry_by_identifier(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error );
+
+int libfshfs_catalog_index_remove_entry(
+     libfshfs_catalog_index_t *catalog_index,
+     uint32_t identifier,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_CATALOG_INDEX_H ) */
+
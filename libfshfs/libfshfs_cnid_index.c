@@ -0,0 +1,840 @@
+/*
+ * Catalog node identifier (CNID) index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_cnid_index.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_volume_header.h"
+
+#include "fshfs_catalog_file.h"
+
+/* The hash of an identifier, based on Fibonacci hashing
+ */
+#define libfshfs_cnid_index_get_hash( identifier ) \
+	( ( (uint32_t) ( identifier ) * 0x9e3779b1UL ) ^ ( ( (uint32_t) ( identifier ) * 0x9e3779b1UL ) >> 16 ) )
+
+/* Creates a CNID index
+ * Make sure the value cnid_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_cnid_index_initialize(
+     libfshfs_cnid_index_t **cnid_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_cnid_index_initialize";
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cnid_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid CNID index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*cnid_index = memory_allocate_structure(
+	               libfshfs_cnid_index_t );
+
+	if( *cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create CNID index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *cnid_index,
+	     0,
+	     sizeof( libfshfs_cnid_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear CNID index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *cnid_index != NULL )
+	{
+		memory_free(
+		 *cnid_index );
+
+		*cnid_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a CNID index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_cnid_index_free(
+     libfshfs_cnid_index_t **cnid_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_cnid_index_free";
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cnid_index != NULL )
+	{
+		if( ( *cnid_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *cnid_index )->entries );
+		}
+		memory_free(
+		 *cnid_index );
+
+		*cnid_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the CNID index hash table
+ * The maximum number of entries must be a power of 2
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_cnid_index_resize(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libfshfs_cnid_index_entry_t *entries = NULL;
+	static char *function                = "libfshfs_cnid_index_resize";
+	size_t entries_size                  = 0;
+	uint32_t entry_index                 = 0;
+	uint32_t hash_index                  = 0;
+	uint32_t hash_mask                   = 0;
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries == 0 )
+	 || ( ( maximum_number_of_entries & ( maximum_number_of_entries - 1 ) ) != 0 )
+	 || ( maximum_number_of_entries < cnid_index->number_of_entries )
+	 || ( (size_t) maximum_number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libfshfs_cnid_index_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries_size = sizeof( libfshfs_cnid_index_entry_t ) * maximum_number_of_entries;
+
+	entries = (libfshfs_cnid_index_entry_t *) memory_allocate(
+	                                           entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	hash_mask = maximum_number_of_entries - 1;
+
+	for( entry_index = 0;
+	     entry_index < cnid_index->maximum_number_of_entries;
+	     entry_index++ )
+	{
+		if( cnid_index->entries[ entry_index ].identifier == 0 )
+		{
+			continue;
+		}
+		hash_index = libfshfs_cnid_index_get_hash(
+		              cnid_index->entries[ entry_index ].identifier ) & hash_mask;
+
+		while( entries[ hash_index ].identifier != 0 )
+		{
+			hash_index = ( hash_index + 1 ) & hash_mask;
+		}
+		entries[ hash_index ] = cnid_index->entries[ entry_index ];
+	}
+	if( cnid_index->entries != NULL )
+	{
+		memory_free(
+		 cnid_index->entries );
+	}
+	cnid_index->entries                   = entries;
+	cnid_index->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Inserts an entry into the CNID index
+ * The hash table is resized when it is more than 3/4 full
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_cnid_index_insert_entry(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint16_t record_type,
+     libcerror_error_t **error )
+{
+	static char *function              = "libfshfs_cnid_index_insert_entry";
+	uint32_t hash_index                = 0;
+	uint32_t hash_mask                 = 0;
+	uint32_t maximum_number_of_entries = 0;
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (uint64_t) cnid_index->number_of_entries + 1 ) * 4 > ( (uint64_t) cnid_index->maximum_number_of_entries * 3 ) )
+	{
+		if( cnid_index->maximum_number_of_entries == 0 )
+		{
+			maximum_number_of_entries = 1024;
+		}
+		else if( cnid_index->maximum_number_of_entries < 0x80000000UL )
+		{
+			maximum_number_of_entries = cnid_index->maximum_number_of_entries * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfshfs_cnid_index_resize(
+		     cnid_index,
+		     maximum_number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize CNID index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	hash_mask  = cnid_index->maximum_number_of_entries - 1;
+	hash_index = libfshfs_cnid_index_get_hash(
+	              identifier ) & hash_mask;
+
+	while( cnid_index->entries[ hash_index ].identifier != 0 )
+	{
+		if( cnid_index->entries[ hash_index ].identifier == identifier )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid CNID index - entry: %" PRIu32 " already set.",
+			 function,
+			 identifier );
+
+			return( -1 );
+		}
+		hash_index = ( hash_index + 1 ) & hash_mask;
+	}
+	cnid_index->entries[ hash_index ].identifier   = identifier;
+	cnid_index->entries[ hash_index ].node_number  = node_number;
+	cnid_index->entries[ hash_index ].record_index = record_index;
+	cnid_index->entries[ hash_index ].record_type  = record_type;
+
+	cnid_index->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Reads the CNID index from the catalog B-tree file
+ * The entries are read in a single pass over the B-tree leaf nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_cnid_index_read_btree_file(
+     libfshfs_cnid_index_t *cnid_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node      = NULL;
+	const uint8_t *record_data       = NULL;
+	static char *function            = "libfshfs_cnid_index_read_btree_file";
+	size_t record_data_offset        = 0;
+	size_t record_data_size          = 0;
+	uint64_t maximum_number_of_nodes = 0;
+	uint64_t number_of_nodes         = 0;
+	uint32_t identifier              = 0;
+	uint32_t node_number             = 0;
+	uint16_t key_data_size           = 0;
+	uint16_t number_of_records       = 0;
+	uint16_t record_index            = 0;
+	uint16_t record_type             = 0;
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( cnid_index->number_of_entries != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid CNID index - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header->catalog_file_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume header - missing catalog file fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header->node_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree file - node size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_nodes = volume_header->catalog_file_fork_descriptor->size / btree_file->header->node_size;
+
+	node_number = btree_file->header->first_leaf_node_number;
+
+	while( node_number != 0 )
+	{
+		if( ( (uint64_t) node_number >= maximum_number_of_nodes )
+		 || ( number_of_nodes >= maximum_number_of_nodes ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree leaf node number: %" PRIu32 " value out of bounds.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree leaf node: %" PRIu32 ".",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree leaf node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 node_number,
+			 node->descriptor->type );
+
+			goto on_error;
+		}
+		number_of_records = node->descriptor->number_of_records;
+
+		for( record_index = 0;
+		     record_index < number_of_records;
+		     record_index++ )
+		{
+			if( libfshfs_btree_node_get_record_data_by_index(
+			     node,
+			     record_index,
+			     &record_data,
+			     &record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+			/* Only the size of the key is needed, hence the key is not read
+			 */
+			if( record_data_size < 2 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 ( (fshfs_catalog_index_key_hfsplus_t *) record_data )->data_size,
+			 key_data_size );
+
+			record_data_offset = (size_t) key_data_size + 2;
+
+			if( record_data_offset > ( record_data_size - 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 record_type );
+
+			record_data_size -= record_data_offset;
+			record_data      += record_data_offset;
+
+			switch( record_type )
+			{
+				case 0x0001:
+					if( record_data_size < sizeof( fshfs_catalog_directory_record_hfsplus_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_directory_record_hfsplus_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0002:
+					if( record_data_size < sizeof( fshfs_catalog_file_record_hfsplus_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_file_record_hfsplus_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0100:
+					if( record_data_size < sizeof( fshfs_catalog_directory_record_hfs_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_directory_record_hfs_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				case 0x0200:
+					if( record_data_size < sizeof( fshfs_catalog_file_record_hfs_t ) )
+					{
+						record_type = 0;
+
+						break;
+					}
+					byte_stream_copy_to_uint32_big_endian(
+					 ( (fshfs_catalog_file_record_hfs_t *) record_data )->identifier,
+					 identifier );
+
+					break;
+
+				default:
+					record_type = 0;
+
+					break;
+			}
+			/* Only directory and file records are indexed
+			 */
+			if( ( record_type != 0 )
+			 && ( identifier != 0 ) )
+			{
+				if( libfshfs_cnid_index_insert_entry(
+				     cnid_index,
+				     identifier,
+				     node_number,
+				     record_index,
+				     record_type,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert entry: %" PRIu32 " into CNID index.",
+					 function,
+					 identifier );
+
+					goto on_error;
+				}
+			}
+		}
+		node_number = node->descriptor->next_node_number;
+
+		number_of_nodes++;
+	}
+	return( 1 );
+
+on_error:
+	if( cnid_index->entries != NULL )
+	{
+		memory_free(
+		 cnid_index->entries );
+
+		cnid_index->entries = NULL;
+	}
+	cnid_index->number_of_entries         = 0;
+	cnid_index->maximum_number_of_entries = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the location of the catalog record of a specific identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_cnid_index_get_entry_by_identifier(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_cnid_index_get_entry_by_identifier";
+	uint32_t hash_index   = 0;
+	uint32_t hash_mask    = 0;
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node number.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( identifier == 0 )
+	 || ( cnid_index->entries == NULL ) )
+	{
+		return( 0 );
+	}
+	hash_mask  = cnid_index->maximum_number_of_entries - 1;
+	hash_index = libfshfs_cnid_index_get_hash(
+	              identifier ) & hash_mask;
+
+	/* The hash table is never full, hence an unused entry terminates the probe
+	 */
+	while( cnid_index->entries[ hash_index ].identifier != 0 )
+	{
+		if( cnid_index->entries[ hash_index ].identifier == identifier )
+		{
+			*node_number  = cnid_index->entries[ hash_index ].node_number;
+			*record_index = cnid_index->entries[ hash_index ].record_index;
+
+			return( 1 );
+		}
+		hash_index = ( hash_index + 1 ) & hash_mask;
+	}
+	return( 0 );
+}
+
+/* Removes the entry of a specific identifier from the CNID index
+ * The entries that follow in the same probe sequence are shifted back,
+ * so that the probe sequences remain intact without the use of tombstones
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_cnid_index_remove_entry(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_cnid_index_remove_entry";
+	uint32_t hash_index   = 0;
+	uint32_t hash_mask    = 0;
+	uint32_t home_index   = 0;
+	uint32_t next_index   = 0;
+
+	if( cnid_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CNID index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( identifier == 0 )
+	 || ( cnid_index->entries == NULL ) )
+	{
+		return( 0 );
+	}
+	hash_mask  = cnid_index->maximum_number_of_entries - 1;
+	hash_index = libfshfs_cnid_index_get_hash(
+	              identifier ) & hash_mask;
+
+	while( cnid_index->entries[ hash_index ].identifier != identifier )
+	{
+		if( cnid_index->entries[ hash_index ].identifier == 0 )
+		{
+			return( 0 );
+		}
+		hash_index = ( hash_index + 1 ) & hash_mask;
+	}
+	next_index = ( hash_index + 1 ) & hash_mask;
+
+	while( cnid_index->entries[ next_index ].identifier != 0 )
+	{
+		home_index = libfshfs_cnid_index_get_hash(
+		              cnid_index->entries[ next_index ].identifier ) & hash_mask;
+
+		/* The entry can only be moved back if that does not place it before its home index
+		 */
+		if( ( ( next_index - home_index ) & hash_mask ) >= ( ( next_index - hash_index ) & hash_mask ) )
+		{
+			cnid_index->entries[ hash_index ] = cnid_index->entries[ next_index ];
+
+			hash_index = next_index;
+		}
+		next_index = ( next_index + 1 ) & hash_mask;
+	}
+	if( memory_set(
+	     &( cnid_index->entries[ hash_index ] ),
+	     0,
+	     sizeof( libfshfs_cnid_index_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		return( -1 );
+	}
+	cnid_index->number_of_entries -= 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,120 @@
+/*
+ * Catalog node identifier (CNID) index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_CNID_INDEX_H )
+#define _LIBFSHFS_CNID_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_volume_header.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_cnid_index_entry libfshfs_cnid_index_entry_t;
+
+struct libfshfs_cnid_index_entry
+{
+	/* The identifier (CNID), where 0 represents an unused entry
+	 */
+	uint32_t identifier;
+
+	/* The catalog B-tree leaf node number
+	 */
+	uint32_t node_number;
+
+	/* The record index in the catalog B-tree leaf node
+	 */
+	uint16_t record_index;
+
+	/* The record type
+	 */
+	uint16_t record_type;
+};
+
+typedef struct libfshfs_cnid_index libfshfs_cnid_index_t;
+
+struct libfshfs_cnid_index
+{
+	/* The entries, which are stored in an open-addressed hash table
+	 */
+	libfshfs_cnid_index_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The maximum number of entries, which is a power of 2
+	 */
+	uint32_t maximum_number_of_entries;
+};
+
+int libfshfs_cnid_index_initialize(
+     libfshfs_cnid_index_t **cnid_index,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_free(
+     libfshfs_cnid_index_t **cnid_index,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_resize(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_insert_entry(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint16_t record_type,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_read_btree_file(
+     libfshfs_cnid_index_t *cnid_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_get_entry_by_identifier(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     uint32_t *node_number,
+     uint16_t *record_index,
+     libcerror_error_t **error );
+
+int libfshfs_cnid_index_remove_entry(
+     libfshfs_cnid_index_t *cnid_index,
+     uint32_t identifier,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_CNID_INDEX_H ) */
+
@@ -0,0 +1,888 @@
+/*
+ * Direct I/O functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT is only defined by glibc if _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_direct_io.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libclocale.h"
+#include "libfshfs_libuna.h"
+
+/* Direct I/O uses O_DIRECT if available, otherwise F_NOCACHE
+ */
+#if defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && defined( HAVE_PREAD ) && ( defined( O_DIRECT ) || defined( F_NOCACHE ) )
+#define HAVE_LIBFSHFS_DIRECT_IO_SUPPORT
+#endif
+
+/* Creates direct I/O
+ * Make sure the value direct_io is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_direct_io_initialize(
+     libfshfs_direct_io_t **direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_direct_io_initialize";
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct I/O value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*direct_io = memory_allocate_structure(
+	              libfshfs_direct_io_t );
+
+	if( *direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct I/O.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *direct_io,
+	     0,
+	     sizeof( libfshfs_direct_io_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear direct I/O.",
+		 function );
+
+		goto on_error;
+	}
+	( *direct_io )->file_descriptor = -1;
+	( *direct_io )->alignment       = LIBFSHFS_DIRECT_IO_ALIGNMENT;
+
+	return( 1 );
+
+on_error:
+	if( *direct_io != NULL )
+	{
+		memory_free(
+		 *direct_io );
+
+		*direct_io = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees direct I/O
+ * The file is closed if open
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_direct_io_free(
+     libfshfs_direct_io_t **direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_direct_io_free";
+	int result            = 1;
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( *direct_io != NULL )
+	{
+		if( ( *direct_io )->file_descriptor != -1 )
+		{
+			if( libfshfs_direct_io_close(
+			     *direct_io,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close direct I/O.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *direct_io );
+
+		*direct_io = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file for reading with direct I/O
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_direct_io_open(
+     libfshfs_direct_io_t *direct_io,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_direct_io_open";
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid direct I/O - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_DIRECT_IO_SUPPORT )
+#if defined( O_DIRECT )
+	direct_io->file_descriptor = open(
+	                              filename,
+	                              O_RDONLY | O_DIRECT );
+#else
+	direct_io->file_descriptor = open(
+	                              filename,
+	                              O_RDONLY );
+#endif
+	if( direct_io->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s for direct I/O.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+#if !defined( O_DIRECT )
+	if( fcntl(
+	     direct_io->file_descriptor,
+	     F_NOCACHE,
+	     1 ) == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to disable caching of file: %s.",
+		 function,
+		 filename );
+
+		close(
+		 direct_io->file_descriptor );
+
+		direct_io->file_descriptor = -1;
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct I/O not supported.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a file for reading with direct I/O
+ * The filename is converted to the narrow system string codepage
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_direct_io_open_wide(
+     libfshfs_direct_io_t *direct_io,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	char *narrow_filename       = NULL;
+	static char *function       = "libfshfs_direct_io_open_wide";
+	size_t filename_size        = 0;
+	size_t narrow_filename_size = 0;
+	int codepage                = 0;
+	int result                  = 0;
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libclocale_codepage_get(
+	     &codepage,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve codepage.",
+		 function );
+
+		goto on_error;
+	}
+	filename_size = wide_string_length(
+	                 filename ) + 1;
+
+	/* A codepage of 0 represents UTF-8
+	 */
+	if( codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          codepage,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          codepage,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow filename size.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_filename = narrow_string_allocate(
+	                   narrow_filename_size );
+
+	if( narrow_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          codepage,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          codepage,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_direct_io_open(
+	     direct_io,
+	     narrow_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %ls for direct I/O.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 narrow_filename );
+
+	return( 1 );
+
+on_error:
+	if( narrow_filename != NULL )
+	{
+		memory_free(
+		 narrow_filename );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Closes the file
+ * Returns 0 if successful or -1 on error
+ */
+int libfshfs_direct_io_close(
+     libfshfs_direct_io_t *direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_direct_io_close";
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSHFS_DIRECT_IO_SUPPORT )
+	if( close(
+	     direct_io->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to close file.",
+		 function );
+
+		direct_io->file_descriptor = -1;
+
+		return( -1 );
+	}
+#endif
+	direct_io->file_descriptor = -1;
+
+	return( 0 );
+}
+
+/* Reads data at a specific offset into an aligned buffer
+ * The offset, size and buffer must be aligned to the alignment
+ * Returns the number of bytes read, which is less than size at the end of the file, or -1 on error
+ */
+ssize_t libfshfs_direct_io_read_aligned_buffer_at_offset(
+         libfshfs_direct_io_t *direct_io,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libfshfs_direct_io_read_aligned_buffer_at_offset";
+
+#if defined( HAVE_LIBFSHFS_DIRECT_IO_SUPPORT )
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+#endif
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( direct_io->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid direct I/O - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % direct_io->alignment ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer == NULL )
+	 || ( ( (intptr_t) buffer % direct_io->alignment ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size > (size_t) SSIZE_MAX )
+	 || ( ( size % direct_io->alignment ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_DIRECT_IO_SUPPORT )
+	while( buffer_offset < size )
+	{
+		read_count = pread(
+		              direct_io->file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              (off_t) ( offset + buffer_offset ) );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset + buffer_offset,
+			 offset + buffer_offset );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: direct I/O not supported.",
+	 function );
+
+	return( -1 );
+#endif
+}
+
+/* Reads data at a specific offset
+ * Data that is not aligned to the alignment is read in aligned blocks into a buffer
+ * from the buffer pool, from which the requested data is copied
+ * Returns the number of bytes read, which is less than size at the end of the file, or -1 on error
+ */
+ssize_t libfshfs_direct_io_read_buffer_at_offset(
+         libfshfs_direct_io_t *direct_io,
+         libfshfs_buffer_pool_t *buffer_pool,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	uint8_t *aligned_buffer    = NULL;
+	static char *function      = "libfshfs_direct_io_read_buffer_at_offset";
+	size_t aligned_buffer_size = 0;
+	size_t aligned_read_size   = 0;
+	size_t alignment_offset    = 0;
+	size_t buffer_offset       = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	off64_t read_offset        = 0;
+
+	if( direct_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid direct I/O.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( direct_io->alignment == 0 )
+	 || ( direct_io->alignment > (size_t) LIBFSHFS_BUFFER_POOL_ALIGNMENT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid direct I/O - alignment value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) ( SSIZE_MAX - LIBFSHFS_BUFFER_POOL_ALIGNMENT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_offset      = offset + (off64_t) buffer_offset;
+		read_size        = size - buffer_offset;
+		alignment_offset = (size_t) ( read_offset % direct_io->alignment );
+
+		if( ( alignment_offset == 0 )
+		 && ( read_size >= direct_io->alignment )
+		 && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % direct_io->alignment ) == 0 ) )
+		{
+			/* Aligned data is read directly into the buffer
+			 */
+			read_size -= read_size % direct_io->alignment;
+
+			read_count = libfshfs_direct_io_read_aligned_buffer_at_offset(
+			              direct_io,
+			              read_offset,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read aligned buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				goto on_error;
+			}
+			buffer_offset += (size_t) read_count;
+
+			if( (size_t) read_count < read_size )
+			{
+				break;
+			}
+			continue;
+		}
+		aligned_read_size = alignment_offset + read_size;
+		aligned_read_size = ( aligned_read_size + direct_io->alignment - 1 ) / direct_io->alignment * direct_io->alignment;
+
+		if( aligned_buffer == NULL )
+		{
+			aligned_buffer_size = aligned_read_size;
+
+			if( aligned_buffer_size > (size_t) LIBFSHFS_BUFFER_POOL_MAXIMUM_BUFFER_SIZE )
+			{
+				aligned_buffer_size = (size_t) LIBFSHFS_BUFFER_POOL_MAXIMUM_BUFFER_SIZE;
+			}
+			if( libfshfs_buffer_pool_get_buffer(
+			     buffer_pool,
+			     aligned_buffer_size,
+			     &aligned_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve aligned buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( aligned_read_size > aligned_buffer_size )
+		{
+			aligned_read_size = aligned_buffer_size;
+		}
+		read_count = libfshfs_direct_io_read_aligned_buffer_at_offset(
+		              direct_io,
+		              read_offset - alignment_offset,
+		              aligned_buffer,
+		              aligned_read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read aligned buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset - alignment_offset,
+			 read_offset - alignment_offset );
+
+			goto on_error;
+		}
+		if( (size_t) read_count <= alignment_offset )
+		{
+			break;
+		}
+		if( read_size > ( (size_t) read_count - alignment_offset ) )
+		{
+			read_size = (size_t) read_count - alignment_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( aligned_buffer[ alignment_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy aligned data.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_offset += read_size;
+
+		if( (size_t) read_count < aligned_read_size )
+		{
+			break;
+		}
+	}
+	if( aligned_buffer != NULL )
+	{
+		if( libfshfs_buffer_pool_release_buffer(
+		     buffer_pool,
+		     &aligned_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release aligned buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( aligned_buffer != NULL )
+	{
+		libfshfs_buffer_pool_release_buffer(
+		 buffer_pool,
+		 &aligned_buffer,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,94 @@
+/*
+ * Direct I/O functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_DIRECT_IO_H )
+#define _LIBFSHFS_DIRECT_IO_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_direct_io libfshfs_direct_io_t;
+
+struct libfshfs_direct_io
+{
+	/* The file descriptor, where -1 represents a file that is not open
+	 */
+	int file_descriptor;
+
+	/* The alignment of the offsets, sizes and buffers of the reads
+	 */
+	size_t alignment;
+};
+
+int libfshfs_direct_io_initialize(
+     libfshfs_direct_io_t **direct_io,
+     libcerror_error_t **error );
+
+int libfshfs_direct_io_free(
+     libfshfs_direct_io_t **direct_io,
+     libcerror_error_t **error );
+
+int libfshfs_direct_io_open(
+     libfshfs_direct_io_t *direct_io,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libfshfs_direct_io_open_wide(
+     libfshfs_direct_io_t *direct_io,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libfshfs_direct_io_close(
+     libfshfs_direct_io_t *direct_io,
+     libcerror_error_t **error );
+
+ssize_t libfshfs_direct_io_read_aligned_buffer_at_offset(
+         libfshfs_direct_io_t *direct_io,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libfshfs_direct_io_read_buffer_at_offset(
+         libfshfs_direct_io_t *direct_io,
+         libfshfs_buffer_pool_t *buffer_pool,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_DIRECT_IO_H ) */
+
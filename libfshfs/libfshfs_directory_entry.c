@@ -23,11 +23,14 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfshfs_atomic.h"
 #include "libfshfs_directory_entry.h"
 #include "libfshfs_directory_record.h"
 #include "libfshfs_file_record.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libuna.h"
+#include "libfshfs_memory_arena.h"
+#include "libfshfs_types.h"
 
 /* Creates a directory entry
  * Make sure the value directory_entry is referencing, is set to NULL
@@ -89,6 +92,8 @@ int libfshfs_directory_entry_initialize(
 
 		goto on_error;
 	}
+	( *directory_entry )->reference_count = 1;
+
 	return( 1 );
 
 on_error:
@@ -102,15 +107,216 @@ on_error:
 	return( -1 );
 }
 
+/* Creates a directory entry from catalog record data
+ * The directory entry, name and catalog record are allocated from the memory arena
+ * and are freed when the last reference to the memory arena is released
+ * Make sure the value directory_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_directory_entry_initialize_in_memory_arena(
+     libfshfs_directory_entry_t **directory_entry,
+     libfshfs_memory_arena_t *memory_arena,
+     uint32_t parent_identifier,
+     const uint8_t *name,
+     uint16_t name_size,
+     uint16_t record_type,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     libcerror_error_t **error )
+{
+	libfshfs_directory_entry_t *safe_directory_entry = NULL;
+	static char *function                            = "libfshfs_directory_entry_initialize_in_memory_arena";
+	int result                                       = 0;
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_memory_arena_allocate(
+	     memory_arena,
+	     sizeof( libfshfs_directory_entry_t ),
+	     (void **) &safe_directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	safe_directory_entry->record_type       = record_type;
+	safe_directory_entry->parent_identifier = parent_identifier;
+	safe_directory_entry->reference_count   = 1;
+
+	if( name_size > 0 )
+	{
+		if( libfshfs_memory_arena_allocate(
+		     memory_arena,
+		     (size_t) name_size,
+		     (void **) &( safe_directory_entry->name ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     safe_directory_entry->name,
+		     name,
+		     (size_t) name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			return( -1 );
+		}
+		safe_directory_entry->name_size = name_size;
+	}
+	if( ( record_type == 0x0001 )
+	 || ( record_type == 0x0100 ) )
+	{
+		if( libfshfs_memory_arena_allocate(
+		     memory_arena,
+		     sizeof( libfshfs_directory_record_t ),
+		     (void **) &( safe_directory_entry->catalog_record ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create directory record.",
+			 function );
+
+			return( -1 );
+		}
+		result = libfshfs_directory_record_read_data(
+		          (libfshfs_directory_record_t *) safe_directory_entry->catalog_record,
+		          record_data,
+		          record_data_size,
+		          error );
+	}
+	else if( ( record_type == 0x0002 )
+	      || ( record_type == 0x0200 ) )
+	{
+		if( libfshfs_memory_arena_allocate(
+		     memory_arena,
+		     sizeof( libfshfs_file_record_t ),
+		     (void **) &( safe_directory_entry->catalog_record ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create file record.",
+			 function );
+
+			return( -1 );
+		}
+		result = libfshfs_file_record_read_data(
+		          (libfshfs_file_record_t *) safe_directory_entry->catalog_record,
+		          record_data,
+		          record_data_size,
+		          error );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported record type: 0x%04" PRIx16 ".",
+		 function,
+		 record_type );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog record.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_memory_arena_reference(
+	     memory_arena,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reference memory arena.",
+		 function );
+
+		return( -1 );
+	}
+	safe_directory_entry->memory_arena = memory_arena;
+
+	*directory_entry = safe_directory_entry;
+
+	return( 1 );
+}
+
 /* Frees a directory entry
+ * This releases a reference and frees the directory entry when the last reference is released
  * Returns 1 if successful or -1 on error
  */
 int libfshfs_directory_entry_free(
      libfshfs_directory_entry_t **directory_entry,
      libcerror_error_t **error )
 {
-	static char *function = "libfshfs_directory_entry_free";
-	int result            = 1;
+	libfshfs_directory_entry_t *safe_directory_entry = NULL;
+	libfshfs_memory_arena_t *memory_arena            = NULL;
+	static char *function                            = "libfshfs_directory_entry_free";
+	int result                                       = 1;
 
 	if( directory_entry == NULL )
 	{
@@ -125,56 +331,133 @@ int libfshfs_directory_entry_free(
 	}
 	if( *directory_entry != NULL )
 	{
-		if( ( *directory_entry )->name != NULL )
+		safe_directory_entry = *directory_entry;
+		*directory_entry     = NULL;
+
+		if( libfshfs_atomic_decrement_uint32(
+		     &( safe_directory_entry->reference_count ) ) != 0 )
 		{
-			memory_free(
-			 ( *directory_entry )->name );
+			return( 1 );
 		}
-		if( ( *directory_entry )->catalog_record != NULL )
+		if( safe_directory_entry->memory_arena != NULL )
 		{
-			if( ( ( *directory_entry )->record_type == 0x0001 )
-			 || ( ( *directory_entry )->record_type == 0x0100 ) )
+			/* The directory entry, name and catalog record are freed with the memory arena
+			 * only the fork descriptors that were read on first access are freed here
+			 */
+			if( ( safe_directory_entry->catalog_record != NULL )
+			 && ( ( safe_directory_entry->record_type == 0x0002 )
+			  || ( safe_directory_entry->record_type == 0x0200 ) ) )
 			{
-				if( libfshfs_directory_record_free(
-				     (libfshfs_directory_record_t **) &( ( *directory_entry )->catalog_record ),
+				if( libfshfs_file_record_free_fork_descriptors(
+				     (libfshfs_file_record_t *) safe_directory_entry->catalog_record,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free catalog directory record.",
+					 "%s: unable to free catalog file record fork descriptors.",
 					 function );
 
 					result = -1;
 				}
 			}
-			else if( ( ( *directory_entry )->record_type == 0x0002 )
-			      || ( ( *directory_entry )->record_type == 0x0200 ) )
+			memory_arena = safe_directory_entry->memory_arena;
+
+			if( libfshfs_memory_arena_free(
+			     &memory_arena,
+			     error ) != 1 )
 			{
-				if( libfshfs_file_record_free(
-				     (libfshfs_file_record_t **) &( ( *directory_entry )->catalog_record ),
-				     error ) != 1 )
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free memory arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+		{
+			if( safe_directory_entry->name != NULL )
+			{
+				memory_free(
+				 safe_directory_entry->name );
+			}
+			if( safe_directory_entry->catalog_record != NULL )
+			{
+				if( ( safe_directory_entry->record_type == 0x0001 )
+				 || ( safe_directory_entry->record_type == 0x0100 ) )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free catalog file record.",
-					 function );
-
-					result = -1;
+					if( libfshfs_directory_record_free(
+					     (libfshfs_directory_record_t **) &( safe_directory_entry->catalog_record ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free catalog directory record.",
+						 function );
+
+						result = -1;
+					}
+				}
+				else if( ( safe_directory_entry->record_type == 0x0002 )
+				      || ( safe_directory_entry->record_type == 0x0200 ) )
+				{
+					if( libfshfs_file_record_free(
+					     (libfshfs_file_record_t **) &( safe_directory_entry->catalog_record ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free catalog file record.",
+						 function );
+
+						result = -1;
+					}
 				}
 			}
+			memory_free(
+			 safe_directory_entry );
 		}
-		memory_free(
-		 *directory_entry );
-
-		*directory_entry = NULL;
 	}
 	return( result );
 }
 
+/* Adds a reference to a directory entry
+ * A directory entry is not changed after it has been read, which allows it
+ * to be shared by file entries. Every reference must be released with
+ * libfshfs_directory_entry_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_directory_entry_reference(
+     libfshfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_directory_entry_reference";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	libfshfs_atomic_increment_uint32(
+	 &( directory_entry->reference_count ) );
+
+	return( 1 );
+}
+
 /* Retrieves the identifier
  * Returns 1 if successful or -1 on error
  */
@@ -231,6 +514,220 @@ int libfshfs_directory_entry_get_identifier(
 	return( 1 );
 }
 
+/* Retrieves the data fork descriptor
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_directory_entry_get_data_fork_descriptor(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_directory_entry_get_data_fork_descriptor";
+	int result            = 0;
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry->catalog_record == NULL )
+	{
+		return( 0 );
+	}
+	if( ( directory_entry->record_type != 0x0002 )
+	 && ( directory_entry->record_type != 0x0200 ) )
+	{
+		return( 0 );
+	}
+	result = libfshfs_file_record_get_data_fork_descriptor(
+	          (libfshfs_file_record_t *) directory_entry->catalog_record,
+	          fork_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data fork descriptor from file record.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the data fork size
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_directory_entry_get_data_fork_size(
+     libfshfs_directory_entry_t *directory_entry,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_directory_entry_get_data_fork_size";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry->catalog_record == NULL )
+	{
+		return( 0 );
+	}
+	if( ( directory_entry->record_type != 0x0002 )
+	 && ( directory_entry->record_type != 0x0200 ) )
+	{
+		return( 0 );
+	}
+	*size = (size64_t) ( (libfshfs_file_record_t *) directory_entry->catalog_record )->data_fork_size;
+
+	return( 1 );
+}
+
+/* Retrieves the resource fork descriptor
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_directory_entry_get_resource_fork_descriptor(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_directory_entry_get_resource_fork_descriptor";
+	int result            = 0;
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry->catalog_record == NULL )
+	{
+		return( 0 );
+	}
+	if( ( directory_entry->record_type != 0x0002 )
+	 && ( directory_entry->record_type != 0x0200 ) )
+	{
+		return( 0 );
+	}
+	result = libfshfs_file_record_get_resource_fork_descriptor(
+	          (libfshfs_file_record_t *) directory_entry->catalog_record,
+	          fork_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve resource fork descriptor from file record.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the resource fork size
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_directory_entry_get_resource_fork_size(
+     libfshfs_directory_entry_t *directory_entry,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_directory_entry_get_resource_fork_size";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry->catalog_record == NULL )
+	{
+		return( 0 );
+	}
+	if( ( directory_entry->record_type != 0x0002 )
+	 && ( directory_entry->record_type != 0x0200 ) )
+	{
+		return( 0 );
+	}
+	*size = (size64_t) ( (libfshfs_file_record_t *) directory_entry->catalog_record )->resource_fork_size;
+
+	return( 1 );
+}
+
 /* Retrieves the size of the UTF-8 encoded name
  * The returned size includes the end of string character
  * Returns 1 if successful or -1 on error
@@ -399,3 +896,104 @@ int libfshfs_directory_entry_get_utf16_name(
 	return( 1 );
 }
 
+/* Retrieves the metadata values
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_directory_entry_get_stat(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_stat_t *stat,
+     libcerror_error_t **error )
+{
+	libfshfs_directory_record_t *directory_record = NULL;
+	libfshfs_file_record_t *file_record           = NULL;
+	static char *function                         = "libfshfs_directory_entry_get_stat";
+
+	if( directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_entry->catalog_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid directory entry - missing catalog record.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stat.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     stat,
+	     0,
+	     sizeof( libfshfs_stat_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stat.",
+		 function );
+
+		return( -1 );
+	}
+	stat->parent_identifier = directory_entry->parent_identifier;
+	stat->record_type       = directory_entry->record_type;
+
+/* TODO add support for the link count of hard links, which is stored in the indirect node file
+ */
+
+	if( ( directory_entry->record_type == 0x0001 )
+	 || ( directory_entry->record_type == 0x0100 ) )
+	{
+		directory_record = (libfshfs_directory_record_t *) directory_entry->catalog_record;
+
+		stat->identifier              = directory_record->identifier;
+		stat->owner_identifier        = directory_record->owner_identifier;
+		stat->group_identifier        = directory_record->group_identifier;
+		stat->creation_time           = directory_record->creation_time;
+		stat->modification_time       = directory_record->modification_time;
+		stat->entry_modification_time = directory_record->entry_modification_time;
+		stat->access_time             = directory_record->access_time;
+		stat->file_mode               = directory_record->file_mode;
+		stat->flags                   = directory_record->flags;
+	}
+	else if( ( directory_entry->record_type == 0x0002 )
+	      || ( directory_entry->record_type == 0x0200 ) )
+	{
+		file_record = (libfshfs_file_record_t *) directory_entry->catalog_record;
+
+		stat->identifier              = file_record->identifier;
+		stat->owner_identifier        = file_record->owner_identifier;
+		stat->group_identifier        = file_record->group_identifier;
+		stat->creation_time           = file_record->creation_time;
+		stat->modification_time       = file_record->modification_time;
+		stat->entry_modification_time = file_record->entry_modification_time;
+		stat->access_time             = file_record->access_time;
+		stat->file_mode               = file_record->file_mode;
+		stat->flags                   = file_record->flags;
+
+		stat->data_size               = file_record->data_fork_size;
+		stat->resource_fork_size      = file_record->resource_fork_size;
+	}
+	return( 1 );
+}
+
@@ -25,7 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfshfs_fork_descriptor.h"
 #include "libfshfs_libcerror.h"
+#include "libfshfs_memory_arena.h"
+#include "libfshfs_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -54,21 +57,65 @@ struct libfshfs_directory_entry
 	/* File or directory catalog record
 	 */
 	intptr_t *catalog_record;
+
+	/* The memory arena from which the directory entry, name and catalog record are allocated
+	 * The directory entry holds a reference to the memory arena
+	 */
+	libfshfs_memory_arena_t *memory_arena;
+
+	/* The reference count
+	 */
+	uint32_t reference_count;
 };
 
 int libfshfs_directory_entry_initialize(
      libfshfs_directory_entry_t **directory_entry,
      libcerror_error_t **error );
 
+int libfshfs_directory_entry_initialize_in_memory_arena(
+     libfshfs_directory_entry_t **directory_entry,
+     libfshfs_memory_arena_t *memory_arena,
+     uint32_t parent_identifier,
+     const uint8_t *name,
+     uint16_t name_size,
+     uint16_t record_type,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     libcerror_error_t **error );
+
 int libfshfs_directory_entry_free(
      libfshfs_directory_entry_t **directory_entry,
      libcerror_error_t **error );
 
+int libfshfs_directory_entry_reference(
+     libfshfs_directory_entry_t *directory_entry,
+     libcerror_error_t **error );
+
 int libfshfs_directory_entry_get_identifier(
      libfshfs_directory_entry_t *directory_entry,
      uint32_t *identifier,
      libcerror_error_t **error );
 
+int libfshfs_directory_entry_get_data_fork_descriptor(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_directory_entry_get_data_fork_size(
+     libfshfs_directory_entry_t *directory_entry,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libfshfs_directory_entry_get_resource_fork_descriptor(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_directory_entry_get_resource_fork_size(
+     libfshfs_directory_entry_t *directory_entry,
+     size64_t *size,
+     libcerror_error_t **error );
+
 int libfshfs_directory_entry_get_utf8_name_size(
      libfshfs_directory_entry_t *directory_entry,
      size_t *utf8_string_size,
@@ -91,6 +138,11 @@ int libfshfs_directory_entry_get_utf16_name(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+int libfshfs_directory_entry_get_stat(
+     libfshfs_directory_entry_t *directory_entry,
+     libfshfs_stat_t *stat,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
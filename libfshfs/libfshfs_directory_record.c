@@ -241,12 +241,68 @@ int libfshfs_directory_record_read_data(
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->identifier,
 		 directory_record->identifier );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->flags,
+		 directory_record->flags );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->creation_time,
+		 directory_record->creation_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->modification_time,
+		 directory_record->modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->entry_modification_time,
+		 directory_record->entry_modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->access_time,
+		 directory_record->access_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfsplus_t *) data )->backup_time,
+		 directory_record->backup_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_directory_record_hfsplus_t *) data )->permissions )->owner_identifier,
+		 directory_record->owner_identifier );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_directory_record_hfsplus_t *) data )->permissions )->group_identifier,
+		 directory_record->group_identifier );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_directory_record_hfsplus_t *) data )->permissions )->file_mode,
+		 directory_record->file_mode );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_directory_record_hfsplus_t *) data )->permissions )->special,
+		 directory_record->special_permissions );
 	}
 	else
 	{
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (fshfs_catalog_directory_record_hfs_t *) data )->identifier,
 		 directory_record->identifier );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 ( (fshfs_catalog_directory_record_hfs_t *) data )->flags,
+		 directory_record->flags );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfs_t *) data )->creation_time,
+		 directory_record->creation_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfs_t *) data )->modification_time,
+		 directory_record->modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_directory_record_hfs_t *) data )->backup_time,
+		 directory_record->backup_time );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -38,6 +38,46 @@ struct libfshfs_directory_record
 	/* The identifier
 	 */
 	uint32_t identifier;
+
+	/* The flags
+	 */
+	uint16_t flags;
+
+	/* The creation time
+	 */
+	uint32_t creation_time;
+
+	/* The modification time
+	 */
+	uint32_t modification_time;
+
+	/* The entry modification time
+	 */
+	uint32_t entry_modification_time;
+
+	/* The access time
+	 */
+	uint32_t access_time;
+
+	/* The backup time
+	 */
+	uint32_t backup_time;
+
+	/* The owner identifier
+	 */
+	uint32_t owner_identifier;
+
+	/* The group identifier
+	 */
+	uint32_t group_identifier;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+
+	/* The special permissions
+	 */
+	uint32_t special_permissions;
 };
 
 int libfshfs_directory_record_initialize(
@@ -0,0 +1,808 @@
+/*
+ * Export planner functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_export_planner.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_kernel_copy.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+
+/* Creates an export planner
+ * Make sure the value export_planner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_initialize(
+     libfshfs_export_planner_t **export_planner,
+     size_t maximum_gap_size,
+     size_t maximum_read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_export_planner_initialize";
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_planner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export planner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_gap_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum gap size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_read_size == 0 )
+	 || ( maximum_read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*export_planner = memory_allocate_structure(
+	                   libfshfs_export_planner_t );
+
+	if( *export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export planner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_planner,
+	     0,
+	     sizeof( libfshfs_export_planner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export planner.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_planner )->maximum_gap_size  = maximum_gap_size;
+	( *export_planner )->maximum_read_size = maximum_read_size;
+
+	return( 1 );
+
+on_error:
+	if( *export_planner != NULL )
+	{
+		memory_free(
+		 *export_planner );
+
+		*export_planner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export planner
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_free(
+     libfshfs_export_planner_t **export_planner,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_export_planner_free";
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_planner != NULL )
+	{
+		if( ( *export_planner )->ranges != NULL )
+		{
+			memory_free(
+			 ( *export_planner )->ranges );
+		}
+		memory_free(
+		 *export_planner );
+
+		*export_planner = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares the volume offsets of 2 planned ranges
+ * This function is used to sort the planned ranges with qsort
+ * Returns -1 if the first offset is less, 0 if equal or 1 if greater
+ */
+int libfshfs_export_planner_compare_ranges(
+     const void *first_range,
+     const void *second_range )
+{
+	off64_t first_offset  = ( (libfshfs_export_planner_range_t *) first_range )->volume_offset;
+	off64_t second_offset = ( (libfshfs_export_planner_range_t *) second_range )->volume_offset;
+
+	if( first_offset < second_offset )
+	{
+		return( -1 );
+	}
+	else if( first_offset > second_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends a range
+ * The size of the range cannot exceed the maximum read size
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_append_range(
+     libfshfs_export_planner_t *export_planner,
+     off64_t volume_offset,
+     off64_t destination_offset,
+     size_t size,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_export_planner_range_t *range  = NULL;
+	libfshfs_export_planner_range_t *ranges = NULL;
+	static char *function                   = "libfshfs_export_planner_append_range";
+	size_t ranges_size                      = 0;
+	int maximum_number_of_ranges            = 0;
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid volume offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid destination offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > export_planner->maximum_read_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_planner->number_of_ranges >= export_planner->maximum_number_of_ranges )
+	{
+		if( export_planner->maximum_number_of_ranges == 0 )
+		{
+			maximum_number_of_ranges = 64;
+		}
+		else if( export_planner->maximum_number_of_ranges < ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_ranges = export_planner->maximum_number_of_ranges * 2;
+		}
+		else
+		{
+			maximum_number_of_ranges = 0;
+		}
+		if( ( maximum_number_of_ranges == 0 )
+		 || ( (size_t) maximum_number_of_ranges > ( (size_t) SSIZE_MAX / sizeof( libfshfs_export_planner_range_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		ranges_size = sizeof( libfshfs_export_planner_range_t ) * maximum_number_of_ranges;
+
+		ranges = (libfshfs_export_planner_range_t *) memory_reallocate(
+		                                              export_planner->ranges,
+		                                              ranges_size );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		export_planner->ranges                   = ranges;
+		export_planner->maximum_number_of_ranges = maximum_number_of_ranges;
+	}
+	range = &( export_planner->ranges[ export_planner->number_of_ranges ] );
+
+	range->volume_offset      = volume_offset;
+	range->destination_offset = destination_offset;
+	range->size               = size;
+	range->file_descriptor    = file_descriptor;
+
+	export_planner->number_of_ranges += 1;
+
+	return( 1 );
+}
+
+/* Appends the ranges of a fork
+ * The extents of the fork are split into ranges of at most the maximum read size,
+ * of which the data is written at the corresponding offset in the destination file
+ * A fork with data beyond the extents of the fork descriptor is unsupported, in which case no ranges are appended
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_append_fork(
+     libfshfs_export_planner_t *export_planner,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t allocation_block_size,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfshfs_export_planner_append_fork";
+	size64_t extent_size        = 0;
+	size64_t extents_size       = 0;
+	size_t range_size           = 0;
+	off64_t extent_offset       = 0;
+	off64_t fork_offset         = 0;
+	uint32_t number_of_blocks   = 0;
+	uint32_t start_block_number = 0;
+	int extent_index            = 0;
+	int number_of_extents       = 0;
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid allocation block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine if the extents cover the fork before any range is appended
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( extents_size >= fork_descriptor->size )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		extents_size += (size64_t) number_of_blocks * allocation_block_size;
+	}
+	if( extents_size < fork_descriptor->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fork - data beyond the extents of the fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( (size64_t) fork_offset >= fork_descriptor->size )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		extent_offset = (off64_t) start_block_number * allocation_block_size;
+		extent_size   = (size64_t) number_of_blocks * allocation_block_size;
+
+		/* The last allocation block can contain data beyond the end of the fork
+		 */
+		if( extent_size > ( fork_descriptor->size - (size64_t) fork_offset ) )
+		{
+			extent_size = fork_descriptor->size - (size64_t) fork_offset;
+		}
+		while( extent_size > 0 )
+		{
+			range_size = export_planner->maximum_read_size;
+
+			if( (size64_t) range_size > extent_size )
+			{
+				range_size = (size_t) extent_size;
+			}
+			if( libfshfs_export_planner_append_range(
+			     export_planner,
+			     extent_offset,
+			     fork_offset,
+			     range_size,
+			     file_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append range of extent: %d.",
+				 function,
+				 extent_index );
+
+				return( -1 );
+			}
+			extent_offset += (off64_t) range_size;
+			fork_offset   += (off64_t) range_size;
+			extent_size   -= (size64_t) range_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the planned ranges that are read in a single read
+ * The planned ranges must be sorted by volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_get_run(
+     libfshfs_export_planner_t *export_planner,
+     int first_range_index,
+     int *last_range_index,
+     off64_t *run_offset,
+     size_t *run_size,
+     libcerror_error_t **error )
+{
+	libfshfs_export_planner_range_t *range = NULL;
+	static char *function                  = "libfshfs_export_planner_get_run";
+	off64_t range_end_offset               = 0;
+	off64_t run_end_offset                 = 0;
+	int range_index                        = 0;
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_range_index < 0 )
+	 || ( first_range_index >= export_planner->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( last_range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid last range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	range = &( export_planner->ranges[ first_range_index ] );
+
+	*run_offset    = range->volume_offset;
+	run_end_offset = range->volume_offset + (off64_t) range->size;
+
+	for( range_index = first_range_index + 1;
+	     range_index < export_planner->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( export_planner->ranges[ range_index ] );
+
+		if( ( range->volume_offset > run_end_offset )
+		 && ( (size64_t) ( range->volume_offset - run_end_offset ) > (size64_t) export_planner->maximum_gap_size ) )
+		{
+			break;
+		}
+		range_end_offset = range->volume_offset + (off64_t) range->size;
+
+		if( range_end_offset < run_end_offset )
+		{
+			range_end_offset = run_end_offset;
+		}
+		if( (size64_t) ( range_end_offset - *run_offset ) > (size64_t) export_planner->maximum_read_size )
+		{
+			break;
+		}
+		run_end_offset = range_end_offset;
+	}
+	*last_range_index = range_index;
+	*run_size         = (size_t) ( run_end_offset - *run_offset );
+
+	return( 1 );
+}
+
+/* Exports the planned ranges
+ * The planned ranges are sorted by volume offset so that the volume is read once in ascending order,
+ * where ranges that are at most the maximum gap size apart are read in a single read
+ * The data of every range is written at its offset in the destination file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_export_planner_export(
+     libfshfs_export_planner_t *export_planner,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_export_planner_range_t *range = NULL;
+	uint8_t *buffer                        = NULL;
+	static char *function                  = "libfshfs_export_planner_export";
+	off64_t run_offset                     = 0;
+	size_t run_size                        = 0;
+	ssize_t read_count                     = 0;
+	int first_range_index                  = 0;
+	int last_range_index                   = 0;
+	int range_index                        = 0;
+
+	if( export_planner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export planner.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_planner->number_of_ranges == 0 )
+	{
+		return( 1 );
+	}
+	if( export_planner->number_of_ranges > 1 )
+	{
+		qsort(
+		 export_planner->ranges,
+		 (size_t) export_planner->number_of_ranges,
+		 sizeof( libfshfs_export_planner_range_t ),
+		 &libfshfs_export_planner_compare_ranges );
+	}
+	if( libfshfs_buffer_pool_get_buffer(
+	     io_handle->buffer_pool,
+	     export_planner->maximum_read_size,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve export buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( first_range_index < export_planner->number_of_ranges )
+	{
+		if( libfshfs_export_planner_get_run(
+		     export_planner,
+		     first_range_index,
+		     &last_range_index,
+		     &run_offset,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve run of range: %d.",
+			 function,
+			 first_range_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %d ranges at offset: 0x%08" PRIx64 " with size: %" PRIzd ".\n",
+			 function,
+			 last_range_index - first_range_index,
+			 run_offset,
+			 run_size );
+		}
+#endif
+		read_count = libfshfs_io_handle_read_data_at_offset(
+		              io_handle,
+		              file_io_handle,
+		              run_offset,
+		              buffer,
+		              run_size,
+		              error );
+
+		if( read_count != (ssize_t) run_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_size,
+			 run_offset,
+			 run_offset );
+
+			goto on_error;
+		}
+		for( range_index = first_range_index;
+		     range_index < last_range_index;
+		     range_index++ )
+		{
+			range = &( export_planner->ranges[ range_index ] );
+
+			if( libfshfs_kernel_copy_write_buffer_at_offset(
+			     range->file_descriptor,
+			     &( buffer[ range->volume_offset - run_offset ] ),
+			     range->size,
+			     range->destination_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write range: %d to file descriptor.",
+				 function,
+				 range_index );
+
+				goto on_error;
+			}
+		}
+		first_range_index = last_range_index;
+	}
+	if( libfshfs_buffer_pool_release_buffer(
+	     io_handle->buffer_pool,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release export buffer.",
+		 function );
+
+		goto on_error;
+	}
+	export_planner->number_of_ranges = 0;
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		libfshfs_buffer_pool_release_buffer(
+		 io_handle->buffer_pool,
+		 &buffer,
+		 NULL );
+	}
+	export_planner->number_of_ranges = 0;
+
+	return( -1 );
+}
+
@@ -0,0 +1,131 @@
+/*
+ * Export planner functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_EXPORT_PLANNER_H )
+#define _LIBFSHFS_EXPORT_PLANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_export_planner_range libfshfs_export_planner_range_t;
+
+struct libfshfs_export_planner_range
+{
+	/* The offset of the data in the volume
+	 */
+	off64_t volume_offset;
+
+	/* The offset of the data in the destination file
+	 */
+	off64_t destination_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The destination file descriptor
+	 */
+	int file_descriptor;
+};
+
+typedef struct libfshfs_export_planner libfshfs_export_planner_t;
+
+struct libfshfs_export_planner
+{
+	/* The maximum gap size between ranges that are read in a single read
+	 */
+	size_t maximum_gap_size;
+
+	/* The maximum size of a single read
+	 */
+	size_t maximum_read_size;
+
+	/* The planned ranges
+	 */
+	libfshfs_export_planner_range_t *ranges;
+
+	/* The number of planned ranges
+	 */
+	int number_of_ranges;
+
+	/* The maximum number of planned ranges
+	 */
+	int maximum_number_of_ranges;
+};
+
+int libfshfs_export_planner_initialize(
+     libfshfs_export_planner_t **export_planner,
+     size_t maximum_gap_size,
+     size_t maximum_read_size,
+     libcerror_error_t **error );
+
+int libfshfs_export_planner_free(
+     libfshfs_export_planner_t **export_planner,
+     libcerror_error_t **error );
+
+int libfshfs_export_planner_compare_ranges(
+     const void *first_range,
+     const void *second_range );
+
+int libfshfs_export_planner_append_range(
+     libfshfs_export_planner_t *export_planner,
+     off64_t volume_offset,
+     off64_t destination_offset,
+     size_t size,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_export_planner_append_fork(
+     libfshfs_export_planner_t *export_planner,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t allocation_block_size,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_export_planner_get_run(
+     libfshfs_export_planner_t *export_planner,
+     int first_range_index,
+     int *last_range_index,
+     off64_t *run_offset,
+     size_t *run_size,
+     libcerror_error_t **error );
+
+int libfshfs_export_planner_export(
+     libfshfs_export_planner_t *export_planner,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_EXPORT_PLANNER_H ) */
+
@@ -0,0 +1,362 @@
+/*
+ * Extent functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_extent.h"
+#include "libfshfs_libcdata.h"
+#include "libfshfs_libcerror.h"
+
+/* Creates an extent
+ * Make sure the value extent is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extent_initialize(
+     libfshfs_extent_t **extent,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_extent_initialize";
+
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*extent = memory_allocate_structure(
+	           libfshfs_extent_t );
+
+	if( *extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *extent,
+	     0,
+	     sizeof( libfshfs_extent_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extent.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *extent != NULL )
+	{
+		memory_free(
+		 *extent );
+
+		*extent = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an extent
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extent_free(
+     libfshfs_extent_t **extent,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_extent_free";
+
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extent != NULL )
+	{
+		memory_free(
+		 *extent );
+
+		*extent = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares 2 extents by their offset
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libfshfs_extent_compare_by_offset(
+     libfshfs_extent_t *first_extent,
+     libfshfs_extent_t *second_extent,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_extent_compare_by_offset";
+
+	if( first_extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_extent->offset < second_extent->offset )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_extent->offset > second_extent->offset )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Inserts an extent into an array of extents sorted by offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extents_array_insert_extent(
+     libcdata_array_t *extents_array,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libfshfs_extent_t *extent = NULL;
+	static char *function     = "libfshfs_extents_array_insert_extent";
+	int entry_index           = 0;
+
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_extent_initialize(
+	     &extent,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extent.",
+		 function );
+
+		goto on_error;
+	}
+	extent->offset = offset;
+	extent->size   = size;
+
+	if( libcdata_array_insert_entry(
+	     extents_array,
+	     &entry_index,
+	     (intptr_t *) extent,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libfshfs_extent_compare_by_offset,
+	     LIBCDATA_INSERT_FLAG_NON_UNIQUE_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert extent into array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( extent != NULL )
+	{
+		libfshfs_extent_free(
+		 &extent,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Merges overlapping and adjacent extents of an array of extents sorted by offset
+ * The extents are moved from the extents array into the merged extents array
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extents_array_merge(
+     libcdata_array_t *extents_array,
+     libcdata_array_t *merged_extents_array,
+     libcerror_error_t **error )
+{
+	libfshfs_extent_t *extent        = NULL;
+	libfshfs_extent_t *merged_extent = NULL;
+	static char *function            = "libfshfs_extents_array_merge";
+	off64_t extent_end_offset        = 0;
+	int entry_index                  = 0;
+	int extent_index                 = 0;
+	int number_of_extents            = 0;
+
+	if( libcdata_array_get_number_of_entries(
+	     extents_array,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     extents_array,
+		     extent_index,
+		     (intptr_t **) &extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( extent == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( extent->size == 0 )
+		{
+			continue;
+		}
+		if( ( merged_extent != NULL )
+		 && ( extent->offset <= (off64_t) ( merged_extent->offset + merged_extent->size ) ) )
+		{
+			extent_end_offset = extent->offset + (off64_t) extent->size;
+
+			if( extent_end_offset > (off64_t) ( merged_extent->offset + merged_extent->size ) )
+			{
+				merged_extent->size = (size64_t) ( extent_end_offset - merged_extent->offset );
+			}
+			continue;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     extents_array,
+		     extent_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_append_entry(
+		     merged_extents_array,
+		     &entry_index,
+		     (intptr_t *) extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent to merged array.",
+			 function );
+
+			libfshfs_extent_free(
+			 &extent,
+			 NULL );
+
+			return( -1 );
+		}
+		merged_extent = extent;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,77 @@
+/*
+ * Extent functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_EXTENT_H )
+#define _LIBFSHFS_EXTENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libcdata.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_extent libfshfs_extent_t;
+
+struct libfshfs_extent
+{
+	/* The offset relative to the start of the volume
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+};
+
+int libfshfs_extent_initialize(
+     libfshfs_extent_t **extent,
+     libcerror_error_t **error );
+
+int libfshfs_extent_free(
+     libfshfs_extent_t **extent,
+     libcerror_error_t **error );
+
+int libfshfs_extent_compare_by_offset(
+     libfshfs_extent_t *first_extent,
+     libfshfs_extent_t *second_extent,
+     libcerror_error_t **error );
+
+int libfshfs_extents_array_insert_extent(
+     libcdata_array_t *extents_array,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libfshfs_extents_array_merge(
+     libcdata_array_t *extents_array,
+     libcdata_array_t *merged_extents_array,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_EXTENT_H ) */
+
@@ -0,0 +1,686 @@
+/*
+ * The extents (overflow) B-tree file functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_extents_btree_file.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+
+#include "fshfs_extents_file.h"
+
+/* Retrieves the key from extents B-tree record data
+ * Only HFS+ keys are supported
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extents_btree_file_get_key_from_record_data(
+     const uint8_t *record_data,
+     size_t record_data_size,
+     uint32_t *identifier,
+     uint8_t *fork_type,
+     uint32_t *start_block_number,
+     size_t *record_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfshfs_extents_btree_file_get_key_from_record_data";
+	size_t safe_key_size   = 0;
+	uint16_t key_data_size = 0;
+
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record_data_size < sizeof( fshfs_extents_index_key_hfsplus_t ) )
+	 || ( record_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork type.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_block_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start block number.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data offset.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 ( (fshfs_extents_index_key_hfsplus_t *) record_data )->data_size,
+	 key_data_size );
+
+	safe_key_size = (size_t) key_data_size + 2;
+
+	if( ( safe_key_size < sizeof( fshfs_extents_index_key_hfsplus_t ) )
+	 || ( safe_key_size > record_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*fork_type = ( (fshfs_extents_index_key_hfsplus_t *) record_data )->fork_type;
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_extents_index_key_hfsplus_t *) record_data )->identifier,
+	 *identifier );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_extents_index_key_hfsplus_t *) record_data )->start_block,
+	 *start_block_number );
+
+	*record_data_offset = safe_key_size;
+
+	return( 1 );
+}
+
+/* Compares 2 extents B-tree keys
+ * The keys are sorted by identifier, fork type and start block number
+ * Returns -1 if the first key is less, 0 if equal or 1 if greater
+ */
+int libfshfs_extents_btree_file_compare_keys(
+     uint32_t first_identifier,
+     uint8_t first_fork_type,
+     uint32_t first_start_block_number,
+     uint32_t second_identifier,
+     uint8_t second_fork_type,
+     uint32_t second_start_block_number )
+{
+	if( first_identifier < second_identifier )
+	{
+		return( -1 );
+	}
+	else if( first_identifier > second_identifier )
+	{
+		return( 1 );
+	}
+	if( first_fork_type < second_fork_type )
+	{
+		return( -1 );
+	}
+	else if( first_fork_type > second_fork_type )
+	{
+		return( 1 );
+	}
+	if( first_start_block_number < second_start_block_number )
+	{
+		return( -1 );
+	}
+	else if( first_start_block_number > second_start_block_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends the extents in an HFS+ extents record to the overflow extents of a fork descriptor
+ * The extents record contains 8 extents, an extent without blocks marks the end of the record
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extents_btree_file_append_extents_data(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfshfs_extents_btree_file_append_extents_data";
+	size_t data_offset          = 0;
+	uint32_t number_of_blocks   = 0;
+	uint32_t start_block_number = 0;
+	int extent_index            = 0;
+
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 64 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 start_block_number );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset + 4 ] ),
+		 number_of_blocks );
+
+		data_offset += 8;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: extent: %d start block number\t\t: %" PRIu32 "\n",
+			 function,
+			 extent_index,
+			 start_block_number );
+
+			libcnotify_printf(
+			 "%s: extent: %d number of blocks\t\t: %" PRIu32 "\n",
+			 function,
+			 extent_index,
+			 number_of_blocks );
+		}
+#endif
+		if( number_of_blocks == 0 )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_append_overflow_extent(
+		     fork_descriptor,
+		     start_block_number,
+		     number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent: %d to fork descriptor.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the extents record of a specific key from the extents B-tree node
+ * The extents of the record are appended to the overflow extents of the fork descriptor
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int libfshfs_extents_btree_file_get_extents_from_node(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_btree_node_t *node,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t start_block_number,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *sub_node  = NULL;
+	const uint8_t *record_data       = NULL;
+	static char *function            = "libfshfs_extents_btree_file_get_extents_from_node";
+	size_t record_data_offset        = 0;
+	size_t record_data_size          = 0;
+	uint32_t key_identifier          = 0;
+	uint32_t key_start_block_number  = 0;
+	uint32_t sub_node_number         = 0;
+	uint16_t number_of_records       = 0;
+	uint16_t record_index            = 0;
+	uint8_t key_fork_type            = 0;
+	uint8_t node_type                = 0;
+	int compare_result               = 0;
+	int result                       = 0;
+
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( node->descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree node - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBFSHFS_MAXIMUM_BTREE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_records = node->descriptor->number_of_records;
+	node_type         = node->descriptor->type;
+
+	if( ( node_type != LIBFSHFS_BTREE_NODE_TYPE_INDEX_NODE )
+	 && ( node_type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported B-tree node type: 0x%02" PRIx8 ".",
+		 function,
+		 node_type );
+
+		return( -1 );
+	}
+	for( record_index = 0;
+	     record_index < number_of_records;
+	     record_index++ )
+	{
+		if( libfshfs_btree_node_get_record_data_by_index(
+		     node,
+		     record_index,
+		     &record_data,
+		     &record_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node record: %" PRIu16 " data.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		if( libfshfs_extents_btree_file_get_key_from_record_data(
+		     record_data,
+		     record_data_size,
+		     &key_identifier,
+		     &key_fork_type,
+		     &key_start_block_number,
+		     &record_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node record: %" PRIu16 " key.",
+			 function,
+			 record_index );
+
+			return( -1 );
+		}
+		compare_result = libfshfs_extents_btree_file_compare_keys(
+		                  key_identifier,
+		                  key_fork_type,
+		                  key_start_block_number,
+		                  identifier,
+		                  fork_type,
+		                  start_block_number );
+
+		if( compare_result > 0 )
+		{
+			break;
+		}
+		if( node_type == LIBFSHFS_BTREE_NODE_TYPE_INDEX_NODE )
+		{
+			/* Only the last sub node with a key less than or equal to the search key
+			 * can contain the record of the search key
+			 */
+			if( ( record_data_size < 4 )
+			 || ( record_data_offset > ( record_data_size - 4 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data size value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 sub_node_number );
+
+			result = 1;
+		}
+		else if( compare_result == 0 )
+		{
+			if( libfshfs_extents_btree_file_append_extents_data(
+			     fork_descriptor,
+			     &( record_data[ record_data_offset ] ),
+			     record_data_size - record_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extents of node record: %" PRIu16 ".",
+				 function,
+				 record_index );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+	}
+	if( ( node_type != LIBFSHFS_BTREE_NODE_TYPE_INDEX_NODE )
+	 || ( result == 0 ) )
+	{
+		return( 0 );
+	}
+	/* Read the sub node after reading the data of the record
+	 * to prevent the node being cached out
+	 */
+	if( libfshfs_btree_file_get_node_by_number(
+	     btree_file,
+	     file_io_handle,
+	     (int) sub_node_number,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve B-tree sub node: %" PRIu32 ".",
+		 function,
+		 sub_node_number );
+
+		return( -1 );
+	}
+	result = libfshfs_extents_btree_file_get_extents_from_node(
+	          btree_file,
+	          file_io_handle,
+	          sub_node,
+	          identifier,
+	          fork_type,
+	          start_block_number,
+	          fork_descriptor,
+	          recursion_depth + 1,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extents from B-tree sub node: %" PRIu32 ".",
+		 function,
+		 sub_node_number );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the overflow extents of a specific fork from the extents B-tree file
+ * The overflow extents are appended to the fork descriptor until its extents map
+ * all the blocks of the fork
+ * The B-tree file is only required when the fork has overflow extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_extents_btree_file_get_overflow_extents(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t identifier,
+     uint8_t fork_type,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *root_node          = NULL;
+	static char *function                     = "libfshfs_extents_btree_file_get_overflow_extents";
+	uint64_t number_of_mapped_blocks          = 0;
+	uint64_t previous_number_of_mapped_blocks = 0;
+	int result                                = 0;
+
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		if( libfshfs_fork_descriptor_get_number_of_mapped_blocks(
+		     fork_descriptor,
+		     &number_of_mapped_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of mapped blocks.",
+			 function );
+
+			return( -1 );
+		}
+		/* Overflow extents are only stored when all the extents in the fork descriptor are used
+		 */
+		if( ( number_of_mapped_blocks >= (uint64_t) fork_descriptor->number_of_blocks )
+		 || ( fork_descriptor->extents[ 7 ][ 1 ] == 0 ) )
+		{
+			break;
+		}
+		if( ( result == 1 )
+		 && ( number_of_mapped_blocks == previous_number_of_mapped_blocks ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extents record of fork: 0x%02" PRIx8 " of identifier: %" PRIu32 " - no blocks mapped.",
+			 function,
+			 fork_type,
+			 identifier );
+
+			return( -1 );
+		}
+		if( number_of_mapped_blocks > (uint64_t) UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of mapped blocks value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		previous_number_of_mapped_blocks = number_of_mapped_blocks;
+
+		if( btree_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid B-tree file.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfshfs_btree_file_get_root_node(
+		     btree_file,
+		     file_io_handle,
+		     &root_node,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree root node.",
+			 function );
+
+			return( -1 );
+		}
+		result = libfshfs_extents_btree_file_get_extents_from_node(
+		          btree_file,
+		          file_io_handle,
+		          root_node,
+		          identifier,
+		          fork_type,
+		          (uint32_t) number_of_mapped_blocks,
+		          fork_descriptor,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extents of fork: 0x%02" PRIx8 " of identifier: %" PRIu32 " from extents B-tree root node.",
+			 function,
+			 fork_type,
+			 identifier );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extents record of fork: 0x%02" PRIx8 " of identifier: %" PRIu32 " starting at block: %" PRIu64 ".",
+			 function,
+			 fork_type,
+			 identifier,
+			 number_of_mapped_blocks );
+
+			return( -1 );
+		}
+	}
+	while( result == 1 );
+
+	return( 1 );
+}
+
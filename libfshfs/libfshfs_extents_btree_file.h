@@ -0,0 +1,85 @@
+/*
+ * The extents (overflow) B-tree file functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_EXTENTS_BTREE_FILE_H )
+#define _LIBFSHFS_EXTENTS_BTREE_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libfshfs_extents_btree_file_get_key_from_record_data(
+     const uint8_t *record_data,
+     size_t record_data_size,
+     uint32_t *identifier,
+     uint8_t *fork_type,
+     uint32_t *start_block_number,
+     size_t *record_data_offset,
+     libcerror_error_t **error );
+
+int libfshfs_extents_btree_file_compare_keys(
+     uint32_t first_identifier,
+     uint8_t first_fork_type,
+     uint32_t first_start_block_number,
+     uint32_t second_identifier,
+     uint8_t second_fork_type,
+     uint32_t second_start_block_number );
+
+int libfshfs_extents_btree_file_append_extents_data(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_extents_btree_file_get_extents_from_node(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_btree_node_t *node,
+     uint32_t identifier,
+     uint8_t fork_type,
+     uint32_t start_block_number,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libfshfs_extents_btree_file_get_overflow_extents(
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t identifier,
+     uint8_t fork_type,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_EXTENTS_BTREE_FILE_H ) */
+
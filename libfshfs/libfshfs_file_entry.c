@@ -23,11 +23,35 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libfshfs_allocation_block_stream.h"
+#include "libfshfs_atomic.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_catalog_btree_file.h"
+#include "libfshfs_definitions.h"
 #include "libfshfs_directory_entry.h"
+#include "libfshfs_extents_btree_file.h"
 #include "libfshfs_file_entry.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_kernel_copy.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcthreads.h"
+#include "libfshfs_libfdata.h"
+#include "libfshfs_libuna.h"
+#include "libfshfs_listing_cursor.h"
+#include "libfshfs_memory_arena.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
+#include "libfshfs_thread_record.h"
+
+/* The size of the data of a sub directory entries memory arena block
+ */
+#define LIBFSHFS_FILE_ENTRY_MEMORY_ARENA_BLOCK_SIZE	32768
+
+/* The size of the buffer used to export data that cannot be copied by the kernel
+ */
+#define LIBFSHFS_FILE_ENTRY_EXPORT_BUFFER_SIZE		1048576
 
 /* Creates a file_entry
  * Make sure the value file_entry is referencing, is set to NULL
@@ -36,8 +60,10 @@
 int libfshfs_file_entry_initialize(
      libfshfs_file_entry_t **file_entry,
      libfshfs_directory_entry_t *directory_entry,
+     libfshfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfshfs_btree_file_t *catalog_btree_file,
+     libfshfs_btree_file_t *extents_btree_file,
      libcerror_error_t **error )
 {
 	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
@@ -76,6 +102,17 @@ int libfshfs_file_entry_initialize(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -126,10 +163,24 @@ int libfshfs_file_entry_initialize(
 
 		goto on_error;
 	}
-/* TODO clone directory_entry */
+	if( libfshfs_directory_entry_reference(
+	     directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reference directory entry.",
+		 function );
+
+		goto on_error;
+	}
 	internal_file_entry->directory_entry    = directory_entry;
+	internal_file_entry->io_handle          = io_handle;
 	internal_file_entry->file_io_handle     = file_io_handle;
 	internal_file_entry->catalog_btree_file = catalog_btree_file;
+	internal_file_entry->extents_btree_file = extents_btree_file;
 
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
@@ -201,9 +252,9 @@ int libfshfs_file_entry_free(
 			result = -1;
 		}
 #endif
-		/* The directory_entry, file_io_handle and catalog_btree_file references are freed elsewhere
+		/* The io_handle, file_io_handle, catalog_btree_file and extents_btree_file references are freed elsewhere
+		 * The directory_entry is reference counted and only released here
 		 */
-#ifdef TODO
 		if( libfshfs_directory_entry_free(
 		     &( internal_file_entry->directory_entry ),
 		     error ) != 1 )
@@ -212,12 +263,11 @@ int libfshfs_file_entry_free(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free directory entry array.",
+			 "%s: unable to free directory entry.",
 			 function );
 
 			result = -1;
 		}
-#endif
 		if( internal_file_entry->sub_directory_entries != NULL )
 		{
 			if( libcdata_array_free(
@@ -235,6 +285,91 @@ int libfshfs_file_entry_free(
 				result = -1;
 			}
 		}
+		if( internal_file_entry->sub_directory_entries_memory_arena != NULL )
+		{
+			if( libfshfs_memory_arena_free(
+			     &( internal_file_entry->sub_directory_entries_memory_arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub directory entries memory arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_file_entry->path != NULL )
+		{
+			memory_free(
+			 internal_file_entry->path );
+		}
+		if( internal_file_entry->data_fork_descriptor != NULL )
+		{
+			if( libfshfs_fork_descriptor_free(
+			     &( internal_file_entry->data_fork_descriptor ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data fork descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_file_entry->resource_fork_descriptor != NULL )
+		{
+			if( libfshfs_fork_descriptor_free(
+			     &( internal_file_entry->resource_fork_descriptor ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free resource fork descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_file_entry->data_stream != NULL )
+		{
+			if( libfdata_stream_free(
+			     &( internal_file_entry->data_stream ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data stream.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_file_entry->resource_fork_stream != NULL )
+		{
+			if( libfdata_stream_free(
+			     &( internal_file_entry->resource_fork_stream ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free resource fork stream.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_file_entry );
 	}
@@ -433,19 +568,24 @@ int libfshfs_file_entry_get_utf16_name(
 	return( 1 );
 }
 
-/* Retrieves the number of sub file entries
+/* Retrieves the parent identifier and name of a specific directory identifier from the path cache
+ * If the directory is not cached its thread record is read from the catalog B-tree file
+ * and added to the path cache
  * Returns 1 if successful or -1 on error
  */
-int libfshfs_file_entry_get_number_of_sub_file_entries(
-     libfshfs_file_entry_t *file_entry,
-     int *number_of_sub_file_entries,
+int libfshfs_internal_file_entry_get_path_cache_entry(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     const uint8_t **name,
+     uint16_t *name_size,
      libcerror_error_t **error )
 {
-	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                               = "libfshfs_file_entry_get_number_of_sub_file_entries";
-	uint32_t identifier                                 = 0;
+	libfshfs_thread_record_t *thread_record = NULL;
+	static char *function                   = "libfshfs_internal_file_entry_get_path_cache_entry";
+	int result                              = 0;
 
-	if( file_entry == NULL )
+	if( internal_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -456,92 +596,131 @@ int libfshfs_file_entry_get_number_of_sub_file_entries(
 
 		return( -1 );
 	}
-	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          internal_file_entry->path_cache,
+	          identifier,
+	          parent_identifier,
+	          name,
+	          name_size,
+	          error );
 
-	if( internal_file_entry->sub_directory_entries == NULL )
+	if( result == -1 )
 	{
-		if( libfshfs_directory_entry_get_identifier(
-		     internal_file_entry->directory_entry,
-		     &identifier,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve identifier.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path cache entry: %" PRIu32 ".",
+		 function,
+		 identifier );
 
-			return( -1 );
-		}
-		if( libcdata_array_initialize(
-		     &( internal_file_entry->sub_directory_entries ),
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sub directory entries array.",
-			 function );
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	result = libfshfs_catalog_btree_file_get_thread_record(
+	          internal_file_entry->catalog_btree_file,
+	          internal_file_entry->file_io_handle,
+	          identifier,
+	          &thread_record,
+	          error );
 
-			return( -1 );
-		}
-		if( libfshfs_catalog_btree_file_get_directory_entries(
-		     internal_file_entry->catalog_btree_file,
-		     internal_file_entry->file_io_handle,
-		     identifier,
-		     internal_file_entry->sub_directory_entries,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub directory entries from catalog B-tree file.",
-			 function );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve thread record: %" PRIu32 " from catalog B-tree file.",
+		 function,
+		 identifier );
 
-			libcdata_array_free(
-			 &( internal_file_entry->sub_directory_entries ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
-			 NULL );
+		goto on_error;
+	}
+	if( libfshfs_path_cache_insert_entry(
+	     internal_file_entry->path_cache,
+	     identifier,
+	     thread_record->parent_identifier,
+	     thread_record->name,
+	     thread_record->name_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert path cache entry: %" PRIu32 ".",
+		 function,
+		 identifier );
 
-			return( -1 );
-		}
+		goto on_error;
 	}
-	if( libcdata_array_get_number_of_entries(
-	     internal_file_entry->sub_directory_entries,
-	     number_of_sub_file_entries,
+	if( libfshfs_thread_record_free(
+	     &thread_record,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub directory entries.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free thread record.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          internal_file_entry->path_cache,
+	          identifier,
+	          parent_identifier,
+	          name,
+	          name_size,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path cache entry: %" PRIu32 ".",
+		 function,
+		 identifier );
+
+		goto on_error;
 	}
 	return( 1 );
+
+on_error:
+	if( thread_record != NULL )
+	{
+		libfshfs_thread_record_free(
+		 &thread_record,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the sub file entry for the specific index
+/* Reads the path
+ * The path consists of the names of the ancestor directories and the file entry, separated by '/'
+ * The path of the root directory is "/"
  * Returns 1 if successful or -1 on error
  */
-int libfshfs_file_entry_get_sub_file_entry_by_index(
-     libfshfs_file_entry_t *file_entry,
-     int sub_file_entry_index,
-     libfshfs_file_entry_t **sub_file_entry,
+int libfshfs_internal_file_entry_read_path(
+     libfshfs_internal_file_entry_t *internal_file_entry,
      libcerror_error_t **error )
 {
-	libfshfs_directory_entry_t *sub_directory_entry     = NULL;
-	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
-	static char *function                               = "libfshfs_file_entry_get_sub_file_entry_by_index";
-	uint32_t identifier                                 = 0;
+	const uint8_t *name        = NULL;
+	uint8_t *safe_path         = NULL;
+	static char *function      = "libfshfs_internal_file_entry_read_path";
+	size_t path_index          = 0;
+	size_t path_size           = 0;
+	uint32_t parent_identifier = 0;
+	uint16_t name_size         = 0;
+	int depth                  = 0;
 
-	if( file_entry == NULL )
+	if( internal_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -552,121 +731,3915 @@ int libfshfs_file_entry_get_sub_file_entry_by_index(
 
 		return( -1 );
 	}
-	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing directory entry.",
+		 function );
 
-	if( sub_file_entry == NULL )
+		return( -1 );
+	}
+	if( internal_file_entry->path_cache == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sub file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing path cache.",
 		 function );
 
 		return( -1 );
 	}
-	if( *sub_file_entry != NULL )
+	if( internal_file_entry->path != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid sub file entry value already set.",
+		 "%s: invalid file entry - path value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file_entry->sub_directory_entries == NULL )
+	/* The first pass determines the path size and adds the ancestor directories to the path cache
+	 */
+	path_size         = 2;
+	parent_identifier = internal_file_entry->directory_entry->parent_identifier;
+
+	/* The parent of the root directory is the root folder thread record with identifier 1
+	 */
+	if( parent_identifier > 1 )
 	{
-		if( libfshfs_directory_entry_get_identifier(
-		     internal_file_entry->directory_entry,
-		     &identifier,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve identifier.",
-			 function );
+		path_size += internal_file_entry->directory_entry->name_size;
 
-			return( -1 );
-		}
-		if( libcdata_array_initialize(
-		     &( internal_file_entry->sub_directory_entries ),
-		     0,
-		     error ) != 1 )
+		while( parent_identifier != LIBFSHFS_ROOT_DIRECTORY_IDENTIFIER )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sub directory entries array.",
-			 function );
+			if( ( parent_identifier <= 1 )
+			 || ( depth >= LIBFSHFS_MAXIMUM_PATH_DEPTH ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid parent identifier: %" PRIu32 " value out of bounds.",
+				 function,
+				 parent_identifier );
 
-			return( -1 );
-		}
-		if( libfshfs_catalog_btree_file_get_directory_entries(
-		     internal_file_entry->catalog_btree_file,
-		     internal_file_entry->file_io_handle,
-		     identifier,
-		     internal_file_entry->sub_directory_entries,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub directory entries from catalog B-tree file.",
-			 function );
+				goto on_error;
+			}
+			if( libfshfs_internal_file_entry_get_path_cache_entry(
+			     internal_file_entry,
+			     parent_identifier,
+			     &parent_identifier,
+			     &name,
+			     &name_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve path cache entry.",
+				 function );
 
-			libcdata_array_free(
-			 &( internal_file_entry->sub_directory_entries ),
-			 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
-			 NULL );
+				goto on_error;
+			}
+			path_size += 2 + (size_t) name_size;
 
-			return( -1 );
+			depth++;
 		}
 	}
-	if( libcdata_array_get_entry_by_index(
-	     internal_file_entry->sub_directory_entries,
-	     sub_file_entry_index,
-	     (intptr_t **) &sub_directory_entry,
-	     error ) != 1 )
+	safe_path = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * path_size );
+
+	if( safe_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	/* The second pass fills the path from the end using the cached ancestor directories
+	 */
+	path_index        = path_size;
+	parent_identifier = internal_file_entry->directory_entry->parent_identifier;
+
+	if( parent_identifier > 1 )
+	{
+		path_index -= internal_file_entry->directory_entry->name_size;
+
+		if( memory_copy(
+		     &( safe_path[ path_index ] ),
+		     internal_file_entry->directory_entry->name,
+		     (size_t) internal_file_entry->directory_entry->name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name to path.",
+			 function );
+
+			goto on_error;
+		}
+		while( parent_identifier != LIBFSHFS_ROOT_DIRECTORY_IDENTIFIER )
+		{
+			path_index -= 2;
+
+			safe_path[ path_index ]     = 0x00;
+			safe_path[ path_index + 1 ] = (uint8_t) LIBFSHFS_SEPARATOR;
+
+			if( libfshfs_internal_file_entry_get_path_cache_entry(
+			     internal_file_entry,
+			     parent_identifier,
+			     &parent_identifier,
+			     &name,
+			     &name_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve path cache entry.",
+				 function );
+
+				goto on_error;
+			}
+			if( (size_t) name_size > ( path_index - 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid name size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			path_index -= name_size;
+
+			if( memory_copy(
+			     &( safe_path[ path_index ] ),
+			     name,
+			     (size_t) name_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy name to path.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( path_index != 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path index value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	safe_path[ 0 ] = 0x00;
+	safe_path[ 1 ] = (uint8_t) LIBFSHFS_SEPARATOR;
+
+	/* The path size is set before the path is published
+	 */
+	internal_file_entry->path_size = path_size;
+
+	libfshfs_atomic_set_pointer(
+	 &( internal_file_entry->path ),
+	 safe_path );
+
+	return( 1 );
+
+on_error:
+	if( safe_path != NULL )
+	{
+		memory_free(
+		 safe_path );
+	}
+	return( -1 );
+}
+
+/* Retrieves the path
+ * The path is read on first access and published once, after which it is retrieved without locking
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_get_path(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_path    = NULL;
+	static char *function = "libfshfs_internal_file_entry_get_path";
+	int result            = 1;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path size.",
+		 function );
+
+		return( -1 );
+	}
+	safe_path = libfshfs_atomic_get_pointer(
+	             &( internal_file_entry->path ) );
+
+	if( safe_path == NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Another thread could have read the path while this thread was waiting for the lock
+		 */
+		if( internal_file_entry->path == NULL )
+		{
+			if( libfshfs_internal_file_entry_read_path(
+			     internal_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read path.",
+				 function );
+
+				result = -1;
+			}
+		}
+		safe_path = internal_file_entry->path;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	*path      = safe_path;
+	*path_size = internal_file_entry->path_size;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded path
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_entry_get_utf8_path_size(
+     libfshfs_file_entry_t *file_entry,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path                                 = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_utf8_path_size";
+	size_t path_size                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( libfshfs_internal_file_entry_get_path(
+	     internal_file_entry,
+	     &path,
+	     &path_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sub directory entry: %d.",
-		 function,
-		 sub_file_entry_index );
+		 "%s: unable to retrieve path.",
+		 function );
 
 		return( -1 );
 	}
-	if( libfshfs_file_entry_initialize(
-	     sub_file_entry,
-	     sub_directory_entry,
-	     internal_file_entry->file_io_handle,
-	     internal_file_entry->catalog_btree_file,
+	if( libuna_utf8_string_size_from_utf16_stream(
+	     path,
+	     path_size,
+	     LIBUNA_ENDIAN_BIG,
+	     utf8_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
 		 function );
 
-		libfshfs_directory_entry_free(
-		 &sub_directory_entry,
-		 NULL );
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded path
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_entry_get_utf8_path(
+     libfshfs_file_entry_t *file_entry,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path                                 = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_utf8_path";
+	size_t path_size                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( libfshfs_internal_file_entry_get_path(
+	     internal_file_entry,
+	     &path,
+	     &path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path.",
+		 function );
+
+		return( -1 );
+	}
+	if( libuna_utf8_string_copy_from_utf16_stream(
+	     (libuna_utf8_character_t *) utf8_string,
+	     utf8_string_size,
+	     path,
+	     path_size,
+	     LIBUNA_ENDIAN_BIG,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string.",
+		 function );
 
 		return( -1 );
 	}
 	return( 1 );
 }
 
+/* Retrieves the size of the UTF-16 encoded path
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_entry_get_utf16_path_size(
+     libfshfs_file_entry_t *file_entry,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path                                 = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_utf16_path_size";
+	size_t path_size                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( libfshfs_internal_file_entry_get_path(
+	     internal_file_entry,
+	     &path,
+	     &path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path.",
+		 function );
+
+		return( -1 );
+	}
+	if( libuna_utf16_string_size_from_utf16_stream(
+	     path,
+	     path_size,
+	     LIBUNA_ENDIAN_BIG,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-16 encoded path
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_entry_get_utf16_path(
+     libfshfs_file_entry_t *file_entry,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *path                                 = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_utf16_path";
+	size_t path_size                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( libfshfs_internal_file_entry_get_path(
+	     internal_file_entry,
+	     &path,
+	     &path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve path.",
+		 function );
+
+		return( -1 );
+	}
+	if( libuna_utf16_string_copy_from_utf16_stream(
+	     (libuna_utf16_character_t *) utf16_string,
+	     utf16_string_size,
+	     path,
+	     path_size,
+	     LIBUNA_ENDIAN_BIG,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the sub directory entries
+ * The parent index is used, if available, to read the sub directory entries directly
+ * from the catalog B-tree leaf nodes, otherwise the catalog B-tree is searched
+ * The sub directories are added to the path cache, if available
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_read_sub_directory_entries(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *safe_sub_directory_entries      = NULL;
+	libfshfs_directory_entry_t *sub_directory_entry   = NULL;
+	libfshfs_parent_index_entry_t *parent_index_entry = NULL;
+	static char *function                             = "libfshfs_internal_file_entry_read_sub_directory_entries";
+	uint32_t identifier                               = 0;
+	uint32_t sub_identifier                           = 0;
+	int number_of_sub_directory_entries               = 0;
+	int result                                        = 0;
+	int sub_directory_entry_index                     = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->sub_directory_entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry - sub directory entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_directory_entry_get_identifier(
+	     internal_file_entry->directory_entry,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &safe_sub_directory_entries,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub directory entries array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_memory_arena_initialize(
+	     &( internal_file_entry->sub_directory_entries_memory_arena ),
+	     LIBFSHFS_FILE_ENTRY_MEMORY_ARENA_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub directory entries memory arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_file_entry->parent_index != NULL )
+	{
+		result = libfshfs_parent_index_get_entry_by_parent_identifier(
+		          internal_file_entry->parent_index,
+		          identifier,
+		          &parent_index_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent index entry: %" PRIu32 ".",
+			 function,
+			 identifier );
+
+			goto on_error;
+		}
+		/* A parent identifier without records in the parent index has no sub directory entries
+		 */
+		else if( result != 0 )
+		{
+			if( libfshfs_catalog_btree_file_get_directory_entries_from_record(
+			     internal_file_entry->catalog_btree_file,
+			     internal_file_entry->file_io_handle,
+			     identifier,
+			     parent_index_entry->node_number,
+			     parent_index_entry->record_index,
+			     parent_index_entry->number_of_records,
+			     internal_file_entry->sub_directory_entries_memory_arena,
+			     safe_sub_directory_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub directory entries from catalog B-tree leaf nodes.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+	{
+		if( libfshfs_catalog_btree_file_get_directory_entries(
+		     internal_file_entry->catalog_btree_file,
+		     internal_file_entry->file_io_handle,
+		     identifier,
+		     internal_file_entry->sub_directory_entries_memory_arena,
+		     safe_sub_directory_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub directory entries from catalog B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_file_entry->path_cache != NULL )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     safe_sub_directory_entries,
+		     &number_of_sub_directory_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub directory entries.",
+			 function );
+
+			goto on_error;
+		}
+		for( sub_directory_entry_index = 0;
+		     sub_directory_entry_index < number_of_sub_directory_entries;
+		     sub_directory_entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     safe_sub_directory_entries,
+			     sub_directory_entry_index,
+			     (intptr_t **) &sub_directory_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub directory entry: %d.",
+				 function,
+				 sub_directory_entry_index );
+
+				goto on_error;
+			}
+			if( sub_directory_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sub directory entry: %d.",
+				 function,
+				 sub_directory_entry_index );
+
+				goto on_error;
+			}
+			/* Only directories can be ancestors in a path
+			 */
+			if( ( sub_directory_entry->record_type != 0x0001 )
+			 && ( sub_directory_entry->record_type != 0x0100 ) )
+			{
+				continue;
+			}
+			if( libfshfs_directory_entry_get_identifier(
+			     sub_directory_entry,
+			     &sub_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub directory entry: %d identifier.",
+				 function,
+				 sub_directory_entry_index );
+
+				goto on_error;
+			}
+			if( libfshfs_path_cache_insert_entry(
+			     internal_file_entry->path_cache,
+			     sub_identifier,
+			     identifier,
+			     sub_directory_entry->name,
+			     sub_directory_entry->name_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert path cache entry: %" PRIu32 ".",
+				 function,
+				 sub_identifier );
+
+				goto on_error;
+			}
+		}
+	}
+	libfshfs_atomic_set_pointer(
+	 &( internal_file_entry->sub_directory_entries ),
+	 safe_sub_directory_entries );
+
+	return( 1 );
+
+on_error:
+	if( safe_sub_directory_entries != NULL )
+	{
+		libcdata_array_free(
+		 &safe_sub_directory_entries,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
+		 NULL );
+	}
+	if( internal_file_entry->sub_directory_entries_memory_arena != NULL )
+	{
+		libfshfs_memory_arena_free(
+		 &( internal_file_entry->sub_directory_entries_memory_arena ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the sub directory entries
+ * The sub directory entries are read on first access and published once,
+ * after which they are retrieved without locking
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_get_sub_directory_entries(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     libcdata_array_t **sub_directory_entries,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *safe_sub_directory_entries = NULL;
+	static char *function                        = "libfshfs_internal_file_entry_get_sub_directory_entries";
+	int result                                   = 1;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_directory_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	safe_sub_directory_entries = libfshfs_atomic_get_pointer(
+	                              &( internal_file_entry->sub_directory_entries ) );
+
+	if( safe_sub_directory_entries == NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Another thread could have read the sub directory entries while this thread was waiting for the lock
+		 */
+		if( internal_file_entry->sub_directory_entries == NULL )
+		{
+			if( libfshfs_internal_file_entry_read_sub_directory_entries(
+			     internal_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sub directory entries.",
+				 function );
+
+				result = -1;
+			}
+		}
+		safe_sub_directory_entries = internal_file_entry->sub_directory_entries;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	*sub_directory_entries = safe_sub_directory_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the number of sub file entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_number_of_sub_file_entries(
+     libfshfs_file_entry_t *file_entry,
+     int *number_of_sub_file_entries,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sub_directory_entries             = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_number_of_sub_file_entries";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( libfshfs_internal_file_entry_get_sub_directory_entries(
+	     internal_file_entry,
+	     &sub_directory_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     sub_directory_entries,
+	     number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the sub file entry for the specific index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_sub_file_entry_by_index(
+     libfshfs_file_entry_t *file_entry,
+     int sub_file_entry_index,
+     libfshfs_file_entry_t **sub_file_entry,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sub_directory_entries             = NULL;
+	libfshfs_directory_entry_t *sub_directory_entry     = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_sub_file_entry_by_index";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( sub_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_internal_file_entry_get_sub_directory_entries(
+	     internal_file_entry,
+	     &sub_directory_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     sub_directory_entries,
+	     sub_file_entry_index,
+	     (intptr_t **) &sub_directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub directory entry: %d.",
+		 function,
+		 sub_file_entry_index );
+
+		return( -1 );
+	}
+	if( libfshfs_file_entry_initialize(
+	     sub_file_entry,
+	     sub_directory_entry,
+	     internal_file_entry->io_handle,
+	     internal_file_entry->file_io_handle,
+	     internal_file_entry->catalog_btree_file,
+	     internal_file_entry->extents_btree_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		return( -1 );
+	}
+	( (libfshfs_internal_file_entry_t *) *sub_file_entry )->parent_index = internal_file_entry->parent_index;
+	( (libfshfs_internal_file_entry_t *) *sub_file_entry )->path_cache   = internal_file_entry->path_cache;
+
+	return( 1 );
+}
+
+/* Retrieves the metadata values
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_stat(
+     libfshfs_file_entry_t *file_entry,
+     libfshfs_stat_t *stat,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_stat";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( libfshfs_directory_entry_get_stat(
+	     internal_file_entry->directory_entry,
+	     stat,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stat from directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the metadata values of multiple sub file entries
+ * The metadata values of at most number_of_stats sub file entries are retrieved
+ * starting with the sub file entry at first_sub_file_entry_index
+ * Returns the number of metadata values retrieved or -1 on error
+ */
+int libfshfs_file_entry_get_sub_file_entries_stat(
+     libfshfs_file_entry_t *file_entry,
+     int first_sub_file_entry_index,
+     libfshfs_stat_t *stats,
+     int number_of_stats,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sub_directory_entries             = NULL;
+	libfshfs_directory_entry_t *sub_directory_entry     = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_sub_file_entries_stat";
+	int number_of_sub_file_entries                      = 0;
+	int stat_index                                      = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( first_sub_file_entry_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first sub file entry index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stats.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stats < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of stats value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_internal_file_entry_get_sub_directory_entries(
+	     internal_file_entry,
+	     &sub_directory_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     sub_directory_entries,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub directory entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_sub_file_entry_index > number_of_sub_file_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first sub file entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_stats > ( number_of_sub_file_entries - first_sub_file_entry_index ) )
+	{
+		number_of_stats = number_of_sub_file_entries - first_sub_file_entry_index;
+	}
+	for( stat_index = 0;
+	     stat_index < number_of_stats;
+	     stat_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     sub_directory_entries,
+		     first_sub_file_entry_index + stat_index,
+		     (intptr_t **) &sub_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub directory entry: %d.",
+			 function,
+			 first_sub_file_entry_index + stat_index );
+
+			return( -1 );
+		}
+		if( libfshfs_directory_entry_get_stat(
+		     sub_directory_entry,
+		     &( stats[ stat_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stat from sub directory entry: %d.",
+			 function,
+			 first_sub_file_entry_index + stat_index );
+
+			return( -1 );
+		}
+	}
+	return( number_of_stats );
+}
+
+/* Retrieves a page of sub file entries
+ * The listing cursor contains the position after which the page starts and is updated
+ * to the position of the last sub file entry retrieved, hence successive calls list
+ * the sub file entries without reading all the sub directory entries
+ * The sub file entries array should be able to contain maximum_number_of_sub_file_entries values
+ * Returns the number of sub file entries retrieved, 0 if no more sub file entries are available or -1 on error
+ */
+int libfshfs_file_entry_get_sub_file_entries_page(
+     libfshfs_file_entry_t *file_entry,
+     libfshfs_listing_cursor_t *listing_cursor,
+     libfshfs_file_entry_t **sub_file_entries,
+     int maximum_number_of_sub_file_entries,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sub_directory_entries                     = NULL;
+	libfshfs_directory_entry_t *sub_directory_entry             = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry         = NULL;
+	libfshfs_internal_listing_cursor_t *internal_listing_cursor = NULL;
+	libfshfs_parent_index_entry_t *parent_index_entry           = NULL;
+	const uint8_t *last_name                                    = NULL;
+	static char *function                                       = "libfshfs_file_entry_get_sub_file_entries_page";
+	uint32_t identifier                                         = 0;
+	uint32_t node_number                                        = 0;
+	uint16_t last_name_size                                     = 0;
+	uint16_t record_index                                       = 0;
+	int number_of_sub_file_entries                              = 0;
+	int result                                                  = 0;
+	int sub_file_entry_index                                    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	internal_listing_cursor = (libfshfs_internal_listing_cursor_t *) listing_cursor;
+
+	if( sub_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_sub_file_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of sub file entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_directory_entry_get_identifier(
+	     internal_file_entry->directory_entry,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_listing_cursor->node_number != 0 )
+	 && ( internal_listing_cursor->parent_identifier != identifier ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid listing cursor - parent identifier does not match file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &sub_directory_entries,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub directory entries array.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_listing_cursor->node_number != 0 )
+	{
+		node_number    = internal_listing_cursor->node_number;
+		record_index   = internal_listing_cursor->record_index;
+		last_name      = internal_listing_cursor->name;
+		last_name_size = internal_listing_cursor->name_size;
+
+		result = 1;
+	}
+	else if( internal_file_entry->parent_index != NULL )
+	{
+		result = libfshfs_parent_index_get_entry_by_parent_identifier(
+		          internal_file_entry->parent_index,
+		          identifier,
+		          &parent_index_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent index entry: %" PRIu32 ".",
+			 function,
+			 identifier );
+		}
+		else if( result != 0 )
+		{
+			node_number  = parent_index_entry->node_number;
+			record_index = parent_index_entry->record_index;
+		}
+	}
+	else
+	{
+		result = libfshfs_catalog_btree_file_get_first_record_by_parent_identifier(
+		          internal_file_entry->catalog_btree_file,
+		          internal_file_entry->file_io_handle,
+		          identifier,
+		          &node_number,
+		          &record_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve first catalog B-tree record of parent: %" PRIu32 ".",
+			 function,
+			 identifier );
+		}
+	}
+	/* A parent identifier without records in the catalog B-tree has no sub file entries
+	 */
+	if( result == 1 )
+	{
+		result = libfshfs_catalog_btree_file_get_directory_entries_page(
+		          internal_file_entry->catalog_btree_file,
+		          internal_file_entry->file_io_handle,
+		          identifier,
+		          &node_number,
+		          &record_index,
+		          last_name,
+		          last_name_size,
+		          maximum_number_of_sub_file_entries,
+		          sub_directory_entries,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve page of sub directory entries from catalog B-tree file.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid listing cursor - position does not match catalog B-tree file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     sub_directory_entries,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub directory entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_file_entry_index = 0;
+	     sub_file_entry_index < number_of_sub_file_entries;
+	     sub_file_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     sub_directory_entries,
+		     sub_file_entry_index,
+		     (intptr_t **) &sub_directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub directory entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		sub_file_entries[ sub_file_entry_index ] = NULL;
+
+		if( libfshfs_file_entry_initialize(
+		     &( sub_file_entries[ sub_file_entry_index ] ),
+		     sub_directory_entry,
+		     internal_file_entry->io_handle,
+		     internal_file_entry->file_io_handle,
+		     internal_file_entry->catalog_btree_file,
+		     internal_file_entry->extents_btree_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		( (libfshfs_internal_file_entry_t *) sub_file_entries[ sub_file_entry_index ] )->parent_index = internal_file_entry->parent_index;
+		( (libfshfs_internal_file_entry_t *) sub_file_entries[ sub_file_entry_index ] )->path_cache   = internal_file_entry->path_cache;
+	}
+	/* The cursor is only updated after all sub file entries were created
+	 * so that the page can be retrieved again on error
+	 */
+	if( sub_directory_entry != NULL )
+	{
+		if( libfshfs_internal_listing_cursor_set_position(
+		     internal_listing_cursor,
+		     identifier,
+		     node_number,
+		     record_index,
+		     sub_directory_entry->name,
+		     sub_directory_entry->name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set listing cursor position.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The sub file entries hold their own reference to the sub directory entries
+	 */
+	if( libcdata_array_free(
+	     &sub_directory_entries,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sub directory entries array.",
+		 function );
+
+		goto on_error;
+	}
+	return( number_of_sub_file_entries );
+
+on_error:
+	while( sub_file_entry_index > 0 )
+	{
+		sub_file_entry_index--;
+
+		libfshfs_file_entry_free(
+		 &( sub_file_entries[ sub_file_entry_index ] ),
+		 NULL );
+	}
+	if( sub_directory_entries != NULL )
+	{
+		libcdata_array_free(
+		 &sub_directory_entries,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_directory_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the fork descriptor of a specific fork
+ * The fork descriptor is copied from the directory entry on first access and
+ * includes the overflow extents stored in the extents B-tree file
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_internal_file_entry_get_fork_descriptor(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t **internal_fork_descriptor = NULL;
+	libfshfs_fork_descriptor_t *safe_fork_descriptor      = NULL;
+	static char *function                                 = "libfshfs_internal_file_entry_get_fork_descriptor";
+	uint32_t identifier                                   = 0;
+	int result                                            = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_type == LIBFSHFS_FORK_TYPE_DATA )
+	{
+		internal_fork_descriptor = &( internal_file_entry->data_fork_descriptor );
+	}
+	else if( fork_type == LIBFSHFS_FORK_TYPE_RESOURCE )
+	{
+		internal_fork_descriptor = &( internal_file_entry->resource_fork_descriptor );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fork type: 0x%02" PRIx8 ".",
+		 function,
+		 fork_type );
+
+		return( -1 );
+	}
+	if( *internal_fork_descriptor == NULL )
+	{
+		if( internal_file_entry->directory_entry == NULL )
+		{
+			return( 0 );
+		}
+		if( fork_type == LIBFSHFS_FORK_TYPE_DATA )
+		{
+			result = libfshfs_directory_entry_get_data_fork_descriptor(
+			          internal_file_entry->directory_entry,
+			          &safe_fork_descriptor,
+			          error );
+		}
+		else
+		{
+			result = libfshfs_directory_entry_get_resource_fork_descriptor(
+			          internal_file_entry->directory_entry,
+			          &safe_fork_descriptor,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve fork descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfshfs_directory_entry_get_identifier(
+		     internal_file_entry->directory_entry,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier.",
+			 function );
+
+			return( -1 );
+		}
+		/* The fork descriptor of the directory entry is shared and therefore copied
+		 * before the overflow extents are added
+		 */
+		if( libfshfs_fork_descriptor_clone(
+		     internal_fork_descriptor,
+		     safe_fork_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create fork descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_extents_btree_file_get_overflow_extents(
+		     internal_file_entry->extents_btree_file,
+		     internal_file_entry->file_io_handle,
+		     identifier,
+		     fork_type,
+		     *internal_fork_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve overflow extents.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*fork_descriptor = *internal_fork_descriptor;
+
+	return( 1 );
+
+on_error:
+	if( *internal_fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 internal_fork_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the allocation block stream of a specific fork
+ * The stream is created on first access
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_internal_file_entry_get_fork_stream(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     libfdata_stream_t **fork_stream,
+     libcerror_error_t **error )
+{
+	libfdata_stream_t **internal_fork_stream    = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	static char *function                       = "libfshfs_internal_file_entry_get_fork_stream";
+	int result                                  = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_type == LIBFSHFS_FORK_TYPE_DATA )
+	{
+		internal_fork_stream = &( internal_file_entry->data_stream );
+	}
+	else if( fork_type == LIBFSHFS_FORK_TYPE_RESOURCE )
+	{
+		internal_fork_stream = &( internal_file_entry->resource_fork_stream );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fork type: 0x%02" PRIx8 ".",
+		 function,
+		 fork_type );
+
+		return( -1 );
+	}
+	if( *internal_fork_stream == NULL )
+	{
+		result = libfshfs_internal_file_entry_get_fork_descriptor(
+		          internal_file_entry,
+		          fork_type,
+		          &fork_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve fork descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( libfshfs_allocation_block_stream_initialize(
+		     internal_fork_stream,
+		     internal_file_entry->io_handle,
+		     fork_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create fork stream.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*fork_stream = *internal_fork_stream;
+
+	return( 1 );
+}
+
+/* Reads data at the current offset of a specific fork into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_internal_file_entry_read_fork_buffer(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfdata_stream_t *fork_stream = NULL;
+	static char *function          = "libfshfs_internal_file_entry_read_fork_buffer";
+	ssize_t read_count             = 0;
+	int result                     = 0;
+
+	result = libfshfs_internal_file_entry_get_fork_stream(
+	          internal_file_entry,
+	          fork_type,
+	          &fork_stream,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing fork: 0x%02" PRIx8 ".",
+		 function,
+		 fork_type );
+
+		return( -1 );
+	}
+	read_count = libfdata_stream_read_buffer(
+	              fork_stream,
+	              (intptr_t *) internal_file_entry->file_io_handle,
+	              buffer,
+	              buffer_size,
+	              0,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Seeks a certain offset in a specific fork
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfshfs_internal_file_entry_seek_fork_offset(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libfdata_stream_t *fork_stream = NULL;
+	static char *function          = "libfshfs_internal_file_entry_seek_fork_offset";
+	int result                     = 0;
+
+	result = libfshfs_internal_file_entry_get_fork_stream(
+	          internal_file_entry,
+	          fork_type,
+	          &fork_stream,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing fork: 0x%02" PRIx8 ".",
+		 function,
+		 fork_type );
+
+		return( -1 );
+	}
+	offset = libfdata_stream_seek_offset(
+	          fork_stream,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( offset );
+}
+
+/* Retrieves the current offset in a specific fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_get_fork_offset(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libfdata_stream_t *fork_stream = NULL;
+	static char *function          = "libfshfs_internal_file_entry_get_fork_offset";
+	int result                     = 0;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfshfs_internal_file_entry_get_fork_stream(
+	          internal_file_entry,
+	          fork_type,
+	          &fork_stream,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*offset = 0;
+
+		return( 1 );
+	}
+	if( libfdata_stream_get_offset(
+	     fork_stream,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset from fork stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of a specific fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_get_fork_size(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_internal_file_entry_get_fork_size";
+	int result            = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->directory_entry != NULL )
+	{
+		if( fork_type == LIBFSHFS_FORK_TYPE_DATA )
+		{
+			result = libfshfs_directory_entry_get_data_fork_size(
+			          internal_file_entry->directory_entry,
+			          size,
+			          error );
+		}
+		else if( fork_type == LIBFSHFS_FORK_TYPE_RESOURCE )
+		{
+			result = libfshfs_directory_entry_get_resource_fork_size(
+			          internal_file_entry->directory_entry,
+			          size,
+			          error );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported fork type: 0x%02" PRIx8 ".",
+			 function,
+			 fork_type );
+
+			return( -1 );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve fork size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		*size = 0;
+	}
+	return( 1 );
+}
+
+/* Reads data at the current offset of the data fork into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_file_entry_read_buffer(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_read_buffer";
+	ssize_t read_count                                  = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfshfs_internal_file_entry_read_fork_buffer(
+	              internal_file_entry,
+	              LIBFSHFS_FORK_TYPE_DATA,
+	              (uint8_t *) buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from data fork.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset of the data fork into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_file_entry_read_buffer_at_offset(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_read_buffer_at_offset";
+	ssize_t read_count                                  = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_file_entry_seek_fork_offset(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_DATA,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in data fork.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfshfs_internal_file_entry_read_fork_buffer(
+		              internal_file_entry,
+		              LIBFSHFS_FORK_TYPE_DATA,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from data fork.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Seeks a certain offset in the data fork
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfshfs_file_entry_seek_offset(
+         libfshfs_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_seek_offset";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libfshfs_internal_file_entry_seek_fork_offset(
+	          internal_file_entry,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in data fork.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset in the data fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_offset(
+     libfshfs_file_entry_t *file_entry,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_offset";
+	int result                                          = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_file_entry_get_fork_offset(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_DATA,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset of data fork.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the data fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_size(
+     libfshfs_file_entry_t *file_entry,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_size";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( libfshfs_internal_file_entry_get_fork_size(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_DATA,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of data fork.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at the current offset of the resource fork into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_file_entry_read_resource_fork_buffer(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_read_resource_fork_buffer";
+	ssize_t read_count                                  = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfshfs_internal_file_entry_read_fork_buffer(
+	              internal_file_entry,
+	              LIBFSHFS_FORK_TYPE_RESOURCE,
+	              (uint8_t *) buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from resource fork.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset of the resource fork into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_file_entry_read_resource_fork_buffer_at_offset(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_read_resource_fork_buffer_at_offset";
+	ssize_t read_count                                  = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_file_entry_seek_fork_offset(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_RESOURCE,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in resource fork.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libfshfs_internal_file_entry_read_fork_buffer(
+		              internal_file_entry,
+		              LIBFSHFS_FORK_TYPE_RESOURCE,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from resource fork.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Seeks a certain offset in the resource fork
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libfshfs_file_entry_seek_resource_fork_offset(
+         libfshfs_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_seek_resource_fork_offset";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libfshfs_internal_file_entry_seek_fork_offset(
+	          internal_file_entry,
+	          LIBFSHFS_FORK_TYPE_RESOURCE,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in resource fork.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset in the resource fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_resource_fork_offset(
+     libfshfs_file_entry_t *file_entry,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_resource_fork_offset";
+	int result                                          = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_file_entry_get_fork_offset(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_RESOURCE,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset of resource fork.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the resource fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_get_resource_fork_size(
+     libfshfs_file_entry_t *file_entry,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_get_resource_fork_size";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	if( libfshfs_internal_file_entry_get_fork_size(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_RESOURCE,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of resource fork.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Exports a range of a specific fork to a file descriptor by reading it into a buffer
+ * The offset is relative to the start of the fork
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_export_fork_range_to_fd(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     off64_t offset,
+     size64_t size,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "libfshfs_internal_file_entry_export_fork_range_to_fd";
+	size64_t export_size  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	if( libfshfs_internal_file_entry_seek_fork_offset(
+	     internal_file_entry,
+	     fork_type,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in fork.",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	if( libfshfs_buffer_pool_get_buffer(
+	     internal_file_entry->io_handle->buffer_pool,
+	     LIBFSHFS_FILE_ENTRY_EXPORT_BUFFER_SIZE,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve export buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( export_size < size )
+	{
+		read_size = LIBFSHFS_FILE_ENTRY_EXPORT_BUFFER_SIZE;
+
+		if( read_size > ( size - export_size ) )
+		{
+			read_size = (size_t) ( size - export_size );
+		}
+		read_count = libfshfs_internal_file_entry_read_fork_buffer(
+		              internal_file_entry,
+		              fork_type,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from fork at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset + (off64_t) export_size,
+			 offset + (off64_t) export_size );
+
+			goto on_error;
+		}
+		if( libfshfs_kernel_copy_write_buffer(
+		     file_descriptor,
+		     buffer,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer to file descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		export_size += (size64_t) read_count;
+	}
+	if( libfshfs_buffer_pool_release_buffer(
+	     internal_file_entry->io_handle->buffer_pool,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release export buffer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		libfshfs_buffer_pool_release_buffer(
+		 internal_file_entry->io_handle->buffer_pool,
+		 &buffer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports a specific fork to a file descriptor
+ * Extents that are not overlaid by the journal are copied by the kernel if supported,
+ * other data is exported by reading it into a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_file_entry_export_fork_to_fd(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	static char *function                       = "libfshfs_internal_file_entry_export_fork_to_fd";
+	size64_t copied_size                        = 0;
+	size64_t extent_size                        = 0;
+	size64_t extents_size                       = 0;
+	off64_t export_offset                       = 0;
+	off64_t extent_offset                       = 0;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t start_block_number                 = 0;
+	int extent_index                            = 0;
+	int number_of_extents                       = 0;
+	int result                                  = 0;
+	int use_kernel_copy                         = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->directory_entry == NULL )
+	{
+		return( 1 );
+	}
+	result = libfshfs_internal_file_entry_get_fork_descriptor(
+	          internal_file_entry,
+	          fork_type,
+	          &fork_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine if the extents cover the fork before any data is written
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( extents_size >= fork_descriptor->size )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		extents_size += (size64_t) number_of_blocks * internal_file_entry->io_handle->allocation_block_size;
+	}
+	if( extents_size < fork_descriptor->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fork - data beyond the extents of the fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->io_handle->kernel_copy != NULL )
+	{
+		use_kernel_copy = libfshfs_kernel_copy_open_source(
+		                   internal_file_entry->io_handle->kernel_copy,
+		                   error );
+
+		if( use_kernel_copy == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open kernel copy source file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( (size64_t) export_offset >= fork_descriptor->size )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		extent_offset = (off64_t) start_block_number * internal_file_entry->io_handle->allocation_block_size;
+		extent_size   = (size64_t) number_of_blocks * internal_file_entry->io_handle->allocation_block_size;
+
+		/* The last allocation block can contain data beyond the end of the fork
+		 */
+		if( extent_size > ( fork_descriptor->size - (size64_t) export_offset ) )
+		{
+			extent_size = fork_descriptor->size - (size64_t) export_offset;
+		}
+		copied_size = 0;
+		result      = 0;
+
+		if( use_kernel_copy != 0 )
+		{
+			/* Extents that are overlaid by the journal are read from the volume and the journal
+			 */
+			if( internal_file_entry->io_handle->journal != NULL )
+			{
+				result = libfshfs_journal_range_has_overlay(
+				          internal_file_entry->io_handle->journal,
+				          extent_offset,
+				          extent_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if extent: %d is overlaid by the journal.",
+					 function,
+					 extent_index );
+
+					return( -1 );
+				}
+			}
+			if( result == 0 )
+			{
+				result = libfshfs_kernel_copy_copy_range(
+				          internal_file_entry->io_handle->kernel_copy,
+				          extent_offset,
+				          extent_size,
+				          file_descriptor,
+				          &copied_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to copy extent: %d to file descriptor.",
+					 function,
+					 extent_index );
+
+					return( -1 );
+				}
+			}
+		}
+		if( copied_size < extent_size )
+		{
+			if( libfshfs_internal_file_entry_export_fork_range_to_fd(
+			     internal_file_entry,
+			     fork_type,
+			     export_offset + (off64_t) copied_size,
+			     extent_size - copied_size,
+			     file_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to export extent: %d to file descriptor.",
+				 function,
+				 extent_index );
+
+				return( -1 );
+			}
+		}
+		export_offset += (off64_t) extent_size;
+	}
+	return( 1 );
+}
+
+/* Exports the data fork to a file descriptor
+ * The data is written at the current offset of the file descriptor
+ * The current offset of the data fork is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_entry_export_to_fd(
+     libfshfs_file_entry_t *file_entry,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_export_to_fd";
+	off64_t offset                                      = 0;
+	int result                                          = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_file_entry_get_fork_offset(
+	     internal_file_entry,
+	     LIBFSHFS_FORK_TYPE_DATA,
+	     &offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset of data fork.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfshfs_internal_file_entry_export_fork_to_fd(
+	          internal_file_entry,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          file_descriptor,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to export data fork.",
+		 function );
+
+		result = -1;
+	}
+	/* Restore the offset of the data fork, which is changed if data is exported via a buffer
+	 */
+	if( ( result == 1 )
+	 && ( internal_file_entry->data_stream != NULL ) )
+	{
+		if( libfshfs_internal_file_entry_seek_fork_offset(
+		     internal_file_entry,
+		     LIBFSHFS_FORK_TYPE_DATA,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to restore offset of data fork.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads data at a specific offset of a specific fork into multiple buffers
+ * The buffers are filled in order as if they were a single contiguous buffer
+ * The data is read directly into the buffers, per contiguous run of allocation blocks,
+ * without passing through the block cache
+ * The runs are read concurrently if the IO handle has an I/O thread pool
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_internal_file_entry_read_fork_vectors_at_offset(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         off64_t offset,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	libfshfs_io_thread_pool_read_t *run         = NULL;
+	libfshfs_io_thread_pool_read_t *runs        = NULL;
+	libfshfs_io_vector_t *run_io_vectors        = NULL;
+	static char *function                       = "libfshfs_internal_file_entry_read_fork_vectors_at_offset";
+	size64_t extent_size                        = 0;
+	size64_t read_size                          = 0;
+	size64_t run_size                           = 0;
+	size_t io_vector_offset                     = 0;
+	size_t total_size                           = 0;
+	ssize_t read_count                          = 0;
+	off64_t extent_logical_offset               = 0;
+	off64_t extent_offset                       = 0;
+	off64_t run_logical_offset                  = 0;
+	off64_t run_offset                          = 0;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t start_block_number                 = 0;
+	int extent_index                            = 0;
+	int io_vector_index                         = 0;
+	int number_of_extents                       = 0;
+	int number_of_run_io_vectors                = 0;
+	int number_of_runs                          = 0;
+	int run_index                               = 0;
+	int run_io_vectors_index                    = 0;
+	int result                                  = 0;
+
+	if( internal_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file_entry->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_io_vectors < 0 )
+	 || ( (size_t) number_of_io_vectors > ( (size_t) SSIZE_MAX / sizeof( libfshfs_io_vector_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of IO vectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( io_vector_index = 0;
+	     io_vector_index < number_of_io_vectors;
+	     io_vector_index++ )
+	{
+		if( io_vectors[ io_vector_index ].buffer_size > ( (size_t) SSIZE_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid IO vectors - total buffer size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		total_size += io_vectors[ io_vector_index ].buffer_size;
+	}
+	if( ( total_size == 0 )
+	 || ( internal_file_entry->directory_entry == NULL ) )
+	{
+		return( 0 );
+	}
+	result = libfshfs_internal_file_entry_get_fork_descriptor(
+	          internal_file_entry,
+	          fork_type,
+	          &fork_descriptor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result == 0 )
+	      || ( (size64_t) offset >= fork_descriptor->size ) )
+	{
+		return( 0 );
+	}
+	read_size = fork_descriptor->size - (size64_t) offset;
+
+	if( read_size > (size64_t) total_size )
+	{
+		read_size = (size64_t) total_size;
+	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every extent maps onto at most one run and a run starts in at most one IO vector
+	 * that is shared with the previous run
+	 */
+	if( ( number_of_extents <= 0 )
+	 || ( (size_t) number_of_extents > ( (size_t) SSIZE_MAX / sizeof( libfshfs_io_thread_pool_read_t ) ) )
+	 || ( (size_t) number_of_extents > ( ( (size_t) SSIZE_MAX / sizeof( libfshfs_io_vector_t ) ) - (size_t) number_of_io_vectors ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	runs = (libfshfs_io_thread_pool_read_t *) memory_allocate(
+	                                           sizeof( libfshfs_io_thread_pool_read_t ) * number_of_extents );
+
+	if( runs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create runs.",
+		 function );
+
+		goto on_error;
+	}
+	run_io_vectors = (libfshfs_io_vector_t *) memory_allocate(
+	                                           sizeof( libfshfs_io_vector_t ) * ( (size_t) number_of_io_vectors + (size_t) number_of_extents ) );
+
+	if( run_io_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create run IO vectors.",
+		 function );
+
+		goto on_error;
+	}
+	/* Map the runs of the extents onto the IO vectors
+	 */
+	run_logical_offset = offset;
+	io_vector_index    = 0;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( (size64_t) run_logical_offset >= ( (size64_t) offset + read_size ) )
+		{
+			break;
+		}
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &start_block_number,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		extent_offset = (off64_t) start_block_number * internal_file_entry->io_handle->allocation_block_size;
+		extent_size   = (size64_t) number_of_blocks * internal_file_entry->io_handle->allocation_block_size;
+
+		if( ( extent_logical_offset + (off64_t) extent_size ) <= run_logical_offset )
+		{
+			extent_logical_offset += (off64_t) extent_size;
+
+			continue;
+		}
+		run_offset = extent_offset + ( run_logical_offset - extent_logical_offset );
+		run_size   = (size64_t) ( extent_logical_offset + (off64_t) extent_size - run_logical_offset );
+
+		if( run_size > ( (size64_t) offset + read_size - (size64_t) run_logical_offset ) )
+		{
+			run_size = (size64_t) offset + read_size - (size64_t) run_logical_offset;
+		}
+		run = &( runs[ number_of_runs ] );
+
+		run->offset     = run_offset;
+		run->buffer     = NULL;
+		run->size       = (size_t) run_size;
+		run->io_vectors = &( run_io_vectors[ run_io_vectors_index ] );
+		run->io_handle  = internal_file_entry->io_handle;
+
+		/* Map the run onto the (remaining parts of the) IO vectors
+		 */
+		number_of_run_io_vectors = 0;
+		total_size               = 0;
+
+		while( ( total_size < run_size )
+		    && ( io_vector_index < number_of_io_vectors ) )
+		{
+			run->io_vectors[ number_of_run_io_vectors ].buffer      = &( ( (uint8_t *) io_vectors[ io_vector_index ].buffer )[ io_vector_offset ] );
+			run->io_vectors[ number_of_run_io_vectors ].buffer_size = io_vectors[ io_vector_index ].buffer_size - io_vector_offset;
+
+			if( run->io_vectors[ number_of_run_io_vectors ].buffer_size > ( run_size - total_size ) )
+			{
+				run->io_vectors[ number_of_run_io_vectors ].buffer_size = (size_t) ( run_size - total_size );
+
+				io_vector_offset += run->io_vectors[ number_of_run_io_vectors ].buffer_size;
+			}
+			else
+			{
+				io_vector_offset = 0;
+
+				io_vector_index++;
+			}
+			total_size += run->io_vectors[ number_of_run_io_vectors ].buffer_size;
+
+			number_of_run_io_vectors++;
+		}
+		run->number_of_io_vectors = number_of_run_io_vectors;
+
+		run_io_vectors_index += number_of_run_io_vectors;
+		number_of_runs       += 1;
+
+		run_logical_offset    += (off64_t) run_size;
+		extent_logical_offset += (off64_t) extent_size;
+	}
+	if( (size64_t) run_logical_offset < ( (size64_t) offset + read_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported fork - data beyond the extents of the fork descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every run is read with a single vectored read, when the IO handle has an I/O thread pool
+	 * the runs are read concurrently
+	 */
+	if( ( internal_file_entry->io_handle->io_thread_pool != NULL )
+	 && ( number_of_runs > 1 ) )
+	{
+		if( libfshfs_io_thread_pool_read_buffers(
+		     internal_file_entry->io_handle->io_thread_pool,
+		     runs,
+		     number_of_runs,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read runs of extents.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		for( run_index = 0;
+		     run_index < number_of_runs;
+		     run_index++ )
+		{
+			run = &( runs[ run_index ] );
+
+			read_count = libfshfs_io_handle_read_vectors_at_offset(
+			              internal_file_entry->io_handle,
+			              internal_file_entry->file_io_handle,
+			              run->offset,
+			              run->io_vectors,
+			              run->number_of_io_vectors,
+			              error );
+
+			if( read_count != (ssize_t) run->size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read run: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 run_index,
+				 run->offset,
+				 run->offset );
+
+				goto on_error;
+			}
+		}
+	}
+	memory_free(
+	 run_io_vectors );
+
+	memory_free(
+	 runs );
+
+	return( (ssize_t) read_size );
+
+on_error:
+	if( run_io_vectors != NULL )
+	{
+		memory_free(
+		 run_io_vectors );
+	}
+	if( runs != NULL )
+	{
+		memory_free(
+		 runs );
+	}
+	return( -1 );
+}
+
+/* Reads data at a specific offset of the data fork into multiple buffers
+ * The buffers are filled in order as if they were a single contiguous buffer
+ * The current offset of the data fork is not changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_file_entry_readv(
+         libfshfs_file_entry_t *file_entry,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                               = "libfshfs_file_entry_readv";
+	ssize_t read_count                                  = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	/* The read/write lock is grabbed for writing since the fork descriptor
+	 * is created on first access
+	 */
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libfshfs_internal_file_entry_read_fork_vectors_at_offset(
+	              internal_file_entry,
+	              LIBFSHFS_FORK_TYPE_DATA,
+	              offset,
+	              io_vectors,
+	              number_of_io_vectors,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read IO vectors from data fork.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
 #ifdef TODO
 	libfshfs_thread_record_t *thread_record = NULL;
 
@@ -27,10 +27,18 @@
 
 #include "libfshfs_btree_file.h"
 #include "libfshfs_directory_entry.h"
+#include "libfshfs_extern.h"
+#include "libfshfs_fork_descriptor.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_libbfio.h"
 #include "libfshfs_libcdata.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcthreads.h"
-#include "libfshfs_extern.h"
+#include "libfshfs_libfdata.h"
+#include "libfshfs_memory_arena.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
+#include "libfshfs_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -40,13 +48,17 @@ typedef struct libfshfs_internal_file_entry libfshfs_internal_file_entry_t;
 
 struct libfshfs_internal_file_entry
 {
+	/* The values below do not change after the file entry has been created
+	 * and are read without holding the read/write lock
+	 */
+
 	/* Directory entry
 	 */
 	libfshfs_directory_entry_t *directory_entry;
 
-	/* Sub directory entries
+	/* The IO handle
 	 */
-	libcdata_array_t *sub_directory_entries;
+	libfshfs_io_handle_t *io_handle;
 
 	/* The file IO handle
 	 */
@@ -56,6 +68,57 @@ struct libfshfs_internal_file_entry
 	 */
 	libfshfs_btree_file_t *catalog_btree_file;
 
+	/* The extents (overflow) btree file
+	 */
+	libfshfs_btree_file_t *extents_btree_file;
+
+	/* The parent index, which is not managed by the file entry
+	 */
+	libfshfs_parent_index_t *parent_index;
+
+	/* The path cache, which is not managed by the file entry
+	 */
+	libfshfs_path_cache_t *path_cache;
+
+	/* The values below are read on first access while holding the read/write lock
+	 * and published once, after which they are read without holding the lock
+	 */
+
+	/* Sub directory entries
+	 */
+	libcdata_array_t *sub_directory_entries;
+
+	/* The memory arena from which the sub directory entries are allocated
+	 */
+	libfshfs_memory_arena_t *sub_directory_entries_memory_arena;
+
+	/* The path, which is stored as an UTF-16 big-endian stream
+	 */
+	uint8_t *path;
+
+	/* The path size, which is set before the path is published
+	 */
+	size_t path_size;
+
+	/* The values below are only accessed while holding the read/write lock
+	 */
+
+	/* The data fork descriptor, including the overflow extents
+	 */
+	libfshfs_fork_descriptor_t *data_fork_descriptor;
+
+	/* The resource fork descriptor, including the overflow extents
+	 */
+	libfshfs_fork_descriptor_t *resource_fork_descriptor;
+
+	/* The data fork stream
+	 */
+	libfdata_stream_t *data_stream;
+
+	/* The resource fork stream
+	 */
+	libfdata_stream_t *resource_fork_stream;
+
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -66,8 +129,10 @@ struct libfshfs_internal_file_entry
 int libfshfs_file_entry_initialize(
      libfshfs_file_entry_t **file_entry,
      libfshfs_directory_entry_t *directory_entry,
+     libfshfs_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libfshfs_btree_file_t *catalog_btree_file,
+     libfshfs_btree_file_t *extents_btree_file,
      libcerror_error_t **error );
 
 LIBFSHFS_EXTERN \
@@ -101,6 +166,59 @@ int libfshfs_file_entry_get_utf16_name(
      size_t utf16_string_size,
      libcerror_error_t **error );
 
+int libfshfs_internal_file_entry_get_path_cache_entry(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     const uint8_t **name,
+     uint16_t *name_size,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_read_path(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_path(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     const uint8_t **path,
+     size_t *path_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_utf8_path_size(
+     libfshfs_file_entry_t *file_entry,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_utf8_path(
+     libfshfs_file_entry_t *file_entry,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_utf16_path_size(
+     libfshfs_file_entry_t *file_entry,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_utf16_path(
+     libfshfs_file_entry_t *file_entry,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_read_sub_directory_entries(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_sub_directory_entries(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     libcdata_array_t **sub_directory_entries,
+     libcerror_error_t **error );
+
 LIBFSHFS_EXTERN \
 int libfshfs_file_entry_get_number_of_sub_file_entries(
      libfshfs_file_entry_t *file_entry,
@@ -114,6 +232,170 @@ int libfshfs_file_entry_get_sub_file_entry_by_index(
      libfshfs_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_stat(
+     libfshfs_file_entry_t *file_entry,
+     libfshfs_stat_t *stat,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_sub_file_entries_stat(
+     libfshfs_file_entry_t *file_entry,
+     int first_sub_file_entry_index,
+     libfshfs_stat_t *stats,
+     int number_of_stats,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_sub_file_entries_page(
+     libfshfs_file_entry_t *file_entry,
+     libfshfs_listing_cursor_t *listing_cursor,
+     libfshfs_file_entry_t **sub_file_entries,
+     int maximum_number_of_sub_file_entries,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_fork_descriptor(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_fork_stream(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     libfdata_stream_t **fork_stream,
+     libcerror_error_t **error );
+
+ssize_t libfshfs_internal_file_entry_read_fork_buffer(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+off64_t libfshfs_internal_file_entry_seek_fork_offset(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_fork_offset(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_get_fork_size(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+ssize_t libfshfs_file_entry_read_buffer(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+ssize_t libfshfs_file_entry_read_buffer_at_offset(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+off64_t libfshfs_file_entry_seek_offset(
+         libfshfs_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_offset(
+     libfshfs_file_entry_t *file_entry,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_size(
+     libfshfs_file_entry_t *file_entry,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+ssize_t libfshfs_file_entry_read_resource_fork_buffer(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+ssize_t libfshfs_file_entry_read_resource_fork_buffer_at_offset(
+         libfshfs_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+off64_t libfshfs_file_entry_seek_resource_fork_offset(
+         libfshfs_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_resource_fork_offset(
+     libfshfs_file_entry_t *file_entry,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_get_resource_fork_size(
+     libfshfs_file_entry_t *file_entry,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_export_fork_range_to_fd(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     off64_t offset,
+     size64_t size,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_internal_file_entry_export_fork_to_fd(
+     libfshfs_internal_file_entry_t *internal_file_entry,
+     uint8_t fork_type,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_file_entry_export_to_fd(
+     libfshfs_file_entry_t *file_entry,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+ssize_t libfshfs_internal_file_entry_read_fork_vectors_at_offset(
+         libfshfs_internal_file_entry_t *internal_file_entry,
+         uint8_t fork_type,
+         off64_t offset,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+ssize_t libfshfs_file_entry_readv(
+         libfshfs_file_entry_t *file_entry,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         off64_t offset,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
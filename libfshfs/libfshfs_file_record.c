@@ -25,6 +25,7 @@
 #include <system_string.h>
 #include <types.h>
 
+#include "libfshfs_atomic.h"
 #include "libfshfs_debug.h"
 #include "libfshfs_file_record.h"
 #include "libfshfs_fork_descriptor.h"
@@ -130,37 +131,18 @@ int libfshfs_file_record_free(
 	}
 	if( *file_record != NULL )
 	{
-		if( ( *file_record )->data_fork_descriptor != NULL )
+		if( libfshfs_file_record_free_fork_descriptors(
+		     *file_record,
+		     error ) != 1 )
 		{
-			if( libfshfs_fork_descriptor_free(
-			     &( ( *file_record )->data_fork_descriptor ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free data fork descriptor.",
-				 function );
-
-				result = -1;
-			}
-		}
-		if( ( *file_record )->resource_fork_descriptor != NULL )
-		{
-			if( libfshfs_fork_descriptor_free(
-			     &( ( *file_record )->resource_fork_descriptor ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free resource fork descriptor.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free fork descriptors.",
+			 function );
 
-				result = -1;
-			}
+			result = -1;
 		}
 		memory_free(
 		 *file_record );
@@ -170,6 +152,62 @@ int libfshfs_file_record_free(
 	return( result );
 }
 
+/* Frees the fork descriptors of a file record
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_file_record_free_fork_descriptors(
+     libfshfs_file_record_t *file_record,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_file_record_free_fork_descriptors";
+	int result            = 1;
+
+	if( file_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file record.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_record->data_fork_descriptor != NULL )
+	{
+		if( libfshfs_fork_descriptor_free(
+		     &( file_record->data_fork_descriptor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data fork descriptor.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( file_record->resource_fork_descriptor != NULL )
+	{
+		if( libfshfs_fork_descriptor_free(
+		     &( file_record->resource_fork_descriptor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free resource fork descriptor.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
 /* Reads a file record
  * Returns 1 if successful or -1 on error
  */
@@ -275,12 +313,116 @@ int libfshfs_file_record_read_data(
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->identifier,
 		 file_record->identifier );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->flags,
+		 file_record->flags );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->creation_time,
+		 file_record->creation_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->modification_time,
+		 file_record->modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->entry_modification_time,
+		 file_record->entry_modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->access_time,
+		 file_record->access_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->backup_time,
+		 file_record->backup_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_file_record_hfsplus_t *) data )->permissions )->owner_identifier,
+		 file_record->owner_identifier );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_file_record_hfsplus_t *) data )->permissions )->group_identifier,
+		 file_record->group_identifier );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_file_record_hfsplus_t *) data )->permissions )->file_mode,
+		 file_record->file_mode );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_permissions_hfsplus_t *) ( (fshfs_catalog_file_record_hfsplus_t *) data )->permissions )->special,
+		 file_record->special_permissions );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->data_fork_descriptor,
+		 file_record->data_fork_size );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (fshfs_catalog_file_record_hfsplus_t *) data )->resource_fork_descriptor,
+		 file_record->resource_fork_size );
+
+		/* The fork descriptors are only read on first access
+		 */
+		if( memory_copy(
+		     file_record->data_fork_descriptor_data,
+		     ( (fshfs_catalog_file_record_hfsplus_t *) data )->data_fork_descriptor,
+		     80 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data fork descriptor data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     file_record->resource_fork_descriptor_data,
+		     ( (fshfs_catalog_file_record_hfsplus_t *) data )->resource_fork_descriptor,
+		     80 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy resource fork descriptor data.",
+			 function );
+
+			goto on_error;
+		}
+		file_record->has_fork_descriptors_data = 1;
 	}
 	else
 	{
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (fshfs_catalog_file_record_hfs_t *) data )->identifier,
 		 file_record->identifier );
+
+		file_record->flags = ( (fshfs_catalog_file_record_hfs_t *) data )->flags;
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfs_t *) data )->creation_time,
+		 file_record->creation_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfs_t *) data )->modification_time,
+		 file_record->modification_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_file_record_hfs_t *) data )->backup_time,
+		 file_record->backup_time );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( ( (fshfs_catalog_file_record_hfs_t *) data )->data_fork[ 2 ] ),
+		 file_record->data_fork_size );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( ( (fshfs_catalog_file_record_hfs_t *) data )->resource_fork[ 2 ] ),
+		 file_record->resource_fork_size );
+
+/* TODO add HFS fork descriptor support */
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -583,7 +725,59 @@ int libfshfs_file_record_read_data(
 			 value_16bit );
 		}
 	}
-#endif
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	return( 1 );
+
+on_error:
+	return( -1 );
+}
+
+/* Retrieves the data fork descriptor
+ * The fork descriptor is read on first access, which is thread-safe
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_record_get_data_fork_descriptor(
+     libfshfs_file_record_t *file_record,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *safe_fork_descriptor = NULL;
+	static char *function                            = "libfshfs_file_record_get_data_fork_descriptor";
+
+	if( file_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file record.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*fork_descriptor = libfshfs_atomic_get_pointer(
+	                    &( file_record->data_fork_descriptor ) );
+
+	if( *fork_descriptor != NULL )
+	{
+		return( 1 );
+	}
+	if( file_record->has_fork_descriptors_data == 0 )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -593,7 +787,7 @@ int libfshfs_file_record_read_data(
 	}
 #endif
 	if( libfshfs_fork_descriptor_initialize(
-	     &( file_record->data_fork_descriptor ),
+	     &safe_fork_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -605,10 +799,9 @@ int libfshfs_file_record_read_data(
 
 		goto on_error;
 	}
-/* TODO add HFS support */
 	if( libfshfs_fork_descriptor_read(
-	     file_record->data_fork_descriptor,
-	     ( (fshfs_catalog_file_record_hfsplus_t *) data )->data_fork_descriptor,
+	     safe_fork_descriptor,
+	     file_record->data_fork_descriptor_data,
 	     80,
 	     error ) != 1 )
 	{
@@ -621,6 +814,88 @@ int libfshfs_file_record_read_data(
 
 		goto on_error;
 	}
+	/* The file record can be shared between threads, if another thread
+	 * has set the fork descriptor first that fork descriptor is used
+	 */
+	if( libfshfs_atomic_compare_and_swap_pointer(
+	     &( file_record->data_fork_descriptor ),
+	     NULL,
+	     safe_fork_descriptor ) == 0 )
+	{
+		if( libfshfs_fork_descriptor_free(
+		     &safe_fork_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data fork descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*fork_descriptor = libfshfs_atomic_get_pointer(
+	                    &( file_record->data_fork_descriptor ) );
+
+	return( 1 );
+
+on_error:
+	if( safe_fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &safe_fork_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the resource fork descriptor
+ * The fork descriptor is read on first access, which is thread-safe
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_file_record_get_resource_fork_descriptor(
+     libfshfs_file_record_t *file_record,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *safe_fork_descriptor = NULL;
+	static char *function                            = "libfshfs_file_record_get_resource_fork_descriptor";
+
+	if( file_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file record.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*fork_descriptor = libfshfs_atomic_get_pointer(
+	                    &( file_record->resource_fork_descriptor ) );
+
+	if( *fork_descriptor != NULL )
+	{
+		return( 1 );
+	}
+	if( file_record->has_fork_descriptors_data == 0 )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -630,7 +905,7 @@ int libfshfs_file_record_read_data(
 	}
 #endif
 	if( libfshfs_fork_descriptor_initialize(
-	     &( file_record->resource_fork_descriptor ),
+	     &safe_fork_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -642,10 +917,9 @@ int libfshfs_file_record_read_data(
 
 		goto on_error;
 	}
-/* TODO add HFS support */
 	if( libfshfs_fork_descriptor_read(
-	     file_record->resource_fork_descriptor,
-	     ( (fshfs_catalog_file_record_hfsplus_t *) data )->resource_fork_descriptor,
+	     safe_fork_descriptor,
+	     file_record->resource_fork_descriptor_data,
 	     80,
 	     error ) != 1 )
 	{
@@ -658,21 +932,39 @@ int libfshfs_file_record_read_data(
 
 		goto on_error;
 	}
+	/* The file record can be shared between threads, if another thread
+	 * has set the fork descriptor first that fork descriptor is used
+	 */
+	if( libfshfs_atomic_compare_and_swap_pointer(
+	     &( file_record->resource_fork_descriptor ),
+	     NULL,
+	     safe_fork_descriptor ) == 0 )
+	{
+		if( libfshfs_fork_descriptor_free(
+		     &safe_fork_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free resource fork descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*fork_descriptor = libfshfs_atomic_get_pointer(
+	                    &( file_record->resource_fork_descriptor ) );
+
 	return( 1 );
 
 on_error:
-	if( file_record->resource_fork_descriptor == NULL )
-	{
-		libfshfs_fork_descriptor_free(
-		 &( file_record->resource_fork_descriptor ),
-		 NULL );
-	}
-	if( file_record->data_fork_descriptor == NULL )
+	if( safe_fork_descriptor != NULL )
 	{
 		libfshfs_fork_descriptor_free(
-		 &( file_record->data_fork_descriptor ),
+		 &safe_fork_descriptor,
 		 NULL );
 	}
 	return( -1 );
 }
-
@@ -40,11 +40,71 @@ struct libfshfs_file_record
 	 */
 	uint32_t identifier;
 
-	/* The data fork descriptor
+	/* The flags
+	 */
+	uint16_t flags;
+
+	/* The creation time
+	 */
+	uint32_t creation_time;
+
+	/* The modification time
+	 */
+	uint32_t modification_time;
+
+	/* The entry modification time
+	 */
+	uint32_t entry_modification_time;
+
+	/* The access time
+	 */
+	uint32_t access_time;
+
+	/* The backup time
+	 */
+	uint32_t backup_time;
+
+	/* The owner identifier
+	 */
+	uint32_t owner_identifier;
+
+	/* The group identifier
+	 */
+	uint32_t group_identifier;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+
+	/* The special permissions
+	 */
+	uint32_t special_permissions;
+
+	/* The data fork size
+	 */
+	uint64_t data_fork_size;
+
+	/* The resource fork size
+	 */
+	uint64_t resource_fork_size;
+
+	/* Value to indicate the fork descriptors data is set
+	 */
+	uint8_t has_fork_descriptors_data;
+
+	/* The data fork descriptor data
+	 */
+	uint8_t data_fork_descriptor_data[ 80 ];
+
+	/* The resource fork descriptor data
+	 */
+	uint8_t resource_fork_descriptor_data[ 80 ];
+
+	/* The data fork descriptor, which is read on first access
 	 */
 	libfshfs_fork_descriptor_t *data_fork_descriptor;
 
-	/* The resource fork descriptor
+	/* The resource fork descriptor, which is read on first access
 	 */
 	libfshfs_fork_descriptor_t *resource_fork_descriptor;
 };
@@ -57,12 +117,26 @@ int libfshfs_file_record_free(
      libfshfs_file_record_t **file_record,
      libcerror_error_t **error );
 
+int libfshfs_file_record_free_fork_descriptors(
+     libfshfs_file_record_t *file_record,
+     libcerror_error_t **error );
+
 int libfshfs_file_record_read_data(
      libfshfs_file_record_t *file_record,
      const uint8_t *data,
      size_t data_size,
      libcerror_error_t **error );
 
+int libfshfs_file_record_get_data_fork_descriptor(
+     libfshfs_file_record_t *file_record,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_file_record_get_resource_fork_descriptor(
+     libfshfs_file_record_t *file_record,
+     libfshfs_fork_descriptor_t **fork_descriptor,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
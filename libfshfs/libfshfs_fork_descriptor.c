@@ -125,6 +125,11 @@ int libfshfs_fork_descriptor_free(
 	}
 	if( *fork_descriptor != NULL )
 	{
+		if( ( *fork_descriptor )->overflow_extents != NULL )
+		{
+			memory_free(
+			 ( *fork_descriptor )->overflow_extents );
+		}
 		memory_free(
 		 *fork_descriptor );
 
@@ -133,6 +138,129 @@ int libfshfs_fork_descriptor_free(
 	return( 1 );
 }
 
+/* Clones a fork descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_fork_descriptor_clone(
+     libfshfs_fork_descriptor_t **destination_fork_descriptor,
+     libfshfs_fork_descriptor_t *source_fork_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function        = "libfshfs_fork_descriptor_clone";
+	size_t overflow_extents_size = 0;
+
+	if( destination_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_fork_descriptor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination fork descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_fork_descriptor == NULL )
+	{
+		*destination_fork_descriptor = NULL;
+
+		return( 1 );
+	}
+	*destination_fork_descriptor = memory_allocate_structure(
+	                                libfshfs_fork_descriptor_t );
+
+	if( *destination_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination fork descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_fork_descriptor,
+	     source_fork_descriptor,
+	     sizeof( libfshfs_fork_descriptor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination fork descriptor.",
+		 function );
+
+		memory_free(
+		 *destination_fork_descriptor );
+
+		*destination_fork_descriptor = NULL;
+
+		return( -1 );
+	}
+	( *destination_fork_descriptor )->overflow_extents                   = NULL;
+	( *destination_fork_descriptor )->number_of_overflow_extents         = 0;
+	( *destination_fork_descriptor )->maximum_number_of_overflow_extents = 0;
+
+	if( source_fork_descriptor->number_of_overflow_extents > 0 )
+	{
+		overflow_extents_size = sizeof( uint32_t ) * 2 * (size_t) source_fork_descriptor->number_of_overflow_extents;
+
+		( *destination_fork_descriptor )->overflow_extents = (uint32_t *) memory_allocate(
+		                                                                   overflow_extents_size );
+
+		if( ( *destination_fork_descriptor )->overflow_extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination overflow extents.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_fork_descriptor )->overflow_extents,
+		     source_fork_descriptor->overflow_extents,
+		     overflow_extents_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination overflow extents.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_fork_descriptor )->number_of_overflow_extents         = source_fork_descriptor->number_of_overflow_extents;
+		( *destination_fork_descriptor )->maximum_number_of_overflow_extents = source_fork_descriptor->number_of_overflow_extents;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 destination_fork_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads the fork descriptor
  * Returns 1 if successful or -1 on error
  */
@@ -276,3 +404,278 @@ int libfshfs_fork_descriptor_read(
 	return( 1 );
 }
 
+/* Appends an overflow extent
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_fork_descriptor_append_overflow_extent(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t start_block_number,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error )
+{
+	uint32_t *overflow_extents             = NULL;
+	static char *function                  = "libfshfs_fork_descriptor_append_overflow_extent";
+	size_t overflow_extents_size           = 0;
+	int maximum_number_of_overflow_extents = 0;
+
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor->number_of_overflow_extents >= fork_descriptor->maximum_number_of_overflow_extents )
+	{
+		if( fork_descriptor->maximum_number_of_overflow_extents == 0 )
+		{
+			maximum_number_of_overflow_extents = 8;
+		}
+		else if( fork_descriptor->maximum_number_of_overflow_extents < ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_overflow_extents = fork_descriptor->maximum_number_of_overflow_extents * 2;
+		}
+		if( ( maximum_number_of_overflow_extents == 0 )
+		 || ( (size_t) maximum_number_of_overflow_extents > ( (size_t) SSIZE_MAX / ( sizeof( uint32_t ) * 2 ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of overflow extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		overflow_extents_size = sizeof( uint32_t ) * 2 * (size_t) maximum_number_of_overflow_extents;
+
+		overflow_extents = (uint32_t *) memory_reallocate(
+		                                 fork_descriptor->overflow_extents,
+		                                 overflow_extents_size );
+
+		if( overflow_extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize overflow extents.",
+			 function );
+
+			return( -1 );
+		}
+		fork_descriptor->overflow_extents                   = overflow_extents;
+		fork_descriptor->maximum_number_of_overflow_extents = maximum_number_of_overflow_extents;
+	}
+	fork_descriptor->overflow_extents[ ( 2 * fork_descriptor->number_of_overflow_extents ) ]     = start_block_number;
+	fork_descriptor->overflow_extents[ ( 2 * fork_descriptor->number_of_overflow_extents ) + 1 ] = number_of_blocks;
+
+	fork_descriptor->number_of_overflow_extents += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the number of extents
+ * The number of extents consists of the extents stored in the fork descriptor
+ * and the overflow extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_fork_descriptor_get_number_of_extents(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_fork_descriptor_get_number_of_extents";
+	int extent_index      = 0;
+
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		if( fork_descriptor->extents[ extent_index ][ 1 ] == 0 )
+		{
+			break;
+		}
+	}
+	/* Overflow extents are only used if all the extents in the fork descriptor are used
+	 */
+	if( extent_index == 8 )
+	{
+		extent_index += fork_descriptor->number_of_overflow_extents;
+	}
+	*number_of_extents = extent_index;
+
+	return( 1 );
+}
+
+/* Retrieves a specific extent
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_fork_descriptor_get_extent_by_index(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int extent_index,
+     uint32_t *start_block_number,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_fork_descriptor_get_extent_by_index";
+	int number_of_extents = 0;
+
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_index < 0 )
+	 || ( extent_index >= number_of_extents ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_block_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start block number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_index < 8 )
+	{
+		*start_block_number = fork_descriptor->extents[ extent_index ][ 0 ];
+		*number_of_blocks   = fork_descriptor->extents[ extent_index ][ 1 ];
+	}
+	else
+	{
+		extent_index -= 8;
+
+		*start_block_number = fork_descriptor->overflow_extents[ 2 * extent_index ];
+		*number_of_blocks   = fork_descriptor->overflow_extents[ ( 2 * extent_index ) + 1 ];
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of blocks that are mapped by the extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_fork_descriptor_get_number_of_mapped_blocks(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint64_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function          = "libfshfs_fork_descriptor_get_number_of_mapped_blocks";
+	uint64_t safe_number_of_blocks = 0;
+	int extent_index               = 0;
+
+	if( fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		if( fork_descriptor->extents[ extent_index ][ 1 ] == 0 )
+		{
+			break;
+		}
+		safe_number_of_blocks += fork_descriptor->extents[ extent_index ][ 1 ];
+	}
+	if( extent_index == 8 )
+	{
+		for( extent_index = 0;
+		     extent_index < fork_descriptor->number_of_overflow_extents;
+		     extent_index++ )
+		{
+			safe_number_of_blocks += fork_descriptor->overflow_extents[ ( 2 * extent_index ) + 1 ];
+		}
+	}
+	*number_of_blocks = safe_number_of_blocks;
+
+	return( 1 );
+}
+
@@ -50,6 +50,19 @@ struct libfshfs_fork_descriptor
 	/* The extents
 	 */
 	uint32_t extents[ 8 ][ 2 ];
+
+	/* The overflow extents, which are stored in the extents (overflow) B-tree file
+	 * Every extent consists of a start block number and a number of blocks
+	 */
+	uint32_t *overflow_extents;
+
+	/* The number of overflow extents
+	 */
+	int number_of_overflow_extents;
+
+	/* The maximum number of overflow extents
+	 */
+	int maximum_number_of_overflow_extents;
 };
 
 int libfshfs_fork_descriptor_initialize(
@@ -60,12 +73,40 @@ int libfshfs_fork_descriptor_free(
      libfshfs_fork_descriptor_t **fork_descriptor,
      libcerror_error_t **error );
 
+int libfshfs_fork_descriptor_clone(
+     libfshfs_fork_descriptor_t **destination_fork_descriptor,
+     libfshfs_fork_descriptor_t *source_fork_descriptor,
+     libcerror_error_t **error );
+
 int libfshfs_fork_descriptor_read(
      libfshfs_fork_descriptor_t *fork_descriptor,
      const uint8_t *data,
      size_t data_size,
      libcerror_error_t **error );
 
+int libfshfs_fork_descriptor_append_overflow_extent(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint32_t start_block_number,
+     uint32_t number_of_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_fork_descriptor_get_number_of_extents(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+int libfshfs_fork_descriptor_get_extent_by_index(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     int extent_index,
+     uint32_t *start_block_number,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_fork_descriptor_get_number_of_mapped_blocks(
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     uint64_t *number_of_blocks,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
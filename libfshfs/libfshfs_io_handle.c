@@ -25,8 +25,31 @@
 #include <system_string.h>
 #include <types.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_UIO_H )
+#include <sys/uio.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libfshfs_block_cache.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_direct_io.h"
 #include "libfshfs_io_handle.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_kernel_copy.h"
+#include "libfshfs_libbfio.h"
 #include "libfshfs_libcerror.h"
+#include "libfshfs_types.h"
+
+/* The maximum number of system IO vectors of a single vectored read
+ */
+#define LIBFSHFS_IO_HANDLE_MAXIMUM_NUMBER_OF_SYSTEM_IO_VECTORS	64
 
 const char fshfs_volume_signature_hfsplus[ 2 ] = "H+";
 const char fshfs_volume_signature_hfsx[ 2 ]    = "HX";
@@ -91,6 +114,13 @@ int libfshfs_io_handle_initialize(
 
 		goto on_error;
 	}
+	( *io_handle )->maximum_read_gap_size = LIBFSHFS_IO_SCHEDULER_DEFAULT_MAXIMUM_GAP_SIZE;
+
+	( *io_handle )->maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_PARTITION_CATALOG ]    = LIBFSHFS_BLOCK_CACHE_DEFAULT_NUMBER_OF_CATALOG_BLOCKS;
+	( *io_handle )->maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_PARTITION_EXTENTS ]    = LIBFSHFS_BLOCK_CACHE_DEFAULT_NUMBER_OF_EXTENTS_BLOCKS;
+	( *io_handle )->maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_PARTITION_ATTRIBUTES ] = LIBFSHFS_BLOCK_CACHE_DEFAULT_NUMBER_OF_ATTRIBUTES_BLOCKS;
+	( *io_handle )->maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_PARTITION_FILE_DATA ]  = LIBFSHFS_BLOCK_CACHE_DEFAULT_NUMBER_OF_FILE_DATA_BLOCKS;
+
 	return( 1 );
 
 on_error:
@@ -141,7 +171,11 @@ int libfshfs_io_handle_clear(
      libfshfs_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libfshfs_io_handle_clear";
+	int maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ];
+
+	static char *function        = "libfshfs_io_handle_clear";
+	size_t maximum_read_gap_size = 0;
+	int number_of_read_threads   = 0;
 
 	if( io_handle == NULL )
 	{
@@ -154,6 +188,27 @@ int libfshfs_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The maximum read gap size, number of read threads and maximum number of cached blocks
+	 * are settings and are retained
+	 */
+	maximum_read_gap_size  = io_handle->maximum_read_gap_size;
+	number_of_read_threads = io_handle->number_of_read_threads;
+
+	if( memory_copy(
+	     maximum_number_of_cached_blocks,
+	     io_handle->maximum_number_of_cached_blocks,
+	     sizeof( int ) * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy maximum number of cached blocks.",
+		 function );
+
+		return( -1 );
+	}
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -168,6 +223,591 @@ int libfshfs_io_handle_clear(
 
 		return( -1 );
 	}
+	io_handle->maximum_read_gap_size  = maximum_read_gap_size;
+	io_handle->number_of_read_threads = number_of_read_threads;
+
+	if( memory_copy(
+	     io_handle->maximum_number_of_cached_blocks,
+	     maximum_number_of_cached_blocks,
+	     sizeof( int ) * LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy maximum number of cached blocks.",
+		 function );
+
+		return( -1 );
+	}
+
 	return( 1 );
 }
 
+/* Reads data at a specific offset
+ * If a journal is set the data is overlaid with the more recent journal blocks
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_io_handle_read_buffer_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( ( io_handle->journal != NULL )
+	 && ( read_count > 0 ) )
+	{
+		if( libfshfs_journal_apply_overlay(
+		     io_handle->journal,
+		     file_io_handle,
+		     offset,
+		     buffer,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply journal overlay.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
+/* Reads file data at a specific offset
+ * The data is read with direct I/O if set, otherwise from the file IO handle
+ * If a journal is set the data is overlaid with the more recent journal blocks
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_io_handle_read_data_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_handle_read_data_at_offset";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->direct_io == NULL )
+	{
+		return( libfshfs_io_handle_read_buffer_at_offset(
+		         io_handle,
+		         file_io_handle,
+		         offset,
+		         buffer,
+		         size,
+		         error ) );
+	}
+	read_count = libfshfs_direct_io_read_buffer_at_offset(
+	              io_handle->direct_io,
+	              io_handle->buffer_pool,
+	              offset,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") with direct I/O.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( ( io_handle->journal != NULL )
+	 && ( read_count > 0 ) )
+	{
+		if( libfshfs_journal_apply_overlay(
+		     io_handle->journal,
+		     file_io_handle,
+		     offset,
+		     buffer,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to apply journal overlay.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
+/* Reads file data at a specific offset into multiple buffers
+ * The buffers are filled in order as if they were a single contiguous buffer
+ * The data is read with a single vectored read if the volume was opened by filename
+ * and direct I/O is not set, otherwise each buffer is read separately
+ * If a journal is set the data is overlaid with the more recent journal blocks
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_io_handle_read_vectors_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         libcerror_error_t **error )
+{
+#if defined( HAVE_PREADV ) && defined( HAVE_SYS_UIO_H )
+	struct iovec system_io_vectors[ LIBFSHFS_IO_HANDLE_MAXIMUM_NUMBER_OF_SYSTEM_IO_VECTORS ];
+
+	size_t io_vector_offset         = 0;
+	size_t remaining_size           = 0;
+	int first_io_vector_index       = 0;
+	int number_of_system_io_vectors = 0;
+	int result                      = 0;
+#endif
+
+	static char *function           = "libfshfs_io_handle_read_vectors_at_offset";
+	size_t total_size               = 0;
+	ssize_t read_count              = 0;
+	ssize_t total_read_count        = 0;
+	int io_vector_index             = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_io_vectors < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of IO vectors value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( io_vector_index = 0;
+	     io_vector_index < number_of_io_vectors;
+	     io_vector_index++ )
+	{
+		if( ( io_vectors[ io_vector_index ].buffer == NULL )
+		 && ( io_vectors[ io_vector_index ].buffer_size > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid IO vector: %d - missing buffer.",
+			 function,
+			 io_vector_index );
+
+			return( -1 );
+		}
+		if( io_vectors[ io_vector_index ].buffer_size > ( (size_t) SSIZE_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid IO vectors - total buffer size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		total_size += io_vectors[ io_vector_index ].buffer_size;
+	}
+#if defined( HAVE_PREADV ) && defined( HAVE_SYS_UIO_H )
+	/* The vectored read uses the file descriptor of the kernel copy source file
+	 */
+	if( ( io_handle->direct_io == NULL )
+	 && ( io_handle->kernel_copy != NULL ) )
+	{
+		result = libfshfs_kernel_copy_open_source(
+		          io_handle->kernel_copy,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open kernel copy source file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
+	{
+		while( first_io_vector_index < number_of_io_vectors )
+		{
+			number_of_system_io_vectors = 0;
+			io_vector_index             = first_io_vector_index;
+
+			while( ( io_vector_index < number_of_io_vectors )
+			    && ( number_of_system_io_vectors < LIBFSHFS_IO_HANDLE_MAXIMUM_NUMBER_OF_SYSTEM_IO_VECTORS ) )
+			{
+				system_io_vectors[ number_of_system_io_vectors ].iov_base = (void *) io_vectors[ io_vector_index ].buffer;
+				system_io_vectors[ number_of_system_io_vectors ].iov_len  = io_vectors[ io_vector_index ].buffer_size;
+
+				/* The first buffer can be partially filled by a previous read
+				 */
+				if( io_vector_index == first_io_vector_index )
+				{
+					system_io_vectors[ number_of_system_io_vectors ].iov_base = (void *) &( ( (uint8_t *) io_vectors[ io_vector_index ].buffer )[ io_vector_offset ] );
+					system_io_vectors[ number_of_system_io_vectors ].iov_len -= io_vector_offset;
+				}
+				number_of_system_io_vectors++;
+				io_vector_index++;
+			}
+			read_count = preadv(
+			              io_handle->kernel_copy->file_descriptor,
+			              system_io_vectors,
+			              number_of_system_io_vectors,
+			              (off_t) ( offset + total_read_count ) );
+
+			if( read_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 (uint32_t) errno,
+				 "%s: unable to read vectors at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset + total_read_count,
+				 offset + total_read_count );
+
+				return( -1 );
+			}
+			total_read_count += read_count;
+
+			/* Advance past the buffers that were filled by the read
+			 */
+			remaining_size = (size_t) read_count;
+
+			while( first_io_vector_index < number_of_io_vectors )
+			{
+				if( remaining_size < ( io_vectors[ first_io_vector_index ].buffer_size - io_vector_offset ) )
+				{
+					io_vector_offset += remaining_size;
+
+					break;
+				}
+				remaining_size  -= io_vectors[ first_io_vector_index ].buffer_size - io_vector_offset;
+				io_vector_offset = 0;
+
+				first_io_vector_index++;
+			}
+			/* The end of the file was reached
+			 */
+			if( read_count == 0 )
+			{
+				break;
+			}
+		}
+		if( io_handle->journal != NULL )
+		{
+			total_size = 0;
+
+			for( io_vector_index = 0;
+			     io_vector_index < number_of_io_vectors;
+			     io_vector_index++ )
+			{
+				if( total_size >= (size_t) total_read_count )
+				{
+					break;
+				}
+				remaining_size = (size_t) total_read_count - total_size;
+
+				if( remaining_size > io_vectors[ io_vector_index ].buffer_size )
+				{
+					remaining_size = io_vectors[ io_vector_index ].buffer_size;
+				}
+				if( ( remaining_size > 0 )
+				 && ( libfshfs_journal_apply_overlay(
+				       io_handle->journal,
+				       file_io_handle,
+				       offset + (off64_t) total_size,
+				       (uint8_t *) io_vectors[ io_vector_index ].buffer,
+				       remaining_size,
+				       error ) != 1 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to apply journal overlay.",
+					 function );
+
+					return( -1 );
+				}
+				total_size += io_vectors[ io_vector_index ].buffer_size;
+			}
+		}
+		return( total_read_count );
+	}
+#endif /* defined( HAVE_PREADV ) && defined( HAVE_SYS_UIO_H ) */
+
+	for( io_vector_index = 0;
+	     io_vector_index < number_of_io_vectors;
+	     io_vector_index++ )
+	{
+		if( io_vectors[ io_vector_index ].buffer_size == 0 )
+		{
+			continue;
+		}
+		read_count = libfshfs_io_handle_read_data_at_offset(
+		              io_handle,
+		              file_io_handle,
+		              offset + total_read_count,
+		              (uint8_t *) io_vectors[ io_vector_index ].buffer,
+		              io_vectors[ io_vector_index ].buffer_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read IO vector: %d.",
+			 function,
+			 io_vector_index );
+
+			return( -1 );
+		}
+		total_read_count += read_count;
+
+		if( (size_t) read_count < io_vectors[ io_vector_index ].buffer_size )
+		{
+			break;
+		}
+	}
+	return( total_read_count );
+}
+
+/* Reads a block at a specific offset
+ * The block is read from the partition of the block cache if available, otherwise
+ * it is read from the file IO handle and stored in the partition of the block cache
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libfshfs_io_handle_read_block_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         int block_cache_partition,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_handle_read_block_at_offset";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->block_cache != NULL )
+	{
+		result = libfshfs_block_cache_get_block(
+		          io_handle->block_cache,
+		          block_cache_partition,
+		          offset,
+		          buffer,
+		          size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ") from cache.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( (ssize_t) size );
+		}
+	}
+	/* File data is read with direct I/O if set, the B-tree nodes are read from the file IO handle
+	 */
+	if( block_cache_partition == LIBFSHFS_BLOCK_CACHE_PARTITION_FILE_DATA )
+	{
+		read_count = libfshfs_io_handle_read_data_at_offset(
+		              io_handle,
+		              file_io_handle,
+		              offset,
+		              buffer,
+		              size,
+		              error );
+	}
+	else
+	{
+		read_count = libfshfs_io_handle_read_buffer_at_offset(
+		              io_handle,
+		              file_io_handle,
+		              offset,
+		              buffer,
+		              size,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( ( io_handle->block_cache != NULL )
+	 && ( read_count == (ssize_t) size ) )
+	{
+		if( libfshfs_block_cache_set_block(
+		     io_handle->block_cache,
+		     block_cache_partition,
+		     offset,
+		     buffer,
+		     size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set block at offset: %" PRIi64 " (0x%08" PRIx64 ") in cache.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
@@ -25,7 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfshfs_block_cache.h"
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_direct_io.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_kernel_copy.h"
+#include "libfshfs_libbfio.h"
 #include "libfshfs_libcerror.h"
+#include "libfshfs_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -46,6 +55,44 @@ struct libfshfs_io_handle
 	 */
 	uint32_t allocation_block_size;
 
+	/* The journal, which is used to overlay the volume data
+	 * when the journal is replayed
+	 */
+	libfshfs_journal_t *journal;
+
+	/* The maximum gap size between pending reads that are coalesced
+	 */
+	size_t maximum_read_gap_size;
+
+	/* The number of read threads, where 0 represents synchronous reads
+	 */
+	int number_of_read_threads;
+
+	/* The I/O thread pool, which is used to read the batched B-tree node reads
+	 * and the extent runs of vectored reads concurrently
+	 */
+	libfshfs_io_thread_pool_t *io_thread_pool;
+
+	/* The maximum number of cached blocks of the block cache partitions
+	 */
+	int maximum_number_of_cached_blocks[ LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ];
+
+	/* The block cache, which is shared by the B-tree files and the streams of the volume
+	 */
+	libfshfs_block_cache_t *block_cache;
+
+	/* The buffer pool, which provides the data buffers of the B-tree nodes and allocation blocks
+	 */
+	libfshfs_buffer_pool_t *buffer_pool;
+
+	/* The direct I/O, which is used to read file data without the page cache
+	 */
+	libfshfs_direct_io_t *direct_io;
+
+	/* The kernel copy, which is used to export file data without passing it through user space
+	 */
+	libfshfs_kernel_copy_t *kernel_copy;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -63,6 +110,39 @@ int libfshfs_io_handle_clear(
      libfshfs_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+ssize_t libfshfs_io_handle_read_buffer_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libfshfs_io_handle_read_data_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libfshfs_io_handle_read_vectors_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         libfshfs_io_vector_t *io_vectors,
+         int number_of_io_vectors,
+         libcerror_error_t **error );
+
+ssize_t libfshfs_io_handle_read_block_at_offset(
+         libfshfs_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         int block_cache_partition,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,982 @@
+/*
+ * I/O scheduler functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libfshfs_io_handle.h"
+#include "libfshfs_io_scheduler.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+
+/* Creates an I/O scheduler
+ * Make sure the value io_scheduler is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_initialize(
+     libfshfs_io_scheduler_t **io_scheduler,
+     size_t maximum_gap_size,
+     size_t maximum_read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_scheduler_initialize";
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid I/O scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_gap_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum gap size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_read_size == 0 )
+	 || ( maximum_read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_scheduler = memory_allocate_structure(
+	                 libfshfs_io_scheduler_t );
+
+	if( *io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create I/O scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_scheduler,
+	     0,
+	     sizeof( libfshfs_io_scheduler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear I/O scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_scheduler )->maximum_gap_size  = maximum_gap_size;
+	( *io_scheduler )->maximum_read_size = maximum_read_size;
+
+	return( 1 );
+
+on_error:
+	if( *io_scheduler != NULL )
+	{
+		memory_free(
+		 *io_scheduler );
+
+		*io_scheduler = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an I/O scheduler
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_free(
+     libfshfs_io_scheduler_t **io_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_scheduler_free";
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_scheduler != NULL )
+	{
+		if( ( *io_scheduler )->buffer != NULL )
+		{
+			memory_free(
+			 ( *io_scheduler )->buffer );
+		}
+		if( ( *io_scheduler )->runs != NULL )
+		{
+			memory_free(
+			 ( *io_scheduler )->runs );
+		}
+		if( ( *io_scheduler )->reads != NULL )
+		{
+			memory_free(
+			 ( *io_scheduler )->reads );
+		}
+		memory_free(
+		 *io_scheduler );
+
+		*io_scheduler = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares the offsets of 2 pending reads
+ * This function is used to sort the pending reads with qsort
+ * Returns -1 if the first offset is less, 0 if equal or 1 if greater
+ */
+int libfshfs_io_scheduler_compare_reads(
+     const void *first_read,
+     const void *second_read )
+{
+	off64_t first_offset  = ( (libfshfs_io_scheduler_read_t *) first_read )->offset;
+	off64_t second_offset = ( (libfshfs_io_scheduler_read_t *) second_read )->offset;
+
+	if( first_offset < second_offset )
+	{
+		return( -1 );
+	}
+	else if( first_offset > second_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Queues a read
+ * The buffer must remain available until the pending reads are flushed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_queue_read(
+     libfshfs_io_scheduler_t *io_scheduler,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfshfs_io_scheduler_read_t *pending_read = NULL;
+	libfshfs_io_scheduler_read_t *reads        = NULL;
+	static char *function                      = "libfshfs_io_scheduler_queue_read";
+	size_t reads_size                          = 0;
+	int maximum_number_of_reads                = 0;
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_scheduler->number_of_reads >= io_scheduler->maximum_number_of_reads )
+	{
+		if( io_scheduler->maximum_number_of_reads == 0 )
+		{
+			maximum_number_of_reads = 64;
+		}
+		else if( io_scheduler->maximum_number_of_reads < ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_reads = io_scheduler->maximum_number_of_reads * 2;
+		}
+		else
+		{
+			maximum_number_of_reads = 0;
+		}
+		if( ( maximum_number_of_reads == 0 )
+		 || ( (size_t) maximum_number_of_reads > ( (size_t) SSIZE_MAX / sizeof( libfshfs_io_scheduler_read_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of reads value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reads_size = sizeof( libfshfs_io_scheduler_read_t ) * maximum_number_of_reads;
+
+		reads = (libfshfs_io_scheduler_read_t *) memory_reallocate(
+		                                          io_scheduler->reads,
+		                                          reads_size );
+
+		if( reads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize reads.",
+			 function );
+
+			return( -1 );
+		}
+		io_scheduler->reads                   = reads;
+		io_scheduler->maximum_number_of_reads = maximum_number_of_reads;
+	}
+	pending_read = &( io_scheduler->reads[ io_scheduler->number_of_reads ] );
+
+	pending_read->offset = offset;
+	pending_read->buffer = buffer;
+	pending_read->size   = size;
+
+	io_scheduler->number_of_reads += 1;
+
+	return( 1 );
+}
+
+/* Determines the pending reads that are coalesced into a single read
+ * The pending reads must be sorted by offset
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_get_run(
+     libfshfs_io_scheduler_t *io_scheduler,
+     int first_read_index,
+     int *last_read_index,
+     off64_t *run_offset,
+     size_t *run_size,
+     libcerror_error_t **error )
+{
+	libfshfs_io_scheduler_read_t *pending_read = NULL;
+	static char *function                      = "libfshfs_io_scheduler_get_run";
+	off64_t read_end_offset                    = 0;
+	off64_t run_end_offset                     = 0;
+	int read_index                             = 0;
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_read_index < 0 )
+	 || ( first_read_index >= io_scheduler->number_of_reads ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first read index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( last_read_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid last read index.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	pending_read = &( io_scheduler->reads[ first_read_index ] );
+
+	*run_offset    = pending_read->offset;
+	run_end_offset = pending_read->offset + (off64_t) pending_read->size;
+
+	for( read_index = first_read_index + 1;
+	     read_index < io_scheduler->number_of_reads;
+	     read_index++ )
+	{
+		pending_read = &( io_scheduler->reads[ read_index ] );
+
+		if( ( pending_read->offset > run_end_offset )
+		 && ( (size64_t) ( pending_read->offset - run_end_offset ) > (size64_t) io_scheduler->maximum_gap_size ) )
+		{
+			break;
+		}
+		read_end_offset = pending_read->offset + (off64_t) pending_read->size;
+
+		if( read_end_offset < run_end_offset )
+		{
+			read_end_offset = run_end_offset;
+		}
+		if( (size64_t) ( read_end_offset - *run_offset ) > (size64_t) io_scheduler->maximum_read_size )
+		{
+			break;
+		}
+		run_end_offset = read_end_offset;
+	}
+	*last_read_index = read_index;
+	*run_size        = (size_t) ( run_end_offset - *run_offset );
+
+	return( 1 );
+}
+
+/* Copies the data of a coalesced read into the buffers of its pending reads
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_copy_run_data(
+     libfshfs_io_scheduler_t *io_scheduler,
+     int first_read_index,
+     int last_read_index,
+     off64_t run_offset,
+     const uint8_t *buffer,
+     libcerror_error_t **error )
+{
+	libfshfs_io_scheduler_read_t *pending_read = NULL;
+	static char *function                      = "libfshfs_io_scheduler_copy_run_data";
+	int read_index                             = 0;
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_read_index < 0 )
+	 || ( last_read_index > io_scheduler->number_of_reads )
+	 || ( first_read_index > last_read_index ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_index = first_read_index;
+	     read_index < last_read_index;
+	     read_index++ )
+	{
+		pending_read = &( io_scheduler->reads[ read_index ] );
+
+		/* A pending read that is not coalesced is read directly into its buffer
+		 */
+		if( pending_read->buffer == buffer )
+		{
+			continue;
+		}
+		if( memory_copy(
+		     pending_read->buffer,
+		     &( buffer[ pending_read->offset - run_offset ] ),
+		     pending_read->size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data of pending read: %d.",
+			 function,
+			 read_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Flushes the pending reads
+ * The pending reads are sorted by offset and reads that are at most the maximum gap size apart
+ * are coalesced into a single read, of which the data is copied into the buffers of the pending reads
+ * If the IO handle has an I/O thread pool the coalesced reads are read concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_flush(
+     libfshfs_io_scheduler_t *io_scheduler,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "libfshfs_io_scheduler_flush";
+	off64_t run_offset    = 0;
+	size_t run_size       = 0;
+	ssize_t read_count    = 0;
+	int first_read_index  = 0;
+	int last_read_index   = 0;
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_scheduler->number_of_reads > 1 )
+	{
+		qsort(
+		 io_scheduler->reads,
+		 (size_t) io_scheduler->number_of_reads,
+		 sizeof( libfshfs_io_scheduler_read_t ),
+		 &libfshfs_io_scheduler_compare_reads );
+
+		if( io_handle->io_thread_pool != NULL )
+		{
+			if( libfshfs_io_scheduler_flush_concurrent(
+			     io_scheduler,
+			     io_handle,
+			     file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read pending reads concurrently.",
+				 function );
+
+				goto on_error;
+			}
+			io_scheduler->number_of_reads = 0;
+
+			return( 1 );
+		}
+	}
+	while( first_read_index < io_scheduler->number_of_reads )
+	{
+		if( libfshfs_io_scheduler_get_run(
+		     io_scheduler,
+		     first_read_index,
+		     &last_read_index,
+		     &run_offset,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve coalesced read of pending read: %d.",
+			 function,
+			 first_read_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %d pending reads at offset: 0x%08" PRIx64 " with size: %" PRIzd ".\n",
+			 function,
+			 last_read_index - first_read_index,
+			 run_offset,
+			 run_size );
+		}
+#endif
+		/* A pending read that is not coalesced is read directly into its buffer
+		 */
+		if( ( last_read_index - first_read_index ) == 1 )
+		{
+			buffer = io_scheduler->reads[ first_read_index ].buffer;
+		}
+		else
+		{
+			if( run_size > io_scheduler->buffer_size )
+			{
+				buffer = (uint8_t *) memory_reallocate(
+				                      io_scheduler->buffer,
+				                      run_size );
+
+				if( buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize buffer.",
+					 function );
+
+					goto on_error;
+				}
+				io_scheduler->buffer      = buffer;
+				io_scheduler->buffer_size = run_size;
+			}
+			buffer = io_scheduler->buffer;
+		}
+		read_count = libfshfs_io_handle_read_buffer_at_offset(
+		              io_handle,
+		              file_io_handle,
+		              run_offset,
+		              buffer,
+		              run_size,
+		              error );
+
+		if( read_count != (ssize_t) run_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_size,
+			 run_offset,
+			 run_offset );
+
+			goto on_error;
+		}
+		if( libfshfs_io_scheduler_copy_run_data(
+		     io_scheduler,
+		     first_read_index,
+		     last_read_index,
+		     run_offset,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy data of coalesced read at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset,
+			 run_offset );
+
+			goto on_error;
+		}
+		first_read_index = last_read_index;
+	}
+	io_scheduler->number_of_reads = 0;
+
+	return( 1 );
+
+on_error:
+	io_scheduler->number_of_reads = 0;
+
+	return( -1 );
+}
+
+/* Flushes the sorted pending reads concurrently using the I/O thread pool of the IO handle
+ * All coalesced reads are issued at once, the journal overlay is applied after the reads have completed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_scheduler_flush_concurrent(
+     libfshfs_io_scheduler_t *io_scheduler,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_io_thread_pool_read_t *run  = NULL;
+	libfshfs_io_thread_pool_read_t *runs = NULL;
+	uint8_t *buffer                      = NULL;
+	static char *function                = "libfshfs_io_scheduler_flush_concurrent";
+	off64_t run_offset                   = 0;
+	size_t buffer_offset                 = 0;
+	size_t buffer_size                   = 0;
+	size_t run_size                      = 0;
+	size_t runs_size                     = 0;
+	int first_read_index                 = 0;
+	int last_read_index                  = 0;
+	int number_of_runs                   = 0;
+	int run_index                        = 0;
+
+	if( io_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the number of coalesced reads and the size of their buffer
+	 */
+	while( first_read_index < io_scheduler->number_of_reads )
+	{
+		if( libfshfs_io_scheduler_get_run(
+		     io_scheduler,
+		     first_read_index,
+		     &last_read_index,
+		     &run_offset,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve coalesced read of pending read: %d.",
+			 function,
+			 first_read_index );
+
+			return( -1 );
+		}
+		if( ( last_read_index - first_read_index ) > 1 )
+		{
+			if( run_size > ( (size_t) SSIZE_MAX - buffer_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid buffer size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_size += run_size;
+		}
+		number_of_runs  += 1;
+		first_read_index = last_read_index;
+	}
+	if( number_of_runs > io_scheduler->maximum_number_of_runs )
+	{
+		if( (size_t) number_of_runs > ( (size_t) SSIZE_MAX / sizeof( libfshfs_io_thread_pool_read_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of runs value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		runs_size = sizeof( libfshfs_io_thread_pool_read_t ) * number_of_runs;
+
+		runs = (libfshfs_io_thread_pool_read_t *) memory_reallocate(
+		                                           io_scheduler->runs,
+		                                           runs_size );
+
+		if( runs == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize runs.",
+			 function );
+
+			return( -1 );
+		}
+		io_scheduler->runs                   = runs;
+		io_scheduler->maximum_number_of_runs = number_of_runs;
+	}
+	if( buffer_size > io_scheduler->buffer_size )
+	{
+		buffer = (uint8_t *) memory_reallocate(
+		                      io_scheduler->buffer,
+		                      buffer_size );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer.",
+			 function );
+
+			return( -1 );
+		}
+		io_scheduler->buffer      = buffer;
+		io_scheduler->buffer_size = buffer_size;
+	}
+	/* Set up the coalesced reads, where a pending read that is not coalesced
+	 * is read directly into its buffer
+	 */
+	first_read_index = 0;
+
+	for( run_index = 0;
+	     run_index < number_of_runs;
+	     run_index++ )
+	{
+		if( libfshfs_io_scheduler_get_run(
+		     io_scheduler,
+		     first_read_index,
+		     &last_read_index,
+		     &run_offset,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve coalesced read of pending read: %d.",
+			 function,
+			 first_read_index );
+
+			return( -1 );
+		}
+		run = &( io_scheduler->runs[ run_index ] );
+
+		run->offset               = run_offset;
+		run->size                 = run_size;
+		run->io_vectors           = NULL;
+		run->number_of_io_vectors = 0;
+		run->io_handle            = NULL;
+
+		if( ( last_read_index - first_read_index ) == 1 )
+		{
+			run->buffer = io_scheduler->reads[ first_read_index ].buffer;
+		}
+		else
+		{
+			run->buffer = &( io_scheduler->buffer[ buffer_offset ] );
+
+			buffer_offset += run_size;
+		}
+		first_read_index = last_read_index;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading %d pending reads as %d concurrent reads.\n",
+		 function,
+		 io_scheduler->number_of_reads,
+		 number_of_runs );
+	}
+#endif
+	if( libfshfs_io_thread_pool_read_buffers(
+	     io_handle->io_thread_pool,
+	     io_scheduler->runs,
+	     number_of_runs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		return( -1 );
+	}
+	/* The journal overlay is applied by the calling thread since the journal is not shared
+	 * with the threads of the I/O thread pool
+	 */
+	first_read_index = 0;
+
+	for( run_index = 0;
+	     run_index < number_of_runs;
+	     run_index++ )
+	{
+		run = &( io_scheduler->runs[ run_index ] );
+
+		if( io_handle->journal != NULL )
+		{
+			if( libfshfs_journal_apply_overlay(
+			     io_handle->journal,
+			     file_io_handle,
+			     run->offset,
+			     run->buffer,
+			     run->size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to apply journal overlay.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libfshfs_io_scheduler_get_run(
+		     io_scheduler,
+		     first_read_index,
+		     &last_read_index,
+		     &run_offset,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve coalesced read of pending read: %d.",
+			 function,
+			 first_read_index );
+
+			return( -1 );
+		}
+		if( libfshfs_io_scheduler_copy_run_data(
+		     io_scheduler,
+		     first_read_index,
+		     last_read_index,
+		     run->offset,
+		     run->buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy data of coalesced read: %d.",
+			 function,
+			 run_index );
+
+			return( -1 );
+		}
+		first_read_index = last_read_index;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,149 @@
+/*
+ * I/O scheduler functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_IO_SCHEDULER_H )
+#define _LIBFSHFS_IO_SCHEDULER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_io_handle.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_io_scheduler_read libfshfs_io_scheduler_read_t;
+
+struct libfshfs_io_scheduler_read
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+};
+
+typedef struct libfshfs_io_scheduler libfshfs_io_scheduler_t;
+
+struct libfshfs_io_scheduler
+{
+	/* The maximum gap size between reads that are coalesced
+	 */
+	size_t maximum_gap_size;
+
+	/* The maximum size of a coalesced read
+	 */
+	size_t maximum_read_size;
+
+	/* The pending reads
+	 */
+	libfshfs_io_scheduler_read_t *reads;
+
+	/* The number of pending reads
+	 */
+	int number_of_reads;
+
+	/* The maximum number of pending reads
+	 */
+	int maximum_number_of_reads;
+
+	/* The buffer of a coalesced read
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The coalesced reads, which are used when reading concurrently
+	 */
+	libfshfs_io_thread_pool_read_t *runs;
+
+	/* The maximum number of coalesced reads
+	 */
+	int maximum_number_of_runs;
+};
+
+int libfshfs_io_scheduler_initialize(
+     libfshfs_io_scheduler_t **io_scheduler,
+     size_t maximum_gap_size,
+     size_t maximum_read_size,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_free(
+     libfshfs_io_scheduler_t **io_scheduler,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_compare_reads(
+     const void *first_read,
+     const void *second_read );
+
+int libfshfs_io_scheduler_queue_read(
+     libfshfs_io_scheduler_t *io_scheduler,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_get_run(
+     libfshfs_io_scheduler_t *io_scheduler,
+     int first_read_index,
+     int *last_read_index,
+     off64_t *run_offset,
+     size_t *run_size,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_copy_run_data(
+     libfshfs_io_scheduler_t *io_scheduler,
+     int first_read_index,
+     int last_read_index,
+     off64_t run_offset,
+     const uint8_t *buffer,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_flush(
+     libfshfs_io_scheduler_t *io_scheduler,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_io_scheduler_flush_concurrent(
+     libfshfs_io_scheduler_t *io_scheduler,
+     libfshfs_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_IO_SCHEDULER_H ) */
+
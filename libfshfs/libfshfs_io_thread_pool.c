@@ -0,0 +1,730 @@
+/*
+ * The I/O thread pool functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_io_handle.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+#include "libfshfs_libcthreads.h"
+
+/* Creates an I/O thread pool
+ * Make sure the value io_thread_pool is referencing, is set to NULL
+ * Every thread of the pool reads using its own clone of the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_thread_pool_initialize(
+     libfshfs_io_thread_pool_t **io_thread_pool,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function       = "libfshfs_io_thread_pool_initialize";
+	size_t file_io_handles_size = 0;
+	int file_io_handle_index    = 0;
+	int file_io_handle_is_open  = 0;
+
+	if( io_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid I/O thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBFSHFS_IO_THREAD_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_thread_pool = memory_allocate_structure(
+	                   libfshfs_io_thread_pool_t );
+
+	if( *io_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create I/O thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_thread_pool,
+	     0,
+	     sizeof( libfshfs_io_thread_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear I/O thread pool.",
+		 function );
+
+		memory_free(
+		 *io_thread_pool );
+
+		*io_thread_pool = NULL;
+
+		return( -1 );
+	}
+	file_io_handles_size = sizeof( libbfio_handle_t * ) * number_of_threads;
+
+	( *io_thread_pool )->file_io_handles = (libbfio_handle_t **) memory_allocate(
+	                                                              file_io_handles_size );
+
+	if( ( *io_thread_pool )->file_io_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *io_thread_pool )->file_io_handles,
+	     0,
+	     file_io_handles_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	for( file_io_handle_index = 0;
+	     file_io_handle_index < number_of_threads;
+	     file_io_handle_index++ )
+	{
+		if( libbfio_handle_clone(
+		     &( ( *io_thread_pool )->file_io_handles[ file_io_handle_index ] ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 file_io_handle_index );
+
+			goto on_error;
+		}
+		( *io_thread_pool )->number_of_file_io_handles += 1;
+
+		file_io_handle_is_open = libbfio_handle_is_open(
+		                          ( *io_thread_pool )->file_io_handles[ file_io_handle_index ],
+		                          error );
+
+		if( file_io_handle_is_open == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 file_io_handle_index );
+
+			goto on_error;
+		}
+		else if( file_io_handle_is_open == 0 )
+		{
+			if( libbfio_handle_open(
+			     ( *io_thread_pool )->file_io_handles[ file_io_handle_index ],
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle: %d.",
+				 function,
+				 file_io_handle_index );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_thread_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *io_thread_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *io_thread_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     LIBFSHFS_IO_THREAD_POOL_MAXIMUM_NUMBER_OF_QUEUED_READS,
+	     (int (*)(intptr_t *, void *)) &libfshfs_io_thread_pool_callback_read,
+	     (void *) *io_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *io_thread_pool != NULL )
+	{
+		libfshfs_io_thread_pool_free(
+		 io_thread_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an I/O thread pool
+ * The threads are joined before the file IO handles are closed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_thread_pool_free(
+     libfshfs_io_thread_pool_t **io_thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function    = "libfshfs_io_thread_pool_free";
+	int file_io_handle_index = 0;
+	int result               = 1;
+
+	if( io_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_thread_pool != NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( ( *io_thread_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *io_thread_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_thread_pool )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *io_thread_pool )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_thread_pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *io_thread_pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *io_thread_pool )->file_io_handles != NULL )
+		{
+			for( file_io_handle_index = 0;
+			     file_io_handle_index < ( *io_thread_pool )->number_of_file_io_handles;
+			     file_io_handle_index++ )
+			{
+				if( libbfio_handle_free(
+				     &( ( *io_thread_pool )->file_io_handles[ file_io_handle_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free file IO handle: %d.",
+					 function,
+					 file_io_handle_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *io_thread_pool )->file_io_handles );
+		}
+		memory_free(
+		 *io_thread_pool );
+
+		*io_thread_pool = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+
+/* Grabs the mutex of the I/O thread pool
+ * The pending reads of a batch reference the state of the thread that waits for the batch,
+ * hence the mutex is grabbed again until successful
+ * Returns 1 if successful or -1 if the first attempt failed, in both cases the mutex is held
+ */
+int libfshfs_io_thread_pool_grab_mutex(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_thread_pool_grab_mutex";
+	int result            = 1;
+
+	while( libcthreads_mutex_grab(
+	        io_thread_pool->mutex,
+	        NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Releases the mutex of the I/O thread pool
+ * The mutex is released again until successful, otherwise the other threads cannot progress
+ * Returns 1 if successful or -1 if the first attempt failed, in both cases the mutex is released
+ */
+int libfshfs_io_thread_pool_release_mutex(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_io_thread_pool_release_mutex";
+	int result            = 1;
+
+	while( libcthreads_mutex_release(
+	        io_thread_pool->mutex,
+	        NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the buffer of a pending read
+ * If the pending read has IO vectors these are read using the IO handle instead,
+ * which includes the journal overlay
+ * This function is called by the threads of the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_thread_pool_callback_read(
+     libfshfs_io_thread_pool_read_t *pending_read,
+     libfshfs_io_thread_pool_t *io_thread_pool )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libfshfs_io_thread_pool_callback_read";
+	int result               = 1;
+
+	if( pending_read == NULL )
+	{
+		return( -1 );
+	}
+	if( io_thread_pool == NULL )
+	{
+		return( -1 );
+	}
+	if( pending_read->io_vectors != NULL )
+	{
+		pending_read->read_count = libfshfs_io_handle_read_vectors_at_offset(
+		                            pending_read->io_handle,
+		                            pending_read->file_io_handle,
+		                            pending_read->offset,
+		                            pending_read->io_vectors,
+		                            pending_read->number_of_io_vectors,
+		                            &error );
+	}
+	else
+	{
+		pending_read->read_count = libbfio_handle_read_buffer_at_offset(
+		                            pending_read->file_io_handle,
+		                            pending_read->buffer,
+		                            pending_read->size,
+		                            pending_read->offset,
+		                            &error );
+	}
+
+	/* The read count is checked by the thread that waits for the batch
+	 */
+	if( pending_read->read_count == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 pending_read->offset,
+		 pending_read->offset );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The number of outstanding reads is always decremented, otherwise the thread
+	 * that waits for the batch never continues
+	 */
+	if( libfshfs_io_thread_pool_grab_mutex(
+	     io_thread_pool,
+	     &error ) != 1 )
+	{
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	*( pending_read->number_of_outstanding_reads ) -= 1;
+
+	if( *( pending_read->number_of_outstanding_reads ) == 0 )
+	{
+		while( libcthreads_condition_broadcast(
+		        io_thread_pool->condition,
+		        NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( libfshfs_io_thread_pool_release_mutex(
+	     io_thread_pool,
+	     &error ) != 1 )
+	{
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+#else
+	*( pending_read->number_of_outstanding_reads ) -= 1;
+#endif
+	return( result );
+}
+
+/* Reads the buffers of a batch of reads
+ * The reads are distributed over the threads and this function waits until all reads have completed
+ * The caller sets the offset, size and buffer of the reads, or the IO vectors and IO handle instead of the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_io_thread_pool_read_buffers(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libfshfs_io_thread_pool_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+	libfshfs_io_thread_pool_read_t *pending_read = NULL;
+	static char *function                        = "libfshfs_io_thread_pool_read_buffers";
+	int number_of_outstanding_reads              = 0;
+	int read_index                               = 0;
+	int result                                   = 1;
+
+	if( io_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid I/O thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_thread_pool->number_of_file_io_handles == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid I/O thread pool - missing file IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of reads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_outstanding_reads = number_of_reads;
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		pending_read = &( reads[ read_index ] );
+
+		pending_read->file_io_handle              = io_thread_pool->file_io_handles[ read_index % io_thread_pool->number_of_file_io_handles ];
+		pending_read->read_count                  = -1;
+		pending_read->number_of_outstanding_reads = &number_of_outstanding_reads;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     io_thread_pool->thread_pool,
+		     (intptr_t *) pending_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read: %d onto thread pool.",
+			 function,
+			 read_index );
+
+			/* The reads that were pushed still need to complete before the buffers can be released
+			 */
+			libfshfs_io_thread_pool_grab_mutex(
+			 io_thread_pool,
+			 error );
+
+			number_of_outstanding_reads -= number_of_reads - read_index;
+
+			libfshfs_io_thread_pool_release_mutex(
+			 io_thread_pool,
+			 error );
+
+			result = -1;
+
+			break;
+		}
+#else
+		libfshfs_io_thread_pool_callback_read(
+		 pending_read,
+		 io_thread_pool );
+#endif
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The pending reads reference number_of_outstanding_reads and the buffers of the caller,
+	 * hence this function does not return before all reads have completed
+	 */
+	if( libfshfs_io_thread_pool_grab_mutex(
+	     io_thread_pool,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	while( number_of_outstanding_reads > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     io_thread_pool->condition,
+		     io_thread_pool->mutex,
+		     NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+			}
+			/* Poll the number of outstanding reads instead
+			 */
+			libfshfs_io_thread_pool_release_mutex(
+			 io_thread_pool,
+			 NULL );
+
+			libfshfs_io_thread_pool_grab_mutex(
+			 io_thread_pool,
+			 NULL );
+		}
+	}
+	if( libfshfs_io_thread_pool_release_mutex(
+	     io_thread_pool,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		pending_read = &( reads[ read_index ] );
+
+		if( pending_read->read_count != (ssize_t) pending_read->size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 pending_read->size,
+			 pending_read->offset,
+			 pending_read->offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
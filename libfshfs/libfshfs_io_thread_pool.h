@@ -0,0 +1,142 @@
+/*
+ * The I/O thread pool functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_IO_THREAD_POOL_H )
+#define _LIBFSHFS_IO_THREAD_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+#include "libfshfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_io_thread_pool_read libfshfs_io_thread_pool_read_t;
+
+struct libfshfs_io_thread_pool_read
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The IO vectors, which are read instead of the buffer if set
+	 */
+	libfshfs_io_vector_t *io_vectors;
+
+	/* The number of IO vectors
+	 */
+	int number_of_io_vectors;
+
+	/* The IO handle that is used to read the IO vectors
+	 */
+	struct libfshfs_io_handle *io_handle;
+
+	/* The read count, which is -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The number of outstanding reads of the batch the read is part of
+	 */
+	int *number_of_outstanding_reads;
+};
+
+typedef struct libfshfs_io_thread_pool libfshfs_io_thread_pool_t;
+
+struct libfshfs_io_thread_pool
+{
+	/* The file IO handles, which are clones of the file IO handle of the volume
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The number of file IO handles
+	 */
+	int number_of_file_io_handles;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the number of outstanding reads of the batches
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is broadcasted when all outstanding reads of a batch have completed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libfshfs_io_thread_pool_initialize(
+     libfshfs_io_thread_pool_t **io_thread_pool,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libfshfs_io_thread_pool_free(
+     libfshfs_io_thread_pool_t **io_thread_pool,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+
+int libfshfs_io_thread_pool_grab_mutex(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libcerror_error_t **error );
+
+int libfshfs_io_thread_pool_release_mutex(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT ) */
+
+int libfshfs_io_thread_pool_callback_read(
+     libfshfs_io_thread_pool_read_t *pending_read,
+     libfshfs_io_thread_pool_t *io_thread_pool );
+
+int libfshfs_io_thread_pool_read_buffers(
+     libfshfs_io_thread_pool_t *io_thread_pool,
+     libfshfs_io_thread_pool_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_IO_THREAD_POOL_H ) */
+
@@ -0,0 +1,1928 @@
+/*
+ * Journal functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+
+#include "fshfs_journal.h"
+
+/* The initial number of slots of the blocks hash table
+ */
+#define LIBFSHFS_JOURNAL_INITIAL_NUMBER_OF_SLOTS	1024
+
+/* The maximum number of slots of the blocks hash table
+ */
+#define LIBFSHFS_JOURNAL_MAXIMUM_NUMBER_OF_SLOTS	( (uint32_t) 1 << 28 )
+
+/* The maximum supported block list header size
+ */
+#define LIBFSHFS_JOURNAL_MAXIMUM_BLOCK_LIST_HEADER_SIZE	( 16 * 1024 * 1024 )
+
+/* The multiplier used to hash block numbers
+ */
+#define LIBFSHFS_JOURNAL_HASH_MULTIPLIER		0x9e3779b97f4a7c15ULL
+
+const uint8_t fshfs_journal_signature_big_endian[ 4 ]    = { 'J', 'N', 'L', 'x' };
+const uint8_t fshfs_journal_signature_little_endian[ 4 ] = { 'x', 'L', 'N', 'J' };
+
+/* Creates a journal
+ * Make sure the value journal is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_initialize(
+     libfshfs_journal_t **journal,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_initialize";
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( *journal != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid journal value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*journal = memory_allocate_structure(
+	            libfshfs_journal_t );
+
+	if( *journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create journal.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *journal,
+	     0,
+	     sizeof( libfshfs_journal_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear journal.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *journal != NULL )
+	{
+		memory_free(
+		 *journal );
+
+		*journal = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a journal
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_free(
+     libfshfs_journal_t **journal,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_free";
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( *journal != NULL )
+	{
+		if( ( *journal )->blocks != NULL )
+		{
+			memory_free(
+			 ( *journal )->blocks );
+		}
+		memory_free(
+		 *journal );
+
+		*journal = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the checksum of journal header or block list header data
+ * The checksum value in the data should be zeroed before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_calculate_checksum(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error )
+{
+	static char *function  = "libfshfs_journal_calculate_checksum";
+	size_t data_offset     = 0;
+	uint32_t safe_checksum = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		safe_checksum = ( safe_checksum << 8 ) ^ ( safe_checksum + data[ data_offset ] );
+	}
+	*checksum = ~safe_checksum;
+
+	return( 1 );
+}
+
+/* Reads the journal information block
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_read_information_block_data(
+     libfshfs_journal_t *journal,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_read_information_block_data";
+	uint64_t value_64bit  = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( fshfs_journal_information_block_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: journal information block data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( fshfs_journal_information_block_t ),
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_journal_information_block_t *) data )->flags,
+	 journal->flags );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (fshfs_journal_information_block_t *) data )->journal_offset,
+	 value_64bit );
+
+	journal->journal_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (fshfs_journal_information_block_t *) data )->journal_size,
+	 journal->journal_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: flags\t\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 journal->flags );
+
+		libcnotify_printf(
+		 "%s: journal offset\t\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 value_64bit );
+
+		libcnotify_printf(
+		 "%s: journal size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 journal->journal_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->journal_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the journal header
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_read_header_data(
+     libfshfs_journal_t *journal,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t journal_header_data[ sizeof( fshfs_journal_header_t ) ];
+
+	static char *function        = "libfshfs_journal_read_header_data";
+	uint64_t journal_size        = 0;
+	uint64_t value_64bit         = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum     = 0;
+	uint32_t value_32bit         = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( fshfs_journal_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: journal header data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( fshfs_journal_header_t ),
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	/* The journal header is stored in the byte order of the system that created the journal
+	 */
+	if( memory_compare(
+	     ( (fshfs_journal_header_t *) data )->signature,
+	     fshfs_journal_signature_big_endian,
+	     4 ) == 0 )
+	{
+		journal->byte_order = LIBFSHFS_ENDIAN_BIG;
+	}
+	else if( memory_compare(
+	          ( (fshfs_journal_header_t *) data )->signature,
+	          fshfs_journal_signature_little_endian,
+	          4 ) == 0 )
+	{
+		journal->byte_order = LIBFSHFS_ENDIAN_LITTLE;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid journal header signature.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_journal_header_t *) data )->endian_signature,
+		 value_32bit );
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_journal_header_t *) data )->endian_signature,
+		 value_32bit );
+	}
+	if( value_32bit != 0x12345678UL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid journal header endian signature: 0x%08" PRIx32 ".",
+		 function,
+		 value_32bit );
+
+		return( -1 );
+	}
+	if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_journal_header_t *) data )->checksum,
+		 stored_checksum );
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_journal_header_t *) data )->checksum,
+		 stored_checksum );
+	}
+	/* The checksum is calculated with the checksum value set to 0
+	 */
+	if( memory_copy(
+	     journal_header_data,
+	     data,
+	     sizeof( fshfs_journal_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy journal header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     ( (fshfs_journal_header_t *) journal_header_data )->checksum,
+	     0,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear journal header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_journal_calculate_checksum(
+	     journal_header_data,
+	     sizeof( fshfs_journal_header_t ),
+	     &calculated_checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate journal header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: mismatch in journal header checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		return( -1 );
+	}
+	if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+	{
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (fshfs_journal_header_t *) data )->start_offset,
+		 value_64bit );
+
+		journal->start_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (fshfs_journal_header_t *) data )->end_offset,
+		 value_64bit );
+
+		journal->end_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_big_endian(
+		 ( (fshfs_journal_header_t *) data )->journal_size,
+		 journal_size );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_journal_header_t *) data )->block_list_header_size,
+		 journal->block_list_header_size );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_journal_header_t *) data )->journal_header_size,
+		 journal->journal_header_size );
+	}
+	else
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fshfs_journal_header_t *) data )->start_offset,
+		 value_64bit );
+
+		journal->start_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fshfs_journal_header_t *) data )->end_offset,
+		 value_64bit );
+
+		journal->end_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (fshfs_journal_header_t *) data )->journal_size,
+		 journal_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_journal_header_t *) data )->block_list_header_size,
+		 journal->block_list_header_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (fshfs_journal_header_t *) data )->journal_header_size,
+		 journal->journal_header_size );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: signature\t\t\t\t: %c%c%c%c\n",
+		 function,
+		 ( (fshfs_journal_header_t *) data )->signature[ 0 ],
+		 ( (fshfs_journal_header_t *) data )->signature[ 1 ],
+		 ( (fshfs_journal_header_t *) data )->signature[ 2 ],
+		 ( (fshfs_journal_header_t *) data )->signature[ 3 ] );
+
+		libcnotify_printf(
+		 "%s: endian signature\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 value_32bit );
+
+		libcnotify_printf(
+		 "%s: start offset\t\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 journal->start_offset );
+
+		libcnotify_printf(
+		 "%s: end offset\t\t\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 journal->end_offset );
+
+		libcnotify_printf(
+		 "%s: journal size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 journal_size );
+
+		libcnotify_printf(
+		 "%s: block list header size\t\t\t: %" PRIu32 "\n",
+		 function,
+		 journal->block_list_header_size );
+
+		libcnotify_printf(
+		 "%s: checksum\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 stored_checksum );
+
+		libcnotify_printf(
+		 "%s: journal header size\t\t\t: %" PRIu32 "\n",
+		 function,
+		 journal->journal_header_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	/* The journal size in the journal information block is authoritative
+	 */
+	if( journal->journal_size == 0 )
+	{
+		journal->journal_size = (size64_t) journal_size;
+	}
+	if( ( journal->journal_header_size < sizeof( fshfs_journal_header_t ) )
+	 || ( journal->journal_header_size > 65536 )
+	 || ( (size64_t) journal->journal_header_size >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->block_list_header_size < ( sizeof( fshfs_journal_block_list_header_t ) + sizeof( fshfs_journal_block_information_t ) ) )
+	 || ( (size64_t) journal->block_list_header_size > ( journal->journal_size - journal->journal_header_size ) )
+	 || ( journal->block_list_header_size > LIBFSHFS_JOURNAL_MAXIMUM_BLOCK_LIST_HEADER_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block list header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->start_offset < (off64_t) journal->journal_header_size )
+	 || ( (size64_t) journal->start_offset >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid start offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->end_offset < (off64_t) journal->journal_header_size )
+	 || ( (size64_t) journal->end_offset >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid end offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the journal information block
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_read_information_block_file_io_handle(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	uint8_t journal_information_block_data[ sizeof( fshfs_journal_information_block_t ) ];
+
+	static char *function = "libfshfs_journal_read_information_block_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading journal information block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek journal information block offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              journal_information_block_data,
+	              sizeof( fshfs_journal_information_block_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( fshfs_journal_information_block_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal information block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_journal_read_information_block_data(
+	     journal,
+	     journal_information_block_data,
+	     sizeof( fshfs_journal_information_block_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal information block.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the journal information block, the journal header and the transactions
+ * Returns 1 if successful, 0 if the journal does not need to be replayed or -1 on error
+ */
+int libfshfs_journal_read_file_io_handle(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	uint8_t journal_header_data[ sizeof( fshfs_journal_header_t ) ];
+
+	static char *function = "libfshfs_journal_read_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_journal_read_information_block_file_io_handle(
+	     journal,
+	     file_io_handle,
+	     file_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal information block.",
+		 function );
+
+		return( -1 );
+	}
+	/* A journal stored on another device or that still needs to be initialized
+	 * contains no transactions that can be replayed
+	 */
+	if( ( ( journal->flags & LIBFSHFS_JOURNAL_FLAG_IN_FILE_SYSTEM ) == 0 )
+	 || ( ( journal->flags & LIBFSHFS_JOURNAL_FLAG_NEEDS_INITIALIZATION ) != 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading journal header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 journal->journal_offset,
+		 journal->journal_offset );
+	}
+#endif
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     journal->journal_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek journal header offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 journal->journal_offset,
+		 journal->journal_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              journal_header_data,
+	              sizeof( fshfs_journal_header_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( fshfs_journal_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal header data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_journal_read_header_data(
+	     journal,
+	     journal_header_data,
+	     sizeof( fshfs_journal_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal header.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->start_offset == journal->end_offset )
+	{
+		return( 0 );
+	}
+	if( libfshfs_journal_read_transactions(
+	     journal,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal transactions.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->number_of_blocks == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the transactions between the start and end offset
+ * The block data itself is not read, only its location in the journal is recorded
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_read_transactions(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *block_list_header_data  = NULL;
+	uint8_t *block_information_data  = NULL;
+	static char *function            = "libfshfs_journal_read_transactions";
+	size64_t buffer_size             = 0;
+	size64_t remaining_size          = 0;
+	size64_t transaction_data_size   = 0;
+	off64_t block_data_offset        = 0;
+	off64_t transaction_offset       = 0;
+	uint64_t block_number            = 0;
+	uint32_t block_size              = 0;
+	uint32_t calculated_checksum     = 0;
+	uint32_t number_of_bytes_used    = 0;
+	uint32_t sequence_number         = 0;
+	uint32_t stored_checksum         = 0;
+	uint16_t block_information_index = 0;
+	uint16_t number_of_blocks        = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->journal_header_size == 0 )
+	 || ( (size64_t) journal->journal_header_size >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal - journal header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->block_list_header_size < ( sizeof( fshfs_journal_block_list_header_t ) + sizeof( fshfs_journal_block_information_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal - block list header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_size = journal->journal_size - journal->journal_header_size;
+
+	/* Determine the size of the used part of the circular buffer
+	 */
+	if( journal->end_offset >= journal->start_offset )
+	{
+		remaining_size = (size64_t) ( journal->end_offset - journal->start_offset );
+	}
+	else
+	{
+		remaining_size = ( journal->journal_size - journal->start_offset )
+		               + ( journal->end_offset - journal->journal_header_size );
+	}
+	block_list_header_data = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * journal->block_list_header_size );
+
+	if( block_list_header_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block list header data.",
+		 function );
+
+		goto on_error;
+	}
+	transaction_offset = journal->start_offset;
+
+	while( remaining_size > 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading transaction: %" PRIu32 " at journal offset: 0x%08" PRIx64 "\n",
+			 function,
+			 sequence_number,
+			 transaction_offset );
+		}
+#endif
+		if( libfshfs_journal_read_buffer(
+		     journal,
+		     file_io_handle,
+		     transaction_offset,
+		     block_list_header_data,
+		     (size_t) journal->block_list_header_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block list header data.",
+			 function );
+
+			goto on_error;
+		}
+		if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->checksum,
+			 stored_checksum );
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->checksum,
+			 stored_checksum );
+		}
+		/* The checksum is calculated over the block list header and the first block information
+		 * with the checksum value set to 0
+		 */
+		byte_stream_copy_from_uint32_big_endian(
+		 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->checksum,
+		 0 );
+
+		if( libfshfs_journal_calculate_checksum(
+		     block_list_header_data,
+		     sizeof( fshfs_journal_block_list_header_t ) + sizeof( fshfs_journal_block_information_t ),
+		     &calculated_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate block list header checksum.",
+			 function );
+
+			goto on_error;
+		}
+		if( stored_checksum != calculated_checksum )
+		{
+			/* Like the replay of Mac OS X the transactions are replayed up to
+			 * the first block list header with a mismatching checksum, if that
+			 * is the first block list header the journal is considered corrupt
+			 */
+			if( transaction_offset == journal->start_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+				 "%s: mismatch in block list header checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).",
+				 function,
+				 stored_checksum,
+				 calculated_checksum );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: mismatch in block list header checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ) - stopping replay.\n",
+				 function,
+				 stored_checksum,
+				 calculated_checksum );
+			}
+#endif
+			break;
+		}
+		if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+		{
+			byte_stream_copy_to_uint16_big_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->number_of_blocks,
+			 number_of_blocks );
+
+			byte_stream_copy_to_uint32_big_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->number_of_bytes_used,
+			 number_of_bytes_used );
+		}
+		else
+		{
+			byte_stream_copy_to_uint16_little_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->number_of_blocks,
+			 number_of_blocks );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (fshfs_journal_block_list_header_t *) block_list_header_data )->number_of_bytes_used,
+			 number_of_bytes_used );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: number of blocks\t\t\t: %" PRIu16 "\n",
+			 function,
+			 number_of_blocks );
+
+			libcnotify_printf(
+			 "%s: number of bytes used\t\t\t: %" PRIu32 "\n",
+			 function,
+			 number_of_bytes_used );
+		}
+#endif
+		if( ( number_of_blocks == 0 )
+		 || ( ( sizeof( fshfs_journal_block_list_header_t ) + ( (size_t) number_of_blocks * sizeof( fshfs_journal_block_information_t ) ) ) > (size_t) journal->block_list_header_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of blocks value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( number_of_bytes_used < journal->block_list_header_size )
+		 || ( (size64_t) number_of_bytes_used > remaining_size )
+		 || ( (size64_t) number_of_bytes_used > buffer_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of bytes used value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		block_data_offset     = transaction_offset + journal->block_list_header_size;
+		transaction_data_size = number_of_bytes_used - journal->block_list_header_size;
+
+		if( (size64_t) block_data_offset >= journal->journal_size )
+		{
+			block_data_offset -= (off64_t) buffer_size;
+		}
+		/* The first block information is used to link block list headers
+		 */
+		block_information_data = &( block_list_header_data[ sizeof( fshfs_journal_block_list_header_t ) + sizeof( fshfs_journal_block_information_t ) ] );
+
+		for( block_information_index = 1;
+		     block_information_index < number_of_blocks;
+		     block_information_index++ )
+		{
+			if( journal->byte_order == LIBFSHFS_ENDIAN_BIG )
+			{
+				byte_stream_copy_to_uint64_big_endian(
+				 ( (fshfs_journal_block_information_t *) block_information_data )->block_number,
+				 block_number );
+
+				byte_stream_copy_to_uint32_big_endian(
+				 ( (fshfs_journal_block_information_t *) block_information_data )->block_size,
+				 block_size );
+			}
+			else
+			{
+				byte_stream_copy_to_uint64_little_endian(
+				 ( (fshfs_journal_block_information_t *) block_information_data )->block_number,
+				 block_number );
+
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (fshfs_journal_block_information_t *) block_information_data )->block_size,
+				 block_size );
+			}
+			block_information_data += sizeof( fshfs_journal_block_information_t );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: block: %" PRIu16 " number\t\t\t: %" PRIi64 "\n",
+				 function,
+				 block_information_index,
+				 (int64_t) block_number );
+
+				libcnotify_printf(
+				 "%s: block: %" PRIu16 " size\t\t\t: %" PRIu32 "\n",
+				 function,
+				 block_information_index,
+				 block_size );
+			}
+#endif
+			if( (size64_t) block_size > transaction_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid block: %" PRIu16 " size value out of bounds.",
+				 function,
+				 block_information_index );
+
+				goto on_error;
+			}
+			/* A block number of -1 indicates a block that was killed
+			 */
+			if( ( block_number != (uint64_t) -1 )
+			 && ( block_size != 0 ) )
+			{
+				if( libfshfs_journal_insert_block(
+				     journal,
+				     block_number,
+				     block_data_offset,
+				     block_size,
+				     sequence_number,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert block: %" PRIu16 ".",
+					 function,
+					 block_information_index );
+
+					goto on_error;
+				}
+			}
+			block_data_offset     += block_size;
+			transaction_data_size -= block_size;
+
+			if( (size64_t) block_data_offset >= journal->journal_size )
+			{
+				block_data_offset -= (off64_t) buffer_size;
+			}
+		}
+		transaction_offset += number_of_bytes_used;
+		remaining_size     -= number_of_bytes_used;
+
+		if( (size64_t) transaction_offset >= journal->journal_size )
+		{
+			transaction_offset -= (off64_t) buffer_size;
+		}
+		sequence_number++;
+	}
+	memory_free(
+	 block_list_header_data );
+
+	return( 1 );
+
+on_error:
+	if( block_list_header_data != NULL )
+	{
+		memory_free(
+		 block_list_header_data );
+	}
+	return( -1 );
+}
+
+/* Reads data from the circular buffer of the journal
+ * Reads that extend beyond the end of the journal continue directly after the journal header
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_read_buffer(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t journal_data_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_read_buffer";
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->journal_header_size == 0 )
+	 || ( (size64_t) journal->journal_header_size >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal - journal header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal_data_offset < (off64_t) journal->journal_header_size )
+	 || ( (size64_t) journal_data_offset >= journal->journal_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size > (size_t) SSIZE_MAX )
+	 || ( (size64_t) size > ( journal->journal_size - journal->journal_header_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( (size64_t) journal_data_offset >= journal->journal_size )
+		{
+			journal_data_offset = (off64_t) journal->journal_header_size;
+		}
+		read_size = size - buffer_offset;
+
+		if( (size64_t) read_size > ( journal->journal_size - journal_data_offset ) )
+		{
+			read_size = (size_t) ( journal->journal_size - journal_data_offset );
+		}
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     journal->journal_offset + journal_data_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek journal data offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 journal_data_offset,
+			 journal_data_offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( buffer[ buffer_offset ] ),
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset       += read_size;
+		journal_data_offset += read_size;
+	}
+	return( 1 );
+}
+
+/* Inserts a block into the blocks hash table
+ * A block that was already stored is replaced by the more recent one
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_insert_block(
+     libfshfs_journal_t *journal,
+     uint64_t block_number,
+     off64_t data_offset,
+     uint32_t block_size,
+     uint32_t sequence_number,
+     libcerror_error_t **error )
+{
+	libfshfs_journal_block_t *block  = NULL;
+	libfshfs_journal_block_t *blocks = NULL;
+	static char *function            = "libfshfs_journal_insert_block";
+	uint64_t hash_value              = 0;
+	off64_t block_offset             = 0;
+	uint32_t new_slot_index          = 0;
+	uint32_t number_of_slots         = 0;
+	uint32_t slot_index              = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->journal_header_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid journal - journal header size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number > ( (uint64_t) INT64_MAX / journal->journal_header_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the load factor of the hash table below 3/4
+	 */
+	if( ( (uint64_t) journal->number_of_blocks + 1 ) * 4 > (uint64_t) journal->number_of_slots * 3 )
+	{
+		if( journal->number_of_slots == 0 )
+		{
+			number_of_slots = LIBFSHFS_JOURNAL_INITIAL_NUMBER_OF_SLOTS;
+		}
+		else if( journal->number_of_slots < LIBFSHFS_JOURNAL_MAXIMUM_NUMBER_OF_SLOTS )
+		{
+			number_of_slots = journal->number_of_slots * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid journal - number of blocks value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		blocks = (libfshfs_journal_block_t *) memory_allocate(
+		                                       sizeof( libfshfs_journal_block_t ) * number_of_slots );
+
+		if( blocks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create blocks hash table.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     blocks,
+		     0,
+		     sizeof( libfshfs_journal_block_t ) * number_of_slots ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear blocks hash table.",
+			 function );
+
+			memory_free(
+			 blocks );
+
+			return( -1 );
+		}
+		for( slot_index = 0;
+		     slot_index < journal->number_of_slots;
+		     slot_index++ )
+		{
+			block = &( journal->blocks[ slot_index ] );
+
+			if( block->block_size == 0 )
+			{
+				continue;
+			}
+			hash_value     = ( block->block_number * LIBFSHFS_JOURNAL_HASH_MULTIPLIER ) >> 32;
+			new_slot_index = (uint32_t) ( hash_value & ( number_of_slots - 1 ) );
+
+			while( blocks[ new_slot_index ].block_size != 0 )
+			{
+				new_slot_index = ( new_slot_index + 1 ) & ( number_of_slots - 1 );
+			}
+			blocks[ new_slot_index ] = *block;
+		}
+		if( journal->blocks != NULL )
+		{
+			memory_free(
+			 journal->blocks );
+		}
+		journal->blocks          = blocks;
+		journal->number_of_slots = number_of_slots;
+	}
+	hash_value = ( block_number * LIBFSHFS_JOURNAL_HASH_MULTIPLIER ) >> 32;
+	slot_index = (uint32_t) ( hash_value & ( journal->number_of_slots - 1 ) );
+
+	while( journal->blocks[ slot_index ].block_size != 0 )
+	{
+		if( journal->blocks[ slot_index ].block_number == block_number )
+		{
+			break;
+		}
+		slot_index = ( slot_index + 1 ) & ( journal->number_of_slots - 1 );
+	}
+	block = &( journal->blocks[ slot_index ] );
+
+	if( block->block_size == 0 )
+	{
+		journal->number_of_blocks += 1;
+	}
+	block->block_number    = block_number;
+	block->data_offset     = data_offset;
+	block->block_size      = block_size;
+	block->sequence_number = sequence_number;
+
+	if( block_size > journal->maximum_block_size )
+	{
+		journal->maximum_block_size = block_size;
+	}
+	block_offset = (off64_t) ( block_number * journal->journal_header_size );
+
+	if( ( journal->number_of_blocks == 1 )
+	 || ( block_offset < journal->overlay_start_offset ) )
+	{
+		journal->overlay_start_offset = block_offset;
+	}
+	if( ( journal->number_of_blocks == 1 )
+	 || ( ( block_offset + block_size ) > journal->overlay_end_offset ) )
+	{
+		journal->overlay_end_offset = block_offset + block_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves a block from the blocks hash table
+ * Returns 1 if successful, 0 if no such block or -1 on error
+ */
+int libfshfs_journal_get_block_by_number(
+     libfshfs_journal_t *journal,
+     uint64_t block_number,
+     libfshfs_journal_block_t **block,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_get_block_by_number";
+	uint64_t hash_value   = 0;
+	uint32_t slot_index   = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( journal->number_of_blocks == 0 )
+	{
+		return( 0 );
+	}
+	hash_value = ( block_number * LIBFSHFS_JOURNAL_HASH_MULTIPLIER ) >> 32;
+	slot_index = (uint32_t) ( hash_value & ( journal->number_of_slots - 1 ) );
+
+	while( journal->blocks[ slot_index ].block_size != 0 )
+	{
+		if( journal->blocks[ slot_index ].block_number == block_number )
+		{
+			*block = &( journal->blocks[ slot_index ] );
+
+			return( 1 );
+		}
+		slot_index = ( slot_index + 1 ) & ( journal->number_of_slots - 1 );
+	}
+	return( 0 );
+}
+
+/* Determines if the journal blocks can overlap with a range of the volume
+ * The offset is relative to the start of the volume
+ * The range covered by all the blocks is used, hence a range that falls in between blocks is also considered overlapped
+ * Returns 1 if the range can be overlapped, 0 if not or -1 on error
+ */
+int libfshfs_journal_range_has_overlay(
+     libfshfs_journal_t *journal,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_journal_range_has_overlay";
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( journal->number_of_blocks == 0 )
+	 || ( size == 0 )
+	 || ( offset >= journal->overlay_end_offset )
+	 || ( ( offset < journal->overlay_start_offset )
+	  && ( (size64_t) ( journal->overlay_start_offset - offset ) >= size ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Applies the journal blocks that overlap with data read from the volume
+ * The offset is relative to the start of the volume
+ * Overlapping blocks are applied in transaction order so the most recent data prevails
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_journal_apply_overlay(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libfshfs_journal_block_t *block            = NULL;
+	libfshfs_journal_block_t **matching_blocks = NULL;
+	libfshfs_journal_block_t **reallocation    = NULL;
+	static char *function                      = "libfshfs_journal_apply_overlay";
+	size_t copy_size                           = 0;
+	size_t buffer_offset                       = 0;
+	off64_t block_offset                       = 0;
+	off64_t end_offset                         = 0;
+	off64_t journal_data_offset                = 0;
+	uint64_t block_number                      = 0;
+	uint64_t first_block_number                = 0;
+	uint64_t last_block_number                 = 0;
+	int matching_block_index                   = 0;
+	int maximum_number_of_matching_blocks      = 0;
+	int number_of_matching_blocks              = 0;
+	int result                                 = 0;
+	int sort_index                             = 0;
+
+	if( journal == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid journal.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = offset + (off64_t) size;
+
+	/* Most reads do not overlap with the journal blocks
+	 */
+	if( ( journal->number_of_blocks == 0 )
+	 || ( size == 0 )
+	 || ( offset >= journal->overlay_end_offset )
+	 || ( end_offset <= journal->overlay_start_offset ) )
+	{
+		return( 1 );
+	}
+	/* A block that starts before the offset can still overlap the data
+	 */
+	if( offset > (off64_t) journal->maximum_block_size )
+	{
+		first_block_number = (uint64_t) ( offset - journal->maximum_block_size ) / journal->journal_header_size;
+	}
+	last_block_number = (uint64_t) ( end_offset - 1 ) / journal->journal_header_size;
+
+	for( block_number = first_block_number;
+	     block_number <= last_block_number;
+	     block_number++ )
+	{
+		result = libfshfs_journal_get_block_by_number(
+		          journal,
+		          block_number,
+		          &block,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block: %" PRIu64 ".",
+			 function,
+			 block_number );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		block_offset = (off64_t) ( block_number * journal->journal_header_size );
+
+		if( ( block_offset + block->block_size ) <= offset )
+		{
+			continue;
+		}
+		if( number_of_matching_blocks >= maximum_number_of_matching_blocks )
+		{
+			reallocation = (libfshfs_journal_block_t **) memory_reallocate(
+			                                              matching_blocks,
+			                                              sizeof( libfshfs_journal_block_t * ) * ( maximum_number_of_matching_blocks + 16 ) );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize matching blocks.",
+				 function );
+
+				goto on_error;
+			}
+			matching_blocks                    = reallocation;
+			maximum_number_of_matching_blocks += 16;
+		}
+		/* Keep the matching blocks sorted by sequence number
+		 */
+		for( sort_index = number_of_matching_blocks;
+		     sort_index > 0;
+		     sort_index-- )
+		{
+			if( matching_blocks[ sort_index - 1 ]->sequence_number <= block->sequence_number )
+			{
+				break;
+			}
+			matching_blocks[ sort_index ] = matching_blocks[ sort_index - 1 ];
+		}
+		matching_blocks[ sort_index ] = block;
+
+		number_of_matching_blocks++;
+	}
+	for( matching_block_index = 0;
+	     matching_block_index < number_of_matching_blocks;
+	     matching_block_index++ )
+	{
+		block = matching_blocks[ matching_block_index ];
+
+		block_offset        = (off64_t) ( block->block_number * journal->journal_header_size );
+		journal_data_offset = block->data_offset;
+		copy_size           = (size_t) block->block_size;
+
+		if( block_offset < offset )
+		{
+			journal_data_offset += offset - block_offset;
+			copy_size           -= (size_t) ( offset - block_offset );
+			buffer_offset        = 0;
+		}
+		else
+		{
+			buffer_offset = (size_t) ( block_offset - offset );
+		}
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( (size64_t) journal_data_offset >= journal->journal_size )
+		{
+			journal_data_offset -= (off64_t) ( journal->journal_size - journal->journal_header_size );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: applying journal block: %" PRIu64 " of transaction: %" PRIu32 " to offset: 0x%08" PRIx64 " with size: %" PRIzd ".\n",
+			 function,
+			 block->block_number,
+			 block->sequence_number,
+			 offset + buffer_offset,
+			 copy_size );
+		}
+#endif
+		if( libfshfs_journal_read_buffer(
+		     journal,
+		     file_io_handle,
+		     journal_data_offset,
+		     &( buffer[ buffer_offset ] ),
+		     copy_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal block: %" PRIu64 " data.",
+			 function,
+			 block->block_number );
+
+			goto on_error;
+		}
+	}
+	if( matching_blocks != NULL )
+	{
+		memory_free(
+		 matching_blocks );
+	}
+	return( 1 );
+
+on_error:
+	if( matching_blocks != NULL )
+	{
+		memory_free(
+		 matching_blocks );
+	}
+	return( -1 );
+}
+
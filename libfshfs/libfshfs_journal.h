@@ -0,0 +1,202 @@
+/*
+ * Journal functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_JOURNAL_H )
+#define _LIBFSHFS_JOURNAL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_journal_block libfshfs_journal_block_t;
+
+struct libfshfs_journal_block
+{
+	/* The block number
+	 */
+	uint64_t block_number;
+
+	/* The block data offset relative to the start of the journal
+	 */
+	off64_t data_offset;
+
+	/* The block size
+	 * A value of 0 indicates an unused hash table slot
+	 */
+	uint32_t block_size;
+
+	/* The sequence number of the transaction that contains the block
+	 */
+	uint32_t sequence_number;
+};
+
+typedef struct libfshfs_journal libfshfs_journal_t;
+
+struct libfshfs_journal
+{
+	/* The flags
+	 */
+	uint32_t flags;
+
+	/* The journal offset relative to the start of the volume
+	 */
+	off64_t journal_offset;
+
+	/* The journal size
+	 */
+	size64_t journal_size;
+
+	/* The start offset relative to the start of the journal
+	 */
+	off64_t start_offset;
+
+	/* The end offset relative to the start of the journal
+	 */
+	off64_t end_offset;
+
+	/* The block list header size
+	 */
+	uint32_t block_list_header_size;
+
+	/* The journal header size, which is also the unit of the block numbers
+	 */
+	uint32_t journal_header_size;
+
+	/* The byte order
+	 */
+	uint8_t byte_order;
+
+	/* The blocks hash table
+	 */
+	libfshfs_journal_block_t *blocks;
+
+	/* The number of hash table slots, which is a power of 2
+	 */
+	uint32_t number_of_slots;
+
+	/* The number of blocks
+	 */
+	uint32_t number_of_blocks;
+
+	/* The maximum block size
+	 */
+	uint32_t maximum_block_size;
+
+	/* The start of the volume range covered by the blocks
+	 */
+	off64_t overlay_start_offset;
+
+	/* The end of the volume range covered by the blocks
+	 */
+	off64_t overlay_end_offset;
+};
+
+int libfshfs_journal_initialize(
+     libfshfs_journal_t **journal,
+     libcerror_error_t **error );
+
+int libfshfs_journal_free(
+     libfshfs_journal_t **journal,
+     libcerror_error_t **error );
+
+int libfshfs_journal_calculate_checksum(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_information_block_data(
+     libfshfs_journal_t *journal,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_header_data(
+     libfshfs_journal_t *journal,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_information_block_file_io_handle(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_file_io_handle(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_transactions(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_journal_read_buffer(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t journal_data_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libfshfs_journal_insert_block(
+     libfshfs_journal_t *journal,
+     uint64_t block_number,
+     off64_t data_offset,
+     uint32_t block_size,
+     uint32_t sequence_number,
+     libcerror_error_t **error );
+
+int libfshfs_journal_get_block_by_number(
+     libfshfs_journal_t *journal,
+     uint64_t block_number,
+     libfshfs_journal_block_t **block,
+     libcerror_error_t **error );
+
+int libfshfs_journal_range_has_overlay(
+     libfshfs_journal_t *journal,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libfshfs_journal_apply_overlay(
+     libfshfs_journal_t *journal,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_JOURNAL_H ) */
+
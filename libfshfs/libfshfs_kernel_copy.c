@@ -0,0 +1,909 @@
+/*
+ * Kernel copy functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* copy_file_range is only declared by glibc if _GNU_SOURCE is defined
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_SENDFILE_H )
+#include <sys/sendfile.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_kernel_copy.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+/* Kernel copy uses copy_file_range if available, otherwise sendfile
+ * Note that only the Linux variant of sendfile, declared in <sys/sendfile.h>, can copy from a file
+ */
+#if defined( HAVE_OPEN ) && defined( HAVE_CLOSE ) && ( defined( HAVE_COPY_FILE_RANGE ) || ( defined( HAVE_SENDFILE ) && defined( HAVE_SYS_SENDFILE_H ) ) )
+#define HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT
+#endif
+
+/* Creates kernel copy
+ * Make sure the value kernel_copy is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_initialize(
+     libfshfs_kernel_copy_t **kernel_copy,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_initialize";
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( *kernel_copy != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid kernel copy value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*kernel_copy = memory_allocate_structure(
+	                libfshfs_kernel_copy_t );
+
+	if( *kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create kernel copy.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *kernel_copy,
+	     0,
+	     sizeof( libfshfs_kernel_copy_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear kernel copy.",
+		 function );
+
+		goto on_error;
+	}
+	( *kernel_copy )->file_descriptor = -1;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *kernel_copy )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *kernel_copy != NULL )
+	{
+		memory_free(
+		 *kernel_copy );
+
+		*kernel_copy = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees kernel copy
+ * The source file is closed if open
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_free(
+     libfshfs_kernel_copy_t **kernel_copy,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_free";
+	int result            = 1;
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( *kernel_copy != NULL )
+	{
+		if( ( *kernel_copy )->file_descriptor != -1 )
+		{
+			if( libfshfs_kernel_copy_close(
+			     *kernel_copy,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close kernel copy.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *kernel_copy )->filename != NULL )
+		{
+			memory_free(
+			 ( *kernel_copy )->filename );
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *kernel_copy )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *kernel_copy );
+
+		*kernel_copy = NULL;
+	}
+	return( result );
+}
+
+/* Opens the source file for copying
+ * Returns 1 if successful, 0 if kernel copy is not supported or -1 on error
+ */
+int libfshfs_kernel_copy_open(
+     libfshfs_kernel_copy_t *kernel_copy,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_open";
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( kernel_copy->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid kernel copy - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT )
+	kernel_copy->file_descriptor = open(
+	                                filename,
+	                                O_RDONLY );
+
+	if( kernel_copy->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to open file: %s for kernel copy.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Sets the source filename
+ * The source file is not opened until libfshfs_kernel_copy_open_source is called
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_set_filename(
+     libfshfs_kernel_copy_t *kernel_copy,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_set_filename";
+	size_t filename_size  = 0;
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( kernel_copy->filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid kernel copy - filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = narrow_string_length(
+	                 filename ) + 1;
+
+	kernel_copy->filename = narrow_string_allocate(
+	                         filename_size );
+
+	if( kernel_copy->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     kernel_copy->filename,
+	     filename,
+	     filename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		memory_free(
+		 kernel_copy->filename );
+
+		kernel_copy->filename = NULL;
+
+		return( -1 );
+	}
+	kernel_copy->filename_size = filename_size;
+
+	return( 1 );
+}
+
+/* Opens the source file on first use
+ * Returns 1 if the source file is open, 0 if kernel copy is not available or -1 on error
+ */
+int libfshfs_kernel_copy_open_source(
+     libfshfs_kernel_copy_t *kernel_copy,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_open_source";
+	int result            = 0;
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     kernel_copy->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( kernel_copy->file_descriptor != -1 )
+	{
+		result = 1;
+	}
+	else if( kernel_copy->filename != NULL )
+	{
+		result = libfshfs_kernel_copy_open(
+		          kernel_copy,
+		          kernel_copy->filename,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open source file.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			/* Kernel copy is not supported, do not try to open the source file again
+			 */
+			memory_free(
+			 kernel_copy->filename );
+
+			kernel_copy->filename      = NULL;
+			kernel_copy->filename_size = 0;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     kernel_copy->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Closes the source file
+ * Returns 0 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_close(
+     libfshfs_kernel_copy_t *kernel_copy,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_close";
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( kernel_copy->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT )
+	if( close(
+	     kernel_copy->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to close file.",
+		 function );
+
+		kernel_copy->file_descriptor = -1;
+
+		return( -1 );
+	}
+#endif
+	kernel_copy->file_descriptor = -1;
+
+	return( 0 );
+}
+
+/* Copies a range of the source file to the current offset of the destination file descriptor
+ * The data is copied by the kernel and does not pass through user space
+ * copy_file_range is tried first, sendfile second
+ * Returns 1 if successful, 0 if the kernel cannot copy to the destination or -1 on error
+ * If 0 is returned copied_size contains the number of bytes copied before the kernel copy became unavailable
+ */
+int libfshfs_kernel_copy_copy_range(
+     libfshfs_kernel_copy_t *kernel_copy,
+     off64_t source_offset,
+     size64_t size,
+     int destination_file_descriptor,
+     size64_t *copied_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_copy_range";
+
+#if defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT )
+	size64_t copy_offset  = 0;
+	size_t copy_size      = 0;
+	ssize_t copy_count    = 0;
+
+#if defined( HAVE_COPY_FILE_RANGE )
+	off64_t input_offset  = 0;
+	int use_sendfile      = 0;
+#endif
+#if defined( HAVE_SENDFILE ) && defined( HAVE_SYS_SENDFILE_H )
+	off_t sendfile_offset = 0;
+#endif
+#endif /* defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT ) */
+
+	if( kernel_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid kernel copy.",
+		 function );
+
+		return( -1 );
+	}
+	if( kernel_copy->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid kernel copy - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( copied_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copied size.",
+		 function );
+
+		return( -1 );
+	}
+	*copied_size = 0;
+
+#if defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT )
+	while( copy_offset < size )
+	{
+		copy_size = LIBFSHFS_KERNEL_COPY_MAXIMUM_COPY_SIZE;
+
+		if( copy_size > ( size - copy_offset ) )
+		{
+			copy_size = (size_t) ( size - copy_offset );
+		}
+#if defined( HAVE_COPY_FILE_RANGE )
+		if( use_sendfile == 0 )
+		{
+			input_offset = source_offset + (off64_t) copy_offset;
+
+			copy_count = copy_file_range(
+			              kernel_copy->file_descriptor,
+			              &input_offset,
+			              destination_file_descriptor,
+			              NULL,
+			              copy_size,
+			              0 );
+
+			if( copy_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				/* The destination, for example a pipe or a file on another file system,
+				 * or the kernel does not support copy_file_range
+				 */
+				if( ( errno == EBADF )
+				 || ( errno == EINVAL )
+				 || ( errno == ENOSYS )
+				 || ( errno == EOPNOTSUPP )
+				 || ( errno == EXDEV ) )
+				{
+#if defined( HAVE_SENDFILE ) && defined( HAVE_SYS_SENDFILE_H )
+					use_sendfile = 1;
+
+					continue;
+#else
+					*copied_size = copy_offset;
+
+					return( 0 );
+#endif
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 (uint32_t) errno,
+				 "%s: unable to copy range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 source_offset + copy_offset,
+				 source_offset + copy_offset );
+
+				*copied_size = copy_offset;
+
+				return( -1 );
+			}
+		}
+		else
+#endif /* defined( HAVE_COPY_FILE_RANGE ) */
+		{
+#if defined( HAVE_SENDFILE ) && defined( HAVE_SYS_SENDFILE_H )
+			sendfile_offset = (off_t) ( source_offset + copy_offset );
+
+			copy_count = sendfile(
+			              destination_file_descriptor,
+			              kernel_copy->file_descriptor,
+			              &sendfile_offset,
+			              copy_size );
+
+			if( copy_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				if( ( errno == EINVAL )
+				 || ( errno == ENOSYS )
+				 || ( errno == EOPNOTSUPP ) )
+				{
+					*copied_size = copy_offset;
+
+					return( 0 );
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 (uint32_t) errno,
+				 "%s: unable to send range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 source_offset + copy_offset,
+				 source_offset + copy_offset );
+
+				*copied_size = copy_offset;
+
+				return( -1 );
+			}
+#endif /* defined( HAVE_SENDFILE ) && defined( HAVE_SYS_SENDFILE_H ) */
+		}
+		if( copy_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of source file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 source_offset + copy_offset,
+			 source_offset + copy_offset );
+
+			*copied_size = copy_offset;
+
+			return( -1 );
+		}
+		copy_offset += (size64_t) copy_count;
+	}
+	*copied_size = copy_offset;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBFSHFS_KERNEL_COPY_SUPPORT ) */
+}
+
+/* Writes a buffer to the current offset of the destination file descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_write_buffer(
+     int destination_file_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_write_buffer";
+
+#if defined( HAVE_WRITE )
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+#endif
+
+	if( destination_file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WRITE )
+	while( buffer_offset < size )
+	{
+		write_count = write(
+		               destination_file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to write buffer.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: writing to a file descriptor not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_WRITE ) */
+}
+
+/* Writes a buffer at a specific offset of the destination file descriptor
+ * The current offset of the destination file descriptor is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_kernel_copy_write_buffer_at_offset(
+     int destination_file_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t destination_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_kernel_copy_write_buffer_at_offset";
+
+#if defined( HAVE_PWRITE )
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+#endif
+
+	if( destination_file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid destination offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_PWRITE )
+	while( buffer_offset < size )
+	{
+		write_count = pwrite(
+		               destination_file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               (off_t) ( destination_offset + (off64_t) buffer_offset ) );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to write buffer at offset: %" PRIi64 ".",
+			 function,
+			 destination_offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: writing at an offset of a file descriptor not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_PWRITE ) */
+}
+
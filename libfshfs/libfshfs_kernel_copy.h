@@ -0,0 +1,110 @@
+/*
+ * Kernel copy functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_KERNEL_COPY_H )
+#define _LIBFSHFS_KERNEL_COPY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_kernel_copy libfshfs_kernel_copy_t;
+
+struct libfshfs_kernel_copy
+{
+	/* The source file descriptor, where -1 represents a file that is not open
+	 */
+	int file_descriptor;
+
+	/* The source filename, the file is opened on first use
+	 */
+	char *filename;
+
+	/* The source filename size
+	 */
+	size_t filename_size;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libfshfs_kernel_copy_initialize(
+     libfshfs_kernel_copy_t **kernel_copy,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_free(
+     libfshfs_kernel_copy_t **kernel_copy,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_open(
+     libfshfs_kernel_copy_t *kernel_copy,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_set_filename(
+     libfshfs_kernel_copy_t *kernel_copy,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_open_source(
+     libfshfs_kernel_copy_t *kernel_copy,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_close(
+     libfshfs_kernel_copy_t *kernel_copy,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_copy_range(
+     libfshfs_kernel_copy_t *kernel_copy,
+     off64_t source_offset,
+     size64_t size,
+     int destination_file_descriptor,
+     size64_t *copied_size,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_write_buffer(
+     int destination_file_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libfshfs_kernel_copy_write_buffer_at_offset(
+     int destination_file_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t destination_offset,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_KERNEL_COPY_H ) */
+
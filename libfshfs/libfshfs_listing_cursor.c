@@ -0,0 +1,497 @@
+/*
+ * Listing cursor functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_definitions.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcnotify.h"
+#include "libfshfs_listing_cursor.h"
+#include "libfshfs_types.h"
+
+#include "fshfs_listing_cursor.h"
+
+#define LIBFSHFS_LISTING_CURSOR_FORMAT_VERSION	1
+
+const uint8_t fshfs_listing_cursor_signature[ 8 ] = { 'f', 's', 'h', 'f', 's', 'l', 'c', 'r' };
+
+/* Creates a listing cursor
+ * Make sure the value listing_cursor is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_listing_cursor_initialize(
+     libfshfs_listing_cursor_t **listing_cursor,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_listing_cursor_t *internal_listing_cursor = NULL;
+	static char *function                                       = "libfshfs_listing_cursor_initialize";
+
+	if( listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *listing_cursor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid listing cursor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_listing_cursor = memory_allocate_structure(
+	                           libfshfs_internal_listing_cursor_t );
+
+	if( internal_listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create listing cursor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_listing_cursor,
+	     0,
+	     sizeof( libfshfs_internal_listing_cursor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear listing cursor.",
+		 function );
+
+		goto on_error;
+	}
+	*listing_cursor = (libfshfs_listing_cursor_t *) internal_listing_cursor;
+
+	return( 1 );
+
+on_error:
+	if( internal_listing_cursor != NULL )
+	{
+		memory_free(
+		 internal_listing_cursor );
+	}
+	return( -1 );
+}
+
+/* Frees a listing cursor
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_listing_cursor_free(
+     libfshfs_listing_cursor_t **listing_cursor,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_listing_cursor_free";
+
+	if( listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *listing_cursor != NULL )
+	{
+		memory_free(
+		 *listing_cursor );
+
+		*listing_cursor = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the position of the last listed record
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_listing_cursor_set_position(
+     libfshfs_internal_listing_cursor_t *internal_listing_cursor,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     const uint8_t *name,
+     uint16_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_internal_listing_cursor_set_position";
+
+	if( internal_listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > LIBFSHFS_LISTING_CURSOR_MAXIMUM_NAME_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid name size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > 0 )
+	{
+		if( memory_copy(
+		     internal_listing_cursor->name,
+		     name,
+		     (size_t) name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_listing_cursor->parent_identifier = parent_identifier;
+	internal_listing_cursor->node_number       = node_number;
+	internal_listing_cursor->record_index      = record_index;
+	internal_listing_cursor->name_size         = name_size;
+
+	return( 1 );
+}
+
+/* Copies the listing cursor from a byte stream
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_listing_cursor_copy_from_byte_stream(
+     libfshfs_listing_cursor_t *listing_cursor,
+     const uint8_t *byte_stream,
+     size_t byte_stream_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_listing_cursor_t *internal_listing_cursor = NULL;
+	static char *function                                       = "libfshfs_listing_cursor_copy_from_byte_stream";
+	uint32_t format_version                                     = 0;
+	uint32_t node_number                                        = 0;
+	uint32_t parent_identifier                                  = 0;
+	uint16_t name_size                                          = 0;
+	uint16_t record_index                                       = 0;
+
+	if( listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	internal_listing_cursor = (libfshfs_internal_listing_cursor_t *) listing_cursor;
+
+	if( byte_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( byte_stream_size < sizeof( fshfs_listing_cursor_t ) )
+	 || ( byte_stream_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid byte stream size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: listing cursor data:\n",
+		 function );
+		libcnotify_print_data(
+		 byte_stream,
+		 sizeof( fshfs_listing_cursor_t ),
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     ( (fshfs_listing_cursor_t *) byte_stream )->signature,
+	     fshfs_listing_cursor_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->format_version,
+	 format_version );
+
+	if( format_version != LIBFSHFS_LISTING_CURSOR_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->parent_identifier,
+	 parent_identifier );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->node_number,
+	 node_number );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->record_index,
+	 record_index );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->name_size,
+	 name_size );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: parent identifier\t\t: %" PRIu32 "\n",
+		 function,
+		 parent_identifier );
+
+		libcnotify_printf(
+		 "%s: node number\t\t\t: %" PRIu32 "\n",
+		 function,
+		 node_number );
+
+		libcnotify_printf(
+		 "%s: record index\t\t\t: %" PRIu16 "\n",
+		 function,
+		 record_index );
+
+		libcnotify_printf(
+		 "%s: name size\t\t\t: %" PRIu16 "\n",
+		 function,
+		 name_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( libfshfs_internal_listing_cursor_set_position(
+	     internal_listing_cursor,
+	     parent_identifier,
+	     node_number,
+	     record_index,
+	     ( (fshfs_listing_cursor_t *) byte_stream )->name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set position.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Copies the listing cursor to a byte stream
+ * The byte stream size must be at least LIBFSHFS_LISTING_CURSOR_DATA_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_listing_cursor_copy_to_byte_stream(
+     libfshfs_listing_cursor_t *listing_cursor,
+     uint8_t *byte_stream,
+     size_t byte_stream_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_listing_cursor_t *internal_listing_cursor = NULL;
+	static char *function                                       = "libfshfs_listing_cursor_copy_to_byte_stream";
+
+	if( listing_cursor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid listing cursor.",
+		 function );
+
+		return( -1 );
+	}
+	internal_listing_cursor = (libfshfs_internal_listing_cursor_t *) listing_cursor;
+
+	if( byte_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( byte_stream_size < sizeof( fshfs_listing_cursor_t ) )
+	 || ( byte_stream_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid byte stream size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     byte_stream,
+	     0,
+	     sizeof( fshfs_listing_cursor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (fshfs_listing_cursor_t *) byte_stream )->signature,
+	     fshfs_listing_cursor_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->format_version,
+	 LIBFSHFS_LISTING_CURSOR_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->parent_identifier,
+	 internal_listing_cursor->parent_identifier );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->node_number,
+	 internal_listing_cursor->node_number );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->record_index,
+	 internal_listing_cursor->record_index );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 ( (fshfs_listing_cursor_t *) byte_stream )->name_size,
+	 internal_listing_cursor->name_size );
+
+	if( internal_listing_cursor->name_size > 0 )
+	{
+		if( memory_copy(
+		     ( (fshfs_listing_cursor_t *) byte_stream )->name,
+		     internal_listing_cursor->name,
+		     (size_t) internal_listing_cursor->name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,104 @@
+/*
+ * Listing cursor functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_LISTING_CURSOR_H )
+#define _LIBFSHFS_LISTING_CURSOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_extern.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of the name of a catalog B-tree key
+ */
+#define LIBFSHFS_LISTING_CURSOR_MAXIMUM_NAME_SIZE	512
+
+typedef struct libfshfs_internal_listing_cursor libfshfs_internal_listing_cursor_t;
+
+struct libfshfs_internal_listing_cursor
+{
+	/* The parent identifier (CNID) of the listed directory
+	 */
+	uint32_t parent_identifier;
+
+	/* The catalog B-tree leaf node number of the last listed record
+	 * Contains 0 if no records have been listed
+	 */
+	uint32_t node_number;
+
+	/* The record index of the last listed record in the catalog B-tree leaf node
+	 */
+	uint16_t record_index;
+
+	/* The name size of the key of the last listed record
+	 */
+	uint16_t name_size;
+
+	/* The name of the key of the last listed record
+	 */
+	uint8_t name[ LIBFSHFS_LISTING_CURSOR_MAXIMUM_NAME_SIZE ];
+};
+
+LIBFSHFS_EXTERN \
+int libfshfs_listing_cursor_initialize(
+     libfshfs_listing_cursor_t **listing_cursor,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_listing_cursor_free(
+     libfshfs_listing_cursor_t **listing_cursor,
+     libcerror_error_t **error );
+
+int libfshfs_internal_listing_cursor_set_position(
+     libfshfs_internal_listing_cursor_t *internal_listing_cursor,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     const uint8_t *name,
+     uint16_t name_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_listing_cursor_copy_from_byte_stream(
+     libfshfs_listing_cursor_t *listing_cursor,
+     const uint8_t *byte_stream,
+     size_t byte_stream_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_listing_cursor_copy_to_byte_stream(
+     libfshfs_listing_cursor_t *listing_cursor,
+     uint8_t *byte_stream,
+     size_t byte_stream_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_LISTING_CURSOR_H ) */
+
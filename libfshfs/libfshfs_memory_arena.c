@@ -0,0 +1,326 @@
+/*
+ * Memory arena functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_atomic.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_memory_arena.h"
+
+/* The alignment of the memory allocated from the arena
+ */
+#define LIBFSHFS_MEMORY_ARENA_ALIGNMENT		8
+
+/* Creates a memory arena
+ * Make sure the value memory_arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_memory_arena_initialize(
+     libfshfs_memory_arena_t **memory_arena,
+     size_t block_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_memory_arena_initialize";
+
+	if( memory_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid memory arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_data_size == 0 )
+	 || ( block_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*memory_arena = memory_allocate_structure(
+	                 libfshfs_memory_arena_t );
+
+	if( *memory_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create memory arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *memory_arena,
+	     0,
+	     sizeof( libfshfs_memory_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear memory arena.",
+		 function );
+
+		goto on_error;
+	}
+	( *memory_arena )->block_data_size = block_data_size;
+	( *memory_arena )->reference_count = 1;
+
+	return( 1 );
+
+on_error:
+	if( *memory_arena != NULL )
+	{
+		memory_free(
+		 *memory_arena );
+
+		*memory_arena = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a memory arena
+ * This releases a reference and frees all the memory allocated from the arena
+ * when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_memory_arena_free(
+     libfshfs_memory_arena_t **memory_arena,
+     libcerror_error_t **error )
+{
+	libfshfs_memory_arena_block_t *block       = NULL;
+	libfshfs_memory_arena_t *safe_memory_arena = NULL;
+	static char *function                      = "libfshfs_memory_arena_free";
+
+	if( memory_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *memory_arena != NULL )
+	{
+		safe_memory_arena = *memory_arena;
+		*memory_arena     = NULL;
+
+		if( libfshfs_atomic_decrement_uint32(
+		     &( safe_memory_arena->reference_count ) ) == 0 )
+		{
+			while( safe_memory_arena->block != NULL )
+			{
+				block                    = safe_memory_arena->block;
+				safe_memory_arena->block = block->previous_block;
+
+				memory_free(
+				 block );
+			}
+			memory_free(
+			 safe_memory_arena );
+		}
+	}
+	return( 1 );
+}
+
+/* Adds a reference to a memory arena
+ * Every reference must be released with libfshfs_memory_arena_free
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_memory_arena_reference(
+     libfshfs_memory_arena_t *memory_arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_memory_arena_reference";
+
+	if( memory_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory arena.",
+		 function );
+
+		return( -1 );
+	}
+	libfshfs_atomic_increment_uint32(
+	 &( memory_arena->reference_count ) );
+
+	return( 1 );
+}
+
+/* Allocates memory from the memory arena
+ * The memory is aligned and cleared, and cannot be freed individually
+ * This function is not thread-safe
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_memory_arena_allocate(
+     libfshfs_memory_arena_t *memory_arena,
+     size_t size,
+     void **memory,
+     libcerror_error_t **error )
+{
+	libfshfs_memory_arena_block_t *block = NULL;
+	uint8_t *block_data                  = NULL;
+	static char *function                = "libfshfs_memory_arena_allocate";
+	size_t alignment_padding_size        = 0;
+	size_t data_size                     = 0;
+
+	if( memory_arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > ( (size_t) SSIZE_MAX - LIBFSHFS_MEMORY_ARENA_ALIGNMENT ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory.",
+		 function );
+
+		return( -1 );
+	}
+	block = memory_arena->block;
+
+	if( block != NULL )
+	{
+		block_data = &( ( (uint8_t *) &( block[ 1 ] ) )[ block->used_data_size ] );
+
+		alignment_padding_size = (size_t) ( (intptr_t) block_data % LIBFSHFS_MEMORY_ARENA_ALIGNMENT );
+
+		if( alignment_padding_size != 0 )
+		{
+			alignment_padding_size = LIBFSHFS_MEMORY_ARENA_ALIGNMENT - alignment_padding_size;
+		}
+		if( ( alignment_padding_size + size ) > ( block->data_size - block->used_data_size ) )
+		{
+			block = NULL;
+		}
+	}
+	if( block == NULL )
+	{
+		/* The additional alignment size allows for a block that is not aligned
+		 */
+		data_size = memory_arena->block_data_size;
+
+		if( ( size + LIBFSHFS_MEMORY_ARENA_ALIGNMENT ) > data_size )
+		{
+			data_size = size + LIBFSHFS_MEMORY_ARENA_ALIGNMENT;
+		}
+		block = (libfshfs_memory_arena_block_t *) memory_allocate(
+		                                           sizeof( libfshfs_memory_arena_block_t ) + data_size );
+
+		if( block == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		block->previous_block = memory_arena->block;
+		block->data_size      = data_size;
+		block->used_data_size = 0;
+
+		memory_arena->block = block;
+
+		block_data = (uint8_t *) &( block[ 1 ] );
+
+		alignment_padding_size = (size_t) ( (intptr_t) block_data % LIBFSHFS_MEMORY_ARENA_ALIGNMENT );
+
+		if( alignment_padding_size != 0 )
+		{
+			alignment_padding_size = LIBFSHFS_MEMORY_ARENA_ALIGNMENT - alignment_padding_size;
+		}
+	}
+	block_data = &( ( (uint8_t *) &( block[ 1 ] ) )[ block->used_data_size + alignment_padding_size ] );
+
+	if( memory_set(
+	     block_data,
+	     0,
+	     size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear memory.",
+		 function );
+
+		return( -1 );
+	}
+	block->used_data_size += alignment_padding_size + size;
+
+	*memory = (void *) block_data;
+
+	return( 1 );
+}
+
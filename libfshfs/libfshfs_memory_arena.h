@@ -0,0 +1,95 @@
+/*
+ * Memory arena functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_MEMORY_ARENA_H )
+#define _LIBFSHFS_MEMORY_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_memory_arena_block libfshfs_memory_arena_block_t;
+
+struct libfshfs_memory_arena_block
+{
+	/* The previous block
+	 */
+	libfshfs_memory_arena_block_t *previous_block;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The used data size
+	 */
+	size_t used_data_size;
+
+	/* The data, which directly follows the block
+	 */
+};
+
+typedef struct libfshfs_memory_arena libfshfs_memory_arena_t;
+
+struct libfshfs_memory_arena
+{
+	/* The most recent block
+	 */
+	libfshfs_memory_arena_block_t *block;
+
+	/* The size of the data of a block
+	 */
+	size_t block_data_size;
+
+	/* The reference count
+	 */
+	uint32_t reference_count;
+};
+
+int libfshfs_memory_arena_initialize(
+     libfshfs_memory_arena_t **memory_arena,
+     size_t block_data_size,
+     libcerror_error_t **error );
+
+int libfshfs_memory_arena_free(
+     libfshfs_memory_arena_t **memory_arena,
+     libcerror_error_t **error );
+
+int libfshfs_memory_arena_reference(
+     libfshfs_memory_arena_t *memory_arena,
+     libcerror_error_t **error );
+
+int libfshfs_memory_arena_allocate(
+     libfshfs_memory_arena_t *memory_arena,
+     size_t size,
+     void **memory,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_MEMORY_ARENA_H ) */
+
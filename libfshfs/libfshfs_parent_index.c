@@ -0,0 +1,600 @@
+/*
+ * Parent index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_btree_node.h"
+#include "libfshfs_definitions.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_volume_header.h"
+
+#include "fshfs_catalog_file.h"
+
+/* Creates a parent index
+ * Make sure the value parent_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_parent_index_initialize(
+     libfshfs_parent_index_t **parent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_parent_index_initialize";
+
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parent_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parent index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*parent_index = memory_allocate_structure(
+	               libfshfs_parent_index_t );
+
+	if( *parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parent_index,
+	     0,
+	     sizeof( libfshfs_parent_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parent index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *parent_index != NULL )
+	{
+		memory_free(
+		 *parent_index );
+
+		*parent_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parent index
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_parent_index_free(
+     libfshfs_parent_index_t **parent_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_parent_index_free";
+
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parent_index != NULL )
+	{
+		if( ( *parent_index )->entries != NULL )
+		{
+			memory_free(
+			 ( *parent_index )->entries );
+		}
+		memory_free(
+		 *parent_index );
+
+		*parent_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a catalog B-tree leaf record to the parent index
+ * The records must be appended in key order, which is the order of the leaf nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_parent_index_append_record(
+     libfshfs_parent_index_t *parent_index,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint8_t is_child,
+     libcerror_error_t **error )
+{
+	libfshfs_parent_index_entry_t *entries = NULL;
+	libfshfs_parent_index_entry_t *entry   = NULL;
+	static char *function                  = "libfshfs_parent_index_append_record";
+	size_t entries_size                    = 0;
+	uint32_t maximum_number_of_entries     = 0;
+
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_index->number_of_entries > 0 )
+	{
+		entry = &( parent_index->entries[ parent_index->number_of_entries - 1 ] );
+
+		if( parent_identifier < entry->parent_identifier )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported parent identifier: %" PRIu32 " not stored in key order.",
+			 function,
+			 parent_identifier );
+
+			return( -1 );
+		}
+		if( parent_identifier == entry->parent_identifier )
+		{
+			entry->number_of_records += 1;
+
+			if( is_child != 0 )
+			{
+				entry->number_of_children += 1;
+			}
+			return( 1 );
+		}
+	}
+	if( parent_index->number_of_entries >= parent_index->maximum_number_of_entries )
+	{
+		if( parent_index->maximum_number_of_entries == 0 )
+		{
+			maximum_number_of_entries = 256;
+		}
+		else if( parent_index->maximum_number_of_entries < 0x80000000UL )
+		{
+			maximum_number_of_entries = parent_index->maximum_number_of_entries * 2;
+		}
+		else
+		{
+			maximum_number_of_entries = 0;
+		}
+		if( ( maximum_number_of_entries == 0 )
+		 || ( (size_t) maximum_number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libfshfs_parent_index_entry_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		entries_size = sizeof( libfshfs_parent_index_entry_t ) * maximum_number_of_entries;
+
+		entries = (libfshfs_parent_index_entry_t *) memory_reallocate(
+		                                             parent_index->entries,
+		                                             entries_size );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			return( -1 );
+		}
+		parent_index->entries                   = entries;
+		parent_index->maximum_number_of_entries = maximum_number_of_entries;
+	}
+	entry = &( parent_index->entries[ parent_index->number_of_entries ] );
+
+	entry->parent_identifier  = parent_identifier;
+	entry->node_number        = node_number;
+	entry->record_index       = record_index;
+	entry->number_of_records  = 1;
+	entry->number_of_children = ( is_child != 0 ) ? 1 : 0;
+
+	parent_index->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Reads the parent index from the catalog B-tree file
+ * The entries are read in a single pass over the B-tree leaf nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_parent_index_read_btree_file(
+     libfshfs_parent_index_t *parent_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_btree_node_t *node      = NULL;
+	const uint8_t *record_data       = NULL;
+	static char *function            = "libfshfs_parent_index_read_btree_file";
+	size_t record_data_offset        = 0;
+	size_t record_data_size          = 0;
+	uint64_t maximum_number_of_nodes = 0;
+	uint64_t number_of_nodes         = 0;
+	uint32_t node_number             = 0;
+	uint32_t parent_identifier       = 0;
+	uint16_t key_data_size           = 0;
+	uint16_t number_of_records       = 0;
+	uint16_t record_index            = 0;
+	uint16_t record_type             = 0;
+	uint8_t is_child                 = 0;
+
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_index->number_of_entries != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parent index - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_header->catalog_file_fork_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume header - missing catalog file fork descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid B-tree file - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( btree_file->header->node_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid B-tree file - node size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_nodes = volume_header->catalog_file_fork_descriptor->size / btree_file->header->node_size;
+
+	node_number = btree_file->header->first_leaf_node_number;
+
+	while( node_number != 0 )
+	{
+		if( ( (uint64_t) node_number >= maximum_number_of_nodes )
+		 || ( number_of_nodes >= maximum_number_of_nodes ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid B-tree leaf node number: %" PRIu32 " value out of bounds.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_get_node_by_number(
+		     btree_file,
+		     file_io_handle,
+		     (int) node_number,
+		     &node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve B-tree leaf node: %" PRIu32 ".",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( ( node == NULL )
+		 || ( node->descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid B-tree leaf node: %" PRIu32 " - missing descriptor.",
+			 function,
+			 node_number );
+
+			goto on_error;
+		}
+		if( node->descriptor->type != LIBFSHFS_BTREE_NODE_TYPE_LEAF_NODE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported B-tree node: %" PRIu32 " type: 0x%02" PRIx8 ".",
+			 function,
+			 node_number,
+			 node->descriptor->type );
+
+			goto on_error;
+		}
+		number_of_records = node->descriptor->number_of_records;
+
+		for( record_index = 0;
+		     record_index < number_of_records;
+		     record_index++ )
+		{
+			if( libfshfs_btree_node_get_record_data_by_index(
+			     node,
+			     record_index,
+			     &record_data,
+			     &record_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node: %" PRIu32 " record: %" PRIu16 " data.",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+			/* Only the size and parent identifier of the key are needed, hence the key is not read
+			 */
+			if( record_data_size < sizeof( fshfs_catalog_index_key_hfsplus_t ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 ( (fshfs_catalog_index_key_hfsplus_t *) record_data )->data_size,
+			 key_data_size );
+
+			byte_stream_copy_to_uint32_big_endian(
+			 ( (fshfs_catalog_index_key_hfsplus_t *) record_data )->parent_identifier,
+			 parent_identifier );
+
+			record_data_offset = (size_t) key_data_size + 2;
+
+			if( record_data_offset > ( record_data_size - 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid record data offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint16_big_endian(
+			 &( record_data[ record_data_offset ] ),
+			 record_type );
+
+			switch( record_type )
+			{
+				case 0x0001:
+				case 0x0002:
+				case 0x0100:
+				case 0x0200:
+					is_child = 1;
+					break;
+
+				default:
+					is_child = 0;
+					break;
+			}
+			if( libfshfs_parent_index_append_record(
+			     parent_index,
+			     parent_identifier,
+			     node_number,
+			     record_index,
+			     is_child,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append node: %" PRIu32 " record: %" PRIu16 " to parent index.",
+				 function,
+				 node_number,
+				 record_index );
+
+				goto on_error;
+			}
+		}
+		node_number = node->descriptor->next_node_number;
+
+		number_of_nodes++;
+	}
+	return( 1 );
+
+on_error:
+	if( parent_index->entries != NULL )
+	{
+		memory_free(
+		 parent_index->entries );
+
+		parent_index->entries = NULL;
+	}
+	parent_index->number_of_entries         = 0;
+	parent_index->maximum_number_of_entries = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the entry of a specific parent identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_parent_index_get_entry_by_parent_identifier(
+     libfshfs_parent_index_t *parent_index,
+     uint32_t parent_identifier,
+     libfshfs_parent_index_entry_t **entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_parent_index_get_entry_by_parent_identifier";
+	uint32_t entry_index  = 0;
+	uint32_t maximum      = 0;
+	uint32_t minimum      = 0;
+
+	if( parent_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	maximum = parent_index->number_of_entries;
+
+	while( minimum < maximum )
+	{
+		entry_index = minimum + ( ( maximum - minimum ) / 2 );
+
+		if( parent_index->entries[ entry_index ].parent_identifier == parent_identifier )
+		{
+			*entry = &( parent_index->entries[ entry_index ] );
+
+			return( 1 );
+		}
+		if( parent_index->entries[ entry_index ].parent_identifier < parent_identifier )
+		{
+			minimum = entry_index + 1;
+		}
+		else
+		{
+			maximum = entry_index;
+		}
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,113 @@
+/*
+ * Parent index functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_PARENT_INDEX_H )
+#define _LIBFSHFS_PARENT_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_btree_file.h"
+#include "libfshfs_libbfio.h"
+#include "libfshfs_libcerror.h"
+#include "libfshfs_volume_header.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_parent_index_entry libfshfs_parent_index_entry_t;
+
+struct libfshfs_parent_index_entry
+{
+	/* The parent identifier (CNID)
+	 */
+	uint32_t parent_identifier;
+
+	/* The catalog B-tree leaf node number of the first record with the parent identifier
+	 */
+	uint32_t node_number;
+
+	/* The number of records with the parent identifier
+	 */
+	uint32_t number_of_records;
+
+	/* The number of children, which are the directory and file records with the parent identifier
+	 */
+	uint32_t number_of_children;
+
+	/* The record index of the first record with the parent identifier
+	 */
+	uint16_t record_index;
+};
+
+typedef struct libfshfs_parent_index libfshfs_parent_index_t;
+
+struct libfshfs_parent_index
+{
+	/* The entries, which are sorted by parent identifier
+	 */
+	libfshfs_parent_index_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	uint32_t maximum_number_of_entries;
+};
+
+int libfshfs_parent_index_initialize(
+     libfshfs_parent_index_t **parent_index,
+     libcerror_error_t **error );
+
+int libfshfs_parent_index_free(
+     libfshfs_parent_index_t **parent_index,
+     libcerror_error_t **error );
+
+int libfshfs_parent_index_append_record(
+     libfshfs_parent_index_t *parent_index,
+     uint32_t parent_identifier,
+     uint32_t node_number,
+     uint16_t record_index,
+     uint8_t is_child,
+     libcerror_error_t **error );
+
+int libfshfs_parent_index_read_btree_file(
+     libfshfs_parent_index_t *parent_index,
+     libfshfs_volume_header_t *volume_header,
+     libfshfs_btree_file_t *btree_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_parent_index_get_entry_by_parent_identifier(
+     libfshfs_parent_index_t *parent_index,
+     uint32_t parent_identifier,
+     libfshfs_parent_index_entry_t **entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_PARENT_INDEX_H ) */
+
@@ -0,0 +1,692 @@
+/*
+ * Path cache functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+#include "libfshfs_path_cache.h"
+
+/* The minimum size of the data of a names block
+ */
+#define LIBFSHFS_PATH_CACHE_NAMES_BLOCK_SIZE	65536
+
+/* The hash of an identifier, based on Fibonacci hashing
+ */
+#define libfshfs_path_cache_get_hash( identifier ) \
+	( ( (uint32_t) ( identifier ) * 0x9e3779b1UL ) ^ ( ( (uint32_t) ( identifier ) * 0x9e3779b1UL ) >> 16 ) )
+
+/* Creates a path cache
+ * Make sure the value path_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_path_cache_initialize(
+     libfshfs_path_cache_t **path_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_path_cache_initialize";
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*path_cache = memory_allocate_structure(
+	               libfshfs_path_cache_t );
+
+	if( *path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *path_cache,
+	     0,
+	     sizeof( libfshfs_path_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *path_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *path_cache != NULL )
+	{
+		memory_free(
+		 *path_cache );
+
+		*path_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a path cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_path_cache_free(
+     libfshfs_path_cache_t **path_cache,
+     libcerror_error_t **error )
+{
+	libfshfs_path_cache_names_block_t *names_block = NULL;
+	static char *function                          = "libfshfs_path_cache_free";
+	int result                                     = 1;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_cache != NULL )
+	{
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *path_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		while( ( *path_cache )->names_block != NULL )
+		{
+			names_block                  = ( *path_cache )->names_block;
+			( *path_cache )->names_block = names_block->previous_block;
+
+			memory_free(
+			 names_block );
+		}
+		if( ( *path_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *path_cache )->entries );
+		}
+		memory_free(
+		 *path_cache );
+
+		*path_cache = NULL;
+	}
+	return( result );
+}
+
+/* Resizes the path cache hash table
+ * The maximum number of entries must be a power of 2
+ * This function does not grab the read/write lock
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_path_cache_resize(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	libfshfs_path_cache_entry_t *entries = NULL;
+	static char *function                = "libfshfs_path_cache_resize";
+	size_t entries_size                  = 0;
+	uint32_t entry_index                 = 0;
+	uint32_t hash_index                  = 0;
+	uint32_t hash_mask                   = 0;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries == 0 )
+	 || ( ( maximum_number_of_entries & ( maximum_number_of_entries - 1 ) ) != 0 )
+	 || ( maximum_number_of_entries < path_cache->number_of_entries )
+	 || ( (size_t) maximum_number_of_entries > ( (size_t) SSIZE_MAX / sizeof( libfshfs_path_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries_size = sizeof( libfshfs_path_cache_entry_t ) * maximum_number_of_entries;
+
+	entries = (libfshfs_path_cache_entry_t *) memory_allocate(
+	                                           entries_size );
+
+	if( entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 entries );
+
+		return( -1 );
+	}
+	hash_mask = maximum_number_of_entries - 1;
+
+	for( entry_index = 0;
+	     entry_index < path_cache->maximum_number_of_entries;
+	     entry_index++ )
+	{
+		if( path_cache->entries[ entry_index ].identifier == 0 )
+		{
+			continue;
+		}
+		hash_index = libfshfs_path_cache_get_hash(
+		              path_cache->entries[ entry_index ].identifier ) & hash_mask;
+
+		while( entries[ hash_index ].identifier != 0 )
+		{
+			hash_index = ( hash_index + 1 ) & hash_mask;
+		}
+		entries[ hash_index ] = path_cache->entries[ entry_index ];
+	}
+	if( path_cache->entries != NULL )
+	{
+		memory_free(
+		 path_cache->entries );
+	}
+	path_cache->entries                   = entries;
+	path_cache->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Appends a name to the names blocks
+ * Names blocks are never reallocated hence the cached name remains valid until the path cache is freed
+ * This function does not grab the read/write lock
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_path_cache_append_name(
+     libfshfs_path_cache_t *path_cache,
+     const uint8_t *name,
+     uint16_t name_size,
+     const uint8_t **cached_name,
+     libcerror_error_t **error )
+{
+	libfshfs_path_cache_names_block_t *names_block = NULL;
+	uint8_t *names_data                            = NULL;
+	static char *function                          = "libfshfs_path_cache_append_name";
+	size_t data_size                               = 0;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( cached_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cached name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == 0 )
+	{
+		*cached_name = NULL;
+
+		return( 1 );
+	}
+	names_block = path_cache->names_block;
+
+	if( ( names_block == NULL )
+	 || ( (size_t) name_size > ( names_block->data_size - names_block->used_data_size ) ) )
+	{
+		data_size = LIBFSHFS_PATH_CACHE_NAMES_BLOCK_SIZE;
+
+		if( (size_t) name_size > data_size )
+		{
+			data_size = (size_t) name_size;
+		}
+		names_block = (libfshfs_path_cache_names_block_t *) memory_allocate(
+		                                                     sizeof( libfshfs_path_cache_names_block_t ) + data_size );
+
+		if( names_block == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create names block.",
+			 function );
+
+			return( -1 );
+		}
+		names_block->previous_block = path_cache->names_block;
+		names_block->data_size      = data_size;
+		names_block->used_data_size = 0;
+
+		path_cache->names_block = names_block;
+	}
+	names_data = &( ( (uint8_t *) &( names_block[ 1 ] ) )[ names_block->used_data_size ] );
+
+	if( memory_copy(
+	     names_data,
+	     name,
+	     (size_t) name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	names_block->used_data_size += name_size;
+
+	*cached_name = names_data;
+
+	return( 1 );
+}
+
+/* Inserts an entry into the path cache
+ * The hash table is resized when it is more than 3/4 full
+ * Returns 1 if successful, 0 if the entry was already cached or -1 on error
+ */
+int libfshfs_path_cache_insert_entry(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t identifier,
+     uint32_t parent_identifier,
+     const uint8_t *name,
+     uint16_t name_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *cached_name         = NULL;
+	static char *function              = "libfshfs_path_cache_insert_entry";
+	uint32_t hash_index                = 0;
+	uint32_t hash_mask                 = 0;
+	uint32_t maximum_number_of_entries = 0;
+	int result                         = 1;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     path_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( (uint64_t) path_cache->number_of_entries + 1 ) * 4 > ( (uint64_t) path_cache->maximum_number_of_entries * 3 ) )
+	{
+		if( path_cache->maximum_number_of_entries == 0 )
+		{
+			maximum_number_of_entries = 1024;
+		}
+		else if( path_cache->maximum_number_of_entries < 0x80000000UL )
+		{
+			maximum_number_of_entries = path_cache->maximum_number_of_entries * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of entries value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_path_cache_resize(
+		     path_cache,
+		     maximum_number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize path cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	hash_mask  = path_cache->maximum_number_of_entries - 1;
+	hash_index = libfshfs_path_cache_get_hash(
+	              identifier ) & hash_mask;
+
+	while( path_cache->entries[ hash_index ].identifier != 0 )
+	{
+		if( path_cache->entries[ hash_index ].identifier == identifier )
+		{
+			result = 0;
+
+			break;
+		}
+		hash_index = ( hash_index + 1 ) & hash_mask;
+	}
+	if( result != 0 )
+	{
+		if( libfshfs_path_cache_append_name(
+		     path_cache,
+		     name,
+		     name_size,
+		     &cached_name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append name.",
+			 function );
+
+			goto on_error;
+		}
+		path_cache->entries[ hash_index ].identifier        = identifier;
+		path_cache->entries[ hash_index ].parent_identifier = parent_identifier;
+		path_cache->entries[ hash_index ].name              = cached_name;
+		path_cache->entries[ hash_index ].name_size         = name_size;
+
+		path_cache->number_of_entries += 1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     path_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 path_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the parent identifier and name of a specific identifier
+ * The name is stored as an UTF-16 big-endian stream and remains valid until the path cache is freed
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libfshfs_path_cache_get_entry_by_identifier(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     const uint8_t **name,
+     uint16_t *name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_path_cache_get_entry_by_identifier";
+	uint32_t hash_index   = 0;
+	uint32_t hash_mask    = 0;
+	int result            = 0;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     path_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( path_cache->entries != NULL )
+	{
+		hash_mask  = path_cache->maximum_number_of_entries - 1;
+		hash_index = libfshfs_path_cache_get_hash(
+		              identifier ) & hash_mask;
+
+		/* The hash table is never full, hence an unused entry terminates the probe
+		 */
+		while( path_cache->entries[ hash_index ].identifier != 0 )
+		{
+			if( path_cache->entries[ hash_index ].identifier == identifier )
+			{
+				*parent_identifier = path_cache->entries[ hash_index ].parent_identifier;
+				*name              = path_cache->entries[ hash_index ].name;
+				*name_size         = path_cache->entries[ hash_index ].name_size;
+
+				result = 1;
+
+				break;
+			}
+			hash_index = ( hash_index + 1 ) & hash_mask;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     path_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,144 @@
+/*
+ * Path cache functions
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBFSHFS_PATH_CACHE_H )
+#define _LIBFSHFS_PATH_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libfshfs_libcerror.h"
+#include "libfshfs_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libfshfs_path_cache_entry libfshfs_path_cache_entry_t;
+
+struct libfshfs_path_cache_entry
+{
+	/* The identifier (CNID), where 0 represents an unused entry
+	 */
+	uint32_t identifier;
+
+	/* The parent identifier (CNID)
+	 */
+	uint32_t parent_identifier;
+
+	/* The name, which is stored in the names blocks
+	 */
+	const uint8_t *name;
+
+	/* The name size
+	 */
+	uint16_t name_size;
+};
+
+typedef struct libfshfs_path_cache_names_block libfshfs_path_cache_names_block_t;
+
+struct libfshfs_path_cache_names_block
+{
+	/* The previous names block
+	 */
+	libfshfs_path_cache_names_block_t *previous_block;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The used data size
+	 */
+	size_t used_data_size;
+
+	/* The data, which directly follows the names block
+	 */
+};
+
+typedef struct libfshfs_path_cache libfshfs_path_cache_t;
+
+struct libfshfs_path_cache
+{
+	/* The entries, which are stored in an open-addressed hash table
+	 */
+	libfshfs_path_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	uint32_t number_of_entries;
+
+	/* The maximum number of entries, which is a power of 2
+	 */
+	uint32_t maximum_number_of_entries;
+
+	/* The most recent names block
+	 */
+	libfshfs_path_cache_names_block_t *names_block;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libfshfs_path_cache_initialize(
+     libfshfs_path_cache_t **path_cache,
+     libcerror_error_t **error );
+
+int libfshfs_path_cache_free(
+     libfshfs_path_cache_t **path_cache,
+     libcerror_error_t **error );
+
+int libfshfs_path_cache_resize(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libfshfs_path_cache_append_name(
+     libfshfs_path_cache_t *path_cache,
+     const uint8_t *name,
+     uint16_t name_size,
+     const uint8_t **cached_name,
+     libcerror_error_t **error );
+
+int libfshfs_path_cache_insert_entry(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t identifier,
+     uint32_t parent_identifier,
+     const uint8_t *name,
+     uint16_t name_size,
+     libcerror_error_t **error );
+
+int libfshfs_path_cache_get_entry_by_identifier(
+     libfshfs_path_cache_t *path_cache,
+     uint32_t identifier,
+     uint32_t *parent_identifier,
+     const uint8_t **name,
+     uint16_t *name_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBFSHFS_PATH_CACHE_H ) */
+
@@ -130,6 +130,11 @@ int libfshfs_thread_record_free(
 	}
 	if( *thread_record != NULL )
 	{
+		if( ( *thread_record )->name != NULL )
+		{
+			memory_free(
+			 ( *thread_record )->name );
+		}
 		memory_free(
 		 *thread_record );
 
@@ -172,6 +177,17 @@ int libfshfs_thread_record_read_data(
 
 		return( -1 );
 	}
+	if( thread_record->name != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid thread record - name value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( data == NULL )
 	{
 		libcerror_error_set(
@@ -235,26 +251,32 @@ int libfshfs_thread_record_read_data(
 	if( ( record_type == 0x0003 )
 	 || ( record_type == 0x0004 ) )
 	{
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_thread_record_hfsplus_t *) data )->parent_identifier,
+		 thread_record->parent_identifier );
+
 		byte_stream_copy_to_uint16_big_endian(
 		 ( (fshfs_catalog_thread_record_hfsplus_t *) data )->name_size,
 		 name_size );
 	}
 	else
 	{
+		byte_stream_copy_to_uint32_big_endian(
+		 ( (fshfs_catalog_thread_record_hfs_t *) data )->parent_identifier,
+		 thread_record->parent_identifier );
+
 /* TODO add HFS support */
 	}
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
-		record_size += name_size * 2;
-
 		libcnotify_printf(
 		 "%s: thread record data:\n",
 		 function );
 		libcnotify_print_data(
 		 data,
-		 record_size,
+		 record_size + ( (size_t) name_size * 2 ),
 		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 	}
 #endif
@@ -338,6 +360,17 @@ int libfshfs_thread_record_read_data(
 #endif
 	name_size *= 2;
 
+	if( (size_t) name_size > ( data_size - record_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
 	if( name_size > 0 )
 	{
 		name_data = &( data[ sizeof( fshfs_catalog_thread_record_hfsplus_t ) ] );
@@ -427,6 +460,35 @@ int libfshfs_thread_record_read_data(
 			 "\n" );
 		}
 #endif
+		thread_record->name = (uint8_t *) memory_allocate(
+		                                   sizeof( uint8_t ) * name_size );
+
+		if( thread_record->name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     thread_record->name,
+		     name_data,
+		     name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			goto on_error;
+		}
+		thread_record->name_size = name_size;
 	}
 	return( 1 );
 
@@ -438,6 +500,15 @@ on_error:
 		 value_string );
 	}
 #endif
+	if( thread_record->name != NULL )
+	{
+		memory_free(
+		 thread_record->name );
+
+		thread_record->name = NULL;
+	}
+	thread_record->name_size = 0;
+
 	return( -1 );
 }
 
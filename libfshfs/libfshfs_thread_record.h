@@ -35,9 +35,17 @@ typedef struct libfshfs_thread_record libfshfs_thread_record_t;
 
 struct libfshfs_thread_record
 {
-	/* Dummy
+	/* The parent identifier
 	 */
-	int dummy;
+	uint32_t parent_identifier;
+
+	/* The name
+	 */
+	uint8_t *name;
+
+	/* The name size
+	 */
+	uint16_t name_size;
 };
 
 int libfshfs_thread_record_initialize(
@@ -35,14 +35,99 @@
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libfshfs_file_entry {}	libfshfs_file_entry_t;
+typedef struct libfshfs_listing_cursor {}	libfshfs_listing_cursor_t;
 typedef struct libfshfs_volume {}	libfshfs_volume_t;
 
 #else
 typedef intptr_t libfshfs_file_entry_t;
+typedef intptr_t libfshfs_listing_cursor_t;
 typedef intptr_t libfshfs_volume_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The IO vector, which describes one of the buffers of a vectored read
+ */
+typedef struct libfshfs_io_vector libfshfs_io_vector_t;
+
+struct libfshfs_io_vector
+{
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+};
+
+/* The file entry metadata values, which are retrieved in bulk
+ * The times contain HFS timestamps
+ */
+typedef struct libfshfs_stat libfshfs_stat_t;
+
+struct libfshfs_stat
+{
+	/* The data fork size
+	 */
+	uint64_t data_size;
+
+	/* The resource fork size
+	 */
+	uint64_t resource_fork_size;
+
+	/* The identifier (CNID)
+	 */
+	uint32_t identifier;
+
+	/* The parent identifier (CNID)
+	 */
+	uint32_t parent_identifier;
+
+	/* The owner identifier (UID)
+	 */
+	uint32_t owner_identifier;
+
+	/* The group identifier (GID)
+	 */
+	uint32_t group_identifier;
+
+	/* The creation time
+	 */
+	uint32_t creation_time;
+
+	/* The modification time
+	 */
+	uint32_t modification_time;
+
+	/* The entry modification time
+	 */
+	uint32_t entry_modification_time;
+
+	/* The access time
+	 */
+	uint32_t access_time;
+
+	/* The number of links, 0 if not known
+	 */
+	uint32_t number_of_links;
+
+	/* The catalog record type
+	 */
+	uint16_t record_type;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+
+	/* The flags
+	 */
+	uint16_t flags;
+
+	/* Reserved
+	 */
+	uint8_t reserved[ 6 ];
+};
+
 #endif /* defined( HAVE_LOCAL_LIBFSHFS ) */
 
 #endif /* !defined( _LIBFSHFS_INTERNAL_TYPES_H ) */
@@ -25,17 +25,33 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libfshfs_allocation_bitmap.h"
+#include "libfshfs_block_cache.h"
+#include "libfshfs_block_owner_index.h"
+#include "libfshfs_buffer_pool.h"
 #include "libfshfs_btree_file.h"
 #include "libfshfs_catalog_btree_file.h"
+#include "libfshfs_catalog_index.h"
+#include "libfshfs_cnid_index.h"
 #include "libfshfs_debug.h"
 #include "libfshfs_definitions.h"
+#include "libfshfs_direct_io.h"
 #include "libfshfs_directory_entry.h"
+#include "libfshfs_export_planner.h"
+#include "libfshfs_extent.h"
+#include "libfshfs_extents_btree_file.h"
 #include "libfshfs_file_entry.h"
+#include "libfshfs_fork_descriptor.h"
 #include "libfshfs_io_handle.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_kernel_copy.h"
 #include "libfshfs_libcdata.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcnotify.h"
 #include "libfshfs_libcthreads.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
 #include "libfshfs_thread_record.h"
 #include "libfshfs_volume.h"
 #include "libfshfs_volume_header.h"
@@ -259,6 +275,209 @@ int libfshfs_volume_signal_abort(
 	return( 1 );
 }
 
+/* Sets the maximum read gap size
+ * Pending reads, such as the reads of B-tree nodes, that are at most this size apart
+ * are coalesced into a single read, where 0 only coalesces adjacent reads
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_set_maximum_read_gap_size(
+     libfshfs_volume_t *volume,
+     size_t maximum_read_gap_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_set_maximum_read_gap_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_read_gap_size > (size_t) LIBFSHFS_IO_SCHEDULER_MAXIMUM_READ_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum read gap size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->io_handle->maximum_read_gap_size = maximum_read_gap_size;
+
+	return( 1 );
+}
+
+/* Sets the number of read threads
+ * When set, the batched reads of B-tree nodes and the runs of the extents read by
+ * libfshfs_file_entry_readv are read concurrently by a pool of threads that each read
+ * using their own clone of the file IO handle, where 0 represents synchronous reads.
+ * Other reads of file entry data, including the readahead, are read by the calling thread.
+ * Without multi-threading support reads are synchronous
+ * The number of read threads must be set before the volume is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_set_number_of_read_threads(
+     libfshfs_volume_t *volume,
+     int number_of_read_threads,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_set_number_of_read_threads";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_read_threads < 0 )
+	 || ( number_of_read_threads > LIBFSHFS_IO_THREAD_POOL_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of read threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->io_handle->number_of_read_threads = number_of_read_threads;
+
+	return( 1 );
+}
+
+/* Sets the block cache budget of a specific partition
+ * The block cache is shared by the B-tree files and the file entry data streams of the volume,
+ * where every partition has its own budget so that reading file data does not evict B-tree nodes.
+ * The budget is the maximum number of blocks, such as B-tree nodes or allocation blocks,
+ * where 0 disables caching for the partition
+ * The budget must be set before the volume is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_set_block_cache_budget(
+     libfshfs_volume_t *volume,
+     int block_cache_partition,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_set_block_cache_budget";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_cache_partition < 0 )
+	 || ( block_cache_partition >= LIBFSHFS_BLOCK_CACHE_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block cache partition.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_blocks < 0 )
+	 || ( maximum_number_of_blocks > LIBFSHFS_BLOCK_CACHE_MAXIMUM_NUMBER_OF_BLOCKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->io_handle->maximum_number_of_cached_blocks[ block_cache_partition ] = maximum_number_of_blocks;
+
+	return( 1 );
+}
+
 /* Opens a volume
  * Returns 1 if successful or -1 on error
  */
@@ -285,6 +504,19 @@ int libfshfs_volume_open(
 	}
 	internal_volume = (libfshfs_internal_volume_t *) volume;
 
+	/* The file IO handle, direct I/O and kernel copy are set by a previous open
+	 */
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( filename == NULL )
 	{
 		libcerror_error_set(
@@ -364,6 +596,65 @@ int libfshfs_volume_open(
 
 		goto on_error;
 	}
+	if( ( access_flags & LIBFSHFS_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		if( libfshfs_direct_io_initialize(
+		     &( internal_volume->direct_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct I/O.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_direct_io_open(
+		     internal_volume->direct_io,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open direct I/O.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfshfs_kernel_copy_initialize(
+	     &( internal_volume->kernel_copy ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create kernel copy.",
+		 function );
+
+		goto on_error;
+	}
+	/* The source file of the kernel copy is opened on first use
+	 */
+	if( libfshfs_kernel_copy_set_filename(
+	     internal_volume->kernel_copy,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in kernel copy.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfshfs_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
@@ -415,6 +706,18 @@ int libfshfs_volume_open(
 	return( 1 );
 
 on_error:
+	if( internal_volume->direct_io != NULL )
+	{
+		libfshfs_direct_io_free(
+		 &( internal_volume->direct_io ),
+		 NULL );
+	}
+	if( internal_volume->kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &( internal_volume->kernel_copy ),
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -452,6 +755,19 @@ int libfshfs_volume_open_wide(
 	}
 	internal_volume = (libfshfs_internal_volume_t *) volume;
 
+	/* The file IO handle and direct I/O are set by a previous open
+	 */
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( filename == NULL )
 	{
 		libcerror_error_set(
@@ -531,6 +847,36 @@ int libfshfs_volume_open_wide(
 
 		goto on_error;
 	}
+	if( ( access_flags & LIBFSHFS_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		if( libfshfs_direct_io_initialize(
+		     &( internal_volume->direct_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create direct I/O.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_direct_io_open_wide(
+		     internal_volume->direct_io,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open direct I/O.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libfshfs_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
@@ -582,6 +928,12 @@ int libfshfs_volume_open_wide(
 	return( 1 );
 
 on_error:
+	if( internal_volume->direct_io != NULL )
+	{
+		libfshfs_direct_io_free(
+		 &( internal_volume->direct_io ),
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -666,6 +1018,20 @@ int libfshfs_volume_open_file_io_handle(
 
 		return( -1 );
 	}
+	/* Direct I/O requires the filename and is opened by libfshfs_volume_open
+	 */
+	if( ( ( access_flags & LIBFSHFS_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	 && ( internal_volume->direct_io == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: direct I/O is only supported when opening a volume by filename.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( access_flags & LIBFSHFS_ACCESS_FLAG_READ ) != 0 )
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
@@ -703,6 +1069,8 @@ int libfshfs_volume_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
+	internal_volume->replay_journal = (uint8_t) ( ( access_flags & LIBFSHFS_ACCESS_FLAG_REPLAY_JOURNAL ) != 0 );
+
 	if( libfshfs_internal_volume_open_read(
 	     internal_volume,
 	     file_io_handle,
@@ -834,6 +1202,26 @@ int libfshfs_volume_close(
 		}
 	}
 #endif
+	/* The I/O thread pool is freed first since its threads read using clones of the file IO handle
+	 */
+	internal_volume->io_handle->io_thread_pool = NULL;
+
+	if( internal_volume->io_thread_pool != NULL )
+	{
+		if( libfshfs_io_thread_pool_free(
+		     &( internal_volume->io_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free I/O thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_volume->file_io_handle_opened_in_library != 0 )
 	{
 		if( libbfio_handle_close(
@@ -870,6 +1258,60 @@ int libfshfs_volume_close(
 	}
 	internal_volume->file_io_handle = NULL;
 
+	internal_volume->io_handle->direct_io = NULL;
+
+	if( internal_volume->direct_io != NULL )
+	{
+		if( libfshfs_direct_io_free(
+		     &( internal_volume->direct_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free direct I/O.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_volume->io_handle->kernel_copy = NULL;
+
+	if( internal_volume->kernel_copy != NULL )
+	{
+		if( libfshfs_kernel_copy_free(
+		     &( internal_volume->kernel_copy ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free kernel copy.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_volume->io_handle->block_cache = NULL;
+
+	if( internal_volume->block_cache != NULL )
+	{
+		if( libfshfs_block_cache_free(
+		     &( internal_volume->block_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block cache.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( libfshfs_io_handle_clear(
 	     internal_volume->io_handle,
 	     error ) != 1 )
@@ -883,6 +1325,57 @@ int libfshfs_volume_close(
 
 		result = -1;
 	}
+	if( internal_volume->journal != NULL )
+	{
+		if( libfshfs_journal_free(
+		     &( internal_volume->journal ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free journal.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_volume->replay_journal = 0;
+
+	if( internal_volume->allocation_bitmap != NULL )
+	{
+		if( libfshfs_allocation_bitmap_free(
+		     &( internal_volume->allocation_bitmap ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation bitmap.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->metadata_extents_array != NULL )
+	{
+		if( libcdata_array_free(
+		     &( internal_volume->metadata_extents_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_extent_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata extents array.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( libfshfs_volume_header_free(
 	     &( internal_volume->volume_header ),
 	     error ) != 1 )
@@ -912,6 +1405,22 @@ int libfshfs_volume_close(
 			result = -1;
 		}
 	}
+	if( internal_volume->extents_btree_file != NULL )
+	{
+		if( libfshfs_btree_file_free(
+		     &( internal_volume->extents_btree_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extents btree file.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_volume->root_directory_entry != NULL )
 	{
 		if( libfshfs_directory_entry_free(
@@ -928,6 +1437,106 @@ int libfshfs_volume_close(
 			result = -1;
 		}
 	}
+	if( internal_volume->catalog_index != NULL )
+	{
+		if( libfshfs_catalog_index_free(
+		     &( internal_volume->catalog_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->cnid_index != NULL )
+	{
+		if( libfshfs_cnid_index_free(
+		     &( internal_volume->cnid_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free CNID index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->block_owner_index != NULL )
+	{
+		if( libfshfs_block_owner_index_free(
+		     &( internal_volume->block_owner_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block owner index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->parent_index != NULL )
+	{
+		if( libfshfs_parent_index_free(
+		     &( internal_volume->parent_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->path_cache != NULL )
+	{
+		if( libfshfs_path_cache_free(
+		     &( internal_volume->path_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free path cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The buffer pool is freed last since the B-tree nodes release their data to it
+	 */
+	internal_volume->io_handle->buffer_pool = NULL;
+
+	if( internal_volume->buffer_pool != NULL )
+	{
+		if( libfshfs_buffer_pool_free(
+		     &( internal_volume->buffer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffer pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -1030,107 +1639,3415 @@ int libfshfs_internal_volume_open_read(
 	internal_volume->io_handle->file_system_type      = internal_volume->volume_header->file_system_type;
 	internal_volume->io_handle->allocation_block_size = internal_volume->volume_header->allocation_block_size;
 
-	if( internal_volume->volume_header->catalog_file_fork_descriptor->size > 0 )
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( internal_volume->io_handle->number_of_read_threads > 0 )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "Reading catalog B-tree file:\n" );
-		}
-#endif
-		if( libfshfs_btree_file_initialize(
-		     &( internal_volume->catalog_btree_file ),
+		if( libfshfs_io_thread_pool_initialize(
+		     &( internal_volume->io_thread_pool ),
+		     file_io_handle,
+		     internal_volume->io_handle->number_of_read_threads,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create catalog B-tree file.",
+			 "%s: unable to create I/O thread pool.",
 			 function );
 
 			goto on_error;
 		}
-/* TODO what about extra extents? */
-		if( libfshfs_btree_file_read(
-		     internal_volume->catalog_btree_file,
-		     internal_volume->io_handle,
+		internal_volume->io_handle->io_thread_pool = internal_volume->io_thread_pool;
+	}
+#endif
+	if( ( internal_volume->replay_journal != 0 )
+	 && ( ( internal_volume->volume_header->attribute_flags & LIBFSHFS_VOLUME_ATTRIBUTE_FLAG_JOURNALED ) != 0 )
+	 && ( internal_volume->volume_header->journal_information_block_number != 0 ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading journal:\n" );
+		}
+#endif
+		if( libfshfs_internal_volume_read_journal(
+		     internal_volume,
 		     file_io_handle,
-		     internal_volume->volume_header->catalog_file_fork_descriptor,
+		     file_offset,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to read catalog B-tree file.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal.",
 			 function );
 
 			goto on_error;
 		}
+	}
+	if( libfshfs_buffer_pool_initialize(
+	     &( internal_volume->buffer_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->buffer_pool = internal_volume->buffer_pool;
+	internal_volume->io_handle->direct_io   = internal_volume->direct_io;
+	internal_volume->io_handle->kernel_copy = internal_volume->kernel_copy;
+
+	/* The block cache is created after the journal has been read
+	 * so that the cached blocks contain the journal overlay
+	 */
+	if( libfshfs_block_cache_initialize(
+	     &( internal_volume->block_cache ),
+	     internal_volume->io_handle->maximum_number_of_cached_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block cache.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->block_cache = internal_volume->block_cache;
+
+	if( internal_volume->volume_header->extents_file_fork_descriptor->size > 0 )
+	{
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_printf(
-			 "Reading volume name directory entry:\n" );
+			 "Reading extents B-tree file:\n" );
 		}
 #endif
-		result = libfshfs_catalog_btree_file_get_directory_entry(
-		          internal_volume->catalog_btree_file,
-		          file_io_handle,
-		          1,
-		          &( internal_volume->root_directory_entry ),
-		          error );
-
-		if( result == -1 )
+		if( libfshfs_btree_file_initialize(
+		     &( internal_volume->extents_btree_file ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve root directory entry from catalog B-tree file.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create extents B-tree file.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	return( 1 );
-
-on_error:
+		if( libfshfs_btree_file_read(
+		     internal_volume->extents_btree_file,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     internal_volume->volume_header->extents_file_fork_descriptor,
+		     LIBFSHFS_BLOCK_CACHE_PARTITION_EXTENTS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to read extents B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfshfs_internal_volume_get_special_files_overflow_extents(
+	     internal_volume,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve overflow extents of special files.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_volume->volume_header->catalog_file_fork_descriptor->size > 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading catalog B-tree file:\n" );
+		}
+#endif
+		if( libfshfs_btree_file_initialize(
+		     &( internal_volume->catalog_btree_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create catalog B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_path_cache_initialize(
+		     &( internal_volume->path_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create path cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_btree_file_read(
+		     internal_volume->catalog_btree_file,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     internal_volume->volume_header->catalog_file_fork_descriptor,
+		     LIBFSHFS_BLOCK_CACHE_PARTITION_CATALOG,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to read catalog B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading volume name directory entry:\n" );
+		}
+#endif
+		result = libfshfs_catalog_btree_file_get_directory_entry(
+		          internal_volume->catalog_btree_file,
+		          file_io_handle,
+		          1,
+		          &( internal_volume->root_directory_entry ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve root directory entry from catalog B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* The direct I/O and kernel copy are freed by libfshfs_volume_open
+	 */
+	internal_volume->io_handle->direct_io   = NULL;
+	internal_volume->io_handle->kernel_copy = NULL;
+
+	internal_volume->io_handle->block_cache = NULL;
+
+	if( internal_volume->block_cache != NULL )
+	{
+		libfshfs_block_cache_free(
+		 &( internal_volume->block_cache ),
+		 NULL );
+	}
+	internal_volume->io_handle->io_thread_pool = NULL;
+
+	if( internal_volume->io_thread_pool != NULL )
+	{
+		libfshfs_io_thread_pool_free(
+		 &( internal_volume->io_thread_pool ),
+		 NULL );
+	}
+	internal_volume->io_handle->journal = NULL;
+
+	if( internal_volume->journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &( internal_volume->journal ),
+		 NULL );
+	}
 	if( internal_volume->root_directory_entry == NULL )
 	{
 		libfshfs_directory_entry_free(
 		 &( internal_volume->root_directory_entry ),
 		 NULL );
 	}
-	if( internal_volume->catalog_btree_file == NULL )
+	if( internal_volume->path_cache != NULL )
+	{
+		libfshfs_path_cache_free(
+		 &( internal_volume->path_cache ),
+		 NULL );
+	}
+	if( internal_volume->catalog_btree_file == NULL )
+	{
+		libfshfs_btree_file_free(
+		 &( internal_volume->catalog_btree_file ),
+		 NULL );
+	}
+	if( internal_volume->extents_btree_file != NULL )
+	{
+		libfshfs_btree_file_free(
+		 &( internal_volume->extents_btree_file ),
+		 NULL );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libfshfs_volume_header_free(
+		 &( internal_volume->volume_header ),
+		 NULL );
+	}
+	/* The buffer pool is freed last since the B-tree nodes release their data to it
+	 */
+	internal_volume->io_handle->buffer_pool = NULL;
+
+	if( internal_volume->buffer_pool != NULL )
+	{
+		libfshfs_buffer_pool_free(
+		 &( internal_volume->buffer_pool ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the overflow extents of the special files
+ * The volume header contains the first 8 extents of the special files, the remaining
+ * extents are stored in the extents B-tree file. The extents B-tree file itself
+ * cannot have overflow extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_get_special_files_overflow_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *fork_descriptors[ 4 ];
+	uint32_t fork_identifiers[ 4 ];
+	static char *function = "libfshfs_internal_volume_get_special_files_overflow_extents";
+	int fork_index        = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	fork_descriptors[ 0 ] = internal_volume->volume_header->allocation_file_fork_descriptor;
+	fork_descriptors[ 1 ] = internal_volume->volume_header->catalog_file_fork_descriptor;
+	fork_descriptors[ 2 ] = internal_volume->volume_header->attributes_file_fork_descriptor;
+	fork_descriptors[ 3 ] = internal_volume->volume_header->startup_file_fork_descriptor;
+
+	fork_identifiers[ 0 ] = LIBFSHFS_ALLOCATION_FILE_IDENTIFIER;
+	fork_identifiers[ 1 ] = LIBFSHFS_CATALOG_FILE_IDENTIFIER;
+	fork_identifiers[ 2 ] = LIBFSHFS_ATTRIBUTES_FILE_IDENTIFIER;
+	fork_identifiers[ 3 ] = LIBFSHFS_STARTUP_FILE_IDENTIFIER;
+
+	for( fork_index = 0;
+	     fork_index < 4;
+	     fork_index++ )
+	{
+		if( fork_descriptors[ fork_index ] == NULL )
+		{
+			continue;
+		}
+		if( libfshfs_extents_btree_file_get_overflow_extents(
+		     internal_volume->extents_btree_file,
+		     file_io_handle,
+		     fork_identifiers[ fork_index ],
+		     LIBFSHFS_FORK_TYPE_DATA,
+		     fork_descriptors[ fork_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve overflow extents of special file: %" PRIu32 ".",
+			 function,
+			 fork_identifiers[ fork_index ] );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the journal and replays it as an overlay of the volume data
+ * The volume header is read again since the journal can contain a more recent version
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_read_journal(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	uint8_t volume_header_data[ 1024 ];
+
+	static char *function        = "libfshfs_internal_volume_read_journal";
+	off64_t journal_block_offset = 0;
+	ssize_t read_count           = 0;
+	int result                   = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->journal != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - journal already set.",
+		 function );
+
+		return( -1 );
+	}
+	journal_block_offset = (off64_t) internal_volume->volume_header->journal_information_block_number
+	                     * internal_volume->volume_header->allocation_block_size;
+
+	if( libfshfs_journal_initialize(
+	     &( internal_volume->journal ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create journal.",
+		 function );
+
+		goto on_error;
+	}
+	result = libfshfs_journal_read_file_io_handle(
+	          internal_volume->journal,
+	          file_io_handle,
+	          journal_block_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read journal at offset: %" PRIi64 ".",
+		 function,
+		 journal_block_offset );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* The journal is empty so there is nothing to replay
+		 */
+		if( libfshfs_journal_free(
+		     &( internal_volume->journal ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free journal.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	internal_volume->io_handle->journal = internal_volume->journal;
+
+	read_count = libfshfs_io_handle_read_buffer_at_offset(
+	              internal_volume->io_handle,
+	              file_io_handle,
+	              file_offset,
+	              volume_header_data,
+	              1024,
+	              error );
+
+	if( read_count != (ssize_t) 1024 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header data at offset: %" PRIi64 ".",
+		 function,
+		 file_offset );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_header_read_data(
+	     internal_volume->volume_header,
+	     volume_header_data,
+	     1024,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->file_system_type      = internal_volume->volume_header->file_system_type;
+	internal_volume->io_handle->allocation_block_size = internal_volume->volume_header->allocation_block_size;
+
+	return( 1 );
+
+on_error:
+	internal_volume->io_handle->journal = NULL;
+
+	if( internal_volume->journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &( internal_volume->journal ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_utf8_name_size(
+     libfshfs_volume_t *volume,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_utf8_name_size";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_directory_entry_get_utf8_name_size(
+	     internal_volume->root_directory_entry,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded name
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_utf8_name(
+     libfshfs_volume_t *volume,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_utf8_name";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_directory_entry_get_utf8_name(
+	     internal_volume->root_directory_entry,
+	     utf8_string,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the UTF-16 encoded name
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_utf16_name_size(
+     libfshfs_volume_t *volume,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_utf16_name_size";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_directory_entry_get_utf16_name_size(
+	     internal_volume->root_directory_entry,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 encoded name
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_utf16_name(
+     libfshfs_volume_t *volume,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_utf16_name";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_directory_entry_get_utf16_name(
+	     internal_volume->root_directory_entry,
+	     utf16_string,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the root directory file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_root_directory(
+     libfshfs_volume_t *volume,
+     libfshfs_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_root_directory";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->root_directory_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing root directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_file_entry_initialize(
+	     file_entry,
+	     internal_volume->root_directory_entry,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume->catalog_btree_file,
+	     internal_volume->extents_btree_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file entry.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		( (libfshfs_internal_file_entry_t *) *file_entry )->parent_index = internal_volume->parent_index;
+		( (libfshfs_internal_file_entry_t *) *file_entry )->path_cache   = internal_volume->path_cache;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the allocation block size
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_allocation_block_size(
+     libfshfs_volume_t *volume,
+     uint32_t *allocation_block_size,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_allocation_block_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation block size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*allocation_block_size = internal_volume->volume_header->allocation_block_size;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of (allocation) blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_number_of_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_number_of_blocks";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of (allocation) blocks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_blocks = internal_volume->volume_header->number_of_blocks;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the allocation bitmap
+ * The allocation bitmap is created on first access
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_get_allocation_bitmap(
+     libfshfs_internal_volume_t *internal_volume,
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_internal_volume_get_allocation_bitmap";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->allocation_bitmap == NULL )
+	{
+		if( libfshfs_allocation_bitmap_initialize(
+		     &( internal_volume->allocation_bitmap ),
+		     internal_volume->io_handle,
+		     internal_volume->volume_header->allocation_file_fork_descriptor,
+		     internal_volume->volume_header->number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create allocation bitmap.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*allocation_bitmap = internal_volume->allocation_bitmap;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_number_of_allocated_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_allocated_blocks,
+     libcerror_error_t **error )
+{
+	libfshfs_allocation_bitmap_t *allocation_bitmap = NULL;
+	libfshfs_internal_volume_t *internal_volume     = NULL;
+	static char *function                           = "libfshfs_volume_get_number_of_allocated_blocks";
+	int result                                      = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_volume_get_allocation_bitmap(
+	     internal_volume,
+	     &allocation_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else if( libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+	          allocation_bitmap,
+	          internal_volume->file_io_handle,
+	          number_of_allocated_blocks,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocated blocks.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of unallocated blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_number_of_unallocated_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_unallocated_blocks,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_number_of_unallocated_blocks";
+	uint32_t number_of_allocated_blocks         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_unallocated_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of unallocated blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_volume_get_number_of_allocated_blocks(
+	     volume,
+	     &number_of_allocated_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocated blocks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_unallocated_blocks = internal_volume->volume_header->number_of_blocks - number_of_allocated_blocks;
+
+	return( 1 );
+}
+
+/* Retrieves the run of blocks with the same allocation status that starts at a specific block
+ * Returns 1 if successful, 0 if the block number is out of bounds or -1 on error
+ */
+int libfshfs_volume_get_allocation_block_run(
+     libfshfs_volume_t *volume,
+     uint32_t block_number,
+     uint32_t *number_of_blocks,
+     uint8_t *is_allocated,
+     libcerror_error_t **error )
+{
+	libfshfs_allocation_bitmap_t *allocation_bitmap = NULL;
+	libfshfs_internal_volume_t *internal_volume     = NULL;
+	static char *function                           = "libfshfs_volume_get_allocation_block_run";
+	int result                                      = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libfshfs_internal_volume_get_allocation_bitmap(
+	     internal_volume,
+	     &allocation_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation bitmap.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libfshfs_allocation_bitmap_get_block_run(
+		          allocation_bitmap,
+		          internal_volume->file_io_handle,
+		          block_number,
+		          number_of_blocks,
+		          is_allocated,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve run of block: %" PRIu32 ".",
+			 function,
+			 block_number );
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Appends the extents of a fork of a metadata file to an array of extents sorted by offset
+ * The extents include those stored in the extents overflow file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_append_fork_metadata_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libcdata_array_t *extents_array,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function              = "libfshfs_internal_volume_append_fork_metadata_extents";
+	uint64_t number_of_mapped_blocks   = 0;
+	uint32_t extent_number_of_blocks   = 0;
+	uint32_t extent_start_block_number = 0;
+	int extent_index                   = 0;
+	int number_of_extents              = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( fork_descriptor == NULL )
+	{
+		return( 1 );
+	}
+	if( libfshfs_fork_descriptor_get_number_of_mapped_blocks(
+	     fork_descriptor,
+	     &number_of_mapped_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of mapped blocks.",
+		 function );
+
+		return( -1 );
+	}
+	/* A metadata file that is only partially mapped would result in an incomplete image
+	 */
+	if( fork_descriptor->size > ( number_of_mapped_blocks * internal_volume->volume_header->allocation_block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fork descriptor - size exceeds size of extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_fork_descriptor_get_number_of_extents(
+	     fork_descriptor,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libfshfs_fork_descriptor_get_extent_by_index(
+		     fork_descriptor,
+		     extent_index,
+		     &extent_start_block_number,
+		     &extent_number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( ( (uint64_t) extent_start_block_number + extent_number_of_blocks ) > internal_volume->volume_header->number_of_blocks )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent: %d value out of bounds.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		if( libfshfs_extents_array_insert_extent(
+		     extents_array,
+		     (off64_t) extent_start_block_number * internal_volume->volume_header->allocation_block_size,
+		     (size64_t) extent_number_of_blocks * internal_volume->volume_header->allocation_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the metadata extents
+ * The metadata extents contain the volume headers, the allocation, extents overflow,
+ * catalog, attributes and startup files and the journal, sorted by offset where
+ * overlapping and adjacent extents are merged
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_read_metadata_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *extents_array                = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptors[ 5 ];
+	libfshfs_journal_t *journal                    = NULL;
+	static char *function                          = "libfshfs_internal_volume_read_metadata_extents";
+	size64_t volume_size                           = 0;
+	off64_t journal_information_block_offset       = 0;
+	int fork_index                                 = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->metadata_extents_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - metadata extents array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	volume_size = (size64_t) internal_volume->volume_header->number_of_blocks
+	            * internal_volume->volume_header->allocation_block_size;
+
+	if( volume_size < 1536 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &extents_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create extents array.",
+		 function );
+
+		goto on_error;
+	}
+	/* The reserved boot blocks and the volume header
+	 */
+	if( libfshfs_extents_array_insert_extent(
+	     extents_array,
+	     0,
+	     1536,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert volume header extent.",
+		 function );
+
+		goto on_error;
+	}
+	/* The alternate volume header
+	 */
+	if( libfshfs_extents_array_insert_extent(
+	     extents_array,
+	     (off64_t) ( volume_size - 1024 ),
+	     1024,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert alternate volume header extent.",
+		 function );
+
+		goto on_error;
+	}
+	fork_descriptors[ 0 ] = internal_volume->volume_header->allocation_file_fork_descriptor;
+	fork_descriptors[ 1 ] = internal_volume->volume_header->extents_file_fork_descriptor;
+	fork_descriptors[ 2 ] = internal_volume->volume_header->catalog_file_fork_descriptor;
+	fork_descriptors[ 3 ] = internal_volume->volume_header->attributes_file_fork_descriptor;
+	fork_descriptors[ 4 ] = internal_volume->volume_header->startup_file_fork_descriptor;
+
+	for( fork_index = 0;
+	     fork_index < 5;
+	     fork_index++ )
+	{
+		if( libfshfs_internal_volume_append_fork_metadata_extents(
+		     internal_volume,
+		     extents_array,
+		     fork_descriptors[ fork_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extents of fork: %d.",
+			 function,
+			 fork_index );
+
+			goto on_error;
+		}
+	}
+	if( ( ( internal_volume->volume_header->attribute_flags & LIBFSHFS_VOLUME_ATTRIBUTE_FLAG_JOURNALED ) != 0 )
+	 && ( internal_volume->volume_header->journal_information_block_number != 0 )
+	 && ( internal_volume->volume_header->journal_information_block_number < internal_volume->volume_header->number_of_blocks ) )
+	{
+		journal_information_block_offset = (off64_t) internal_volume->volume_header->journal_information_block_number
+		                                 * internal_volume->volume_header->allocation_block_size;
+
+		if( libfshfs_extents_array_insert_extent(
+		     extents_array,
+		     journal_information_block_offset,
+		     (size64_t) internal_volume->volume_header->allocation_block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert journal information block extent.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_journal_initialize(
+		     &journal,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create journal.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_journal_read_information_block_file_io_handle(
+		     journal,
+		     file_io_handle,
+		     journal_information_block_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read journal information block.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( journal->flags & LIBFSHFS_JOURNAL_FLAG_IN_FILE_SYSTEM ) != 0 )
+		{
+			if( ( journal->journal_offset < 0 )
+			 || ( (size64_t) journal->journal_offset >= volume_size )
+			 || ( journal->journal_size > ( volume_size - journal->journal_offset ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid journal - range value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfshfs_extents_array_insert_extent(
+			     extents_array,
+			     journal->journal_offset,
+			     journal->journal_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert journal extent.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libfshfs_journal_free(
+		     &journal,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free journal.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_initialize(
+	     &( internal_volume->metadata_extents_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata extents array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_extents_array_merge(
+	     extents_array,
+	     internal_volume->metadata_extents_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to merge extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_free(
+	     &extents_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_extent_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free extents array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_volume->metadata_extents_array != NULL )
+	{
+		libcdata_array_free(
+		 &( internal_volume->metadata_extents_array ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_extent_free,
+		 NULL );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	if( extents_array != NULL )
+	{
+		libcdata_array_free(
+		 &extents_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libfshfs_extent_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of metadata extents
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_number_of_metadata_extents(
+     libfshfs_volume_t *volume,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_number_of_metadata_extents";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->metadata_extents_array == NULL )
+	{
+		if( libfshfs_internal_volume_read_metadata_extents(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata extents.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_volume->metadata_extents_array,
+		     number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of metadata extents.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific metadata extent
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_get_metadata_extent_by_index(
+     libfshfs_volume_t *volume,
+     int extent_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error )
+{
+	libfshfs_extent_t *extent                   = NULL;
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_get_metadata_extent_by_index";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->metadata_extents_array == NULL )
+	{
+		if( libfshfs_internal_volume_read_metadata_extents(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata extents.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->metadata_extents_array,
+		     extent_index,
+		     (intptr_t **) &extent,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve metadata extent: %d.",
+			 function,
+			 extent_index );
+
+			result = -1;
+		}
+		else if( extent == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing metadata extent: %d.",
+			 function,
+			 extent_index );
+
+			result = -1;
+		}
+		else
+		{
+			*extent_offset = extent->offset;
+			*extent_size   = extent->size;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the catalog index
+ * The catalog index is read from the catalog B-tree file if no catalog index was read before
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_get_catalog_index(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libfshfs_internal_volume_get_catalog_index";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( catalog_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid catalog index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->catalog_index == NULL )
+	{
+		if( libfshfs_catalog_index_initialize(
+		     &( internal_volume->catalog_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create catalog index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfshfs_catalog_index_read_btree_file(
+		     internal_volume->catalog_index,
+		     internal_volume->volume_header,
+		     internal_volume->catalog_btree_file,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read catalog index from catalog B-tree file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*catalog_index = internal_volume->catalog_index;
+
+	return( 1 );
+
+on_error:
+	if( internal_volume->catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &( internal_volume->catalog_index ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a catalog index file
+ * A catalog index that does not match the volume is ignored
+ * Returns 1 if successful, 0 if the catalog index does not match the volume or -1 on error
+ */
+int libfshfs_volume_read_catalog_index(
+     libfshfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfshfs_volume_read_catalog_index";
+	int result                       = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+		goto on_error;
+	}
+	result = libfshfs_volume_read_catalog_index_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Reads a catalog index file
+ * A catalog index that does not match the volume is ignored
+ * Returns 1 if successful, 0 if the catalog index does not match the volume or -1 on error
+ */
+int libfshfs_volume_read_catalog_index_wide(
+     libfshfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfshfs_volume_read_catalog_index_wide";
+	int result                       = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+		goto on_error;
+	}
+	result = libfshfs_volume_read_catalog_index_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Reads a catalog index file using a Basic File IO (bfio) handle
+ * A catalog index that does not match the volume is ignored
+ * The parent index and path cache are filled from a matching catalog index
+ * Returns 1 if successful, 0 if the catalog index does not match the volume or -1 on error
+ */
+int libfshfs_volume_read_catalog_index_file_io_handle(
+     libfshfs_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_catalog_index_t *catalog_index     = NULL;
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	libfshfs_parent_index_t *parent_index       = NULL;
+	static char *function                       = "libfshfs_volume_read_catalog_index_file_io_handle";
+	int file_io_handle_is_open                  = 0;
+	int file_io_handle_opened_in_library        = 0;
+	int result                                  = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->volume_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+	if( libfshfs_catalog_index_initialize(
+	     &catalog_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create catalog index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_index_read_file_io_handle(
+	     catalog_index,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog index.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		file_io_handle_opened_in_library = 0;
+
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          internal_volume->volume_header,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to determine if catalog index matches volume header.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: catalog index does not match volume and is ignored.\n",
+			 function );
+		}
+#endif
+		if( libfshfs_catalog_index_free(
+		     &catalog_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog index.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	/* The path cache has its own read/write lock
+	 */
+	if( internal_volume->path_cache != NULL )
+	{
+		if( libfshfs_catalog_index_read_path_cache(
+		     catalog_index,
+		     internal_volume->path_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read path cache from catalog index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfshfs_parent_index_initialize(
+	     &parent_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create parent index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfshfs_catalog_index_read_parent_index(
+	     catalog_index,
+	     parent_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read parent index from catalog index.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_volume->catalog_index != NULL )
+	{
+		if( libfshfs_catalog_index_free(
+		     &( internal_volume->catalog_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_volume->catalog_index = catalog_index;
+		catalog_index                  = NULL;
+
+		/* A parent index that was read from the catalog B-tree file before is kept
+		 */
+		if( internal_volume->parent_index == NULL )
+		{
+			internal_volume->parent_index = parent_index;
+			parent_index                  = NULL;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( parent_index != NULL )
+	{
+		if( libfshfs_parent_index_free(
+		     &parent_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a catalog index file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_write_catalog_index(
+     libfshfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfshfs_volume_write_catalog_index";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_write_catalog_index_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write catalog index: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes a catalog index file
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_write_catalog_index_wide(
+     libfshfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libfshfs_volume_write_catalog_index_wide";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     wide_string_length(
+	      filename ) + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+		goto on_error;
+	}
+	if( libfshfs_volume_write_catalog_index_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write catalog index: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes a catalog index file using a Basic File IO (bfio) handle
+ * The catalog index is read from the catalog B-tree file if no catalog index was read before
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_write_catalog_index_file_io_handle(
+     libfshfs_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libfshfs_catalog_index_t *catalog_index     = NULL;
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_write_catalog_index_file_io_handle";
+	int file_io_handle_is_open                  = 0;
+	int file_io_handle_opened_in_library        = 0;
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle_opened_in_library = 1;
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+	else
+#endif
+	{
+		if( libfshfs_internal_volume_get_catalog_index(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     &catalog_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve catalog index.",
+			 function );
+
+			result = -1;
+		}
+		else if( libfshfs_catalog_index_write_file_io_handle(
+		          catalog_index,
+		          file_io_handle,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write catalog index.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			result = -1;
+		}
+#endif
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads the CNID index
+ * The CNID index is an in-memory hash table of the location of the catalog record
+ * of every directory and file, that is read in a single pass over the catalog
+ * B-tree leaf nodes. Once read it is used to retrieve file entries by identifier.
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_read_cnid_index(
+     libfshfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_read_cnid_index";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->cnid_index == NULL )
+	{
+		if( libfshfs_cnid_index_initialize(
+		     &( internal_volume->cnid_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create CNID index.",
+			 function );
+
+			result = -1;
+		}
+		else if( libfshfs_cnid_index_read_btree_file(
+		          internal_volume->cnid_index,
+		          internal_volume->volume_header,
+		          internal_volume->catalog_btree_file,
+		          internal_volume->file_io_handle,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read CNID index from catalog B-tree file.",
+			 function );
+
+			libfshfs_cnid_index_free(
+			 &( internal_volume->cnid_index ),
+			 NULL );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the parent index
+ * The parent index contains the location of the first catalog record and the number
+ * of children of every parent, that is read in a single pass over the catalog B-tree
+ * leaf nodes. File entries that are retrieved after the parent index was read use it
+ * to read sub file entries directly from the catalog B-tree leaf nodes.
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_volume_read_parent_index(
+     libfshfs_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libfshfs_internal_volume_t *internal_volume = NULL;
+	static char *function                       = "libfshfs_volume_read_parent_index";
+	int result                                  = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->parent_index == NULL )
+	{
+		if( libfshfs_parent_index_initialize(
+		     &( internal_volume->parent_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent index.",
+			 function );
+
+			result = -1;
+		}
+		else if( libfshfs_parent_index_read_btree_file(
+		          internal_volume->parent_index,
+		          internal_volume->volume_header,
+		          internal_volume->catalog_btree_file,
+		          internal_volume->file_io_handle,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read parent index from catalog B-tree file.",
+			 function );
+
+			libfshfs_parent_index_free(
+			 &( internal_volume->parent_index ),
+			 NULL );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the block owner index
+ * The block owner index is read from the volume header, catalog and extents (overflow)
+ * B-tree files if no block owner index was read before
+ * Returns 1 if successful or -1 on error
+ */
+int libfshfs_internal_volume_get_block_owner_index(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error )
+{
+	libfshfs_fork_descriptor_t *fork_descriptors[ 5 ];
+	uint32_t fork_identifiers[ 5 ];
+	static char *function = "libfshfs_internal_volume_get_block_owner_index";
+	int fork_index        = 0;
+
+	if( internal_volume == NULL )
 	{
-		libfshfs_btree_file_free(
-		 &( internal_volume->catalog_btree_file ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
 	}
 	if( internal_volume->volume_header == NULL )
 	{
-		libfshfs_volume_header_free(
-		 &( internal_volume->volume_header ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_owner_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block owner index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->block_owner_index == NULL )
+	{
+		if( libfshfs_block_owner_index_initialize(
+		     &( internal_volume->block_owner_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block owner index.",
+			 function );
+
+			goto on_error;
+		}
+		/* The first 8 extents of the special files are stored in the volume header
+		 */
+		fork_descriptors[ 0 ] = internal_volume->volume_header->allocation_file_fork_descriptor;
+		fork_descriptors[ 1 ] = internal_volume->volume_header->extents_file_fork_descriptor;
+		fork_descriptors[ 2 ] = internal_volume->volume_header->catalog_file_fork_descriptor;
+		fork_descriptors[ 3 ] = internal_volume->volume_header->attributes_file_fork_descriptor;
+		fork_descriptors[ 4 ] = internal_volume->volume_header->startup_file_fork_descriptor;
+
+		fork_identifiers[ 0 ] = LIBFSHFS_ALLOCATION_FILE_IDENTIFIER;
+		fork_identifiers[ 1 ] = LIBFSHFS_EXTENTS_FILE_IDENTIFIER;
+		fork_identifiers[ 2 ] = LIBFSHFS_CATALOG_FILE_IDENTIFIER;
+		fork_identifiers[ 3 ] = LIBFSHFS_ATTRIBUTES_FILE_IDENTIFIER;
+		fork_identifiers[ 4 ] = LIBFSHFS_STARTUP_FILE_IDENTIFIER;
+
+		for( fork_index = 0;
+		     fork_index < 5;
+		     fork_index++ )
+		{
+			if( fork_descriptors[ fork_index ] == NULL )
+			{
+				continue;
+			}
+			if( libfshfs_block_owner_index_append_fork_descriptor(
+			     internal_volume->block_owner_index,
+			     fork_descriptors[ fork_index ],
+			     fork_identifiers[ fork_index ],
+			     LIBFSHFS_FORK_TYPE_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extents of fork: %d.",
+				 function,
+				 fork_index );
+
+				goto on_error;
+			}
+		}
+		if( internal_volume->catalog_btree_file != NULL )
+		{
+			if( libfshfs_block_owner_index_read_btree_file(
+			     internal_volume->block_owner_index,
+			     internal_volume->catalog_btree_file,
+			     file_io_handle,
+			     internal_volume->volume_header->catalog_file_fork_descriptor,
+			     LIBFSHFS_BTREE_FILE_TYPE_CATALOG,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block owner index from catalog B-tree file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( internal_volume->extents_btree_file != NULL )
+		{
+			if( libfshfs_block_owner_index_read_btree_file(
+			     internal_volume->block_owner_index,
+			     internal_volume->extents_btree_file,
+			     file_io_handle,
+			     internal_volume->volume_header->extents_file_fork_descriptor,
+			     LIBFSHFS_BTREE_FILE_TYPE_EXTENTS,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block owner index from extents B-tree file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libfshfs_block_owner_index_sort(
+		     internal_volume->block_owner_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sort block owner index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*block_owner_index = internal_volume->block_owner_index;
+
+	return( 1 );
+
+on_error:
+	if( internal_volume->block_owner_index != NULL )
+	{
+		libfshfs_block_owner_index_free(
+		 &( internal_volume->block_owner_index ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Retrieves the size of the UTF-8 encoded name
- * The returned size includes the end of string character
+/* Reads the block owner index
+ * The block owner index maps allocation block ranges to the fork that owns them and
+ * is read in a single pass over the catalog and extents (overflow) B-tree files.
  * Returns 1 if successful or -1 on error
  */
-int libfshfs_volume_get_utf8_name_size(
+int libfshfs_volume_read_block_owner_index(
      libfshfs_volume_t *volume,
-     size_t *utf8_string_size,
      libcerror_error_t **error )
 {
-	libfshfs_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libfshfs_volume_get_utf8_name_size";
-	int result                                  = 1;
+	libfshfs_block_owner_index_t *block_owner_index = NULL;
+	libfshfs_internal_volume_t *internal_volume     = NULL;
+	static char *function                           = "libfshfs_volume_read_block_owner_index";
+	int result                                      = 1;
 
 	if( volume == NULL )
 	{
@@ -1145,8 +5062,19 @@ int libfshfs_volume_get_utf8_name_size(
 	}
 	internal_volume = (libfshfs_internal_volume_t *) volume;
 
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1154,28 +5082,29 @@ int libfshfs_volume_get_utf8_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfshfs_directory_entry_get_utf8_name_size(
-	     internal_volume->root_directory_entry,
-	     utf8_string_size,
+	if( libfshfs_internal_volume_get_block_owner_index(
+	     internal_volume,
+	     internal_volume->file_io_handle,
+	     &block_owner_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 string size.",
+		 "%s: unable to retrieve block owner index.",
 		 function );
 
 		result = -1;
 	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1183,7 +5112,7 @@ int libfshfs_volume_get_utf8_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1192,19 +5121,25 @@ int libfshfs_volume_get_utf8_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-8 encoded name
- * The size should include the end of string character
- * Returns 1 if successful or -1 on error
+/* Retrieves the owner of a specific allocation block
+ * The owner is the identifier (CNID) and fork type of the fork that contains the block
+ * and the offset of the block relative to the start of the fork
+ * The block owner index is read if no block owner index was read before
+ * Returns 1 if successful, 0 if the block is not owned or -1 on error
  */
-int libfshfs_volume_get_utf8_name(
+int libfshfs_volume_get_block_owner(
      libfshfs_volume_t *volume,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
+     uint32_t block_number,
+     uint32_t *identifier,
+     uint8_t *fork_type,
+     uint64_t *fork_offset,
      libcerror_error_t **error )
 {
-	libfshfs_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libfshfs_volume_get_utf8_name";
-	int result                                  = 1;
+	libfshfs_block_owner_index_t *block_owner_index = NULL;
+	libfshfs_block_owner_index_entry_t *entry       = NULL;
+	libfshfs_internal_volume_t *internal_volume     = NULL;
+	static char *function                           = "libfshfs_volume_get_block_owner";
+	int result                                      = 0;
 
 	if( volume == NULL )
 	{
@@ -1219,82 +5154,63 @@ int libfshfs_volume_get_utf8_name(
 	}
 	internal_volume = (libfshfs_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libfshfs_directory_entry_get_utf8_name(
-	     internal_volume->root_directory_entry,
-	     utf8_string,
-	     utf8_string_size,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 string.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( identifier == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the size of the UTF-16 encoded name
- * The returned size includes the end of string character
- * Returns 1 if successful or -1 on error
- */
-int libfshfs_volume_get_utf16_name_size(
-     libfshfs_volume_t *volume,
-     size_t *utf16_string_size,
-     libcerror_error_t **error )
-{
-	libfshfs_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libfshfs_volume_get_utf16_name_size";
-	int result                                  = 1;
-
-	if( volume == NULL )
+	if( fork_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid fork type.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libfshfs_internal_volume_t *) volume;
+	if( fork_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fork offset.",
+		 function );
 
+		return( -1 );
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1302,28 +5218,55 @@ int libfshfs_volume_get_utf16_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfshfs_directory_entry_get_utf16_name_size(
-	     internal_volume->root_directory_entry,
-	     utf16_string_size,
+	if( libfshfs_internal_volume_get_block_owner_index(
+	     internal_volume,
+	     internal_volume->file_io_handle,
+	     &block_owner_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 string size.",
+		 "%s: unable to retrieve block owner index.",
 		 function );
 
 		result = -1;
 	}
+	else
+	{
+		result = libfshfs_block_owner_index_get_entry_by_block_number(
+		          block_owner_index,
+		          block_number,
+		          &entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block owner index entry of block: %" PRIu32 ".",
+			 function,
+			 block_number );
+		}
+		else if( result != 0 )
+		{
+			*identifier  = entry->identifier;
+			*fork_type   = entry->fork_type;
+			*fork_offset = (uint64_t) ( entry->fork_block_number + ( block_number - entry->start_block_number ) )
+			             * internal_volume->io_handle->allocation_block_size;
+		}
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1331,7 +5274,7 @@ int libfshfs_volume_get_utf16_name_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1340,19 +5283,29 @@ int libfshfs_volume_get_utf16_name_size(
 	return( result );
 }
 
-/* Retrieves the UTF-16 encoded name
- * The size should include the end of string character
- * Returns 1 if successful or -1 on error
+/* Retrieves the file entry of a specific identifier (CNID)
+ * The CNID index is used if it was read before, otherwise the catalog index is used
+ * The catalog index is read from the catalog B-tree file if no catalog index was read before
+ * An index entry that does not refer to a catalog record of the identifier is removed
+ * and the catalog B-tree file is searched instead
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libfshfs_volume_get_utf16_name(
+int libfshfs_volume_get_file_entry_by_identifier(
      libfshfs_volume_t *volume,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     uint32_t identifier,
+     libfshfs_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
-	libfshfs_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libfshfs_volume_get_utf16_name";
-	int result                                  = 1;
+	libfshfs_catalog_index_t *catalog_index             = NULL;
+	libfshfs_directory_entry_t *directory_entry         = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfshfs_internal_volume_t *internal_volume         = NULL;
+	static char *function                               = "libfshfs_volume_get_file_entry_by_identifier";
+	uint32_t directory_entry_identifier                 = 0;
+	uint32_t node_number                                = 0;
+	uint32_t parent_identifier                          = 0;
+	uint16_t record_index                               = 0;
+	int result                                          = 0;
 
 	if( volume == NULL )
 	{
@@ -1365,10 +5318,32 @@ int libfshfs_volume_get_utf16_name(
 
 		return( -1 );
 	}
-	internal_volume = (libfshfs_internal_volume_t *) volume;
-
+	internal_volume = (libfshfs_internal_volume_t *) volume;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1376,29 +5351,228 @@ int libfshfs_volume_get_utf16_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libfshfs_directory_entry_get_utf16_name(
-	     internal_volume->root_directory_entry,
-	     utf16_string,
-	     utf16_string_size,
-	     error ) != 1 )
+	if( internal_volume->cnid_index != NULL )
+	{
+		result = libfshfs_cnid_index_get_entry_by_identifier(
+		          internal_volume->cnid_index,
+		          identifier,
+		          &node_number,
+		          &record_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve CNID index entry: %" PRIu32 ".",
+			 function,
+			 identifier );
+		}
+	}
+	else if( libfshfs_internal_volume_get_catalog_index(
+	          internal_volume,
+	          internal_volume->file_io_handle,
+	          &catalog_index,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 string.",
+		 "%s: unable to retrieve catalog index.",
 		 function );
 
 		result = -1;
 	}
+	else
+	{
+		result = libfshfs_catalog_index_get_entry_by_identifier(
+		          catalog_index,
+		          identifier,
+		          &parent_identifier,
+		          &node_number,
+		          &record_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve catalog index entry: %" PRIu32 ".",
+			 function,
+			 identifier );
+		}
+	}
+	if( result == 1 )
+	{
+		result = libfshfs_catalog_btree_file_get_directory_entry_by_record(
+		          internal_volume->catalog_btree_file,
+		          internal_volume->file_io_handle,
+		          node_number,
+		          record_index,
+		          NULL,
+		          &directory_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory entry: %" PRIu32 " from catalog B-tree node: %" PRIu32 " record: %" PRIu16 ".",
+			 function,
+			 identifier,
+			 node_number,
+			 record_index );
+		}
+		else if( result == 1 )
+		{
+			if( libfshfs_directory_entry_get_identifier(
+			     directory_entry,
+			     &directory_entry_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve directory entry identifier.",
+				 function );
+
+				result = -1;
+			}
+			else if( directory_entry_identifier != identifier )
+			{
+				if( libfshfs_directory_entry_free(
+				     &directory_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free directory entry.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					result = 0;
+				}
+			}
+		}
+		/* The index entry no longer refers to the catalog record of the identifier,
+		 * for example if the catalog B-tree was modified after the index was created,
+		 * hence the index entry is removed and the catalog B-tree is searched instead
+		 */
+		if( result == 0 )
+		{
+			if( internal_volume->cnid_index != NULL )
+			{
+				result = libfshfs_cnid_index_remove_entry(
+				          internal_volume->cnid_index,
+				          identifier,
+				          error );
+			}
+			else
+			{
+				result = libfshfs_catalog_index_remove_entry(
+				          catalog_index,
+				          identifier,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove index entry: %" PRIu32 ".",
+				 function,
+				 identifier );
+			}
+			else
+			{
+				result = libfshfs_catalog_btree_file_get_directory_entry(
+				          internal_volume->catalog_btree_file,
+				          internal_volume->file_io_handle,
+				          identifier,
+				          &directory_entry,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve directory entry: %" PRIu32 " from catalog B-tree file.",
+					 function,
+					 identifier );
+				}
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		if( libfshfs_file_entry_initialize(
+		     file_entry,
+		     directory_entry,
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     internal_volume->catalog_btree_file,
+		     internal_volume->extents_btree_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			internal_file_entry = (libfshfs_internal_file_entry_t *) *file_entry;
+
+			internal_file_entry->parent_index = internal_volume->parent_index;
+			internal_file_entry->path_cache   = internal_volume->path_cache;
+		}
+	}
+	/* The file entry holds its own reference to the directory entry
+	 */
+	if( directory_entry != NULL )
+	{
+		if( libfshfs_directory_entry_free(
+		     &directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entry.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1406,26 +5580,51 @@ int libfshfs_volume_get_utf16_name(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
+	if( result == -1 )
+	{
+		if( *file_entry != NULL )
+		{
+			libfshfs_file_entry_free(
+			 file_entry,
+			 NULL );
+		}
+		if( directory_entry != NULL )
+		{
+			libfshfs_directory_entry_free(
+			 &directory_entry,
+			 NULL );
+		}
+	}
 	return( result );
 }
 
-/* Retrieves the root directory file entry
+/* Exports the data forks of multiple file entries to file descriptors
+ * The data of all file entries is read in order of its offset in the volume,
+ * so that the volume is read once in ascending order instead of file by file
+ * The data of a file entry is written at the corresponding offset of its file descriptor,
+ * hence the file descriptors must support writing at an offset
  * Returns 1 if successful or -1 on error
  */
-int libfshfs_volume_get_root_directory(
+int libfshfs_volume_export_file_entries_to_fds(
      libfshfs_volume_t *volume,
-     libfshfs_file_entry_t **file_entry,
+     libfshfs_file_entry_t **file_entries,
+     int *file_descriptors,
+     int number_of_file_entries,
      libcerror_error_t **error )
 {
-	libfshfs_internal_volume_t *internal_volume = NULL;
-	static char *function                       = "libfshfs_volume_get_root_directory";
-	int result                                  = 1;
+	libfshfs_export_planner_t *export_planner           = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor         = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfshfs_internal_volume_t *internal_volume         = NULL;
+	static char *function                               = "libfshfs_volume_export_file_entries_to_fds";
+	int entry_index                                     = 0;
+	int result                                          = 1;
 
 	if( volume == NULL )
 	{
@@ -1440,41 +5639,178 @@ int libfshfs_volume_get_root_directory(
 	}
 	internal_volume = (libfshfs_internal_volume_t *) volume;
 
-	if( internal_volume->root_directory_entry == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing root directory entry.",
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_entry == NULL )
+	if( file_entries == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 "%s: invalid file entries.",
 		 function );
 
 		return( -1 );
 	}
-	if( *file_entry != NULL )
+	if( file_descriptors == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file entry value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_file_entries < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of file entries value less than zero.",
 		 function );
 
 		return( -1 );
 	}
+	if( libfshfs_export_planner_initialize(
+	     &export_planner,
+	     internal_volume->io_handle->maximum_read_gap_size,
+	     LIBFSHFS_EXPORT_PLANNER_MAXIMUM_READ_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create export planner.",
+		 function );
+
+		goto on_error;
+	}
+	/* The fork descriptor of a file entry, which includes the overflow extents,
+	 * is created on first access and therefore retrieved while holding the lock of the file entry
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_file_entries;
+	     entry_index++ )
+	{
+		internal_file_entry = (libfshfs_internal_file_entry_t *) file_entries[ entry_index ];
+
+		if( internal_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid file entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( internal_file_entry->io_handle != internal_volume->io_handle )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid file entry: %d - not part of volume.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( internal_file_entry->directory_entry == NULL )
+		{
+			continue;
+		}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libfshfs_internal_file_entry_get_fork_descriptor(
+		          internal_file_entry,
+		          LIBFSHFS_FORK_TYPE_DATA,
+		          &fork_descriptor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data fork descriptor of file entry: %d.",
+			 function,
+			 entry_index );
+		}
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_file_entry->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result == -1 )
+		{
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( libfshfs_export_planner_append_fork(
+		     export_planner,
+		     fork_descriptor,
+		     internal_volume->io_handle->allocation_block_size,
+		     file_descriptors[ entry_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data fork of file entry: %d to export planner.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	result = 1;
+
+#if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1482,30 +5818,29 @@ int libfshfs_volume_get_root_directory(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( libfshfs_file_entry_initialize(
-	     file_entry,
-	     internal_volume->root_directory_entry,
+	if( libfshfs_export_planner_export(
+	     export_planner,
+	     internal_volume->io_handle,
 	     internal_volume->file_io_handle,
-	     internal_volume->catalog_btree_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file entry.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to export file entries.",
 		 function );
 
 		result = -1;
 	}
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1513,12 +5848,34 @@ int libfshfs_volume_get_root_directory(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
 #endif
+	if( libfshfs_export_planner_free(
+	     &export_planner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free export planner.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
+
+on_error:
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( -1 );
 }
 
@@ -25,13 +25,27 @@
 #include <common.h>
 #include <types.h>
 
+#include "libfshfs_allocation_bitmap.h"
+#include "libfshfs_block_cache.h"
+#include "libfshfs_block_owner_index.h"
 #include "libfshfs_btree_file.h"
+#include "libfshfs_buffer_pool.h"
+#include "libfshfs_catalog_index.h"
+#include "libfshfs_cnid_index.h"
+#include "libfshfs_direct_io.h"
 #include "libfshfs_directory_entry.h"
 #include "libfshfs_extern.h"
+#include "libfshfs_fork_descriptor.h"
 #include "libfshfs_io_handle.h"
+#include "libfshfs_io_thread_pool.h"
+#include "libfshfs_journal.h"
+#include "libfshfs_kernel_copy.h"
 #include "libfshfs_libbfio.h"
+#include "libfshfs_libcdata.h"
 #include "libfshfs_libcerror.h"
 #include "libfshfs_libcthreads.h"
+#include "libfshfs_parent_index.h"
+#include "libfshfs_path_cache.h"
 #include "libfshfs_types.h"
 #include "libfshfs_volume_header.h"
 
@@ -59,10 +73,50 @@ struct libfshfs_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* Value to indicate if the journal should be replayed
+	 */
+	uint8_t replay_journal;
+
 	/* The volume header
 	 */
 	libfshfs_volume_header_t *volume_header;
 
+	/* The journal
+	 */
+	libfshfs_journal_t *journal;
+
+	/* The I/O thread pool
+	 */
+	libfshfs_io_thread_pool_t *io_thread_pool;
+
+	/* The block cache
+	 */
+	libfshfs_block_cache_t *block_cache;
+
+	/* The buffer pool
+	 */
+	libfshfs_buffer_pool_t *buffer_pool;
+
+	/* The direct I/O
+	 */
+	libfshfs_direct_io_t *direct_io;
+
+	/* The kernel copy, which is used to export file data without passing it through user space
+	 */
+	libfshfs_kernel_copy_t *kernel_copy;
+
+	/* The allocation bitmap
+	 */
+	libfshfs_allocation_bitmap_t *allocation_bitmap;
+
+	/* The metadata extents array
+	 */
+	libcdata_array_t *metadata_extents_array;
+
+	/* The extents (overflow) btree file
+	 */
+	libfshfs_btree_file_t *extents_btree_file;
+
 	/* The catalog btree file
 	 */
 	libfshfs_btree_file_t *catalog_btree_file;
@@ -71,6 +125,26 @@ struct libfshfs_internal_volume
 	 */
 	libfshfs_directory_entry_t *root_directory_entry;
 
+	/* The catalog index
+	 */
+	libfshfs_catalog_index_t *catalog_index;
+
+	/* The CNID index
+	 */
+	libfshfs_cnid_index_t *cnid_index;
+
+	/* The parent index
+	 */
+	libfshfs_parent_index_t *parent_index;
+
+	/* The block owner index
+	 */
+	libfshfs_block_owner_index_t *block_owner_index;
+
+	/* The path cache
+	 */
+	libfshfs_path_cache_t *path_cache;
+
 #if defined( HAVE_LIBFSHFS_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -93,6 +167,25 @@ int libfshfs_volume_signal_abort(
      libfshfs_volume_t *volume,
      libcerror_error_t **error );
 
+LIBFSHFS_EXTERN \
+int libfshfs_volume_set_maximum_read_gap_size(
+     libfshfs_volume_t *volume,
+     size_t maximum_read_gap_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_set_number_of_read_threads(
+     libfshfs_volume_t *volume,
+     int number_of_read_threads,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_set_block_cache_budget(
+     libfshfs_volume_t *volume,
+     int block_cache_partition,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
 LIBFSHFS_EXTERN \
 int libfshfs_volume_open(
      libfshfs_volume_t *volume,
@@ -129,6 +222,17 @@ int libfshfs_internal_volume_open_read(
      off64_t file_offset,
      libcerror_error_t **error );
 
+int libfshfs_internal_volume_get_special_files_overflow_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_read_journal(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
 LIBFSHFS_EXTERN \
 int libfshfs_volume_get_utf8_name_size(
      libfshfs_volume_t *volume,
@@ -161,6 +265,163 @@ int libfshfs_volume_get_root_directory(
      libfshfs_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_allocation_block_size(
+     libfshfs_volume_t *volume,
+     uint32_t *allocation_block_size,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_number_of_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_get_allocation_bitmap(
+     libfshfs_internal_volume_t *internal_volume,
+     libfshfs_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_number_of_allocated_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_allocated_blocks,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_number_of_unallocated_blocks(
+     libfshfs_volume_t *volume,
+     uint32_t *number_of_unallocated_blocks,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_allocation_block_run(
+     libfshfs_volume_t *volume,
+     uint32_t block_number,
+     uint32_t *number_of_blocks,
+     uint8_t *is_allocated,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_append_fork_metadata_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libcdata_array_t *extents_array,
+     libfshfs_fork_descriptor_t *fork_descriptor,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_read_metadata_extents(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_number_of_metadata_extents(
+     libfshfs_volume_t *volume,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_metadata_extent_by_index(
+     libfshfs_volume_t *volume,
+     int extent_index,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_get_catalog_index(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_catalog_index_t **catalog_index,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_catalog_index(
+     libfshfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_catalog_index_wide(
+     libfshfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_catalog_index_file_io_handle(
+     libfshfs_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_write_catalog_index(
+     libfshfs_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_write_catalog_index_wide(
+     libfshfs_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_write_catalog_index_file_io_handle(
+     libfshfs_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_cnid_index(
+     libfshfs_volume_t *volume,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_parent_index(
+     libfshfs_volume_t *volume,
+     libcerror_error_t **error );
+
+int libfshfs_internal_volume_get_block_owner_index(
+     libfshfs_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libfshfs_block_owner_index_t **block_owner_index,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_read_block_owner_index(
+     libfshfs_volume_t *volume,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_block_owner(
+     libfshfs_volume_t *volume,
+     uint32_t block_number,
+     uint32_t *identifier,
+     uint8_t *fork_type,
+     uint64_t *fork_offset,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_get_file_entry_by_identifier(
+     libfshfs_volume_t *volume,
+     uint32_t identifier,
+     libfshfs_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+LIBFSHFS_EXTERN \
+int libfshfs_volume_export_file_entries_to_fds(
+     libfshfs_volume_t *volume,
+     libfshfs_file_entry_t **file_entries,
+     int *file_descriptors,
+     int number_of_file_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -473,10 +473,30 @@ int libfshfs_volume_header_read_data(
 
 		return( -1 );
 	}
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_volume_header_t *) data )->attribute_flags,
+	 volume_header->attribute_flags );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_volume_header_t *) data )->journal_information_block_number,
+	 volume_header->journal_information_block_number );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_volume_header_t *) data )->modification_time,
+	 volume_header->modification_time );
+
 	byte_stream_copy_to_uint32_big_endian(
 	 ( (fshfs_volume_header_t *) data )->allocation_block_size,
 	 volume_header->allocation_block_size );
 
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_volume_header_t *) data )->number_of_blocks,
+	 volume_header->number_of_blocks );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (fshfs_volume_header_t *) data )->volume_write_count,
+	 volume_header->volume_write_count );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -494,15 +514,12 @@ int libfshfs_volume_header_read_data(
 		 function,
 		 value_16bit );
 
-		byte_stream_copy_to_uint32_big_endian(
-		 ( (fshfs_volume_header_t *) data )->attribute_flags,
-		 value_32bit );
 		libcnotify_printf(
 		 "%s: attribute flags\t\t\t: 0x%08" PRIx32 "\n",
 		 function,
-		 value_32bit );
+		 volume_header->attribute_flags );
 		libfshfs_debug_print_volume_attribute_flags(
-		 value_32bit );
+		 volume_header->attribute_flags );
 		libcnotify_printf(
 		 "\n" );
 
@@ -514,13 +531,10 @@ int libfshfs_volume_header_read_data(
 		 ( (fshfs_volume_header_t *) data )->last_mounted_version[ 2 ],
 		 ( (fshfs_volume_header_t *) data )->last_mounted_version[ 3 ] );
 
-		byte_stream_copy_to_uint32_big_endian(
-		 ( (fshfs_volume_header_t *) data )->journal_information_block_number,
-		 value_32bit );
 		libcnotify_printf(
 		 "%s: journal information block number\t: %" PRIu32 "\n",
 		 function,
-		 value_32bit );
+		 volume_header->journal_information_block_number );
 
 		if( libfshfs_debug_print_hfs_time_value(
 		     function,
@@ -615,13 +629,10 @@ int libfshfs_volume_header_read_data(
 		 function,
 		 volume_header->allocation_block_size );
 
-		byte_stream_copy_to_uint32_big_endian(
-		 ( (fshfs_volume_header_t *) data )->number_of_blocks,
-		 value_32bit );
 		libcnotify_printf(
 		 "%s: number of blocks\t\t\t: %" PRIu32 "\n",
 		 function,
-		 value_32bit );
+		 volume_header->number_of_blocks );
 
 		byte_stream_copy_to_uint32_big_endian(
 		 ( (fshfs_volume_header_t *) data )->number_of_unused_blocks,
@@ -655,13 +666,10 @@ int libfshfs_volume_header_read_data(
 		 function,
 		 value_32bit );
 
-		byte_stream_copy_to_uint32_big_endian(
-		 ( (fshfs_volume_header_t *) data )->volume_write_count,
-		 value_32bit );
 		libcnotify_printf(
 		 "%s: volume write count\t\t\t: %" PRIu32 "\n",
 		 function,
-		 value_32bit );
+		 volume_header->volume_write_count );
 
 		libcnotify_printf(
 		 "%s: encodings bitmap:\n",
@@ -41,10 +41,30 @@ struct libfshfs_volume_header
 	 */
 	uint8_t file_system_type;
 
+	/* The attribute flags
+	 */
+	uint32_t attribute_flags;
+
+	/* The journal information block number
+	 */
+	uint32_t journal_information_block_number;
+
+	/* The modification time
+	 */
+	uint32_t modification_time;
+
 	/* The allocation block size
 	 */
 	uint32_t allocation_block_size;
 
+	/* The number of (allocation) blocks
+	 */
+	uint32_t number_of_blocks;
+
+	/* The volume write count
+	 */
+	uint32_t volume_write_count;
+
 	/* Allocation file fork descriptor
 	 */
 	libfshfs_fork_descriptor_t *allocation_file_fork_descriptor;
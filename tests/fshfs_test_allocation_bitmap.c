@@ -0,0 +1,1454 @@
+/*
+ * Library allocation_bitmap type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_allocation_bitmap.h"
+#include "../libfshfs/libfshfs_fork_descriptor.h"
+#include "../libfshfs/libfshfs_io_handle.h"
+
+uint8_t fshfs_test_allocation_bitmap_data1[ 24 ] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_allocation_bitmap_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_initialize(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libfshfs_allocation_bitmap_t *allocation_bitmap = NULL;
+	libfshfs_fork_descriptor_t fork_descriptor;
+	int result                                      = 0;
+
+	fork_descriptor.size = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_initialize(
+	          NULL,
+	          NULL,
+	          &fork_descriptor,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	allocation_bitmap = (libfshfs_allocation_bitmap_t *) 0x12345678UL;
+
+	result = libfshfs_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          NULL,
+	          &fork_descriptor,
+	          0,
+	          &error );
+
+	allocation_bitmap = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the number of blocks exceeds the allocation file size
+	 */
+	result = libfshfs_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          NULL,
+	          &fork_descriptor,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_population_count function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_population_count(
+     void )
+{
+	uint32_t population_count = 0;
+
+	/* Test regular cases
+	 */
+	population_count = libfshfs_allocation_bitmap_get_population_count(
+	                    0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "population_count",
+	 population_count,
+	 (uint32_t) 0 );
+
+	population_count = libfshfs_allocation_bitmap_get_population_count(
+	                    0xffffffffffffffffULL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "population_count",
+	 population_count,
+	 (uint32_t) 64 );
+
+	population_count = libfshfs_allocation_bitmap_get_population_count(
+	                    0x8000000100000081ULL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "population_count",
+	 population_count,
+	 (uint32_t) 4 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_number_of_leading_zero_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_number_of_leading_zero_bits(
+     void )
+{
+	uint8_t number_of_bits = 0;
+
+	/* Test regular cases
+	 */
+	number_of_bits = libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+	                  0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint8_t) 64 );
+
+	number_of_bits = libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+	                  0x8000000000000000ULL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint8_t) 0 );
+
+	number_of_bits = libfshfs_allocation_bitmap_get_number_of_leading_zero_bits(
+	                  0x0000000000000001ULL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint8_t) 63 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_number_of_set_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_number_of_set_bits(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	uint32_t number_of_set_bits = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_allocation_bitmap_get_number_of_set_bits(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          &number_of_set_bits,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 (uint32_t) 78 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with data that is not a multitude of 8
+	 */
+	result = libfshfs_allocation_bitmap_get_number_of_set_bits(
+	          fshfs_test_allocation_bitmap_data1,
+	          10,
+	          &number_of_set_bits,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_set_bits",
+	 number_of_set_bits,
+	 (uint32_t) 76 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_get_number_of_set_bits(
+	          NULL,
+	          24,
+	          &number_of_set_bits,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_number_of_set_bits(
+	          fshfs_test_allocation_bitmap_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &number_of_set_bits,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_number_of_set_bits(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_run_in_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_run_in_data(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t number_of_bits  = 0;
+	uint8_t bit_value        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          0,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint32_t) 76 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          70,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint32_t) 6 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          76,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint32_t) 108 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 (uint8_t) 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          185,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint32_t) 6 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "bit_value",
+	 bit_value,
+	 (uint8_t) 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a bit index that is out of bounds
+	 */
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          192,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          NULL,
+	          24,
+	          0,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          10,
+	          0,
+	          &number_of_bits,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          0,
+	          NULL,
+	          &bit_value,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_run_in_data(
+	          fshfs_test_allocation_bitmap_data1,
+	          24,
+	          0,
+	          &number_of_bits,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_read_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_read_chunk(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          1024 * 1024,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "allocation_bitmap->chunk_data_offset",
+	 (int64_t) allocation_bitmap->chunk_data_offset,
+	 (int64_t) 1024 * 1024 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "allocation_bitmap->chunk_data_size",
+	 allocation_bitmap->chunk_data_size,
+	 (size_t) 16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->chunk_data[ 3 ]",
+	 allocation_bitmap->chunk_data[ 3 ],
+	 (uint8_t) 0xff );
+
+	/* Test if the bits of blocks beyond the number of blocks are cleared
+	 */
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->chunk_data[ 15 ]",
+	 allocation_bitmap->chunk_data[ 15 ],
+	 (uint8_t) 0xf8 );
+
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "allocation_bitmap->chunk_data_offset",
+	 (int64_t) allocation_bitmap->chunk_data_offset,
+	 (int64_t) 0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "allocation_bitmap->chunk_data_size",
+	 allocation_bitmap->chunk_data_size,
+	 (size_t) 1024 * 1024 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->chunk_data[ 8 ]",
+	 allocation_bitmap->chunk_data[ 8 ],
+	 (uint8_t) 0xc0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->chunk_data[ 1048575 ]",
+	 allocation_bitmap->chunk_data[ 1048575 ],
+	 (uint8_t) 0xff );
+
+	/* Test reading the chunk that is already read
+	 */
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "allocation_bitmap->chunk_data_offset",
+	 (int64_t) allocation_bitmap->chunk_data_offset,
+	 (int64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          -1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the chunk data offset is not aligned to a chunk
+	 */
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          8,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the chunk data offset is beyond the end of the bitmap
+	 */
+	result = libfshfs_allocation_bitmap_read_chunk(
+	          allocation_bitmap,
+	          file_io_handle,
+	          2 * 1024 * 1024,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_number_of_allocated_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_number_of_allocated_blocks(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle )
+{
+	libcerror_error_t *error            = NULL;
+	uint32_t number_of_allocated_blocks = 0;
+	int result                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+	          allocation_bitmap,
+	          file_io_handle,
+	          &number_of_allocated_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_allocated_blocks",
+	 number_of_allocated_blocks,
+	 (uint32_t) 135 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+	          NULL,
+	          file_io_handle,
+	          &number_of_allocated_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_number_of_allocated_blocks(
+	          allocation_bitmap,
+	          file_io_handle,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_allocation_bitmap_get_block_run function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_allocation_bitmap_get_block_run(
+     libfshfs_allocation_bitmap_t *allocation_bitmap,
+     libbfio_handle_t *file_io_handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint32_t number_of_blocks = 0;
+	uint8_t is_allocated      = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          0,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 66 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run that starts inside a 64-bit word and crosses the word boundary
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          60,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 6 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          66,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 8388510 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run that crosses the chunk boundary
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          8388576,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 64 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run that starts in the last chunk
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          8388640,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 88 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run that ends at the last block in a partial last byte
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          8388728,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 5 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 (uint8_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a block number that is out of bounds
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          8388733,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          NULL,
+	          file_io_handle,
+	          0,
+	          &number_of_blocks,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          0,
+	          NULL,
+	          &is_allocated,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_allocation_bitmap_get_block_run(
+	          allocation_bitmap,
+	          file_io_handle,
+	          0,
+	          &number_of_blocks,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+	libfshfs_fork_descriptor_t fork_descriptor;
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libfshfs_allocation_bitmap_t *allocation_bitmap = NULL;
+	libfshfs_io_handle_t *io_handle                 = NULL;
+	uint8_t *allocation_file_data                   = NULL;
+	int result                                      = 0;
+#endif
+
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_initialize",
+	 fshfs_test_allocation_bitmap_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_free",
+	 fshfs_test_allocation_bitmap_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_get_population_count",
+	 fshfs_test_allocation_bitmap_get_population_count );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_get_number_of_leading_zero_bits",
+	 fshfs_test_allocation_bitmap_get_number_of_leading_zero_bits );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_get_number_of_set_bits",
+	 fshfs_test_allocation_bitmap_get_number_of_set_bits );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_allocation_bitmap_get_run_in_data",
+	 fshfs_test_allocation_bitmap_get_run_in_data );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize allocation bitmap for tests
+	 * The allocation file consists of 257 allocation blocks of 4096 bytes
+	 * and contains a bitmap of 1048592 bytes for 8388733 blocks, which spans
+	 * 2 chunks and of which the last byte is partially used. The bitmap has
+	 * allocated runs at blocks 0 - 65, 8388576 - 8388639 and 8388728 - 8388732
+	 */
+	allocation_file_data = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * 257 * 4096 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_file_data",
+	 allocation_file_data );
+
+	memory_set(
+	 allocation_file_data,
+	 0,
+	 sizeof( uint8_t ) * 257 * 4096 );
+
+	memory_set(
+	 allocation_file_data,
+	 0xff,
+	 sizeof( uint8_t ) * 8 );
+
+	allocation_file_data[ 8 ] = 0xc0;
+
+	memory_set(
+	 &( allocation_file_data[ 1048572 ] ),
+	 0xff,
+	 sizeof( uint8_t ) * 8 );
+
+	/* The bits of the 3 blocks beyond the number of blocks are set as well
+	 */
+	allocation_file_data[ 1048591 ] = 0xff;
+
+	result = libfshfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->allocation_block_size = 4096;
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          allocation_file_data,
+	          257 * 4096,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &fork_descriptor,
+	 0,
+	 sizeof( libfshfs_fork_descriptor_t ) );
+
+	fork_descriptor.size              = 257 * 4096;
+	fork_descriptor.extents[ 0 ][ 0 ] = 0;
+	fork_descriptor.extents[ 0 ][ 1 ] = 257;
+
+	result = libfshfs_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          io_handle,
+	          &fork_descriptor,
+	          8388733,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_RUN_WITH_ARGS(
+	 "libfshfs_allocation_bitmap_read_chunk",
+	 fshfs_test_allocation_bitmap_read_chunk,
+	 allocation_bitmap,
+	 file_io_handle );
+
+	FSHFS_TEST_RUN_WITH_ARGS(
+	 "libfshfs_allocation_bitmap_get_number_of_allocated_blocks",
+	 fshfs_test_allocation_bitmap_get_number_of_allocated_blocks,
+	 allocation_bitmap,
+	 file_io_handle );
+
+	FSHFS_TEST_RUN_WITH_ARGS(
+	 "libfshfs_allocation_bitmap_get_block_run",
+	 fshfs_test_allocation_bitmap_get_block_run,
+	 allocation_bitmap,
+	 file_io_handle );
+
+	/* Clean up
+	 */
+	result = libfshfs_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 allocation_file_data );
+
+	allocation_file_data = NULL;
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libfshfs_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfshfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( allocation_file_data != NULL )
+	{
+		memory_free(
+		 allocation_file_data );
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_FAILURE );
+}
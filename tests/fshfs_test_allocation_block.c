@@ -57,6 +57,7 @@ int fshfs_test_allocation_block_initialize(
 	 */
 	result = libfshfs_allocation_block_initialize(
 	          &allocation_block,
+	          NULL,
 	          4096,
 	          &error );
 
@@ -93,6 +94,7 @@ int fshfs_test_allocation_block_initialize(
 	/* Test error cases
 	 */
 	result = libfshfs_allocation_block_initialize(
+	          NULL,
 	          NULL,
 	          4096,
 	          &error );
@@ -113,6 +115,7 @@ int fshfs_test_allocation_block_initialize(
 
 	result = libfshfs_allocation_block_initialize(
 	          &allocation_block,
+	          NULL,
 	          4096,
 	          &error );
 
@@ -132,6 +135,7 @@ int fshfs_test_allocation_block_initialize(
 
 	result = libfshfs_allocation_block_initialize(
 	          &allocation_block,
+	          NULL,
 	          (size_t) SSIZE_MAX + 1,
 	          &error );
 
@@ -159,6 +163,7 @@ int fshfs_test_allocation_block_initialize(
 
 		result = libfshfs_allocation_block_initialize(
 		          &allocation_block,
+		          NULL,
 		          4096,
 		          &error );
 
@@ -202,6 +207,7 @@ int fshfs_test_allocation_block_initialize(
 
 		result = libfshfs_allocation_block_initialize(
 		          &allocation_block,
+		          NULL,
 		          4096,
 		          &error );
 
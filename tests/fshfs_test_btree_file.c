@@ -306,6 +306,7 @@ int fshfs_test_btree_file_read(
 	          NULL,
 	          NULL,
 	          0,
+	          LIBFSHFS_BLOCK_CACHE_PARTITION_CATALOG,
 	          &error );
 
 	FSHFS_TEST_ASSERT_EQUAL_INT(
@@ -325,6 +326,7 @@ int fshfs_test_btree_file_read(
 	          NULL,
 	          NULL,
 	          0,
+	          LIBFSHFS_BLOCK_CACHE_PARTITION_CATALOG,
 	          &error );
 
 	FSHFS_TEST_ASSERT_EQUAL_INT(
@@ -57,6 +57,7 @@ int fshfs_test_btree_node_initialize(
 	 */
 	result = libfshfs_btree_node_initialize(
 	          &btree_node,
+	          NULL,
 	          128,
 	          &error );
 
@@ -93,6 +94,7 @@ int fshfs_test_btree_node_initialize(
 	/* Test error cases
 	 */
 	result = libfshfs_btree_node_initialize(
+	          NULL,
 	          NULL,
 	          128,
 	          &error );
@@ -113,6 +115,7 @@ int fshfs_test_btree_node_initialize(
 
 	result = libfshfs_btree_node_initialize(
 	          &btree_node,
+	          NULL,
 	          128,
 	          &error );
 
@@ -132,6 +135,7 @@ int fshfs_test_btree_node_initialize(
 
 	result = libfshfs_btree_node_initialize(
 	          &btree_node,
+	          NULL,
 	          (size_t) SSIZE_MAX + 1,
 	          &error );
 
@@ -159,6 +163,7 @@ int fshfs_test_btree_node_initialize(
 
 		result = libfshfs_btree_node_initialize(
 		          &btree_node,
+		          NULL,
 		          128,
 		          &error );
 
@@ -202,6 +207,7 @@ int fshfs_test_btree_node_initialize(
 
 		result = libfshfs_btree_node_initialize(
 		          &btree_node,
+		          NULL,
 		          128,
 		          &error );
 
@@ -0,0 +1,2489 @@
+/*
+ * Library catalog_index type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_catalog_index.h"
+#include "../libfshfs/libfshfs_parent_index.h"
+#include "../libfshfs/libfshfs_path_cache.h"
+#include "../libfshfs/libfshfs_volume_header.h"
+
+uint8_t fshfs_test_catalog_index_data1[ 168 ] = {
+	0x66, 0x73, 0x68, 0x66, 0x73, 0x63, 0x69, 0x78, 0x03, 0x00, 0x00, 0x00, 0x44, 0x33, 0x22, 0x11,
+	0x05, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x11, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00,
+	0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x72, 0x00, 0x74, 0x00, 0x66, 0x00, 0x64 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_catalog_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 1;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	catalog_index = (libfshfs_catalog_index_t *) 0x12345678UL;
+
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	catalog_index = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_catalog_index_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_catalog_index_initialize(
+		          &catalog_index,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( catalog_index != NULL )
+			{
+				libfshfs_catalog_index_free(
+				 &catalog_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "catalog_index",
+			 catalog_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_catalog_index_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_catalog_index_initialize(
+		          &catalog_index,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( catalog_index != NULL )
+			{
+				libfshfs_catalog_index_free(
+				 &catalog_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "catalog_index",
+			 catalog_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_compare_entry_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_compare_entry_data(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_compare_entry_data(
+	          &( fshfs_test_catalog_index_data1[ 48 ] ),
+	          &( fshfs_test_catalog_index_data1[ 72 ] ) );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libfshfs_catalog_index_compare_entry_data(
+	          &( fshfs_test_catalog_index_data1[ 96 ] ),
+	          &( fshfs_test_catalog_index_data1[ 72 ] ) );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_catalog_index_compare_entry_data(
+	          &( fshfs_test_catalog_index_data1[ 72 ] ),
+	          &( fshfs_test_catalog_index_data1[ 72 ] ) );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_read_file_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_read_file_header_data(
+     void )
+{
+	uint8_t file_header_data[ 48 ];
+
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          fshfs_test_catalog_index_data1,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->volume_modification_time",
+	 catalog_index->volume_modification_time,
+	 (uint32_t) 0x11223344UL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->volume_write_count",
+	 catalog_index->volume_write_count,
+	 (uint32_t) 5 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT64(
+	 "catalog_index->catalog_file_size",
+	 catalog_index->catalog_file_size,
+	 (uint64_t) 4096 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->number_of_entries",
+	 catalog_index->number_of_entries,
+	 (uint32_t) 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->number_of_parent_entries",
+	 catalog_index->number_of_parent_entries,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->names_data_size",
+	 catalog_index->names_data_size,
+	 (uint32_t) 8 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "catalog_index->data_size",
+	 catalog_index->data_size,
+	 (size_t) 168 );
+
+	/* Test the file header data written matches the file header data read
+	 */
+	result = libfshfs_catalog_index_write_file_header_data(
+	          catalog_index,
+	          file_header_data,
+	          48,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          file_header_data,
+	          fshfs_test_catalog_index_data1,
+	          48 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_read_file_header_data(
+	          NULL,
+	          fshfs_test_catalog_index_data1,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          NULL,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          fshfs_test_catalog_index_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          fshfs_test_catalog_index_data1,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where signature is invalid
+	 */
+	file_header_data[ 0 ] = 0xff;
+
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          file_header_data,
+	          48,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_set_data function and the lookup functions
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_set_data(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	uint8_t *data                           = NULL;
+	uint32_t node_number                    = 0;
+	uint32_t parent_identifier              = 0;
+	uint16_t record_index                   = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 168 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_copy(
+	          data,
+	          fshfs_test_catalog_index_data1,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          167,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog index now manages the data
+	 */
+	data = NULL;
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          catalog_index,
+	          16,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "node_number",
+	 node_number,
+	 (uint32_t) 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "record_index",
+	 record_index,
+	 (uint16_t) 2 );
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          catalog_index,
+	          3,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          NULL,
+	          16,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_read_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_read_file_io_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize file IO handle
+	 */
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fshfs_test_catalog_index_data1,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_read_file_io_handle(
+	          catalog_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->number_of_entries",
+	 catalog_index->number_of_entries,
+	 (uint32_t) 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "catalog_index->data_size",
+	 catalog_index->data_size,
+	 (size_t) 168 );
+
+	result = memory_compare(
+	          catalog_index->data,
+	          fshfs_test_catalog_index_data1,
+	          168 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_read_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_file_io_handle(
+	          catalog_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO handle
+	 */
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the catalog index file is truncated
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fshfs_test_catalog_index_data1,
+	          167,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_read_file_io_handle(
+	          catalog_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_write_file_io_handle function
+ * The written catalog index file is read back to test the round trip
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_write_file_io_handle(
+     void )
+{
+	uint8_t file_data[ 168 ];
+
+	libbfio_handle_t *file_io_handle        = NULL;
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	libfshfs_catalog_index_t *read_index    = NULL;
+	uint8_t *data                           = NULL;
+	uint32_t node_number                    = 0;
+	uint32_t parent_identifier              = 0;
+	uint16_t record_index                   = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 168 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_copy(
+	          data,
+	          fshfs_test_catalog_index_data1,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog index now manages the data
+	 */
+	data = NULL;
+
+	/* Initialize file IO handle
+	 */
+	result = memory_set(
+	          file_data,
+	          0,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          file_data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ_WRITE,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_write_file_io_handle(
+	          catalog_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          file_data,
+	          fshfs_test_catalog_index_data1,
+	          168 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test the catalog index read matches the catalog index written
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &read_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_read_file_io_handle(
+	          read_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "read_index->data_size",
+	 read_index->data_size,
+	 catalog_index->data_size );
+
+	result = memory_compare(
+	          read_index->data,
+	          catalog_index->data,
+	          catalog_index->data_size );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          read_index,
+	          17,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "record_index",
+	 record_index,
+	 (uint16_t) 3 );
+
+	result = libfshfs_catalog_index_free(
+	          &read_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_write_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_initialize(
+	          &read_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_write_file_io_handle(
+	          read_index,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_free(
+	          &read_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up file IO handle
+	 */
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( read_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &read_index,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_matches_volume_header function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_matches_volume_header(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	libfshfs_volume_header_t *volume_header = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_read_file_header_data(
+	          catalog_index,
+	          fshfs_test_catalog_index_data1,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_volume_header_initialize(
+	          &volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_header",
+	 volume_header );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	volume_header->modification_time                  = 0x11223344UL;
+	volume_header->volume_write_count                 = 5;
+	volume_header->catalog_file_fork_descriptor->size = 4096;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a volume that was modified after the catalog index was created
+	 */
+	volume_header->volume_write_count = 6;
+
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	volume_header->volume_write_count = 5;
+	volume_header->modification_time  = 0x11223345UL;
+
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	volume_header->modification_time                  = 0x11223344UL;
+	volume_header->catalog_file_fork_descriptor->size = 8192;
+
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_matches_volume_header(
+	          NULL,
+	          volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_matches_volume_header(
+	          catalog_index,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_volume_header_free(
+	          &volume_header,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "volume_header",
+	 volume_header );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_header != NULL )
+	{
+		libfshfs_volume_header_free(
+		 &volume_header,
+		 NULL );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_read_parent_index function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_read_parent_index(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	libfshfs_parent_index_entry_t *entry    = NULL;
+	libfshfs_parent_index_t *parent_index   = NULL;
+	uint8_t *data                           = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 168 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_copy(
+	          data,
+	          fshfs_test_catalog_index_data1,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog index now manages the data
+	 */
+	data = NULL;
+
+	result = libfshfs_parent_index_initialize(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_read_parent_index(
+	          catalog_index,
+	          parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_index->number_of_entries",
+	 parent_index->number_of_entries,
+	 (uint32_t) 2 );
+
+	result = libfshfs_parent_index_get_entry_by_parent_identifier(
+	          parent_index,
+	          2,
+	          &entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "entry",
+	 entry );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "entry->node_number",
+	 entry->node_number,
+	 (uint32_t) 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "entry->record_index",
+	 entry->record_index,
+	 (uint16_t) 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "entry->number_of_records",
+	 entry->number_of_records,
+	 (uint32_t) 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "entry->number_of_children",
+	 entry->number_of_children,
+	 (uint32_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_read_parent_index(
+	          NULL,
+	          parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_parent_index(
+	          catalog_index,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_parent_index(
+	          catalog_index,
+	          parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_parent_index_free(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_read_path_cache function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_read_path_cache(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	libfshfs_path_cache_t *path_cache       = NULL;
+	const uint8_t *name                     = NULL;
+	uint8_t *data                           = NULL;
+	uint32_t parent_identifier              = 0;
+	uint16_t name_size                      = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 168 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_copy(
+	          data,
+	          fshfs_test_catalog_index_data1,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog index now manages the data
+	 */
+	data = NULL;
+
+	result = libfshfs_path_cache_initialize(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_read_path_cache(
+	          catalog_index,
+	          path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          17,
+	          &parent_identifier,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "name_size",
+	 name_size,
+	 (uint16_t) 2 );
+
+	result = memory_compare(
+	          name,
+	          &( fshfs_test_catalog_index_data1[ 166 ] ),
+	          2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Files are not added to the path cache
+	 */
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          16,
+	          &parent_identifier,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_read_path_cache(
+	          NULL,
+	          path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_catalog_index_read_path_cache(
+	          catalog_index,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		libfshfs_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_catalog_index_remove_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_catalog_index_remove_entry(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libfshfs_catalog_index_t *catalog_index = NULL;
+	uint8_t *data                           = NULL;
+	uint32_t node_number                    = 0;
+	uint32_t number_of_entries              = 0;
+	uint32_t parent_identifier              = 0;
+	uint16_t record_index                   = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_catalog_index_initialize(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * 168 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = memory_copy(
+	          data,
+	          fshfs_test_catalog_index_data1,
+	          168 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_catalog_index_set_data(
+	          catalog_index,
+	          data,
+	          168,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The catalog index now manages the data
+	 */
+	data = NULL;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_catalog_index_remove_entry(
+	          catalog_index,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "catalog_index->number_of_entries",
+	 catalog_index->number_of_entries,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "catalog_index->data_size",
+	 catalog_index->data_size,
+	 (size_t) 144 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( catalog_index->data[ 20 ] ),
+	 number_of_entries );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_entries",
+	 number_of_entries,
+	 (uint32_t) 2 );
+
+	/* Test the parent entries and names data that follow the entries are moved
+	 */
+	result = memory_compare(
+	          catalog_index->parent_entries_data,
+	          &( fshfs_test_catalog_index_data1[ 120 ] ),
+	          48 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          catalog_index,
+	          16,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          catalog_index,
+	          17,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "record_index",
+	 record_index,
+	 (uint16_t) 3 );
+
+	result = libfshfs_catalog_index_remove_entry(
+	          catalog_index,
+	          17,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_get_entry_by_identifier(
+	          catalog_index,
+	          2,
+	          &parent_identifier,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_catalog_index_remove_entry(
+	          catalog_index,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_catalog_index_remove_entry(
+	          NULL,
+	          2,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_catalog_index_free(
+	          &catalog_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "catalog_index",
+	 catalog_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( catalog_index != NULL )
+	{
+		libfshfs_catalog_index_free(
+		 &catalog_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_initialize",
+	 fshfs_test_catalog_index_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_free",
+	 fshfs_test_catalog_index_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_compare_entry_data",
+	 fshfs_test_catalog_index_compare_entry_data );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_read_file_header_data",
+	 fshfs_test_catalog_index_read_file_header_data );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_set_data",
+	 fshfs_test_catalog_index_set_data );
+
+	/* TODO: add tests for libfshfs_catalog_index_read_btree_file */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_read_file_io_handle",
+	 fshfs_test_catalog_index_read_file_io_handle );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_write_file_io_handle",
+	 fshfs_test_catalog_index_write_file_io_handle );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_matches_volume_header",
+	 fshfs_test_catalog_index_matches_volume_header );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_read_parent_index",
+	 fshfs_test_catalog_index_read_parent_index );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_read_path_cache",
+	 fshfs_test_catalog_index_read_path_cache );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_catalog_index_remove_entry",
+	 fshfs_test_catalog_index_remove_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
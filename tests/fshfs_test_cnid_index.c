@@ -0,0 +1,1037 @@
+/*
+ * Library cnid_index type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_cnid_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_cnid_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_cnid_index_t *cnid_index = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_cnid_index_free(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	cnid_index = (libfshfs_cnid_index_t *) 0x12345678UL;
+
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	cnid_index = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_cnid_index_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_cnid_index_initialize(
+		          &cnid_index,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( cnid_index != NULL )
+			{
+				libfshfs_cnid_index_free(
+				 &cnid_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "cnid_index",
+			 cnid_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_cnid_index_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_cnid_index_initialize(
+		          &cnid_index,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( cnid_index != NULL )
+			{
+				libfshfs_cnid_index_free(
+				 &cnid_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "cnid_index",
+			 cnid_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cnid_index != NULL )
+	{
+		libfshfs_cnid_index_free(
+		 &cnid_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_cnid_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_cnid_index_resize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_resize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_cnid_index_t *cnid_index = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_cnid_index_resize(
+	          cnid_index,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "cnid_index->maximum_number_of_entries",
+	 cnid_index->maximum_number_of_entries,
+	 (uint32_t) 16 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_resize(
+	          NULL,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_cnid_index_resize(
+	          cnid_index,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_cnid_index_resize(
+	          cnid_index,
+	          24,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_cnid_index_free(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cnid_index != NULL )
+	{
+		libfshfs_cnid_index_free(
+		 &cnid_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_cnid_index_insert_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_insert_entry(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_cnid_index_t *cnid_index = NULL;
+	uint32_t identifier               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier++ )
+	{
+		result = libfshfs_cnid_index_insert_entry(
+		          cnid_index,
+		          identifier,
+		          identifier / 16,
+		          (uint16_t) ( identifier % 16 ),
+		          0x0002,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "cnid_index->number_of_entries",
+	 cnid_index->number_of_entries,
+	 (uint32_t) 2000 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "cnid_index->maximum_number_of_entries",
+	 cnid_index->maximum_number_of_entries,
+	 (uint32_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_insert_entry(
+	          NULL,
+	          1,
+	          0,
+	          0,
+	          0x0002,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_cnid_index_insert_entry(
+	          cnid_index,
+	          0,
+	          0,
+	          0,
+	          0x0002,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfshfs_cnid_index_insert_entry with an identifier that already was inserted
+	 */
+	result = libfshfs_cnid_index_insert_entry(
+	          cnid_index,
+	          16,
+	          0,
+	          0,
+	          0x0002,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_cnid_index_free(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cnid_index != NULL )
+	{
+		libfshfs_cnid_index_free(
+		 &cnid_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_cnid_index_get_entry_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_get_entry_by_identifier(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_cnid_index_t *cnid_index = NULL;
+	uint32_t identifier               = 0;
+	uint32_t node_number              = 0;
+	uint16_t record_index             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier++ )
+	{
+		result = libfshfs_cnid_index_insert_entry(
+		          cnid_index,
+		          identifier * 3,
+		          identifier / 16,
+		          (uint16_t) ( identifier % 16 ),
+		          0x0001,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier++ )
+	{
+		result = libfshfs_cnid_index_get_entry_by_identifier(
+		          cnid_index,
+		          identifier * 3,
+		          &node_number,
+		          &record_index,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSHFS_TEST_ASSERT_EQUAL_UINT32(
+		 "node_number",
+		 node_number,
+		 identifier / 16 );
+
+		FSHFS_TEST_ASSERT_EQUAL_UINT16(
+		 "record_index",
+		 record_index,
+		 (uint16_t) ( identifier % 16 ) );
+	}
+	result = libfshfs_cnid_index_get_entry_by_identifier(
+	          cnid_index,
+	          4,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_cnid_index_get_entry_by_identifier(
+	          cnid_index,
+	          0,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_get_entry_by_identifier(
+	          NULL,
+	          3,
+	          &node_number,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_cnid_index_get_entry_by_identifier(
+	          cnid_index,
+	          3,
+	          NULL,
+	          &record_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_cnid_index_get_entry_by_identifier(
+	          cnid_index,
+	          3,
+	          &node_number,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_cnid_index_free(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cnid_index != NULL )
+	{
+		libfshfs_cnid_index_free(
+		 &cnid_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_cnid_index_remove_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_cnid_index_remove_entry(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_cnid_index_t *cnid_index = NULL;
+	uint32_t identifier               = 0;
+	uint32_t node_number              = 0;
+	uint16_t record_index             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_cnid_index_initialize(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier++ )
+	{
+		result = libfshfs_cnid_index_insert_entry(
+		          cnid_index,
+		          identifier * 3,
+		          identifier / 16,
+		          (uint16_t) ( identifier % 16 ),
+		          0x0001,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier += 2 )
+	{
+		result = libfshfs_cnid_index_remove_entry(
+		          cnid_index,
+		          identifier * 3,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "cnid_index->number_of_entries",
+	 cnid_index->number_of_entries,
+	 (uint32_t) 1000 );
+
+	/* Test that the remaining entries can still be retrieved
+	 */
+	for( identifier = 1;
+	     identifier <= 2000;
+	     identifier++ )
+	{
+		result = libfshfs_cnid_index_get_entry_by_identifier(
+		          cnid_index,
+		          identifier * 3,
+		          &node_number,
+		          &record_index,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 (int) ( ( identifier % 2 ) == 0 ) );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			FSHFS_TEST_ASSERT_EQUAL_UINT32(
+			 "node_number",
+			 node_number,
+			 identifier / 16 );
+
+			FSHFS_TEST_ASSERT_EQUAL_UINT16(
+			 "record_index",
+			 record_index,
+			 (uint16_t) ( identifier % 16 ) );
+		}
+	}
+	result = libfshfs_cnid_index_remove_entry(
+	          cnid_index,
+	          3,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_cnid_index_remove_entry(
+	          cnid_index,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_cnid_index_remove_entry(
+	          NULL,
+	          6,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_cnid_index_free(
+	          &cnid_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "cnid_index",
+	 cnid_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cnid_index != NULL )
+	{
+		libfshfs_cnid_index_free(
+		 &cnid_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_initialize",
+	 fshfs_test_cnid_index_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_free",
+	 fshfs_test_cnid_index_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_resize",
+	 fshfs_test_cnid_index_resize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_insert_entry",
+	 fshfs_test_cnid_index_insert_entry );
+
+	/* TODO: add tests for libfshfs_cnid_index_read_btree_file */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_get_entry_by_identifier",
+	 fshfs_test_cnid_index_get_entry_by_identifier );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_cnid_index_remove_entry",
+	 fshfs_test_cnid_index_remove_entry );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
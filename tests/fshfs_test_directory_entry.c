@@ -293,10 +293,14 @@ int main(
 	 "libfshfs_directory_entry_initialize",
 	 fshfs_test_directory_entry_initialize );
 
+	/* TODO: add tests for libfshfs_directory_entry_initialize_in_memory_arena */
+
 	FSHFS_TEST_RUN(
 	 "libfshfs_directory_entry_free",
 	 fshfs_test_directory_entry_free );
 
+	/* TODO: add tests for libfshfs_directory_entry_reference */
+
 	/* TODO: add tests for libfshfs_directory_entry_get_identifier */
 
 	/* TODO: add tests for libfshfs_directory_entry_get_utf8_name_size */
@@ -307,6 +311,8 @@ int main(
 
 	/* TODO: add tests for libfshfs_directory_entry_get_utf16_name */
 
+	/* TODO: add tests for libfshfs_directory_entry_get_stat */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
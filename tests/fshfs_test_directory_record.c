@@ -324,6 +324,31 @@ int fshfs_test_directory_record_read_data(
 	 "error",
 	 error );
 
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "directory_record->identifier",
+	 directory_record->identifier,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "directory_record->modification_time",
+	 directory_record->modification_time,
+	 (uint32_t) 0xc9d3e8efUL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "directory_record->access_time",
+	 directory_record->access_time,
+	 (uint32_t) 0xc9d3e8eeUL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "directory_record->group_identifier",
+	 directory_record->group_identifier,
+	 (uint32_t) 99 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "directory_record->file_mode",
+	 directory_record->file_mode,
+	 (uint16_t) 0x41fd );
+
 	/* Test error cases
 	 */
 	result = libfshfs_directory_record_read_data(
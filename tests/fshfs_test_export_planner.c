@@ -0,0 +1,1622 @@
+/*
+ * Library export_planner type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_export_planner.h"
+#include "../libfshfs/libfshfs_fork_descriptor.h"
+#include "../libfshfs/libfshfs_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_export_planner_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_initialize(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libfshfs_export_planner_t *export_planner = NULL;
+	int result                                = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests           = 1;
+	int number_of_memset_fail_tests           = 1;
+	int test_number                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_export_planner_free(
+	          &export_planner,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_initialize(
+	          NULL,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	export_planner = (libfshfs_export_planner_t *) 0x12345678UL;
+
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          65536,
+	          4194304,
+	          &error );
+
+	export_planner = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          65536,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_export_planner_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_export_planner_initialize(
+		          &export_planner,
+		          65536,
+		          4194304,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( export_planner != NULL )
+			{
+				libfshfs_export_planner_free(
+				 &export_planner,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "export_planner",
+			 export_planner );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_export_planner_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_export_planner_initialize(
+		          &export_planner,
+		          65536,
+		          4194304,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( export_planner != NULL )
+			{
+				libfshfs_export_planner_free(
+				 &export_planner,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "export_planner",
+			 export_planner );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_export_planner_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_export_planner_compare_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_compare_ranges(
+     void )
+{
+	libfshfs_export_planner_range_t first_range;
+	libfshfs_export_planner_range_t second_range;
+
+	int result = 0;
+
+	first_range.volume_offset  = 4096;
+	second_range.volume_offset = 8192;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_export_planner_compare_ranges(
+	          &first_range,
+	          &second_range );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libfshfs_export_planner_compare_ranges(
+	          &second_range,
+	          &first_range );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_export_planner_compare_ranges(
+	          &first_range,
+	          &first_range );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_export_planner_append_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_append_range(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libfshfs_export_planner_t *export_planner = NULL;
+	int range_index                           = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( range_index = 0;
+	     range_index < 96;
+	     range_index++ )
+	{
+		result = libfshfs_export_planner_append_range(
+		          export_planner,
+		          (off64_t) ( 96 - range_index ) * 4096,
+		          (off64_t) range_index * 4096,
+		          4096,
+		          1,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 96 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 95 ].volume_offset",
+	 (int64_t) export_planner->ranges[ 95 ].volume_offset,
+	 (int64_t) 4096 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 95 ].destination_offset",
+	 (int64_t) export_planner->ranges[ 95 ].destination_offset,
+	 (int64_t) 95 * 4096 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_append_range(
+	          NULL,
+	          0,
+	          0,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          -1,
+	          0,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          0,
+	          -1,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          0,
+	          0,
+	          0,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          0,
+	          0,
+	          4194304 + 1,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          0,
+	          0,
+	          4096,
+	          -1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_export_planner_free(
+	          &export_planner,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_export_planner_append_fork function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_append_fork(
+     void )
+{
+	libfshfs_fork_descriptor_t fork_descriptor;
+
+	libcerror_error_t *error                  = NULL;
+	libfshfs_export_planner_t *export_planner = NULL;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          65536,
+	          16384,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &fork_descriptor,
+	 0,
+	 sizeof( libfshfs_fork_descriptor_t ) );
+
+	/* A fork of 2 extents where the first extent is split into 2 ranges
+	 * and the last allocation block is partially used
+	 */
+	fork_descriptor.size              = 24576 + 1000;
+	fork_descriptor.extents[ 0 ][ 0 ] = 100;
+	fork_descriptor.extents[ 0 ][ 1 ] = 5;
+	fork_descriptor.extents[ 1 ][ 0 ] = 10;
+	fork_descriptor.extents[ 1 ][ 1 ] = 2;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 1 ].volume_offset",
+	 (int64_t) export_planner->ranges[ 1 ].volume_offset,
+	 (int64_t) 104 * 4096 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "export_planner->ranges[ 1 ].size",
+	 export_planner->ranges[ 1 ].size,
+	 (size_t) 4096 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 2 ].destination_offset",
+	 (int64_t) export_planner->ranges[ 2 ].destination_offset,
+	 (int64_t) 20480 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "export_planner->ranges[ 2 ].size",
+	 export_planner->ranges[ 2 ].size,
+	 (size_t) 4096 + 1000 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_append_fork(
+	          NULL,
+	          &fork_descriptor,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          NULL,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          0,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          4096,
+	          -1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with data beyond the extents of the fork descriptor
+	 */
+	fork_descriptor.size = 65536;
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_export_planner_free(
+	          &export_planner,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_export_planner_get_run function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_get_run(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libfshfs_export_planner_t *export_planner = NULL;
+	size_t run_size                           = 0;
+	off64_t run_offset                        = 0;
+	int last_range_index                      = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          4096,
+	          65536,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Ranges sorted by volume offset: 2 ranges with a gap of 4096 bytes
+	 * followed by a range with a gap of 8192 bytes
+	 */
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          0,
+	          0,
+	          8192,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          12288,
+	          0,
+	          4096,
+	          2,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          24576,
+	          8192,
+	          4096,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          0,
+	          &last_range_index,
+	          &run_offset,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "last_range_index",
+	 last_range_index,
+	 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "run_offset",
+	 (int64_t) run_offset,
+	 (int64_t) 0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 16384 );
+
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          2,
+	          &last_range_index,
+	          &run_offset,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "last_range_index",
+	 last_range_index,
+	 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "run_offset",
+	 (int64_t) run_offset,
+	 (int64_t) 24576 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_get_run(
+	          NULL,
+	          0,
+	          &last_range_index,
+	          &run_offset,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          3,
+	          &last_range_index,
+	          &run_offset,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          0,
+	          NULL,
+	          &run_offset,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          0,
+	          &last_range_index,
+	          NULL,
+	          &run_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_get_run(
+	          export_planner,
+	          0,
+	          &last_range_index,
+	          &run_offset,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_export_planner_free(
+	          &export_planner,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_PWRITE )
+
+/* Tests the libfshfs_export_planner_export function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_export_planner_export(
+     void )
+{
+	libfshfs_fork_descriptor_t fork_descriptor;
+	uint8_t data[ 8192 ];
+	uint8_t expected_export_data[ 1636 ];
+	uint8_t export_data[ 1636 ];
+
+	libbfio_handle_t *file_io_handle          = NULL;
+	libcerror_error_t *error                  = NULL;
+	libfshfs_export_planner_t *export_planner = NULL;
+	libfshfs_io_handle_t *io_handle           = NULL;
+	FILE *file_stream                         = NULL;
+	size_t data_offset                        = 0;
+	size_t read_count                         = 0;
+	int file_descriptor                       = -1;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 8192;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = libfshfs_export_planner_initialize(
+	          &export_planner,
+	          2048,
+	          8192,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          8192,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_stream = tmpfile();
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	file_descriptor = fileno(
+	                   file_stream );
+
+	memory_set(
+	 &fork_descriptor,
+	 0,
+	 sizeof( libfshfs_fork_descriptor_t ) );
+
+	/* A fork of 3 extents of which the physical order differs from the logical order
+	 * and the last allocation block is partially used
+	 */
+	fork_descriptor.size              = 1536 + 100;
+	fork_descriptor.extents[ 0 ][ 0 ] = 12;
+	fork_descriptor.extents[ 0 ][ 1 ] = 1;
+	fork_descriptor.extents[ 1 ][ 0 ] = 2;
+	fork_descriptor.extents[ 1 ][ 1 ] = 2;
+	fork_descriptor.extents[ 2 ][ 0 ] = 8;
+	fork_descriptor.extents[ 2 ][ 1 ] = 1;
+
+	result = memory_copy(
+	          &( expected_export_data[ 0 ] ),
+	          &( data[ 12 * 512 ] ),
+	          512 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_copy(
+	          &( expected_export_data[ 512 ] ),
+	          &( data[ 2 * 512 ] ),
+	          1024 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_copy(
+	          &( expected_export_data[ 1536 ] ),
+	          &( data[ 8 * 512 ] ),
+	          100 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          512,
+	          file_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 3 );
+
+	/* Test that a fork with data beyond the extents of the fork descriptor
+	 * is reported as unsupported and that none of its ranges are planned
+	 */
+	fork_descriptor.size = 65536;
+
+	result = libfshfs_export_planner_append_fork(
+	          export_planner,
+	          &fork_descriptor,
+	          512,
+	          file_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 3 );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_export_planner_export(
+	          export_planner,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 0 );
+
+	/* The ranges were exported in physical block order
+	 */
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 0 ].volume_offset",
+	 (int64_t) export_planner->ranges[ 0 ].volume_offset,
+	 (int64_t) 2 * 512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 0 ].destination_offset",
+	 (int64_t) export_planner->ranges[ 0 ].destination_offset,
+	 (int64_t) 512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 1 ].volume_offset",
+	 (int64_t) export_planner->ranges[ 1 ].volume_offset,
+	 (int64_t) 8 * 512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 1 ].destination_offset",
+	 (int64_t) export_planner->ranges[ 1 ].destination_offset,
+	 (int64_t) 1536 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 2 ].volume_offset",
+	 (int64_t) export_planner->ranges[ 2 ].volume_offset,
+	 (int64_t) 12 * 512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "export_planner->ranges[ 2 ].destination_offset",
+	 (int64_t) export_planner->ranges[ 2 ].destination_offset,
+	 (int64_t) 0 );
+
+	/* The data of every range was written at its offset in the destination file
+	 */
+	result = file_stream_seek_offset(
+	          file_stream,
+	          0,
+	          SEEK_SET );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = file_stream_read(
+	              file_stream,
+	              export_data,
+	              1636 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "read_count",
+	 read_count,
+	 (size_t) 1636 );
+
+	result = memory_compare(
+	          export_data,
+	          expected_export_data,
+	          1636 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test export without planned ranges
+	 */
+	result = libfshfs_export_planner_export(
+	          export_planner,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_export_planner_export(
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_export_planner_export(
+	          export_planner,
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test export of a range beyond the end of the volume
+	 */
+	result = libfshfs_export_planner_append_range(
+	          export_planner,
+	          7680,
+	          0,
+	          1024,
+	          file_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_export_planner_export(
+	          export_planner,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "export_planner->number_of_ranges",
+	 export_planner->number_of_ranges,
+	 0 );
+
+	/* Clean up
+	 */
+	result = file_stream_close(
+	          file_stream );
+
+	file_stream = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_export_planner_free(
+	          &export_planner,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "export_planner",
+	 export_planner );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfshfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( export_planner != NULL )
+	{
+		libfshfs_export_planner_free(
+		 &export_planner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_PWRITE ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_initialize",
+	 fshfs_test_export_planner_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_free",
+	 fshfs_test_export_planner_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_compare_ranges",
+	 fshfs_test_export_planner_compare_ranges );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_append_range",
+	 fshfs_test_export_planner_append_range );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_append_fork",
+	 fshfs_test_export_planner_append_fork );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_get_run",
+	 fshfs_test_export_planner_get_run );
+
+#if defined( HAVE_PWRITE )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_export_planner_export",
+	 fshfs_test_export_planner_export );
+
+#endif /* defined( HAVE_PWRITE ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
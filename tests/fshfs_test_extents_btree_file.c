@@ -0,0 +1,589 @@
+/*
+ * Library extents_btree_file functions test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_extents_btree_file.h"
+#include "../libfshfs/libfshfs_fork_descriptor.h"
+
+uint8_t fshfs_test_extents_btree_file_record_data1[ 76 ] = {
+	0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_extents_btree_file_get_key_from_record_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_extents_btree_file_get_key_from_record_data(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	size_t record_data_offset   = 0;
+	uint32_t identifier         = 0;
+	uint32_t start_block_number = 0;
+	uint8_t fork_type           = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_extents_btree_file_get_key_from_record_data(
+	          fshfs_test_extents_btree_file_record_data1,
+	          76,
+	          &identifier,
+	          &fork_type,
+	          &start_block_number,
+	          &record_data_offset,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "identifier",
+	 identifier,
+	 (uint32_t) 21 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "fork_type",
+	 fork_type,
+	 (uint8_t) LIBFSHFS_FORK_TYPE_DATA );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "start_block_number",
+	 start_block_number,
+	 (uint32_t) 16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "record_data_offset",
+	 record_data_offset,
+	 (size_t) 12 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_extents_btree_file_get_key_from_record_data(
+	          NULL,
+	          76,
+	          &identifier,
+	          &fork_type,
+	          &start_block_number,
+	          &record_data_offset,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_extents_btree_file_get_key_from_record_data(
+	          fshfs_test_extents_btree_file_record_data1,
+	          8,
+	          &identifier,
+	          &fork_type,
+	          &start_block_number,
+	          &record_data_offset,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_extents_btree_file_get_key_from_record_data(
+	          fshfs_test_extents_btree_file_record_data1,
+	          76,
+	          NULL,
+	          &fork_type,
+	          &start_block_number,
+	          &record_data_offset,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_extents_btree_file_compare_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_extents_btree_file_compare_keys(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_extents_btree_file_compare_keys(
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          16,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The identifier takes precedence over the fork type and start block number
+	 */
+	result = libfshfs_extents_btree_file_compare_keys(
+	          20,
+	          LIBFSHFS_FORK_TYPE_RESOURCE,
+	          32,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* The fork type takes precedence over the start block number
+	 */
+	result = libfshfs_extents_btree_file_compare_keys(
+	          21,
+	          LIBFSHFS_FORK_TYPE_RESOURCE,
+	          8,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_extents_btree_file_compare_keys(
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          8,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_extents_btree_file_append_extents_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_extents_btree_file_append_extents_data(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t start_block_number                 = 0;
+	int extent_index                            = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_fork_descriptor_initialize(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "fork_descriptor",
+	 fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		fork_descriptor->extents[ extent_index ][ 0 ] = (uint32_t) ( 100 * ( extent_index + 1 ) );
+		fork_descriptor->extents[ extent_index ][ 1 ] = 2;
+	}
+	/* Test regular cases
+	 */
+	result = libfshfs_extents_btree_file_append_extents_data(
+	          fork_descriptor,
+	          &( fshfs_test_extents_btree_file_record_data1[ 12 ] ),
+	          64,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "fork_descriptor->number_of_overflow_extents",
+	 fork_descriptor->number_of_overflow_extents,
+	 2 );
+
+	result = libfshfs_fork_descriptor_get_extent_by_index(
+	          fork_descriptor,
+	          9,
+	          &start_block_number,
+	          &number_of_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "start_block_number",
+	 start_block_number,
+	 (uint32_t) 8192 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_extents_btree_file_append_extents_data(
+	          NULL,
+	          &( fshfs_test_extents_btree_file_record_data1[ 12 ] ),
+	          64,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_extents_btree_file_append_extents_data(
+	          fork_descriptor,
+	          &( fshfs_test_extents_btree_file_record_data1[ 12 ] ),
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_fork_descriptor_free(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &fork_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_extents_btree_file_get_overflow_extents function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_extents_btree_file_get_overflow_extents(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	int extent_index                            = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_fork_descriptor_initialize(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "fork_descriptor",
+	 fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		fork_descriptor->extents[ extent_index ][ 0 ] = (uint32_t) ( 100 * ( extent_index + 1 ) );
+		fork_descriptor->extents[ extent_index ][ 1 ] = 1;
+	}
+	fork_descriptor->number_of_blocks = 8;
+
+	/* Test regular cases
+	 */
+
+	/* The extents B-tree file is not needed when all the blocks are mapped
+	 */
+	result = libfshfs_extents_btree_file_get_overflow_extents(
+	          NULL,
+	          NULL,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_extents_btree_file_get_overflow_extents(
+	          NULL,
+	          NULL,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The extents B-tree file is needed when not all the blocks are mapped
+	 */
+	fork_descriptor->number_of_blocks = 16;
+
+	result = libfshfs_extents_btree_file_get_overflow_extents(
+	          NULL,
+	          NULL,
+	          21,
+	          LIBFSHFS_FORK_TYPE_DATA,
+	          fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_fork_descriptor_free(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &fork_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_extents_btree_file_get_key_from_record_data",
+	 fshfs_test_extents_btree_file_get_key_from_record_data );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_extents_btree_file_compare_keys",
+	 fshfs_test_extents_btree_file_compare_keys );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_extents_btree_file_append_extents_data",
+	 fshfs_test_extents_btree_file_append_extents_data );
+
+	/* TODO: add tests for libfshfs_extents_btree_file_get_extents_from_node */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_extents_btree_file_get_overflow_extents",
+	 fshfs_test_extents_btree_file_get_overflow_extents );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
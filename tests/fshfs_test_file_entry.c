@@ -21,22 +21,872 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
 #endif
 
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
 #include "fshfs_test_libcerror.h"
 #include "fshfs_test_libfshfs.h"
 #include "fshfs_test_macros.h"
 #include "fshfs_test_memory.h"
 #include "fshfs_test_unused.h"
 
+#include "../libfshfs/libfshfs_btree_file.h"
+#include "../libfshfs/libfshfs_directory_entry.h"
 #include "../libfshfs/libfshfs_file_entry.h"
+#include "../libfshfs/libfshfs_io_handle.h"
+#include "../libfshfs/libfshfs_path_cache.h"
+
+/* The names are stored as in the catalog B-tree key: UTF-16 big-endian
+ */
+uint8_t fshfs_test_file_entry_name1[ 8 ] = {
+	0x00, 0x66, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65 };
+
+uint8_t fshfs_test_file_entry_name2[ 6 ] = {
+	0x00, 0x64, 0x00, 0x69, 0x00, 0x72 };
+
+uint8_t fshfs_test_file_entry_name3[ 6 ] = {
+	0x00, 0x73, 0x00, 0x75, 0x00, 0x62 };
+
+uint8_t fshfs_test_file_entry_data1[ 512 ];
 
 #if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
 
+/* Creates the handles needed to create a file entry of "/dir/sub/file"
+ * The ancestor directories are stored in the path cache, hence the catalog B-tree file is not read
+ * Returns 1 if successful or -1 on error
+ */
+int fshfs_test_file_entry_initialize_handles(
+     libfshfs_io_handle_t **io_handle,
+     libbfio_handle_t **file_io_handle,
+     libfshfs_btree_file_t **catalog_btree_file,
+     libfshfs_path_cache_t **path_cache,
+     libfshfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "fshfs_test_file_entry_initialize_handles";
+
+	if( libfshfs_io_handle_initialize(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( fshfs_test_open_file_io_handle(
+	     file_io_handle,
+	     fshfs_test_file_entry_data1,
+	     512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_btree_file_initialize(
+	     catalog_btree_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create catalog B-tree file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_path_cache_initialize(
+	     path_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_path_cache_insert_entry(
+	     *path_cache,
+	     16,
+	     2,
+	     fshfs_test_file_entry_name2,
+	     6,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert path cache entry: 16.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_path_cache_insert_entry(
+	     *path_cache,
+	     17,
+	     16,
+	     fshfs_test_file_entry_name3,
+	     6,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert path cache entry: 17.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfshfs_directory_entry_initialize(
+	     directory_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory entry.",
+		 function );
+
+		return( -1 );
+	}
+	( *directory_entry )->name = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * 8 );
+
+	if( ( *directory_entry )->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( *directory_entry )->name,
+	     fshfs_test_file_entry_name1,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	( *directory_entry )->name_size         = 8;
+	( *directory_entry )->parent_identifier = 17;
+
+	return( 1 );
+}
+
+/* Frees the handles needed to create a file entry
+ * Returns 1 if successful or -1 on error
+ */
+int fshfs_test_file_entry_free_handles(
+     libfshfs_io_handle_t **io_handle,
+     libbfio_handle_t **file_io_handle,
+     libfshfs_btree_file_t **catalog_btree_file,
+     libfshfs_path_cache_t **path_cache,
+     libfshfs_directory_entry_t **directory_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "fshfs_test_file_entry_free_handles";
+	int result            = 1;
+
+	if( *directory_entry != NULL )
+	{
+		if( libfshfs_directory_entry_free(
+		     directory_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( *path_cache != NULL )
+	{
+		if( libfshfs_path_cache_free(
+		     path_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free path cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( *catalog_btree_file != NULL )
+	{
+		if( libfshfs_btree_file_free(
+		     catalog_btree_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free catalog B-tree file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( fshfs_test_close_file_io_handle(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( *io_handle != NULL )
+	{
+		if( libfshfs_io_handle_free(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Tests the libfshfs_file_entry_get_utf8_path function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_get_utf8_path(
+     void )
+{
+	uint8_t utf8_path[ 32 ];
+
+	libbfio_handle_t *file_io_handle                    = NULL;
+	libcerror_error_t *error                            = NULL;
+	libfshfs_btree_file_t *catalog_btree_file           = NULL;
+	libfshfs_directory_entry_t *directory_entry         = NULL;
+	libfshfs_file_entry_t *file_entry                   = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfshfs_io_handle_t *io_handle                     = NULL;
+	libfshfs_path_cache_t *path_cache                   = NULL;
+	uint8_t *path                                       = NULL;
+	size_t utf8_path_size                               = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = fshfs_test_file_entry_initialize_handles(
+	          &io_handle,
+	          &file_io_handle,
+	          &catalog_btree_file,
+	          &path_cache,
+	          &directory_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_file_entry_initialize(
+	          &file_entry,
+	          directory_entry,
+	          io_handle,
+	          file_io_handle,
+	          catalog_btree_file,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	internal_file_entry->path_cache = path_cache;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_file_entry_get_utf8_path_size(
+	          file_entry,
+	          &utf8_path_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_path_size",
+	 utf8_path_size,
+	 (size_t) 14 );
+
+	/* The path is built from the path cache on first access and cached
+	 */
+	path = internal_file_entry->path;
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path",
+	 path );
+
+	result = libfshfs_file_entry_get_utf8_path(
+	          file_entry,
+	          utf8_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf8_path,
+	          "/dir/sub/file",
+	          14 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the cached path was used
+	 */
+	FSHFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "internal_file_entry->path",
+	 (intptr_t *) internal_file_entry->path,
+	 (intptr_t *) path );
+
+	/* Test that the path is rebuilt for a new file entry of the same directory entry
+	 */
+	result = libfshfs_file_entry_free(
+	          &file_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_file_entry_initialize(
+	          &file_entry,
+	          directory_entry,
+	          io_handle,
+	          file_io_handle,
+	          catalog_btree_file,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	internal_file_entry->path_cache = path_cache;
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "internal_file_entry->path",
+	 internal_file_entry->path );
+
+	result = libfshfs_file_entry_get_utf8_path(
+	          file_entry,
+	          utf8_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf8_path,
+	          "/dir/sub/file",
+	          14 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_file_entry->path",
+	 internal_file_entry->path );
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_entry_get_utf8_path(
+	          NULL,
+	          utf8_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_file_entry_get_utf8_path(
+	          file_entry,
+	          utf8_path,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_file_entry_free(
+	          &file_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_file_entry_free_handles(
+	          &io_handle,
+	          &file_io_handle,
+	          &catalog_btree_file,
+	          &path_cache,
+	          &directory_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libfshfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	fshfs_test_file_entry_free_handles(
+	 &io_handle,
+	 &file_io_handle,
+	 &catalog_btree_file,
+	 &path_cache,
+	 &directory_entry,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libfshfs_file_entry_get_utf16_path function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_get_utf16_path(
+     void )
+{
+	uint16_t expected_utf16_path[ 14 ] = {
+		'/', 'd', 'i', 'r', '/', 's', 'u', 'b', '/', 'f', 'i', 'l', 'e', 0 };
+	uint16_t utf16_path[ 32 ];
+
+	libbfio_handle_t *file_io_handle                    = NULL;
+	libcerror_error_t *error                            = NULL;
+	libfshfs_btree_file_t *catalog_btree_file           = NULL;
+	libfshfs_directory_entry_t *directory_entry         = NULL;
+	libfshfs_file_entry_t *file_entry                   = NULL;
+	libfshfs_internal_file_entry_t *internal_file_entry = NULL;
+	libfshfs_io_handle_t *io_handle                     = NULL;
+	libfshfs_path_cache_t *path_cache                   = NULL;
+	uint8_t *path                                       = NULL;
+	size_t utf16_path_size                              = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = fshfs_test_file_entry_initialize_handles(
+	          &io_handle,
+	          &file_io_handle,
+	          &catalog_btree_file,
+	          &path_cache,
+	          &directory_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_file_entry_initialize(
+	          &file_entry,
+	          directory_entry,
+	          io_handle,
+	          file_io_handle,
+	          catalog_btree_file,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry",
+	 file_entry );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	internal_file_entry->path_cache = path_cache;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_file_entry_get_utf16_path_size(
+	          file_entry,
+	          &utf16_path_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "utf16_path_size",
+	 utf16_path_size,
+	 (size_t) 14 );
+
+	/* The path is built from the path cache on first access and cached
+	 */
+	path = internal_file_entry->path;
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path",
+	 path );
+
+	result = libfshfs_file_entry_get_utf16_path(
+	          file_entry,
+	          utf16_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf16_path,
+	          expected_utf16_path,
+	          sizeof( uint16_t ) * 14 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the cached path was used
+	 */
+	FSHFS_TEST_ASSERT_EQUAL_INTPTR(
+	 "internal_file_entry->path",
+	 (intptr_t *) internal_file_entry->path,
+	 (intptr_t *) path );
+
+	/* Test that the path is rebuilt for a new file entry of the same directory entry
+	 */
+	result = libfshfs_file_entry_free(
+	          &file_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_file_entry_initialize(
+	          &file_entry,
+	          directory_entry,
+	          io_handle,
+	          file_io_handle,
+	          catalog_btree_file,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_file_entry = (libfshfs_internal_file_entry_t *) file_entry;
+
+	internal_file_entry->path_cache = path_cache;
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "internal_file_entry->path",
+	 internal_file_entry->path );
+
+	result = libfshfs_file_entry_get_utf16_path(
+	          file_entry,
+	          utf16_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          utf16_path,
+	          expected_utf16_path,
+	          sizeof( uint16_t ) * 14 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_file_entry->path",
+	 internal_file_entry->path );
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_entry_get_utf16_path(
+	          NULL,
+	          utf16_path,
+	          32,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_file_entry_get_utf16_path(
+	          file_entry,
+	          utf16_path,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_file_entry_free(
+	          &file_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_file_entry_free_handles(
+	          &io_handle,
+	          &file_io_handle,
+	          &catalog_btree_file,
+	          &path_cache,
+	          &directory_entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libfshfs_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	fshfs_test_file_entry_free_handles(
+	 &io_handle,
+	 &file_io_handle,
+	 &catalog_btree_file,
+	 &path_cache,
+	 &directory_entry,
+	 NULL );
+
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
 
 /* Tests the libfshfs_file_entry_free function
@@ -77,6 +927,173 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfshfs_file_entry_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_get_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_entry_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_file_entry_get_resource_fork_size function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_get_resource_fork_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_entry_get_resource_fork_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_file_entry_readv function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_readv(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libfshfs_io_vector_t io_vectors[ 1 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+
+	io_vectors[ 0 ].buffer      = buffer;
+	io_vectors[ 0 ].buffer_size = 16;
+
+	/* Test error cases
+	 */
+	read_count = libfshfs_file_entry_readv(
+	              NULL,
+	              io_vectors,
+	              1,
+	              0,
+	              &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_file_entry_export_to_fd function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_entry_export_to_fd(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_entry_export_to_fd(
+	          NULL,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -110,10 +1127,60 @@ int main(
 
 	/* TODO: add tests for libfshfs_file_entry_get_utf16_name */
 
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_get_utf8_path",
+	 fshfs_test_file_entry_get_utf8_path );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_get_utf16_path",
+	 fshfs_test_file_entry_get_utf16_path );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
 	/* TODO: add tests for libfshfs_file_entry_get_number_of_sub_file_entries */
 
 	/* TODO: add tests for libfshfs_file_entry_get_sub_file_entry_by_index */
 
+	/* TODO: add tests for libfshfs_file_entry_get_stat */
+
+	/* TODO: add tests for libfshfs_file_entry_get_sub_file_entries_stat */
+
+	/* TODO: add tests for libfshfs_file_entry_get_sub_file_entries_page */
+
+	/* TODO: add tests for libfshfs_file_entry_read_buffer */
+
+	/* TODO: add tests for libfshfs_file_entry_read_buffer_at_offset */
+
+	/* TODO: add tests for libfshfs_file_entry_seek_offset */
+
+	/* TODO: add tests for libfshfs_file_entry_get_offset */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_get_size",
+	 fshfs_test_file_entry_get_size );
+
+	/* TODO: add tests for libfshfs_file_entry_read_resource_fork_buffer */
+
+	/* TODO: add tests for libfshfs_file_entry_read_resource_fork_buffer_at_offset */
+
+	/* TODO: add tests for libfshfs_file_entry_seek_resource_fork_offset */
+
+	/* TODO: add tests for libfshfs_file_entry_get_resource_fork_offset */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_get_resource_fork_size",
+	 fshfs_test_file_entry_get_resource_fork_size );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_readv",
+	 fshfs_test_file_entry_readv );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_entry_export_to_fd",
+	 fshfs_test_file_entry_export_to_fd );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -334,6 +334,45 @@ int fshfs_test_file_record_read_data(
 	 "error",
 	 error );
 
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "file_record->identifier",
+	 file_record->identifier,
+	 (uint32_t) 94 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "file_record->flags",
+	 file_record->flags,
+	 (uint16_t) 0x0002 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "file_record->modification_time",
+	 file_record->modification_time,
+	 (uint32_t) 0xc9d3e61fUL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "file_record->access_time",
+	 file_record->access_time,
+	 (uint32_t) 0xc9d3e778UL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "file_record->owner_identifier",
+	 file_record->owner_identifier,
+	 (uint32_t) 99 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "file_record->file_mode",
+	 file_record->file_mode,
+	 (uint16_t) 0x8180 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT64(
+	 "file_record->data_fork_size",
+	 file_record->data_fork_size,
+	 (uint64_t) 235 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "file_record->data_fork_descriptor",
+	 file_record->data_fork_descriptor );
+
 	/* Test error cases
 	 */
 	result = libfshfs_file_record_read_data(
@@ -444,6 +483,169 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfshfs_file_record_get_data_fork_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_file_record_get_data_fork_descriptor(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libfshfs_file_record_t *file_record         = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_file_record_initialize(
+	          &file_record,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_record",
+	 file_record );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test fork descriptor not available
+	 */
+	result = libfshfs_file_record_get_data_fork_descriptor(
+	          file_record,
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_file_record_read_data(
+	          file_record,
+	          fshfs_test_file_record_data1,
+	          248,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_file_record_get_data_fork_descriptor(
+	          file_record,
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "fork_descriptor",
+	 fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT64(
+	 "fork_descriptor->size",
+	 fork_descriptor->size,
+	 (uint64_t) 235 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "fork_descriptor->number_of_blocks",
+	 fork_descriptor->number_of_blocks,
+	 (uint32_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_file_record_get_data_fork_descriptor(
+	          NULL,
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_file_record_get_data_fork_descriptor(
+	          file_record,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_file_record_free(
+	          &file_record,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "file_record",
+	 file_record );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_record != NULL )
+	{
+		libfshfs_file_record_free(
+		 &file_record,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
 
 /* The main program
@@ -475,6 +677,12 @@ int main(
 	 "libfshfs_file_record_read_data",
 	 fshfs_test_file_record_read_data );
 
+	FSHFS_TEST_RUN(
+	 "libfshfs_file_record_get_data_fork_descriptor",
+	 fshfs_test_file_record_get_data_fork_descriptor );
+
+	/* TODO: add tests for libfshfs_file_record_get_resource_fork_descriptor */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
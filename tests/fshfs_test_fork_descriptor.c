@@ -270,6 +270,384 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libfshfs_fork_descriptor_append_overflow_extent function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_fork_descriptor_append_overflow_extent(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libfshfs_fork_descriptor_t *fork_descriptor = NULL;
+	uint64_t number_of_mapped_blocks            = 0;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t start_block_number                 = 0;
+	int extent_index                            = 0;
+	int number_of_extents                       = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_fork_descriptor_initialize(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "fork_descriptor",
+	 fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( extent_index = 0;
+	     extent_index < 8;
+	     extent_index++ )
+	{
+		fork_descriptor->extents[ extent_index ][ 0 ] = (uint32_t) ( 100 * ( extent_index + 1 ) );
+		fork_descriptor->extents[ extent_index ][ 1 ] = 2;
+	}
+	fork_descriptor->number_of_blocks = 21;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_fork_descriptor_append_overflow_extent(
+	          fork_descriptor,
+	          5000,
+	          5,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_get_number_of_extents(
+	          fork_descriptor,
+	          &number_of_extents,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 number_of_extents,
+	 9 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_get_extent_by_index(
+	          fork_descriptor,
+	          8,
+	          &start_block_number,
+	          &number_of_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "start_block_number",
+	 start_block_number,
+	 (uint32_t) 5000 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 (uint32_t) 5 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_get_number_of_mapped_blocks(
+	          fork_descriptor,
+	          &number_of_mapped_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_mapped_blocks",
+	 number_of_mapped_blocks,
+	 (uint64_t) 21 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_fork_descriptor_append_overflow_extent(
+	          NULL,
+	          5000,
+	          5,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_fork_descriptor_append_overflow_extent(
+	          fork_descriptor,
+	          6000,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_fork_descriptor_get_extent_by_index(
+	          fork_descriptor,
+	          9,
+	          &start_block_number,
+	          &number_of_blocks,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_fork_descriptor_free(
+	          &fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "fork_descriptor",
+	 fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &fork_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_fork_descriptor_clone function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_fork_descriptor_clone(
+     void )
+{
+	libcerror_error_t *error                                = NULL;
+	libfshfs_fork_descriptor_t *destination_fork_descriptor = NULL;
+	libfshfs_fork_descriptor_t *source_fork_descriptor      = NULL;
+	int number_of_extents                                   = 0;
+	int result                                              = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_fork_descriptor_initialize(
+	          &source_fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "source_fork_descriptor",
+	 source_fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	source_fork_descriptor->extents[ 0 ][ 0 ] = 100;
+	source_fork_descriptor->extents[ 0 ][ 1 ] = 4;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_fork_descriptor_clone(
+	          &destination_fork_descriptor,
+	          source_fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_fork_descriptor",
+	 destination_fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_get_number_of_extents(
+	          destination_fork_descriptor,
+	          &number_of_extents,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 number_of_extents,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_free(
+	          &destination_fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_fork_descriptor_clone(
+	          &destination_fork_descriptor,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "destination_fork_descriptor",
+	 destination_fork_descriptor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_fork_descriptor_clone(
+	          NULL,
+	          source_fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_fork_descriptor_free(
+	          &source_fork_descriptor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &destination_fork_descriptor,
+		 NULL );
+	}
+	if( source_fork_descriptor != NULL )
+	{
+		libfshfs_fork_descriptor_free(
+		 &source_fork_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
 
 /* The main program
@@ -297,6 +675,14 @@ int main(
 	 "libfshfs_fork_descriptor_free",
 	 fshfs_test_fork_descriptor_free );
 
+	FSHFS_TEST_RUN(
+	 "libfshfs_fork_descriptor_clone",
+	 fshfs_test_fork_descriptor_clone );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_fork_descriptor_append_overflow_extent",
+	 fshfs_test_fork_descriptor_append_overflow_extent );
+
 	/* TODO: add tests for libfshfs_fork_descriptor_read */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
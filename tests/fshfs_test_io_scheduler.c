@@ -0,0 +1,967 @@
+/*
+ * Library io_scheduler type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_io_handle.h"
+#include "../libfshfs/libfshfs_io_scheduler.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_io_scheduler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_io_scheduler_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_io_scheduler_t *io_scheduler = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_io_scheduler_initialize(
+	          &io_scheduler,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_free(
+	          &io_scheduler,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_io_scheduler_initialize(
+	          NULL,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_scheduler = (libfshfs_io_scheduler_t *) 0x12345678UL;
+
+	result = libfshfs_io_scheduler_initialize(
+	          &io_scheduler,
+	          65536,
+	          4194304,
+	          &error );
+
+	io_scheduler = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_io_scheduler_initialize(
+	          &io_scheduler,
+	          65536,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_io_scheduler_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_io_scheduler_initialize(
+		          &io_scheduler,
+		          65536,
+		          4194304,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( io_scheduler != NULL )
+			{
+				libfshfs_io_scheduler_free(
+				 &io_scheduler,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "io_scheduler",
+			 io_scheduler );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_io_scheduler_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_io_scheduler_initialize(
+		          &io_scheduler,
+		          65536,
+		          4194304,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( io_scheduler != NULL )
+			{
+				libfshfs_io_scheduler_free(
+				 &io_scheduler,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "io_scheduler",
+			 io_scheduler );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_scheduler != NULL )
+	{
+		libfshfs_io_scheduler_free(
+		 &io_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_io_scheduler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_io_scheduler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_io_scheduler_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_io_scheduler_compare_reads function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_io_scheduler_compare_reads(
+     void )
+{
+	libfshfs_io_scheduler_read_t first_read;
+	libfshfs_io_scheduler_read_t second_read;
+
+	int result = 0;
+
+	first_read.offset  = 4096;
+	second_read.offset = 8192;
+
+	/* Test regular cases
+	 */
+	result = libfshfs_io_scheduler_compare_reads(
+	          &first_read,
+	          &second_read );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libfshfs_io_scheduler_compare_reads(
+	          &second_read,
+	          &first_read );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_io_scheduler_compare_reads(
+	          &first_read,
+	          &first_read );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libfshfs_io_scheduler_queue_read function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_io_scheduler_queue_read(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error              = NULL;
+	libfshfs_io_scheduler_t *io_scheduler = NULL;
+	int read_index                        = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_io_scheduler_initialize(
+	          &io_scheduler,
+	          65536,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( read_index = 0;
+	     read_index < 96;
+	     read_index++ )
+	{
+		result = libfshfs_io_scheduler_queue_read(
+		          io_scheduler,
+		          (off64_t) ( 96 - read_index ) * 512,
+		          buffer,
+		          512,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "io_scheduler->number_of_reads",
+	 io_scheduler->number_of_reads,
+	 96 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "io_scheduler->reads[ 95 ].offset",
+	 (int64_t) io_scheduler->reads[ 95 ].offset,
+	 (int64_t) 512 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_io_scheduler_queue_read(
+	          NULL,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          -1,
+	          buffer,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          0,
+	          buffer,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_io_scheduler_free(
+	          &io_scheduler,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_scheduler != NULL )
+	{
+		libfshfs_io_scheduler_free(
+		 &io_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_io_scheduler_flush function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_io_scheduler_flush(
+     void )
+{
+	uint8_t data[ 4096 ];
+	uint8_t buffer1[ 512 ];
+	uint8_t buffer2[ 512 ];
+	uint8_t buffer3[ 128 ];
+	uint8_t buffer4[ 512 ];
+
+	libbfio_handle_t *file_io_handle      = NULL;
+	libcerror_error_t *error              = NULL;
+	libfshfs_io_handle_t *io_handle       = NULL;
+	libfshfs_io_scheduler_t *io_scheduler = NULL;
+	size_t data_offset                    = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = libfshfs_io_scheduler_initialize(
+	          &io_scheduler,
+	          256,
+	          4194304,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          4096,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* The reads at offset 0 and 640 are coalesced, the reads at offset 2048 and 3584 are not
+	 */
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          2048,
+	          buffer1,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          0,
+	          buffer2,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          3584,
+	          buffer4,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          640,
+	          buffer3,
+	          128,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_flush(
+	          io_scheduler,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "io_scheduler->number_of_reads",
+	 io_scheduler->number_of_reads,
+	 0 );
+
+	result = memory_compare(
+	          buffer1,
+	          &( data[ 2048 ] ),
+	          512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer2,
+	          &( data[ 0 ] ),
+	          512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer3,
+	          &( data[ 640 ] ),
+	          128 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          buffer4,
+	          &( data[ 3584 ] ),
+	          512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test flush without pending reads
+	 */
+	result = libfshfs_io_scheduler_flush(
+	          io_scheduler,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_io_scheduler_flush(
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_io_scheduler_flush(
+	          io_scheduler,
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test flush with a pending read beyond the end of the data
+	 */
+	result = libfshfs_io_scheduler_queue_read(
+	          io_scheduler,
+	          3840,
+	          buffer1,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_flush(
+	          io_scheduler,
+	          io_handle,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The pending reads are discarded after a failed flush
+	 */
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "io_scheduler->number_of_reads",
+	 io_scheduler->number_of_reads,
+	 0 );
+
+	/* Clean up
+	 */
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_io_scheduler_free(
+	          &io_scheduler,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "io_scheduler",
+	 io_scheduler );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libfshfs_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( io_scheduler != NULL )
+	{
+		libfshfs_io_scheduler_free(
+		 &io_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_io_scheduler_initialize",
+	 fshfs_test_io_scheduler_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_io_scheduler_free",
+	 fshfs_test_io_scheduler_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_io_scheduler_compare_reads",
+	 fshfs_test_io_scheduler_compare_reads );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_io_scheduler_queue_read",
+	 fshfs_test_io_scheduler_queue_read );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_io_scheduler_flush",
+	 fshfs_test_io_scheduler_flush );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
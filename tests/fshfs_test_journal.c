@@ -0,0 +1,1710 @@
+/*
+ * Library journal type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_functions.h"
+#include "fshfs_test_libbfio.h"
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_journal.h"
+
+uint8_t fshfs_test_journal_header_data1[ 44 ] = {
+	0x4a, 0x4e, 0x4c, 0x78, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00,
+	0x00, 0x00, 0x10, 0x00, 0x86, 0x19, 0x1c, 0xbd, 0x00, 0x00, 0x02, 0x00 };
+
+uint8_t fshfs_test_journal_header_data2[ 44 ] = {
+	0x4a, 0x4e, 0x4c, 0x78, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00,
+	0x00, 0x00, 0x04, 0x00, 0x87, 0x99, 0x1b, 0x3b, 0x00, 0x00, 0x02, 0x00 };
+
+/* The journal data used by the transactions tests
+ */
+uint8_t fshfs_test_journal_data1[ 8192 ];
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Writes a block list header with a single block into the journal data
+ * Returns 1 if successful or -1 on error
+ */
+int fshfs_test_journal_write_block_list_header(
+     uint8_t *journal_data,
+     size_t block_list_header_offset,
+     uint32_t number_of_bytes_used,
+     uint64_t block_number,
+     uint32_t block_size,
+     uint32_t checksum_modifier )
+{
+	uint8_t *block_list_header_data = NULL;
+	uint32_t checksum               = 0;
+
+	if( journal_data == NULL )
+	{
+		return( -1 );
+	}
+	block_list_header_data = &( journal_data[ block_list_header_offset ] );
+
+	if( memory_set(
+	     block_list_header_data,
+	     0,
+	     1024 ) == NULL )
+	{
+		return( -1 );
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 &( block_list_header_data[ 0 ] ),
+	 63 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( block_list_header_data[ 2 ] ),
+	 2 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( block_list_header_data[ 4 ] ),
+	 number_of_bytes_used );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( block_list_header_data[ 32 ] ),
+	 block_number );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( block_list_header_data[ 40 ] ),
+	 block_size );
+
+	if( libfshfs_journal_calculate_checksum(
+	     block_list_header_data,
+	     32,
+	     &checksum,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( block_list_header_data[ 8 ] ),
+	 checksum + checksum_modifier );
+
+	return( 1 );
+}
+
+/* Creates the journal data used by the transactions tests
+ * The journal is 8192 bytes in size with a 512 bytes journal header and contains:
+ *   a block list header at offset 7168 for block 16 whose data wraps around to offset 512
+ *   a block list header at offset 1536 for block 17 with data at offset 2560
+ *   a block list header at offset 3072 for block 18 with a mismatching checksum
+ * Returns 1 if successful or -1 on error
+ */
+int fshfs_test_journal_create_data(
+     uint8_t *journal_data )
+{
+	if( journal_data == NULL )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     journal_data,
+	     0,
+	     8192 ) == NULL )
+	{
+		return( -1 );
+	}
+	if( fshfs_test_journal_write_block_list_header(
+	     journal_data,
+	     7168,
+	     2048,
+	     16,
+	     1024,
+	     0 ) != 1 )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     &( journal_data[ 512 ] ),
+	     0xa1,
+	     1024 ) == NULL )
+	{
+		return( -1 );
+	}
+	if( fshfs_test_journal_write_block_list_header(
+	     journal_data,
+	     1536,
+	     1536,
+	     17,
+	     512,
+	     0 ) != 1 )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     &( journal_data[ 2560 ] ),
+	     0xb1,
+	     512 ) == NULL )
+	{
+		return( -1 );
+	}
+	if( fshfs_test_journal_write_block_list_header(
+	     journal_data,
+	     3072,
+	     1536,
+	     18,
+	     512,
+	     1 ) != 1 )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     &( journal_data[ 4096 ] ),
+	     0xc1,
+	     512 ) == NULL )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libfshfs_journal_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfshfs_journal_t *journal     = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	journal = (libfshfs_journal_t *) 0x12345678UL;
+
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	journal = NULL;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_journal_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_journal_initialize(
+		          &journal,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( journal != NULL )
+			{
+				libfshfs_journal_free(
+				 &journal,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "journal",
+			 journal );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_journal_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_journal_initialize(
+		          &journal,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( journal != NULL )
+			{
+				libfshfs_journal_free(
+				 &journal,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "journal",
+			 journal );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_calculate_checksum function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_calculate_checksum(
+     void )
+{
+	uint8_t journal_header_data[ 44 ];
+
+	libcerror_error_t *error = NULL;
+	uint32_t checksum        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = memory_copy(
+	          journal_header_data,
+	          fshfs_test_journal_header_data1,
+	          44 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( journal_header_data[ 36 ] ),
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_journal_calculate_checksum(
+	          journal_header_data,
+	          44,
+	          &checksum,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x86191cbdUL );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_calculate_checksum(
+	          NULL,
+	          44,
+	          &checksum,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_calculate_checksum(
+	          journal_header_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &checksum,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_calculate_checksum(
+	          journal_header_data,
+	          44,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_read_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_read_header_data(
+     void )
+{
+	uint8_t journal_header_data[ 44 ];
+
+	libcerror_error_t *error    = NULL;
+	libfshfs_journal_t *journal = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data1,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "journal->start_offset",
+	 (int64_t) journal->start_offset,
+	 (int64_t) 0x00001000UL );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "journal->end_offset",
+	 (int64_t) journal->end_offset,
+	 (int64_t) 0x00003000UL );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->block_list_header_size",
+	 journal->block_list_header_size,
+	 (uint32_t) 4096 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->journal_header_size",
+	 journal->journal_header_size,
+	 (uint32_t) 512 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_read_header_data(
+	          NULL,
+	          fshfs_test_journal_header_data1,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          NULL,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data1,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the checksum does not match
+	 */
+	result = memory_copy(
+	          journal_header_data,
+	          fshfs_test_journal_header_data1,
+	          44 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	journal_header_data[ 15 ] = 0x11;
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          journal_header_data,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_insert_block function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_insert_block(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libfshfs_journal_block_t *block = NULL;
+	libfshfs_journal_t *journal     = NULL;
+	uint64_t block_number           = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	journal->journal_header_size = 512;
+
+	/* Test regular cases
+	 * Insert enough blocks for the hash table to grow
+	 */
+	for( block_number = 0;
+	     block_number < 2048;
+	     block_number++ )
+	{
+		result = libfshfs_journal_insert_block(
+		          journal,
+		          block_number * 8,
+		          (off64_t) ( 512 + block_number ),
+		          4096,
+		          0,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->number_of_blocks",
+	 journal->number_of_blocks,
+	 (uint32_t) 2048 );
+
+	/* A more recent version of a block replaces the previous one
+	 */
+	result = libfshfs_journal_insert_block(
+	          journal,
+	          80,
+	          (off64_t) 8192,
+	          8192,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->number_of_blocks",
+	 journal->number_of_blocks,
+	 (uint32_t) 2048 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->maximum_block_size",
+	 journal->maximum_block_size,
+	 (uint32_t) 8192 );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          80,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "block",
+	 block );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "block->data_offset",
+	 (int64_t) block->data_offset,
+	 (int64_t) 8192 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "block->sequence_number",
+	 block->sequence_number,
+	 (uint32_t) 1 );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          16376,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          81,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_insert_block(
+	          NULL,
+	          0,
+	          512,
+	          4096,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_insert_block(
+	          journal,
+	          0,
+	          512,
+	          0,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_get_block_by_number(
+	          NULL,
+	          0,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          0,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_read_transactions function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_read_transactions(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libfshfs_journal_block_t *block  = NULL;
+	libfshfs_journal_t *journal      = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = fshfs_test_journal_create_data(
+	          fshfs_test_journal_data1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fshfs_test_journal_data1,
+	          8192,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data2,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The transactions wrap around the end of the circular buffer and
+	 * replay stops at the block list header with the mismatching checksum
+	 */
+	result = libfshfs_journal_read_transactions(
+	          journal,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "journal->number_of_blocks",
+	 journal->number_of_blocks,
+	 (uint32_t) 2 );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          16,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "block->data_offset",
+	 (int64_t) block->data_offset,
+	 (int64_t) 512 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "block->block_size",
+	 block->block_size,
+	 (uint32_t) 1024 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "block->sequence_number",
+	 block->sequence_number,
+	 (uint32_t) 0 );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          17,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT64(
+	 "block->data_offset",
+	 (int64_t) block->data_offset,
+	 (int64_t) 2560 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "block->sequence_number",
+	 block->sequence_number,
+	 (uint32_t) 1 );
+
+	result = libfshfs_journal_get_block_by_number(
+	          journal,
+	          18,
+	          &block,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data2,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	journal->start_offset = 3072;
+
+	/* Test error case where the checksum of the first block list header does not match
+	 */
+	result = libfshfs_journal_read_transactions(
+	          journal,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_read_transactions(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_journal_apply_overlay function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_journal_apply_overlay(
+     void )
+{
+	uint8_t buffer[ 2048 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libfshfs_journal_t *journal      = NULL;
+	size_t buffer_offset             = 0;
+	uint8_t expected_byte_value      = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = fshfs_test_journal_create_data(
+	          fshfs_test_journal_data1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = fshfs_test_open_file_io_handle(
+	          &file_io_handle,
+	          fshfs_test_journal_data1,
+	          8192,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_initialize(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_read_header_data(
+	          journal,
+	          fshfs_test_journal_header_data2,
+	          44,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_journal_read_transactions(
+	          journal,
+	          file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Block 16 covers volume offsets 8192 - 9215 and the more recent block 17 covers 8704 - 9215
+	 */
+	result = memory_set(
+	          buffer,
+	          0,
+	          2048 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_journal_apply_overlay(
+	          journal,
+	          file_io_handle,
+	          8192,
+	          buffer,
+	          2048,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 2048;
+	     buffer_offset++ )
+	{
+		if( buffer_offset < 512 )
+		{
+			expected_byte_value = 0xa1;
+		}
+		else if( buffer_offset < 1024 )
+		{
+			expected_byte_value = 0xb1;
+		}
+		else
+		{
+			expected_byte_value = 0;
+		}
+		if( buffer[ buffer_offset ] != expected_byte_value )
+		{
+			break;
+		}
+	}
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_offset",
+	 buffer_offset,
+	 (size_t) 2048 );
+
+	/* Data of the block with the mismatching checksum is not applied
+	 */
+	result = memory_set(
+	          buffer,
+	          0,
+	          2048 ) != NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfshfs_journal_apply_overlay(
+	          journal,
+	          file_io_handle,
+	          9216,
+	          buffer,
+	          512,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_journal_apply_overlay(
+	          NULL,
+	          file_io_handle,
+	          8192,
+	          buffer,
+	          2048,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_apply_overlay(
+	          journal,
+	          file_io_handle,
+	          -1,
+	          buffer,
+	          2048,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_apply_overlay(
+	          journal,
+	          file_io_handle,
+	          8192,
+	          NULL,
+	          2048,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_journal_apply_overlay(
+	          journal,
+	          file_io_handle,
+	          8192,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_journal_free(
+	          &journal,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "journal",
+	 journal );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fshfs_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( journal != NULL )
+	{
+		libfshfs_journal_free(
+		 &journal,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_initialize",
+	 fshfs_test_journal_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_free",
+	 fshfs_test_journal_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_calculate_checksum",
+	 fshfs_test_journal_calculate_checksum );
+
+	/* TODO: add tests for libfshfs_journal_read_information_block_data */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_read_header_data",
+	 fshfs_test_journal_read_header_data );
+
+	/* TODO: add tests for libfshfs_journal_read_file_io_handle */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_read_transactions",
+	 fshfs_test_journal_read_transactions );
+
+	/* TODO: add tests for libfshfs_journal_read_buffer */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_insert_block",
+	 fshfs_test_journal_insert_block );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_journal_apply_overlay",
+	 fshfs_test_journal_apply_overlay );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
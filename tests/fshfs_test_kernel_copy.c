@@ -0,0 +1,950 @@
+/*
+ * Library kernel_copy type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_kernel_copy.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_kernel_copy_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfshfs_kernel_copy_t *kernel_copy = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 1;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_kernel_copy_free(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	kernel_copy = (libfshfs_kernel_copy_t *) 0x12345678UL;
+
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	kernel_copy = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_kernel_copy_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_kernel_copy_initialize(
+		          &kernel_copy,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( kernel_copy != NULL )
+			{
+				libfshfs_kernel_copy_free(
+				 &kernel_copy,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "kernel_copy",
+			 kernel_copy );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_kernel_copy_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_kernel_copy_initialize(
+		          &kernel_copy,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( kernel_copy != NULL )
+			{
+				libfshfs_kernel_copy_free(
+				 &kernel_copy,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "kernel_copy",
+			 kernel_copy );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &kernel_copy,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_open function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_open(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfshfs_kernel_copy_t *kernel_copy = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_open(
+	          NULL,
+	          "test",
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_open(
+	          kernel_copy,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_kernel_copy_free(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &kernel_copy,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_set_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_set_filename(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfshfs_kernel_copy_t *kernel_copy = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_kernel_copy_set_filename(
+	          kernel_copy,
+	          "test",
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy->filename",
+	 kernel_copy->filename );
+
+	FSHFS_TEST_ASSERT_EQUAL_SIZE(
+	 "kernel_copy->filename_size",
+	 kernel_copy->filename_size,
+	 (size_t) 5 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "kernel_copy->file_descriptor",
+	 kernel_copy->file_descriptor,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_set_filename(
+	          NULL,
+	          "test",
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_set_filename(
+	          kernel_copy,
+	          "test",
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_kernel_copy_free(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &kernel_copy,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_open_source function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_open_source(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfshfs_kernel_copy_t *kernel_copy = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_kernel_copy_open_source(
+	          kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_open_source(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_kernel_copy_free(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &kernel_copy,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_copy_range function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_copy_range(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libfshfs_kernel_copy_t *kernel_copy = NULL;
+	size64_t copied_size                = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_kernel_copy_initialize(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_copy_range(
+	          NULL,
+	          0,
+	          16,
+	          1,
+	          &copied_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test copy with a kernel copy that is not open
+	 */
+	result = libfshfs_kernel_copy_copy_range(
+	          kernel_copy,
+	          0,
+	          16,
+	          1,
+	          &copied_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_kernel_copy_free(
+	          &kernel_copy,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "kernel_copy",
+	 kernel_copy );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( kernel_copy != NULL )
+	{
+		libfshfs_kernel_copy_free(
+		 &kernel_copy,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_write_buffer(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_write_buffer(
+	          -1,
+	          buffer,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_write_buffer(
+	          1,
+	          NULL,
+	          16,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_write_buffer(
+	          1,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_kernel_copy_write_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_kernel_copy_write_buffer_at_offset(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_kernel_copy_write_buffer_at_offset(
+	          -1,
+	          buffer,
+	          16,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_write_buffer_at_offset(
+	          1,
+	          NULL,
+	          16,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_write_buffer_at_offset(
+	          1,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_kernel_copy_write_buffer_at_offset(
+	          1,
+	          buffer,
+	          16,
+	          -1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_initialize",
+	 fshfs_test_kernel_copy_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_free",
+	 fshfs_test_kernel_copy_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_open",
+	 fshfs_test_kernel_copy_open );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_set_filename",
+	 fshfs_test_kernel_copy_set_filename );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_open_source",
+	 fshfs_test_kernel_copy_open_source );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_copy_range",
+	 fshfs_test_kernel_copy_copy_range );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_write_buffer",
+	 fshfs_test_kernel_copy_write_buffer );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_kernel_copy_write_buffer_at_offset",
+	 fshfs_test_kernel_copy_write_buffer_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,741 @@
+/*
+ * Library listing_cursor type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_listing_cursor.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_listing_cursor_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_listing_cursor_initialize(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libfshfs_listing_cursor_t *listing_cursor = NULL;
+	int result                                = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests           = 1;
+	int number_of_memset_fail_tests           = 1;
+	int test_number                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_listing_cursor_initialize(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_listing_cursor_free(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_listing_cursor_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	listing_cursor = (libfshfs_listing_cursor_t *) 0x12345678UL;
+
+	result = libfshfs_listing_cursor_initialize(
+	          &listing_cursor,
+	          &error );
+
+	listing_cursor = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_listing_cursor_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_listing_cursor_initialize(
+		          &listing_cursor,
+			          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( listing_cursor != NULL )
+			{
+				libfshfs_listing_cursor_free(
+				 &listing_cursor,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "listing_cursor",
+			 listing_cursor );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_listing_cursor_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_listing_cursor_initialize(
+		          &listing_cursor,
+			          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( listing_cursor != NULL )
+			{
+				libfshfs_listing_cursor_free(
+				 &listing_cursor,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "listing_cursor",
+			 listing_cursor );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( listing_cursor != NULL )
+	{
+		libfshfs_listing_cursor_free(
+		 &listing_cursor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_listing_cursor_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_listing_cursor_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_listing_cursor_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_internal_listing_cursor_set_position function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_internal_listing_cursor_set_position(
+     void )
+{
+	uint8_t name[ 6 ]                         = { 0, 'a', 0, 'b', 0, 'c' };
+	libcerror_error_t *error                  = NULL;
+	libfshfs_listing_cursor_t *listing_cursor = NULL;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_listing_cursor_initialize(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_internal_listing_cursor_set_position(
+	          (libfshfs_internal_listing_cursor_t *) listing_cursor,
+	          16,
+	          5,
+	          3,
+	          name,
+	          6,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "listing_cursor->node_number",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->node_number,
+	 (uint32_t) 5 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "listing_cursor->name_size",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->name_size,
+	 (uint16_t) 6 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_internal_listing_cursor_set_position(
+	          NULL,
+	          16,
+	          5,
+	          3,
+	          name,
+	          6,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_internal_listing_cursor_set_position(
+	          (libfshfs_internal_listing_cursor_t *) listing_cursor,
+	          16,
+	          5,
+	          3,
+	          NULL,
+	          6,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_internal_listing_cursor_set_position(
+	          (libfshfs_internal_listing_cursor_t *) listing_cursor,
+	          16,
+	          5,
+	          3,
+	          name,
+	          LIBFSHFS_LISTING_CURSOR_MAXIMUM_NAME_SIZE + 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_listing_cursor_free(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( listing_cursor != NULL )
+	{
+		libfshfs_listing_cursor_free(
+		 &listing_cursor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_listing_cursor_copy_to_byte_stream and libfshfs_listing_cursor_copy_from_byte_stream functions
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_listing_cursor_copy_byte_stream(
+     void )
+{
+	uint8_t byte_stream[ LIBFSHFS_LISTING_CURSOR_DATA_SIZE ];
+
+	uint8_t name[ 6 ]                         = { 0, 'a', 0, 'b', 0, 'c' };
+	libcerror_error_t *error                  = NULL;
+	libfshfs_listing_cursor_t *listing_cursor = NULL;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_listing_cursor_initialize(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_internal_listing_cursor_set_position(
+	          (libfshfs_internal_listing_cursor_t *) listing_cursor,
+	          16,
+	          5,
+	          3,
+	          name,
+	          6,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_listing_cursor_copy_to_byte_stream(
+	          listing_cursor,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_internal_listing_cursor_set_position(
+	          (libfshfs_internal_listing_cursor_t *) listing_cursor,
+	          0,
+	          0,
+	          0,
+	          NULL,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_listing_cursor_copy_from_byte_stream(
+	          listing_cursor,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "listing_cursor->parent_identifier",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->parent_identifier,
+	 (uint32_t) 16 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "listing_cursor->node_number",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->node_number,
+	 (uint32_t) 5 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "listing_cursor->record_index",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->record_index,
+	 (uint16_t) 3 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "listing_cursor->name_size",
+	 ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->name_size,
+	 (uint16_t) 6 );
+
+	result = memory_compare(
+	          ( (libfshfs_internal_listing_cursor_t *) listing_cursor )->name,
+	          name,
+	          6 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_listing_cursor_copy_to_byte_stream(
+	          NULL,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_listing_cursor_copy_to_byte_stream(
+	          listing_cursor,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE - 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_listing_cursor_copy_from_byte_stream(
+	          listing_cursor,
+	          NULL,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_listing_cursor_copy_from_byte_stream(
+	          listing_cursor,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE - 1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test copy from byte stream with an invalid signature
+	 */
+	byte_stream[ 0 ] = 0xff;
+
+	result = libfshfs_listing_cursor_copy_from_byte_stream(
+	          listing_cursor,
+	          byte_stream,
+	          LIBFSHFS_LISTING_CURSOR_DATA_SIZE,
+	          &error );
+
+	byte_stream[ 0 ] = 'f';
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_listing_cursor_free(
+	          &listing_cursor,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "listing_cursor",
+	 listing_cursor );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( listing_cursor != NULL )
+	{
+		libfshfs_listing_cursor_free(
+		 &listing_cursor,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_listing_cursor_initialize",
+	 fshfs_test_listing_cursor_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_listing_cursor_free",
+	 fshfs_test_listing_cursor_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_internal_listing_cursor_set_position",
+	 fshfs_test_internal_listing_cursor_set_position );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_listing_cursor_copy_byte_stream",
+	 fshfs_test_listing_cursor_copy_byte_stream );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,682 @@
+/*
+ * Library memory_arena type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_memory_arena.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_memory_arena_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_memory_arena_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_memory_arena_t *memory_arena = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_memory_arena_initialize(
+	          &memory_arena,
+	          4096,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_memory_arena_free(
+	          &memory_arena,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_memory_arena_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	memory_arena = (libfshfs_memory_arena_t *) 0x12345678UL;
+
+	result = libfshfs_memory_arena_initialize(
+	          &memory_arena,
+	          4096,
+	          &error );
+
+	memory_arena = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_memory_arena_initialize(
+	          &memory_arena,
+	          0,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_memory_arena_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_memory_arena_initialize(
+		          &memory_arena,
+		          4096,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( memory_arena != NULL )
+			{
+				libfshfs_memory_arena_free(
+				 &memory_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "memory_arena",
+			 memory_arena );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_memory_arena_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_memory_arena_initialize(
+		          &memory_arena,
+		          4096,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( memory_arena != NULL )
+			{
+				libfshfs_memory_arena_free(
+				 &memory_arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "memory_arena",
+			 memory_arena );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( memory_arena != NULL )
+	{
+		libfshfs_memory_arena_free(
+		 &memory_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_memory_arena_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_memory_arena_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_memory_arena_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_memory_arena_allocate function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_memory_arena_allocate(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_memory_arena_t *memory_arena = NULL;
+	uint8_t *first_memory                 = NULL;
+	uint8_t *second_memory                = NULL;
+	uint8_t *third_memory                 = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_memory_arena_initialize(
+	          &memory_arena,
+	          64,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_memory_arena_allocate(
+	          memory_arena,
+	          3,
+	          (void **) &first_memory,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "first_memory",
+	 first_memory );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "first_memory[ 0 ]",
+	 first_memory[ 0 ],
+	 (uint8_t) 0 );
+
+	first_memory[ 0 ] = 0xff;
+	first_memory[ 1 ] = 0xff;
+	first_memory[ 2 ] = 0xff;
+
+	result = libfshfs_memory_arena_allocate(
+	          memory_arena,
+	          8,
+	          (void **) &second_memory,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "second_memory",
+	 second_memory );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "( (intptr_t) second_memory ) % 8",
+	 (int) ( ( (intptr_t) second_memory ) % 8 ),
+	 0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "second_memory[ 0 ]",
+	 second_memory[ 0 ],
+	 (uint8_t) 0 );
+
+	/* Test an allocation that does not fit in a block
+	 */
+	result = libfshfs_memory_arena_allocate(
+	          memory_arena,
+	          256,
+	          (void **) &third_memory,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "third_memory",
+	 third_memory );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "third_memory[ 255 ]",
+	 third_memory[ 255 ],
+	 (uint8_t) 0 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT8(
+	 "first_memory[ 2 ]",
+	 first_memory[ 2 ],
+	 (uint8_t) 0xff );
+
+	/* Test error cases
+	 */
+	result = libfshfs_memory_arena_allocate(
+	          NULL,
+	          8,
+	          (void **) &first_memory,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_memory_arena_allocate(
+	          memory_arena,
+	          0,
+	          (void **) &first_memory,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_memory_arena_allocate(
+	          memory_arena,
+	          8,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_memory_arena_free(
+	          &memory_arena,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( memory_arena != NULL )
+	{
+		libfshfs_memory_arena_free(
+		 &memory_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_memory_arena_reference function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_memory_arena_reference(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libfshfs_memory_arena_t *memory_arena    = NULL;
+	libfshfs_memory_arena_t *reference_arena = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_memory_arena_initialize(
+	          &memory_arena,
+	          64,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_memory_arena_reference(
+	          memory_arena,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "memory_arena->reference_count",
+	 memory_arena->reference_count,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	reference_arena = memory_arena;
+
+	result = libfshfs_memory_arena_free(
+	          &reference_arena,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "reference_arena",
+	 reference_arena );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "memory_arena->reference_count",
+	 memory_arena->reference_count,
+	 (uint32_t) 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_memory_arena_reference(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_memory_arena_free(
+	          &memory_arena,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "memory_arena",
+	 memory_arena );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( memory_arena != NULL )
+	{
+		libfshfs_memory_arena_free(
+		 &memory_arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_memory_arena_initialize",
+	 fshfs_test_memory_arena_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_memory_arena_free",
+	 fshfs_test_memory_arena_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_memory_arena_allocate",
+	 fshfs_test_memory_arena_allocate );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_memory_arena_reference",
+	 fshfs_test_memory_arena_reference );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
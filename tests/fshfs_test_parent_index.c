@@ -0,0 +1,662 @@
+/*
+ * Library parent_index type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_parent_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_parent_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_parent_index_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_parent_index_t *parent_index = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_parent_index_initialize(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_parent_index_free(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_parent_index_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	parent_index = (libfshfs_parent_index_t *) 0x12345678UL;
+
+	result = libfshfs_parent_index_initialize(
+	          &parent_index,
+	          &error );
+
+	parent_index = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_parent_index_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_parent_index_initialize(
+		          &parent_index,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( parent_index != NULL )
+			{
+				libfshfs_parent_index_free(
+				 &parent_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "parent_index",
+			 parent_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_parent_index_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_parent_index_initialize(
+		          &parent_index,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( parent_index != NULL )
+			{
+				libfshfs_parent_index_free(
+				 &parent_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "parent_index",
+			 parent_index );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_parent_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_parent_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_parent_index_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_parent_index_append_record function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_parent_index_append_record(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_parent_index_t *parent_index = NULL;
+	uint32_t parent_identifier            = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_parent_index_initialize(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( parent_identifier = 1;
+	     parent_identifier <= 300;
+	     parent_identifier++ )
+	{
+		result = libfshfs_parent_index_append_record(
+		          parent_index,
+		          parent_identifier,
+		          parent_identifier,
+		          0,
+		          0,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libfshfs_parent_index_append_record(
+		          parent_index,
+		          parent_identifier,
+		          parent_identifier,
+		          1,
+		          1,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_index->number_of_entries",
+	 parent_index->number_of_entries,
+	 (uint32_t) 300 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_index->entries[ 0 ].number_of_records",
+	 parent_index->entries[ 0 ].number_of_records,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_index->entries[ 0 ].number_of_children",
+	 parent_index->entries[ 0 ].number_of_children,
+	 (uint32_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_parent_index_append_record(
+	          NULL,
+	          301,
+	          301,
+	          0,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libfshfs_parent_index_append_record with a record that is not stored in key order
+	 */
+	result = libfshfs_parent_index_append_record(
+	          parent_index,
+	          16,
+	          301,
+	          0,
+	          1,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_parent_index_free(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_parent_index_get_entry_by_parent_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_parent_index_get_entry_by_parent_identifier(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libfshfs_parent_index_entry_t *entry  = NULL;
+	libfshfs_parent_index_t *parent_index = NULL;
+	uint32_t parent_identifier            = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_parent_index_initialize(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( parent_identifier = 1;
+	     parent_identifier <= 300;
+	     parent_identifier++ )
+	{
+		result = libfshfs_parent_index_append_record(
+		          parent_index,
+		          parent_identifier * 2,
+		          parent_identifier / 8,
+		          (uint16_t) ( parent_identifier % 8 ),
+		          1,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( parent_identifier = 1;
+	     parent_identifier <= 300;
+	     parent_identifier++ )
+	{
+		entry = NULL;
+
+		result = libfshfs_parent_index_get_entry_by_parent_identifier(
+		          parent_index,
+		          parent_identifier * 2,
+		          &entry,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NOT_NULL(
+		 "entry",
+		 entry );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		FSHFS_TEST_ASSERT_EQUAL_UINT32(
+		 "entry->node_number",
+		 entry->node_number,
+		 parent_identifier / 8 );
+
+		FSHFS_TEST_ASSERT_EQUAL_UINT16(
+		 "entry->record_index",
+		 entry->record_index,
+		 (uint16_t) ( parent_identifier % 8 ) );
+	}
+	result = libfshfs_parent_index_get_entry_by_parent_identifier(
+	          parent_index,
+	          3,
+	          &entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_parent_index_get_entry_by_parent_identifier(
+	          NULL,
+	          2,
+	          &entry,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_parent_index_get_entry_by_parent_identifier(
+	          parent_index,
+	          2,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_parent_index_free(
+	          &parent_index,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "parent_index",
+	 parent_index );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( parent_index != NULL )
+	{
+		libfshfs_parent_index_free(
+		 &parent_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_parent_index_initialize",
+	 fshfs_test_parent_index_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_parent_index_free",
+	 fshfs_test_parent_index_free );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_parent_index_append_record",
+	 fshfs_test_parent_index_append_record );
+
+	/* TODO: add tests for libfshfs_parent_index_read_btree_file */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_parent_index_get_entry_by_parent_identifier",
+	 fshfs_test_parent_index_get_entry_by_parent_identifier );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
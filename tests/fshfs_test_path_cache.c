@@ -0,0 +1,736 @@
+/*
+ * Library path_cache type test program
+ *
+ * Copyright (C) 2009-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "fshfs_test_libcerror.h"
+#include "fshfs_test_libfshfs.h"
+#include "fshfs_test_macros.h"
+#include "fshfs_test_memory.h"
+#include "fshfs_test_unused.h"
+
+#include "../libfshfs/libfshfs_path_cache.h"
+
+uint8_t fshfs_test_path_cache_name1[ 10 ] = {
+	0x00, 0x44, 0x00, 0x65, 0x00, 0x73, 0x00, 0x6b, 0x00, 0x74 };
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+/* Tests the libfshfs_path_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_path_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_path_cache_t *path_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libfshfs_path_cache_initialize(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_path_cache_initialize(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	path_cache = (libfshfs_path_cache_t *) 0x12345678UL;
+
+	result = libfshfs_path_cache_initialize(
+	          &path_cache,
+	          &error );
+
+	path_cache = NULL;
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_FSHFS_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_path_cache_initialize with malloc failing
+		 */
+		fshfs_test_malloc_attempts_before_fail = test_number;
+
+		result = libfshfs_path_cache_initialize(
+		          &path_cache,
+		          &error );
+
+		if( fshfs_test_malloc_attempts_before_fail != -1 )
+		{
+			fshfs_test_malloc_attempts_before_fail = -1;
+
+			if( path_cache != NULL )
+			{
+				libfshfs_path_cache_free(
+				 &path_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "path_cache",
+			 path_cache );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libfshfs_path_cache_initialize with memset failing
+		 */
+		fshfs_test_memset_attempts_before_fail = test_number;
+
+		result = libfshfs_path_cache_initialize(
+		          &path_cache,
+		          &error );
+
+		if( fshfs_test_memset_attempts_before_fail != -1 )
+		{
+			fshfs_test_memset_attempts_before_fail = -1;
+
+			if( path_cache != NULL )
+			{
+				libfshfs_path_cache_free(
+				 &path_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			FSHFS_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			FSHFS_TEST_ASSERT_IS_NULL(
+			 "path_cache",
+			 path_cache );
+
+			FSHFS_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_FSHFS_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		libfshfs_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_path_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_path_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libfshfs_path_cache_free(
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_path_cache_insert_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_path_cache_insert_entry(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_path_cache_t *path_cache = NULL;
+	uint32_t identifier               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_path_cache_initialize(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( identifier = 16;
+	     identifier < 2016;
+	     identifier++ )
+	{
+		result = libfshfs_path_cache_insert_entry(
+		          path_cache,
+		          identifier,
+		          identifier / 2,
+		          fshfs_test_path_cache_name1,
+		          10,
+		          &error );
+
+		FSHFS_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		FSHFS_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "path_cache->number_of_entries",
+	 path_cache->number_of_entries,
+	 (uint32_t) 2000 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "path_cache->maximum_number_of_entries",
+	 path_cache->maximum_number_of_entries,
+	 (uint32_t) 4096 );
+
+	/* Test libfshfs_path_cache_insert_entry with an identifier that already was inserted
+	 */
+	result = libfshfs_path_cache_insert_entry(
+	          path_cache,
+	          16,
+	          2,
+	          fshfs_test_path_cache_name1,
+	          10,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "path_cache->number_of_entries",
+	 path_cache->number_of_entries,
+	 (uint32_t) 2000 );
+
+	/* Test error cases
+	 */
+	result = libfshfs_path_cache_insert_entry(
+	          NULL,
+	          1,
+	          0,
+	          fshfs_test_path_cache_name1,
+	          10,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_path_cache_insert_entry(
+	          path_cache,
+	          0,
+	          0,
+	          fshfs_test_path_cache_name1,
+	          10,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_path_cache_insert_entry(
+	          path_cache,
+	          4000,
+	          0,
+	          NULL,
+	          10,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		libfshfs_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfshfs_path_cache_get_entry_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int fshfs_test_path_cache_get_entry_by_identifier(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libfshfs_path_cache_t *path_cache = NULL;
+	const uint8_t *name               = NULL;
+	uint32_t parent_identifier        = 0;
+	uint16_t name_size                = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libfshfs_path_cache_initialize(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_path_cache_insert_entry(
+	          path_cache,
+	          16,
+	          2,
+	          fshfs_test_path_cache_name1,
+	          10,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          16,
+	          &parent_identifier,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 2 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "name_size",
+	 name_size,
+	 (uint16_t) 10 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "name",
+	 name );
+
+	result = memory_compare(
+	          name,
+	          fshfs_test_path_cache_name1,
+	          10 );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          17,
+	          &parent_identifier,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          NULL,
+	          16,
+	          &parent_identifier,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          16,
+	          NULL,
+	          &name,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          16,
+	          &parent_identifier,
+	          NULL,
+	          &name_size,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_path_cache_get_entry_by_identifier(
+	          path_cache,
+	          16,
+	          &parent_identifier,
+	          &name,
+	          NULL,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfshfs_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "path_cache",
+	 path_cache );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		libfshfs_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc FSHFS_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] FSHFS_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argc )
+	FSHFS_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT )
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_path_cache_initialize",
+	 fshfs_test_path_cache_initialize );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_path_cache_free",
+	 fshfs_test_path_cache_free );
+
+	/* TODO: add tests for libfshfs_path_cache_resize */
+
+	/* TODO: add tests for libfshfs_path_cache_append_name */
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_path_cache_insert_entry",
+	 fshfs_test_path_cache_insert_entry );
+
+	FSHFS_TEST_RUN(
+	 "libfshfs_path_cache_get_entry_by_identifier",
+	 fshfs_test_path_cache_get_entry_by_identifier );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBFSHFS_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
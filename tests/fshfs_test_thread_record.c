@@ -321,8 +321,66 @@ int fshfs_test_thread_record_read_data(
 	 "error",
 	 error );
 
+	FSHFS_TEST_ASSERT_EQUAL_UINT32(
+	 "thread_record->parent_identifier",
+	 thread_record->parent_identifier,
+	 (uint32_t) 24 );
+
+	FSHFS_TEST_ASSERT_EQUAL_UINT16(
+	 "thread_record->name_size",
+	 thread_record->name_size,
+	 (uint16_t) 32 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "thread_record->name",
+	 thread_record->name );
+
 	/* Test error cases
 	 */
+	result = libfshfs_thread_record_read_data(
+	          thread_record,
+	          fshfs_test_thread_record_data1,
+	          42,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfshfs_thread_record_free(
+	          &thread_record,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfshfs_thread_record_initialize(
+	          &thread_record,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	FSHFS_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libfshfs_thread_record_read_data(
 	          NULL,
 	          fshfs_test_thread_record_data1,
@@ -395,6 +453,24 @@ int fshfs_test_thread_record_read_data(
 	libcerror_error_free(
 	 &error );
 
+	result = libfshfs_thread_record_read_data(
+	          thread_record,
+	          fshfs_test_thread_record_data1,
+	          20,
+	          &error );
+
+	FSHFS_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	FSHFS_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libfshfs_thread_record_free(
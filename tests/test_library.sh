@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="allocation_block btree_file btree_header btree_node btree_node_descriptor catalog_btree_key directory_entry directory_record error file_entry file_record fork_descriptor io_handle notify thread_record volume_header";
+LIBRARY_TESTS="allocation_bitmap allocation_block block_cache block_owner_index btree_file btree_header btree_node btree_node_descriptor buffer_pool catalog_btree_file catalog_btree_key catalog_index cnid_index direct_io directory_entry directory_record error export_planner extent extents_btree_file file_entry file_record fork_descriptor io_handle io_scheduler io_thread_pool journal kernel_copy listing_cursor memory_arena notify parent_index path_cache thread_record volume_header";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="offset";
 